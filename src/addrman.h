@@ -7,6 +7,7 @@
 #define BITCOIN_ADDRMAN_H
 
 #include <clientversion.h>
+#include <crypto/siphash.h>
 #include <netaddress.h>
 #include <protocol.h>
 #include <random.h>
@@ -18,10 +19,12 @@
 #include <fs.h>
 #include <hash.h>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <set>
 #include <stdint.h>
 #include <streams.h>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -171,6 +174,27 @@ public:
 //! the maximum time we'll spend trying to resolve a tried table collision, in seconds
 static const int64_t ADDRMAN_TEST_WINDOW = 40*60; // 40 minutes
 
+/** Salted hasher for indexing addrman entries by network address. */
+class CServiceHash
+{
+private:
+    const uint64_t m_salt_k0;
+    const uint64_t m_salt_k1;
+
+public:
+    CServiceHash() :
+        m_salt_k0(GetRand(std::numeric_limits<uint64_t>::max())),
+        m_salt_k1(GetRand(std::numeric_limits<uint64_t>::max()))
+    {
+    }
+
+    size_t operator()(const CService& a) const
+    {
+        const auto key = a.GetKey();
+        return static_cast<size_t>(CSipHasher(m_salt_k0, m_salt_k1).Write(key.data(), key.size()).Finalize());
+    }
+};
+
 /**
  * Stochastical (IP) address manager
  */
@@ -187,10 +211,13 @@ private:
     int nIdCount GUARDED_BY(cs);
 
     //! table with information about all nIds
-    std::map<int, CAddrInfo> mapInfo GUARDED_BY(cs);
+    //! Hash-based so the id lookups done on every Add_/Good_/Select_ are O(1)
+    //! instead of a tree walk; iteration order is irrelevant (serialization
+    //! writes its own id mapping and everything else goes through the buckets).
+    std::unordered_map<int, CAddrInfo> mapInfo GUARDED_BY(cs);
 
     //! find an nId based on its network address
-    std::map<CService, int> mapAddr GUARDED_BY(cs);
+    std::unordered_map<CService, int, CServiceHash> mapAddr GUARDED_BY(cs);
 
     //! randomly-ordered vector of all nIds
     std::vector<int> vRandom GUARDED_BY(cs);
@@ -542,9 +569,9 @@ public:
 
         // Prune new entries with refcount 0 (as a result of collisions).
         int nLostUnk = 0;
-        for (std::map<int, CAddrInfo>::const_iterator it = mapInfo.begin(); it != mapInfo.end(); ) {
+        for (auto it = mapInfo.cbegin(); it != mapInfo.cend(); ) {
             if (it->second.fInTried == false && it->second.nRefCount == 0) {
-                std::map<int, CAddrInfo>::const_iterator itCopy = it++;
+                auto itCopy = it++;
                 Delete(itCopy->first);
                 nLostUnk++;
             } else {
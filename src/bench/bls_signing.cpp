@@ -0,0 +1,163 @@
+// Copyright (c) 2022 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <bls/bls_worker.h>
+#include <random.h>
+#include <util/irange.h>
+
+// Benchmarks for the steps a quorum member goes through when producing a
+// recovered threshold signature: signing its share, verifying the shares of
+// the other members against their public key shares, and recovering the final
+// signature from a threshold of shares. This is the CPU side of what
+// CSigningManager/CSigSharesManager do per signing session, on a synthetic
+// quorum so no node context is needed.
+class SigningSession
+{
+private:
+    CBLSWorker blsWorker;
+
+public:
+    std::vector<CBLSId> ids;
+    std::vector<CBLSSecretKey> skShares; // aggregated quorum secret key share per member
+    BLSVerificationVectorPtr quorumVvec;
+
+    explicit SigningSession(int quorumSize)
+    {
+        ids.reserve(quorumSize);
+        for (const int i : irange::range(quorumSize)) {
+            uint256 id;
+            WriteLE64(id.begin(), i + 1);
+            ids.emplace_back(id);
+        }
+
+        blsWorker.Start();
+
+        // Run the DKG: every member contributes a verification vector and a
+        // secret key share for every other member
+        std::vector<BLSVerificationVectorPtr> vvecs;
+        std::vector<BLSSecretKeyVector> contributions;
+        vvecs.reserve(quorumSize);
+        contributions.reserve(quorumSize);
+        for ([[maybe_unused]] const auto _ : irange::range(quorumSize)) {
+            BLSVerificationVectorPtr vvec;
+            BLSSecretKeyVector contribution;
+            blsWorker.GenerateContributions(quorumSize / 2 + 1, ids, vvec, contribution);
+            vvecs.emplace_back(std::move(vvec));
+            contributions.emplace_back(std::move(contribution));
+        }
+
+        quorumVvec = blsWorker.BuildQuorumVerificationVector(vvecs);
+
+        skShares.reserve(quorumSize);
+        for (const int i : irange::range(quorumSize)) {
+            BLSSecretKeyVector received;
+            received.reserve(quorumSize);
+            for (const int j : irange::range(quorumSize)) {
+                received.emplace_back(contributions[j][i]);
+            }
+            skShares.emplace_back(blsWorker.AggregateSecretKeys(received));
+        }
+    }
+
+    ~SigningSession()
+    {
+        blsWorker.Stop();
+    }
+
+    size_t Threshold() const { return ids.size() / 2 + 1; }
+};
+
+// One signature share per member - the work the quorum performs in total for
+// a single signing session
+static void BLSSigning_SignShares(benchmark::Bench& bench, uint32_t epoch_iters, int quorumSize)
+{
+    SigningSession session(quorumSize);
+
+    uint64_t nonce{0};
+    bench.minEpochIterations(epoch_iters).run([&] {
+        uint256 msgHash;
+        WriteLE64(msgHash.begin(), nonce++);
+        for (const auto& skShare : session.skShares) {
+            CBLSSignature sigShare = skShare.Sign(msgHash);
+            assert(sigShare.IsValid());
+        }
+    });
+}
+
+// Verification of a single incoming share, including the public key share
+// derivation from the quorum verification vector (uncached worst case)
+static void BLSSigning_VerifyShare(benchmark::Bench& bench, uint32_t epoch_iters, int quorumSize)
+{
+    SigningSession session(quorumSize);
+
+    uint256 msgHash;
+    WriteLE64(msgHash.begin(), 1);
+    std::vector<CBLSSignature> sigShares;
+    sigShares.reserve(session.ids.size());
+    for (const auto& skShare : session.skShares) {
+        sigShares.emplace_back(skShare.Sign(msgHash));
+    }
+
+    size_t memberIdx{0};
+    bench.minEpochIterations(epoch_iters).run([&] {
+        CBLSPublicKey pubKeyShare = CBLSWorker::BuildPubKeyShare(session.quorumVvec, session.ids[memberIdx]);
+        assert(sigShares[memberIdx].VerifyInsecure(pubKeyShare, msgHash));
+        memberIdx = (memberIdx + 1) % session.ids.size();
+    });
+}
+
+// Recovery of the final threshold signature from threshold-many shares -
+// the time-to-recovered-sig once enough shares have been collected
+static void BLSSigning_RecoverSig(benchmark::Bench& bench, uint32_t epoch_iters, int quorumSize)
+{
+    SigningSession session(quorumSize);
+
+    uint256 msgHash;
+    WriteLE64(msgHash.begin(), 1);
+    std::vector<CBLSSignature> sigShares;
+    std::vector<CBLSId> shareIds;
+    sigShares.reserve(session.Threshold());
+    shareIds.reserve(session.Threshold());
+    for (const size_t i : irange::range(session.Threshold())) {
+        sigShares.emplace_back(session.skShares[i].Sign(msgHash));
+        shareIds.emplace_back(session.ids[i]);
+    }
+
+    bench.minEpochIterations(epoch_iters).run([&] {
+        CBLSSignature recoveredSig;
+        recoveredSig.Recover(sigShares, shareIds);
+        assert(recoveredSig.IsValid());
+    });
+}
+
+#define BENCH_SignShares(quorumSize, epoch_iters) \
+    static void BLSSigning_SignShares_##quorumSize(benchmark::Bench& bench) \
+    { \
+        BLSSigning_SignShares(bench, epoch_iters, quorumSize); \
+    } \
+    BENCHMARK(BLSSigning_SignShares_##quorumSize)
+
+#define BENCH_VerifyShare(quorumSize, epoch_iters) \
+    static void BLSSigning_VerifyShare_##quorumSize(benchmark::Bench& bench) \
+    { \
+        BLSSigning_VerifyShare(bench, epoch_iters, quorumSize); \
+    } \
+    BENCHMARK(BLSSigning_VerifyShare_##quorumSize)
+
+#define BENCH_RecoverSig(quorumSize, epoch_iters) \
+    static void BLSSigning_RecoverSig_##quorumSize(benchmark::Bench& bench) \
+    { \
+        BLSSigning_RecoverSig(bench, epoch_iters, quorumSize); \
+    } \
+    BENCHMARK(BLSSigning_RecoverSig_##quorumSize)
+
+BENCH_SignShares(10, 10)
+BENCH_SignShares(50, 2)
+
+BENCH_VerifyShare(10, 10)
+BENCH_VerifyShare(50, 10)
+
+BENCH_RecoverSig(10, 10)
+BENCH_RecoverSig(50, 2)
@@ -0,0 +1,226 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <coinjoin/coinjoin.h>
+#include <consensus/consensus.h>
+#include <consensus/validation.h>
+#include <policy/policy.h>
+#include <random.h>
+#include <script/standard.h>
+#include <test/util.h>
+#include <test/util/setup_common.h>
+#include <txmempool.h>
+#include <validation.h>
+
+#include <map>
+#include <vector>
+
+static void AddTx(const CTransactionRef& tx, CTxMemPool& pool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, pool.cs)
+{
+    int64_t nTime = 0;
+    unsigned int nHeight = 1;
+    bool spendsCoinbase = false;
+    unsigned int sigOpCost = 4;
+    LockPoints lp;
+    pool.addUnchecked(CTxMemPoolEntry(tx, 1000, nTime, nHeight, spendsCoinbase, sigOpCost, lp));
+}
+
+// Mimic the transaction shape CoinJoin mixing leaves in the mempool: "create
+// denominations" transactions fan a large coin out into many equal
+// denomination outputs, and every subsequent mixing round merges
+// same-denomination outputs from several of those transactions and pays them
+// out again at the very same value. The result is wide transactions with
+// dozens of equal-value inputs and outputs chained many rounds deep - the
+// shape that makes the ancestor/descendant walks in the mempool expensive and
+// which the generic random chains in mempool_stress.cpp never produce.
+static std::vector<CTransactionRef> CreateCoinJoinShapedTxs(FastRandomContext& det_rand, int nSessions, int nRounds)
+{
+    std::vector<CTransactionRef> txs;
+    std::map<CAmount, std::vector<COutPoint>> mapAvailable; // not yet mixed outputs per denomination
+
+    size_t tx_counter = 1;
+    for (int i = 0; i < nSessions; ++i) {
+        for (const CAmount denom : CCoinJoin::GetStandardDenominations()) {
+            CMutableTransaction tx;
+            tx.vin.resize(1);
+            tx.vin[0].scriptSig = CScript() << CScriptNum(static_cast<int64_t>(tx_counter));
+            tx.vout.resize(COINJOIN_ENTRY_MAX_SIZE + det_rand.randrange(COINJOIN_ENTRY_MAX_SIZE));
+            for (auto& out : tx.vout) {
+                out.scriptPubKey = CScript() << CScriptNum(static_cast<int64_t>(tx_counter)) << OP_EQUAL;
+                out.nValue = denom;
+            }
+            txs.emplace_back(MakeTransactionRef(tx));
+            for (uint32_t n = 0; n < txs.back()->vout.size(); ++n) {
+                mapAvailable[denom].emplace_back(txs.back()->GetHash(), n);
+            }
+            ++tx_counter;
+        }
+    }
+
+    for (int nRound = 0; nRound < nRounds; ++nRound) {
+        for (const CAmount denom : CCoinJoin::GetStandardDenominations()) {
+            auto& vecCoins = mapAvailable[denom];
+            // the inputs of one denominate tx should come from many different participants
+            Shuffle(vecCoins.begin(), vecCoins.end(), det_rand);
+            std::vector<COutPoint> vecMixed;
+            size_t i = 0;
+            while (i < vecCoins.size()) {
+                const size_t nIns = std::min<size_t>(3 + det_rand.randrange(2 * COINJOIN_ENTRY_MAX_SIZE), vecCoins.size() - i);
+                CMutableTransaction tx;
+                tx.vin.reserve(nIns);
+                for (size_t k = 0; k < nIns; ++k) {
+                    tx.vin.emplace_back(vecCoins[i + k]);
+                    tx.vin.back().scriptSig = CScript() << CScriptNum(static_cast<int64_t>(tx_counter));
+                }
+                tx.vout.resize(nIns);
+                for (auto& out : tx.vout) {
+                    out.scriptPubKey = CScript() << CScriptNum(static_cast<int64_t>(tx_counter)) << OP_EQUAL;
+                    out.nValue = denom;
+                }
+                txs.emplace_back(MakeTransactionRef(tx));
+                for (uint32_t n = 0; n < txs.back()->vout.size(); ++n) {
+                    vecMixed.emplace_back(txs.back()->GetHash(), n);
+                }
+                ++tx_counter;
+                i += nIns;
+            }
+            vecCoins = std::move(vecMixed);
+        }
+    }
+    return txs;
+}
+
+static void CoinJoinMemPoolTrim(benchmark::Bench& bench)
+{
+    FastRandomContext det_rand{true};
+    const std::vector<CTransactionRef> txs = CreateCoinJoinShapedTxs(det_rand, /* nSessions */ 10, /* nRounds */ 10);
+
+    TestingSetup test_setup;
+    CTxMemPool pool;
+    LOCK2(cs_main, pool.cs);
+    bench.run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (const auto& tx : txs) {
+            AddTx(tx, pool);
+        }
+        pool.TrimToSize(pool.DynamicMemoryUsage() * 3 / 4);
+        pool.TrimToSize(GetVirtualTransactionSize(*txs.front()));
+    });
+}
+
+static void CoinJoinMemPoolRemoveForBlock(benchmark::Bench& bench)
+{
+    FastRandomContext det_rand{true};
+    const std::vector<CTransactionRef> txs = CreateCoinJoinShapedTxs(det_rand, /* nSessions */ 10, /* nRounds */ 10);
+
+    TestingSetup test_setup;
+    CTxMemPool pool;
+    LOCK2(cs_main, pool.cs);
+    // confirm a block's worth of denominate transactions at a time, oldest first
+    constexpr size_t BLOCK_TXS{200};
+    bench.run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (const auto& tx : txs) {
+            AddTx(tx, pool);
+        }
+        unsigned int nHeight = 2;
+        for (size_t i = 0; i < txs.size(); i += BLOCK_TXS) {
+            const std::vector<CTransactionRef> block_txs(txs.begin() + i, txs.begin() + std::min(i + BLOCK_TXS, txs.size()));
+            pool.removeForBlock(block_txs, nHeight++);
+        }
+    });
+}
+
+// Full AcceptToMemoryPool on denominate chains with valid (trivial) scripts.
+// Merging outputs of many participants quickly runs into the default
+// ancestor/descendant limits, so the accepted corpus is one chain of
+// denominate transactions per funding coin, each merging its predecessor's
+// equal-value outputs. On top of that a few transactions deliberately merge
+// the tails of several chains: those exceed the ancestor limit and get
+// rejected, which exercises exactly the expensive limit walk that rejects
+// them.
+static void CoinJoinMemPoolAccept(benchmark::Bench& bench)
+{
+    RegTestingSetup test_setup;
+    const CScript redeemScript = CScript() << OP_DROP << OP_TRUE;
+    const CScript SCRIPT_PUB =
+        CScript() << OP_HASH160 << ToByteVector(CScriptID(redeemScript))
+                  << OP_EQUAL;
+    const CScript scriptSig = CScript() << std::vector<uint8_t>(100, 0xff)
+                                        << ToByteVector(redeemScript);
+
+    const CAmount denom = CCoinJoin::GetSmallestDenomination();
+    constexpr CAmount FEE_COIN{10000};  // one small coin per denominate tx pays its relay fee
+    constexpr size_t GROUP_SIZE{5};     // equal-value inputs/outputs per denominate tx
+    constexpr int ROUNDS{20};           // stays below the default ancestor limit
+
+    // Fund the mixing: split a handful of mature coinbases into exact
+    // denominations plus fee coins, the remainder is simply paid as fee
+    constexpr size_t NUM_BLOCKS{COINBASE_MATURITY + 8};
+    std::vector<CTransactionRef> txs;
+    for (size_t b{0}; b < NUM_BLOCKS; ++b) {
+        CMutableTransaction tx;
+        tx.vin.push_back(MineBlock(test_setup.m_node, SCRIPT_PUB));
+        tx.vin.back().scriptSig = scriptSig;
+        if (NUM_BLOCKS - b < COINBASE_MATURITY) continue;
+        for (size_t n{0}; n < GROUP_SIZE; ++n) {
+            tx.vout.emplace_back(denom, SCRIPT_PUB);
+        }
+        for (int n{0}; n < ROUNDS; ++n) {
+            tx.vout.emplace_back(FEE_COIN, SCRIPT_PUB);
+        }
+        txs.emplace_back(MakeTransactionRef(tx));
+    }
+
+    // One chain of denominate transactions per funding transaction
+    std::vector<COutPoint> vecChainTails;
+    const size_t nFundingTxs = txs.size();
+    for (size_t f{0}; f < nFundingTxs; ++f) {
+        const CTransactionRef funding = txs[f];
+        uint256 prevHash = funding->GetHash();
+        for (int r{0}; r < ROUNDS; ++r) {
+            CMutableTransaction tx;
+            for (size_t n{0}; n < GROUP_SIZE; ++n) {
+                tx.vin.emplace_back(COutPoint(prevHash, n));
+                tx.vin.back().scriptSig = scriptSig;
+            }
+            tx.vin.emplace_back(COutPoint(funding->GetHash(), GROUP_SIZE + r));
+            tx.vin.back().scriptSig = scriptSig;
+            for (size_t n{0}; n < GROUP_SIZE; ++n) {
+                tx.vout.emplace_back(denom, SCRIPT_PUB);
+            }
+            txs.emplace_back(MakeTransactionRef(tx));
+            prevHash = txs.back()->GetHash();
+        }
+        vecChainTails.emplace_back(prevHash, 0);
+    }
+
+    // Merging the tails of several chains unions their ancestor sets, which
+    // blows through the default ancestor limit
+    CMutableTransaction txMerge;
+    for (const auto& tail : vecChainTails) {
+        txMerge.vin.emplace_back(tail);
+        txMerge.vin.back().scriptSig = scriptSig;
+    }
+    for (size_t n{0}; n + 1 < vecChainTails.size(); ++n) {
+        txMerge.vout.emplace_back(denom, SCRIPT_PUB); // one output less, the difference pays the fee
+    }
+    const CTransactionRef txMergeRef = MakeTransactionRef(txMerge);
+
+    LOCK(::cs_main); // Required for ::AcceptToMemoryPool.
+    bench.run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (const auto& txr : txs) {
+            CValidationState state;
+            bool ret{::AcceptToMemoryPool(*test_setup.m_node.mempool, state, txr, nullptr /* pfMissingInputs */, false /* bypass_limits */, /* nAbsurdFee */ 0)};
+            assert(ret);
+        }
+        CValidationState state;
+        bool ret{::AcceptToMemoryPool(*test_setup.m_node.mempool, state, txMergeRef, nullptr /* pfMissingInputs */, false /* bypass_limits */, /* nAbsurdFee */ 0)};
+        assert(!ret); // too-long-mempool-chain, after the full limit walk
+        test_setup.m_node.mempool->clear();
+    });
+}
+
+BENCHMARK(CoinJoinMemPoolTrim);
+BENCHMARK(CoinJoinMemPoolRemoveForBlock);
+BENCHMARK(CoinJoinMemPoolAccept);
@@ -0,0 +1,84 @@
+// Copyright (c) 2026 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <chainparams.h>
+#include <consensus/consensus.h>
+#include <consensus/validation.h>
+#include <script/standard.h>
+#include <test/util.h>
+#include <test/util/setup_common.h>
+#include <txmempool.h>
+#include <validation.h>
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+/** End-to-end IBD-style macro benchmark. A chain with real coinbase spends is
+ * mined once up front, then each epoch replays every block through
+ * ProcessNewBlock against a fresh datadir and ends with a full chainstate
+ * flush, exercising the whole connect path (header acceptance, script checks,
+ * UTXO application, undo writes) that the per-operation benchmarks miss.
+ *
+ * The epoch time is the metric tracked for regressions; per-phase connect and
+ * flush breakdowns for the same replay are available by running with
+ * -debug=bench, which ConnectBlock and FlushStateToDisk already log.
+ */
+static void ProcessBlockReplay(benchmark::Bench& bench)
+{
+    constexpr size_t NUM_BLOCKS{COINBASE_MATURITY + 50};
+
+    const CScript redeemScript = CScript() << OP_DROP << OP_TRUE;
+    const CScript SCRIPT_PUB =
+        CScript() << OP_HASH160 << ToByteVector(CScriptID(redeemScript))
+                  << OP_EQUAL;
+    const CScript scriptSig = CScript() << std::vector<uint8_t>(100, 0xff)
+                                        << ToByteVector(redeemScript);
+
+    // Mine the chain once and capture the blocks to replay.
+    std::vector<std::shared_ptr<const CBlock>> blocks;
+    {
+        RegTestingSetup test_setup;
+        std::vector<CTxIn> coinbase_ins;
+        for (size_t b{0}; b < NUM_BLOCKS; ++b) {
+            if (b >= COINBASE_MATURITY) {
+                // Spend a matured coinbase so the replayed blocks carry real
+                // script and UTXO work, not just coinbase insertions.
+                CMutableTransaction tx;
+                tx.vin.push_back(coinbase_ins[b - COINBASE_MATURITY]);
+                tx.vin.back().scriptSig = scriptSig;
+                tx.vout.emplace_back(1337, SCRIPT_PUB);
+                LOCK(::cs_main);
+                CValidationState state;
+                bool ret{::AcceptToMemoryPool(*test_setup.m_node.mempool, state, MakeTransactionRef(tx), nullptr /* pfMissingInputs */, false /* bypass_limits */, /* nAbsurdFee */ 0)};
+                assert(ret);
+            }
+            coinbase_ins.push_back(MineBlock(test_setup.m_node, SCRIPT_PUB));
+        }
+
+        LOCK(::cs_main);
+        assert(::ChainActive().Height() == int(NUM_BLOCKS));
+        for (int height = 1; height <= ::ChainActive().Height(); ++height) {
+            auto pblock = std::make_shared<CBlock>();
+            bool read = ReadBlockFromDisk(*pblock, ::ChainActive()[height], Params().GetConsensus());
+            assert(read);
+            blocks.push_back(std::move(pblock));
+        }
+    }
+
+    bench.epochs(3).epochIterations(1).run([&] {
+        RegTestingSetup test_setup;
+        for (const auto& pblock : blocks) {
+            bool processed{Assert(test_setup.m_node.chainman)->ProcessNewBlock(Params(), pblock, true /* fForceProcessing */, nullptr)};
+            assert(processed);
+        }
+        assert(WITH_LOCK(::cs_main, return ::ChainActive().Height()) == int(NUM_BLOCKS));
+        // IBD pays the flush too, so include it in the measured epoch.
+        ::ChainstateActive().ForceFlushStateToDisk();
+    });
+}
+
+BENCHMARK(ProcessBlockReplay);
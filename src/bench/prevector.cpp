@@ -107,6 +107,45 @@ static void PrevectorAssignTo(benchmark::Bench& bench)
     });
 }
 
+// Sizes roughly matching the CScript mix in real blocks: most scriptPubKeys
+// (P2SH 23, P2PKH 25) fit the direct storage, while typical scriptSigs
+// (~72 and ~107 bytes) and multisig redeem scripts (~201 bytes) spill to the
+// heap. Weighted towards the scriptSig sizes, as every input carries one.
+static constexpr unsigned int SCRIPT_SIZES[] = {23, 25, 25, 35, 72, 107, 107, 107, 201};
+
+// Byte-wise appends, as done when a script is built via CScript::operator<<;
+// the heap-bound sizes exercise the growth policy.
+static void PrevectorFillScriptSizes(benchmark::Bench& bench)
+{
+    bench.batch(sizeof(SCRIPT_SIZES) / sizeof(SCRIPT_SIZES[0])).run([&] {
+        for (unsigned int size : SCRIPT_SIZES) {
+            prevec t;
+            for (unsigned int i = 0; i < size; ++i) {
+                t.push_back(static_cast<unsigned char>(i));
+            }
+        }
+    });
+}
+BENCHMARK(PrevectorFillScriptSizes);
+
+// Whole-script copies, as done during block deserialization and mempool
+// insertion; these hit change_capacity() once per heap-bound script.
+static void PrevectorCopyScriptSizes(benchmark::Bench& bench)
+{
+    std::vector<prevec> src;
+    for (unsigned int size : SCRIPT_SIZES) {
+        src.emplace_back();
+        src.back().resize(size);
+    }
+    bench.batch(src.size()).run([&] {
+        for (const prevec& s : src) {
+            prevec t(s);
+            ankerl::nanobench::doNotOptimizeAway(t);
+        }
+    });
+}
+BENCHMARK(PrevectorCopyScriptSizes);
+
 #define PREVECTOR_TEST(name)                                         \
     static void Prevector##name##Nontrivial(benchmark::Bench& bench) \
     {                                                                \
@@ -14,20 +14,50 @@
 #include <validation.h>
 #include <util/system.h>
 
+#include <bitset>
 #include <unordered_map>
 
 #define MIN_TRANSACTION_SIZE (::GetSerializeSize(CTransaction(), PROTOCOL_VERSION))
 
+/** Free list of txn_available scratch vectors. Every compact block allocates a
+ *  block-sized vector of refs and throws it away right after reconstruction, at
+ *  exactly the latency-sensitive block-arrival moment; recycling the capacity
+ *  keeps that path allocation-free in the steady state. A handful of entries is
+ *  enough since only a few compact blocks are in flight at once. */
+static constexpr size_t TXN_SCRATCH_POOL_MAX{4};
+static Mutex cs_txn_scratch_pool;
+static std::vector<std::vector<CTransactionRef>> txn_scratch_pool GUARDED_BY(cs_txn_scratch_pool);
+
+static void AcquireTxnScratch(std::vector<CTransactionRef>& scratch)
+{
+    LOCK(cs_txn_scratch_pool);
+    if (!txn_scratch_pool.empty()) {
+        scratch = std::move(txn_scratch_pool.back());
+        txn_scratch_pool.pop_back();
+    }
+}
+
+static void ReleaseTxnScratch(std::vector<CTransactionRef>& scratch)
+{
+    // Drop the refs outside of the pool lock, they may be the last ones
+    scratch.clear();
+    LOCK(cs_txn_scratch_pool);
+    if (txn_scratch_pool.size() < TXN_SCRATCH_POOL_MAX) {
+        txn_scratch_pool.emplace_back(std::move(scratch));
+    }
+}
+
 CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block) :
         nonce(GetRand(std::numeric_limits<uint64_t>::max())),
         shorttxids(block.vtx.size() - 1), prefilledtxn(1), header(block) {
     FillShortTxIDSelector();
     //TODO: Use our mempool prior to block acceptance to predictively fill more than just the coinbase
     prefilledtxn[0] = {0, block.vtx[0]};
+    std::vector<const uint256*> hashes(block.vtx.size() - 1);
     for (size_t i = 1; i < block.vtx.size(); i++) {
-        const CTransaction& tx = *block.vtx[i];
-        shorttxids[i - 1] = GetShortID(tx.GetHash());
+        hashes[i - 1] = &block.vtx[i]->GetHash();
     }
+    GetShortIDs(hashes.data(), shorttxids.data(), hashes.size());
 }
 
 void CBlockHeaderAndShortTxIDs::FillShortTxIDSelector() const {
@@ -46,6 +76,13 @@ uint64_t CBlockHeaderAndShortTxIDs::GetShortID(const uint256& txhash) const {
     return SipHashUint256(shorttxidk0, shorttxidk1, txhash) & 0xffffffffffffL;
 }
 
+void CBlockHeaderAndShortTxIDs::GetShortIDs(const uint256* const* txhashes, uint64_t* out, size_t count) const {
+    SipHashUint256Batch(shorttxidk0, shorttxidk1, txhashes, out, count);
+    for (size_t i = 0; i < count; i++) {
+        out[i] &= 0xffffffffffffL;
+    }
+}
+
 
 
 ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<uint256, CTransactionRef>>& extra_txn) {
@@ -56,7 +93,8 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
 
     assert(header.IsNull() && txn_available.empty());
     header = cmpctblock.header;
-    txn_available.resize(cmpctblock.BlockTxCount());
+    AcquireTxnScratch(txn_available);
+    txn_available.assign(cmpctblock.BlockTxCount(), CTransactionRef());
 
     int32_t lastprefilledindex = -1;
     for (size_t i = 0; i < cmpctblock.prefilledtxn.size(); i++) {
@@ -104,32 +142,56 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     if (shorttxids.size() != cmpctblock.shorttxids.size())
         return READ_STATUS_FAILED; // Short ID collision
 
+    // The mempool scan below computes a short ID for every mempool entry but
+    // almost all of them are not in the block, so reject the misses with one
+    // bit test in this L1-resident prefix filter instead of an unordered_map
+    // lookup each. With a few thousand shorttxids the false positive rate per
+    // entry is shorttxids.size() / 2^16.
+    std::bitset<1 << 16> shortid_prefixes;
+    for (const uint64_t shortid : cmpctblock.shorttxids) {
+        shortid_prefixes.set(shortid & 0xffff);
+    }
+
     std::vector<bool> have_txn(txn_available.size());
     {
     LOCK(pool->cs);
-    for (size_t i = 0; i < pool->vTxHashes.size(); i++) {
-        uint64_t shortid = cmpctblock.GetShortID(pool->vTxHashes[i].first);
-        std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
-        if (idit != shorttxids.end()) {
-            if (!have_txn[idit->second]) {
-                txn_available[idit->second] = pool->vTxHashes[i].second->GetSharedTx();
-                have_txn[idit->second]  = true;
-                mempool_count++;
-            } else {
-                // If we find two mempool txn that match the short id, just request it.
-                // This should be rare enough that the extra bandwidth doesn't matter,
-                // but eating a round-trip due to FillBlock failure would be annoying
-                if (txn_available[idit->second]) {
-                    txn_available[idit->second].reset();
-                    mempool_count--;
+    // Hash the mempool txids in fixed-size chunks so that the batch SipHash
+    // kernel can process several of them per call.
+    constexpr size_t CHUNK = 64;
+    const uint256* chunk_hashes[CHUNK];
+    uint64_t chunk_shortids[CHUNK];
+    const size_t pool_size = pool->vTxHashes.size();
+    for (size_t base = 0; base < pool_size && mempool_count < shorttxids.size(); base += CHUNK) {
+        const size_t chunk = std::min(CHUNK, pool_size - base);
+        for (size_t i = 0; i < chunk; i++) {
+            chunk_hashes[i] = &pool->vTxHashes[base + i].first;
+        }
+        cmpctblock.GetShortIDs(chunk_hashes, chunk_shortids, chunk);
+        for (size_t i = 0; i < chunk; i++) {
+            const uint64_t shortid = chunk_shortids[i];
+            if (!shortid_prefixes[shortid & 0xffff]) continue;
+            std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
+            if (idit != shorttxids.end()) {
+                if (!have_txn[idit->second]) {
+                    txn_available[idit->second] = pool->vTxHashes[base + i].second->GetSharedTx();
+                    have_txn[idit->second]  = true;
+                    mempool_count++;
+                } else {
+                    // If we find two mempool txn that match the short id, just request it.
+                    // This should be rare enough that the extra bandwidth doesn't matter,
+                    // but eating a round-trip due to FillBlock failure would be annoying
+                    if (txn_available[idit->second]) {
+                        txn_available[idit->second].reset();
+                        mempool_count--;
+                    }
                 }
             }
+            // Though ideally we'd continue scanning for the two-txn-match-shortid case,
+            // the performance win of an early exit here is too good to pass up and worth
+            // the extra risk.
+            if (mempool_count == shorttxids.size())
+                break;
         }
-        // Though ideally we'd continue scanning for the two-txn-match-shortid case,
-        // the performance win of an early exit here is too good to pass up and worth
-        // the extra risk.
-        if (mempool_count == shorttxids.size())
-            break;
     }
     }
 
@@ -169,6 +231,13 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     return READ_STATUS_OK;
 }
 
+PartiallyDownloadedBlock::~PartiallyDownloadedBlock()
+{
+    // FillBlock() clear()s txn_available but keeps its capacity, so the
+    // scratch is recycled both on success and when reconstruction is abandoned
+    ReleaseTxnScratch(txn_available);
+}
+
 bool PartiallyDownloadedBlock::IsTxAvailable(size_t index) const {
     assert(!header.IsNull());
     assert(index < txn_available.size());
@@ -38,13 +38,13 @@ CBloomFilter::CBloomFilter(const unsigned int nElements, const double nFPRate, c
 {
 }
 
-inline unsigned int CBloomFilter::Hash(unsigned int nHashNum, const std::vector<unsigned char>& vDataToHash) const
+inline unsigned int CBloomFilter::Hash(unsigned int nHashNum, Span<const unsigned char> vDataToHash) const
 {
     // 0xFBA4C795 chosen as it guarantees a reasonable bit difference between nHashNum values.
     return MurmurHash3(nHashNum * 0xFBA4C795 + nTweak, vDataToHash) % (vData.size() * 8);
 }
 
-void CBloomFilter::insert(const std::vector<unsigned char>& vKey)
+void CBloomFilter::insert(Span<const unsigned char> vKey)
 {
     if (vData.empty()) // Avoid divide-by-zero (CVE-2013-5700)
         return;
@@ -60,17 +60,15 @@ void CBloomFilter::insert(const COutPoint& outpoint)
 {
     CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
     stream << outpoint;
-    std::vector<unsigned char> data(stream.begin(), stream.end());
-    insert(data);
+    insert(MakeUCharSpan(stream));
 }
 
 void CBloomFilter::insert(const uint256& hash)
 {
-    std::vector<unsigned char> data(hash.begin(), hash.end());
-    insert(data);
+    insert(MakeUCharSpan(hash));
 }
 
-bool CBloomFilter::contains(const std::vector<unsigned char>& vKey) const
+bool CBloomFilter::contains(Span<const unsigned char> vKey) const
 {
     if (vData.empty()) // Avoid divide-by-zero (CVE-2013-5700)
         return true;
@@ -88,20 +86,17 @@ bool CBloomFilter::contains(const COutPoint& outpoint) const
 {
     CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
     stream << outpoint;
-    std::vector<unsigned char> data(stream.begin(), stream.end());
-    return contains(data);
+    return contains(MakeUCharSpan(stream));
 }
 
 bool CBloomFilter::contains(const uint256& hash) const
 {
-    std::vector<unsigned char> data(hash.begin(), hash.end());
-    return contains(data);
+    return contains(MakeUCharSpan(hash));
 }
 
 bool CBloomFilter::contains(const uint160& hash) const
 {
-    std::vector<unsigned char> data(hash.begin(), hash.end());
-    return contains(data);
+    return contains(MakeUCharSpan(hash));
 }
 
 bool CBloomFilter::IsWithinSizeConstraints() const
@@ -253,6 +248,14 @@ bool CBloomFilter::IsRelevantAndUpdate(const CTransaction& tx)
     return false;
 }
 
+/* Number of 64-bit generation-bit pairs per probe block. 8 pairs = 16 words =
+ * 128 bytes, so all probes for one key touch at most two adjacent cache lines
+ * (blocked bloom filter layout) instead of being scattered over the whole
+ * array. This raises the fp rate marginally versus fully independent probe
+ * positions, but cuts a contains() miss from nHashFuncs potential cache
+ * misses down to one or two. */
+static constexpr uint32_t ROLLING_BLOOM_BLOCK_PAIRS{8};
+
 CRollingBloomFilter::CRollingBloomFilter(const unsigned int nElements, const double fpRate)
 {
     double logFpRate = log(fpRate);
@@ -275,13 +278,17 @@ CRollingBloomFilter::CRollingBloomFilter(const unsigned int nElements, const dou
      * bit is treated as unset. If the bits are (01), (10), or (11), the bit is
      * treated as set in generation 1, 2, or 3 respectively.
      * These bits are stored in separate integers: position P corresponds to bit
-     * (P & 63) of the integers data[(P >> 6) * 2] and data[(P >> 6) * 2 + 1]. */
-    data.resize(((nFilterBits + 63) / 64) << 1);
+     * (P & 63) of the integers data[(P >> 6) * 2] and data[(P >> 6) * 2 + 1].
+     * The pair count is rounded up to a whole number of probe blocks (see
+     * ROLLING_BLOOM_BLOCK_PAIRS); the extra slack slightly lowers the fp rate. */
+    uint32_t nPairs = (nFilterBits + 63) / 64;
+    nPairs = ((nPairs + ROLLING_BLOOM_BLOCK_PAIRS - 1) / ROLLING_BLOOM_BLOCK_PAIRS) * ROLLING_BLOOM_BLOCK_PAIRS;
+    data.resize(((size_t)nPairs) << 1);
     reset();
 }
 
 /* Similar to CBloomFilter::Hash */
-static inline uint32_t RollingBloomHash(unsigned int nHashNum, uint32_t nTweak, const std::vector<unsigned char>& vDataToHash) {
+static inline uint32_t RollingBloomHash(unsigned int nHashNum, uint32_t nTweak, Span<const unsigned char> vDataToHash) {
     return MurmurHash3(nHashNum * 0xFBA4C795 + nTweak, vDataToHash);
 }
 
@@ -293,7 +300,7 @@ static inline uint32_t FastMod(uint32_t x, size_t n) {
     return ((uint64_t)x * (uint64_t)n) >> 32;
 }
 
-void CRollingBloomFilter::insert(const std::vector<unsigned char>& vKey)
+void CRollingBloomFilter::insert(Span<const unsigned char> vKey)
 {
     if (nEntriesThisGeneration == nEntriesPerGeneration) {
         nEntriesThisGeneration = 0;
@@ -313,31 +320,35 @@ void CRollingBloomFilter::insert(const std::vector<unsigned char>& vKey)
     }
     nEntriesThisGeneration++;
 
+    /* An extra hash (index nHashFuncs, unused by the probes below) selects the
+     * probe block; all probes for this key land within it. */
+    const uint32_t nBase = FastMod(RollingBloomHash(nHashFuncs, nTweak, vKey), data.size() / (ROLLING_BLOOM_BLOCK_PAIRS * 2)) * ROLLING_BLOOM_BLOCK_PAIRS * 2;
+    __builtin_prefetch(&data[nBase], 1, 1);
     for (int n = 0; n < nHashFuncs; n++) {
         uint32_t h = RollingBloomHash(n, nTweak, vKey);
         int bit = h & 0x3F;
-        /* FastMod works with the upper bits of h, so it is safe to ignore that the lower bits of h are already used for bit. */
-        uint32_t pos = FastMod(h, data.size());
-        /* The lowest bit of pos is ignored, and set to zero for the first bit, and to one for the second. */
-        data[pos & ~1] = (data[pos & ~1] & ~(((uint64_t)1) << bit)) | ((uint64_t)(nGeneration & 1)) << bit;
-        data[pos | 1] = (data[pos | 1] & ~(((uint64_t)1) << bit)) | ((uint64_t)(nGeneration >> 1)) << bit;
+        /* Bits 6.. of h select the pair within the block; pos is even, pos + 1 holds the second generation bit. */
+        uint32_t pos = nBase + (((h >> 6) & (ROLLING_BLOOM_BLOCK_PAIRS - 1)) << 1);
+        data[pos] = (data[pos] & ~(((uint64_t)1) << bit)) | ((uint64_t)(nGeneration & 1)) << bit;
+        data[pos + 1] = (data[pos + 1] & ~(((uint64_t)1) << bit)) | ((uint64_t)(nGeneration >> 1)) << bit;
     }
 }
 
 void CRollingBloomFilter::insert(const uint256& hash)
 {
-    std::vector<unsigned char> vData(hash.begin(), hash.end());
-    insert(vData);
+    insert(MakeUCharSpan(hash));
 }
 
-bool CRollingBloomFilter::contains(const std::vector<unsigned char>& vKey) const
+bool CRollingBloomFilter::contains(Span<const unsigned char> vKey) const
 {
+    const uint32_t nBase = FastMod(RollingBloomHash(nHashFuncs, nTweak, vKey), data.size() / (ROLLING_BLOOM_BLOCK_PAIRS * 2)) * ROLLING_BLOOM_BLOCK_PAIRS * 2;
+    __builtin_prefetch(&data[nBase], 0, 1);
     for (int n = 0; n < nHashFuncs; n++) {
         uint32_t h = RollingBloomHash(n, nTweak, vKey);
         int bit = h & 0x3F;
-        uint32_t pos = FastMod(h, data.size());
-        /* If the relevant bit is not set in either data[pos & ~1] or data[pos | 1], the filter does not contain vKey */
-        if (!(((data[pos & ~1] | data[pos | 1]) >> bit) & 1)) {
+        uint32_t pos = nBase + (((h >> 6) & (ROLLING_BLOOM_BLOCK_PAIRS - 1)) << 1);
+        /* If the relevant bit is not set in either data[pos] or data[pos + 1], the filter does not contain vKey */
+        if (!(((data[pos] | data[pos + 1]) >> bit) & 1)) {
             return false;
         }
     }
@@ -346,8 +357,7 @@ bool CRollingBloomFilter::contains(const std::vector<unsigned char>& vKey) const
 
 bool CRollingBloomFilter::contains(const uint256& hash) const
 {
-    std::vector<unsigned char> vData(hash.begin(), hash.end());
-    return contains(vData);
+    return contains(MakeUCharSpan(hash));
 }
 
 void CRollingBloomFilter::reset()
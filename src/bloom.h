@@ -6,6 +6,7 @@
 #define BITCOIN_BLOOM_H
 
 #include <serialize.h>
+#include <span.h>
 
 #include <vector>
 
@@ -51,7 +52,7 @@ private:
     unsigned int nTweak;
     unsigned char nFlags;
 
-    unsigned int Hash(unsigned int nHashNum, const std::vector<unsigned char>& vDataToHash) const;
+    unsigned int Hash(unsigned int nHashNum, Span<const unsigned char> vDataToHash) const;
 
     // Check matches for arbitrary script data elements
     bool CheckScript(const CScript& script) const;
@@ -72,15 +73,19 @@ public:
 
     SERIALIZE_METHODS(CBloomFilter, obj) { READWRITE(obj.vData, obj.nHashFuncs, obj.nTweak, obj.nFlags); }
 
-    void insert(const std::vector<unsigned char>& vKey);
+    void insert(Span<const unsigned char> vKey);
     void insert(const COutPoint& outpoint);
     void insert(const uint256& hash);
 
-    bool contains(const std::vector<unsigned char>& vKey) const;
+    bool contains(Span<const unsigned char> vKey) const;
     bool contains(const COutPoint& outpoint) const;
     bool contains(const uint256& hash) const;
     bool contains(const uint160& hash) const;
 
+    //! True if no filter data was set, i.e. the filter was default constructed
+    //! (note that contains() on such a filter matches everything)
+    bool IsEmpty() const { return vData.empty(); }
+
     //! True if the size is <= MAX_BLOOM_FILTER_SIZE and the number of hash functions is <= MAX_HASH_FUNCS
     //! (catch a filter which was just deserialized which was too big)
     bool IsWithinSizeConstraints() const;
@@ -113,6 +118,10 @@ public:
  * Then we get a more accurate estimate for filter bytes:
  *
  *     3/(log(256)*log(2)) * log(1/fpRate) * nElements
+ *
+ * The bit array uses a blocked layout: all probes for one key fall within a
+ * single 128-byte block, so a lookup touches at most two cache lines. See
+ * ROLLING_BLOOM_BLOCK_PAIRS in bloom.cpp.
  */
 class CRollingBloomFilter
 {
@@ -122,9 +131,9 @@ public:
     // constructed before the randomizer is properly initialized.
     CRollingBloomFilter(const unsigned int nElements, const double nFPRate);
 
-    void insert(const std::vector<unsigned char>& vKey);
+    void insert(Span<const unsigned char> vKey);
     void insert(const uint256& hash);
-    bool contains(const std::vector<unsigned char>& vKey) const;
+    bool contains(Span<const unsigned char> vKey) const;
     bool contains(const uint256& hash) const;
 
     void reset();
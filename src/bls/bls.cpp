@@ -396,7 +396,10 @@ static void create_secure_allocator()
 
     // static variable in function scope ensures it's initialized when first accessed
     // and destroyed before LockedPoolManager
-    static mt_pooled_secure_allocator<uint8_t> a(sizeof(bn_t) + sizeof(size_t));
+    // Grow each per-thread pool in slabs of 1024 chunks so that DKG, which
+    // churns through tens of thousands of scalar temporaries, rarely has to
+    // go through the global LockedPoolManager mutex to get more memory
+    static mt_pooled_secure_allocator<uint8_t> a(sizeof(bn_t) + sizeof(size_t), 1024);
     secure_allocator_instance = &a;
 }
 
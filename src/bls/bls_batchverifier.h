@@ -6,6 +6,7 @@
 #define DASH_CRYPTO_BLS_BATCHVERIFIER_H
 
 #include <bls/bls.h>
+#include <bls/bls_verify_backend.h>
 
 #include <map>
 #include <vector>
@@ -29,6 +30,10 @@ private:
     bool perMessageFallback;
     size_t subBatchSize;
 
+    // Optional backend for the aggregated pairing checks (not owned); when
+    // unset the checks run inline on the calling thread
+    CBLSVerifyBackend* verifyBackend{nullptr};
+
     MessageMap messages;
     MessagesBySourceMap messagesBySource;
 
@@ -68,6 +73,13 @@ public:
         return messagesBySource.size();
     }
 
+    //! Route the aggregated pairing checks through the given backend. The
+    //! backend must outlive this verifier.
+    void SetVerifyBackend(CBLSVerifyBackend* backend)
+    {
+        verifyBackend = backend;
+    }
+
     void Verify()
     {
         std::map<uint256, std::vector<MessageMapIterator>> byMessageHash;
@@ -81,37 +93,68 @@ public:
             return;
         }
 
-        // revert to per-source verification
-        for (const auto& p : messagesBySource) {
-            bool batchValid = false;
+        // The full batch failed. Bisect over the sources, so that a few bad
+        // sources cost O(log n) aggregated verifications instead of one
+        // aggregated verification per source.
+        std::vector<typename MessagesBySourceMap::value_type*> sources;
+        sources.reserve(messagesBySource.size());
+        for (auto& p : messagesBySource) {
+            sources.emplace_back(&p);
+        }
+        VerifySourcesBisect(sources, /*known_invalid=*/true);
+    }
 
-            // no need to verify it again if there was just one source
-            if (messagesBySource.size() != 1) {
-                byMessageHash.clear();
-                for (auto it = p.second.begin(); it != p.second.end(); ++it) {
-                    byMessageHash[(*it)->second.msgHash].emplace_back(*it);
+private:
+    // Verify the aggregate over a contiguous range of sources. known_invalid
+    // is set when a parent aggregate containing exactly this range has already
+    // failed, so re-verifying it would be wasted work.
+    void VerifySourcesBisect(const std::vector<typename MessagesBySourceMap::value_type*>& sources, bool known_invalid)
+    {
+        if (sources.size() > 1) {
+            if (!known_invalid) {
+                std::map<uint256, std::vector<MessageMapIterator>> byMessageHash;
+                for (const auto* s : sources) {
+                    for (const auto& msgIt : s->second) {
+                        byMessageHash[msgIt->second.msgHash].emplace_back(msgIt);
+                    }
+                }
+                if (VerifyBatch(byMessageHash)) {
+                    return;
                 }
-                batchValid = VerifyBatch(byMessageHash);
             }
-            if (!batchValid) {
-                badSources.emplace(p.first);
-
-                if (perMessageFallback) {
-                    // revert to per-message verification
-                    if (p.second.size() == 1) {
-                        // no need to re-verify a single message
-                        badMessages.emplace(p.second[0]->second.msgId);
-                    } else {
-                        for (const auto& msgIt : p.second) {
-                            if (badMessages.count(msgIt->first)) {
-                                // same message might be invalid from different source, so no need to re-verify it
-                                continue;
-                            }
-
-                            const auto& msg = msgIt->second;
-                            if (!msg.sig.VerifyInsecure(msg.pubKey, msg.msgHash)) {
-                                badMessages.emplace(msg.msgId);
-                            }
+            const size_t mid = sources.size() / 2;
+            VerifySourcesBisect({sources.begin(), sources.begin() + mid}, false);
+            VerifySourcesBisect({sources.begin() + mid, sources.end()}, false);
+            return;
+        }
+
+        const auto& p = *sources[0];
+        bool batchValid = false;
+        if (!known_invalid) {
+            std::map<uint256, std::vector<MessageMapIterator>> byMessageHash;
+            for (const auto& msgIt : p.second) {
+                byMessageHash[msgIt->second.msgHash].emplace_back(msgIt);
+            }
+            batchValid = VerifyBatch(byMessageHash);
+        }
+        if (!batchValid) {
+            badSources.emplace(p.first);
+
+            if (perMessageFallback) {
+                // revert to per-message verification
+                if (p.second.size() == 1) {
+                    // no need to re-verify a single message
+                    badMessages.emplace(p.second[0]->second.msgId);
+                } else {
+                    for (const auto& msgIt : p.second) {
+                        if (badMessages.count(msgIt->first)) {
+                            // same message might be invalid from different source, so no need to re-verify it
+                            continue;
+                        }
+
+                        const auto& msg = msgIt->second;
+                        if (!msg.sig.VerifyInsecure(msg.pubKey, msg.msgHash)) {
+                            badMessages.emplace(msg.msgId);
                         }
                     }
                 }
@@ -119,7 +162,14 @@ public:
         }
     }
 
-private:
+    bool VerifyAggregated(const CBLSSignature& aggSig, const std::vector<CBLSPublicKey>& pubKeys, const std::vector<uint256>& msgHashes)
+    {
+        if (verifyBackend != nullptr) {
+            return verifyBackend->VerifyAggregated(aggSig, pubKeys, msgHashes);
+        }
+        return aggSig.VerifyInsecureAggregated(pubKeys, msgHashes);
+    }
+
     // All Verify methods take ownership of the passed byMessageHash map and thus might modify the map. This is to avoid
     // unnecessary copies
 
@@ -180,7 +230,7 @@ private:
             return true;
         }
 
-        return aggSig.VerifyInsecureAggregated(pubKeys, msgHashes);
+        return VerifyAggregated(aggSig, pubKeys, msgHashes);
     }
 
     bool VerifyBatchSecure(std::map<uint256, std::vector<MessageMapIterator>>& byMessageHash)
@@ -233,7 +283,7 @@ private:
 
         assert(!msgHashes.empty());
 
-        return aggSig.VerifyInsecureAggregated(pubKeys, msgHashes);
+        return VerifyAggregated(aggSig, pubKeys, msgHashes);
     }
 };
 
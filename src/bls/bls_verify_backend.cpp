@@ -0,0 +1,54 @@
+// Copyright (c) 2018-2023 The Dash Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bls/bls_verify_backend.h>
+
+#include <memory>
+#include <utility>
+
+void CBLSCPUVerifyBackend::AsyncVerifyBatch(std::vector<VerifyJob>&& jobs, BatchDoneCallback doneCallback)
+{
+    auto sharedJobs = std::make_shared<std::vector<VerifyJob>>(std::move(jobs));
+    workerPool.push([sharedJobs, doneCallback](int threadId) {
+        const auto& jobs = *sharedJobs;
+        std::vector<bool> results(jobs.size(), false);
+
+        if (jobs.size() == 1) {
+            results[0] = jobs[0].sig.VerifyInsecure(jobs[0].pubKey, jobs[0].msgHash);
+            doneCallback(results);
+            return;
+        }
+
+        CBLSSignature aggSig;
+        std::vector<CBLSPublicKey> pubKeys;
+        std::vector<uint256> msgHashes;
+        pubKeys.reserve(jobs.size());
+        msgHashes.reserve(jobs.size());
+        for (const auto& job : jobs) {
+            if (pubKeys.empty()) {
+                aggSig = job.sig;
+            } else {
+                aggSig.AggregateInsecure(job.sig);
+            }
+            pubKeys.emplace_back(job.pubKey);
+            msgHashes.emplace_back(job.msgHash);
+        }
+
+        if (aggSig.VerifyInsecureAggregated(pubKeys, msgHashes)) {
+            results.assign(jobs.size(), true);
+        } else {
+            // one or more sigs were not valid, revert to per-sig verification
+            // TODO this could be improved if we would cache pairing results in some way as the previous aggregated verification already calculated all the pairings for the hashes
+            for (size_t i = 0; i < jobs.size(); i++) {
+                results[i] = jobs[i].sig.VerifyInsecure(jobs[i].pubKey, jobs[i].msgHash);
+            }
+        }
+        doneCallback(results);
+    });
+}
+
+bool CBLSCPUVerifyBackend::VerifyAggregated(const CBLSSignature& aggSig, const std::vector<CBLSPublicKey>& pubKeys, const std::vector<uint256>& msgHashes)
+{
+    return aggSig.VerifyInsecureAggregated(pubKeys, msgHashes);
+}
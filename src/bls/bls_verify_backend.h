@@ -0,0 +1,62 @@
+// Copyright (c) 2018-2023 The Dash Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef DASH_CRYPTO_BLS_VERIFY_BACKEND_H
+#define DASH_CRYPTO_BLS_VERIFY_BACKEND_H
+
+#include <bls/bls.h>
+
+#include <ctpl_stl.h>
+
+#include <functional>
+#include <vector>
+
+// Pluggable backend for the pairing-heavy parts of BLS signature
+// verification. CBLSWorker and CBLSBatchVerifier dispatch their bulk
+// verification through this interface, with CBLSCPUVerifyBackend (running on
+// the shared worker pool) as the default. Alternative implementations can
+// offload the pairings to an accelerator; they only need to implement the two
+// entry points below, both of which are pure bulk pairing work with no
+// callbacks into the rest of the codebase.
+class CBLSVerifyBackend
+{
+public:
+    struct VerifyJob {
+        CBLSSignature sig;
+        CBLSPublicKey pubKey;
+        uint256 msgHash;
+    };
+    using BatchDoneCallback = std::function<void(const std::vector<bool>&)>;
+
+    virtual ~CBLSVerifyBackend() = default;
+
+    //! Verify a batch of independent (sig, pubKey, msgHash) jobs. The callback
+    //! receives one result per job, in submission order, and may be invoked
+    //! from an arbitrary thread.
+    virtual void AsyncVerifyBatch(std::vector<VerifyJob>&& jobs, BatchDoneCallback doneCallback) = 0;
+
+    //! Synchronous aggregated check: true iff aggSig is valid for all
+    //! (pubKey, msgHash) pairs. msgHashes must not contain duplicates.
+    virtual bool VerifyAggregated(const CBLSSignature& aggSig, const std::vector<CBLSPublicKey>& pubKeys, const std::vector<uint256>& msgHashes) = 0;
+};
+
+// Default CPU implementation. Batches are verified on the shared worker pool
+// via one aggregated pairing check, reverting to per-signature verification
+// when the aggregate fails.
+class CBLSCPUVerifyBackend : public CBLSVerifyBackend
+{
+private:
+    ctpl::thread_pool& workerPool;
+
+public:
+    explicit CBLSCPUVerifyBackend(ctpl::thread_pool& _workerPool) :
+        workerPool(_workerPool)
+    {
+    }
+
+    void AsyncVerifyBatch(std::vector<VerifyJob>&& jobs, BatchDoneCallback doneCallback) override;
+    bool VerifyAggregated(const CBLSSignature& aggSig, const std::vector<CBLSPublicKey>& pubKeys, const std::vector<uint256>& msgHashes) override;
+};
+
+#endif // DASH_CRYPTO_BLS_VERIFY_BACKEND_H
@@ -53,13 +53,23 @@ std::pair<std::function<void(T)>, std::future<T> > BuildFutureDoneCallback2()
 
 /////
 
-CBLSWorker::CBLSWorker() = default;
+CBLSWorker::CBLSWorker() :
+    verifyBackend(std::make_unique<CBLSCPUVerifyBackend>(workerPool))
+{
+}
 
 CBLSWorker::~CBLSWorker()
 {
     Stop();
 }
 
+void CBLSWorker::SetVerifyBackend(std::unique_ptr<CBLSVerifyBackend> backend)
+{
+    std::unique_lock<std::mutex> l(sigVerifyMutex);
+    assert(sigVerifyBatchesInProgress == 0 && sigVerifyQueue.empty());
+    verifyBackend = std::move(backend);
+}
+
 void CBLSWorker::Start()
 {
     int workerCount = std::thread::hardware_concurrency() / 2;
@@ -142,6 +152,9 @@ struct Aggregator : public std::enable_shared_from_this<Aggregator<T>> {
     // keeps track of currently queued/in-progress batches. If it reaches 0, we are done
     std::atomic<size_t> waitCount{0};
 
+    // next input batch to be claimed by a worker loop (see Start)
+    std::atomic<size_t> nextBatch{0};
+
     using DoneCallback = std::function<void(const T& agg)>;
     DoneCallback doneCallback;
 
@@ -195,10 +208,24 @@ struct Aggregator : public std::enable_shared_from_this<Aggregator<T>> {
 
         // increment wait counter as otherwise the first finished async aggregation might signal that we're done
         IncWait();
-        for (size_t i = 0; i < batchCount; i++) {
-            size_t start = i * batchSize;
-            size_t count = std::min(batchSize, inputVec->size() - start);
-            AsyncAggregateAndPushAggQueue(inputVec, start, count, false);
+        // Instead of one pool submission per batch, which serializes all
+        // workers on the pool's queue lock for tiny tasks, push one looping
+        // task per worker. Each loop claims the next unprocessed batch from
+        // an atomic counter until none are left, so workers self-schedule
+        // without touching the queue again.
+        auto self(this->shared_from_this());
+        size_t numWorkers = std::min(batchCount, (size_t)workerPool.size());
+        for (size_t i = 0; i < numWorkers; i++) {
+            IncWait();
+            PushWork([this, self, batchCount](int threadId) {
+                size_t idx;
+                while ((idx = nextBatch.fetch_add(1)) < batchCount) {
+                    size_t start = idx * batchSize;
+                    size_t count = std::min(batchSize, inputVec->size() - start);
+                    PushAggQueue(SyncAggregate(*inputVec, start, count));
+                }
+                CheckDone();
+            });
         }
         // this will decrement the wait counter and in most cases NOT finish, as async work is still in progress
         CheckDone();
@@ -561,12 +588,19 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
     {
         size_t count = batchStates[batchIdx].count;
         batchStates[batchIdx].verifyResults.assign(count, 0);
-        for (size_t i = 0; i < count; i++) {
-            auto self(this->shared_from_this());
-            auto f = [this, self, i, batchIdx](int threadId) {
+        // as in Aggregator::Start, let each worker claim contributions from a
+        // shared counter instead of queueing one pool task per contribution
+        auto nextIdx = std::make_shared<std::atomic<size_t>>(0);
+        size_t numWorkers = parallel ? std::min(count, (size_t)workerPool.size()) : 1;
+        auto self(this->shared_from_this());
+        for (size_t w = 0; w < numWorkers; w++) {
+            auto f = [this, self, batchIdx, count, nextIdx](int threadId) {
                 auto& batchState = batchStates[batchIdx];
-                batchState.verifyResults[i] = Verify(vvecs[batchState.start + i], skShares[batchState.start + i]);
-                HandleVerifyDone(1);
+                size_t i;
+                while ((i = nextIdx->fetch_add(1)) < count) {
+                    batchState.verifyResults[i] = Verify(vvecs[batchState.start + i], skShares[batchState.start + i]);
+                    HandleVerifyDone(1);
+                }
             };
             PushOrDoWork(std::move(f));
         }
@@ -841,58 +875,25 @@ bool CBLSWorker::IsAsyncVerifyInProgress()
 // sigVerifyMutex must be held while calling
 void CBLSWorker::PushSigVerifyBatch()
 {
-    auto f = [this](int threadId, const std::shared_ptr<std::vector<SigVerifyJob> >& _jobs) {
-        auto& jobs = *_jobs;
-        if (jobs.size() == 1) {
-            const auto& job = jobs[0];
-            if (!job.cancelCond()) {
-                bool valid = job.sig.VerifyInsecure(job.pubKey, job.msgHash);
-                job.doneCallback(valid);
-            }
-            std::unique_lock<std::mutex> l(sigVerifyMutex);
-            sigVerifyBatchesInProgress--;
-            if (!sigVerifyQueue.empty()) {
-                PushSigVerifyBatch();
-            }
-            return;
-        }
+    auto batch = std::make_shared<std::vector<SigVerifyJob> >(std::move(sigVerifyQueue));
+    sigVerifyQueue.reserve(SIG_VERIFY_BATCH_SIZE);
 
-        CBLSSignature aggSig;
-        std::vector<size_t> indexes;
-        std::vector<CBLSPublicKey> pubKeys;
-        std::vector<uint256> msgHashes;
-        indexes.reserve(jobs.size());
-        pubKeys.reserve(jobs.size());
-        msgHashes.reserve(jobs.size());
-        for (size_t i = 0; i < jobs.size(); i++) {
-            auto& job = jobs[i];
-            if (job.cancelCond()) {
-                continue;
-            }
-            if (pubKeys.empty()) {
-                aggSig = job.sig;
-            } else {
-                aggSig.AggregateInsecure(job.sig);
-            }
-            indexes.emplace_back(i);
-            pubKeys.emplace_back(job.pubKey);
-            msgHashes.emplace_back(job.msgHash);
-        }
+    sigVerifyBatchesInProgress++;
 
-        if (!pubKeys.empty()) {
-            bool allValid = aggSig.VerifyInsecureAggregated(pubKeys, msgHashes);
-            if (allValid) {
-                for (size_t i = 0; i < pubKeys.size(); i++) {
-                    jobs[indexes[i]].doneCallback(true);
-                }
-            } else {
-                // one or more sigs were not valid, revert to per-sig verification
-                // TODO this could be improved if we would cache pairing results in some way as the previous aggregated verification already calculated all the pairings for the hashes
-                for (size_t i = 0; i < pubKeys.size(); i++) {
-                    const auto& job = jobs[indexes[i]];
-                    bool valid = job.sig.VerifyInsecure(job.pubKey, job.msgHash);
-                    job.doneCallback(valid);
-                }
+    // The backend only sees the raw (sig, pubKey, msgHash) triples; cancel
+    // conditions are evaluated here when the results come back, so backends
+    // never call into the rest of the codebase.
+    std::vector<CBLSVerifyBackend::VerifyJob> backendJobs;
+    backendJobs.reserve(batch->size());
+    for (const auto& job : *batch) {
+        backendJobs.emplace_back(CBLSVerifyBackend::VerifyJob{job.sig, job.pubKey, job.msgHash});
+    }
+
+    verifyBackend->AsyncVerifyBatch(std::move(backendJobs), [this, batch](const std::vector<bool>& results) {
+        for (size_t i = 0; i < batch->size(); i++) {
+            const auto& job = (*batch)[i];
+            if (!job.cancelCond()) {
+                job.doneCallback(results[i]);
             }
         }
 
@@ -901,11 +902,5 @@ void CBLSWorker::PushSigVerifyBatch()
         if (!sigVerifyQueue.empty()) {
             PushSigVerifyBatch();
         }
-    };
-
-    auto batch = std::make_shared<std::vector<SigVerifyJob> >(std::move(sigVerifyQueue));
-    sigVerifyQueue.reserve(SIG_VERIFY_BATCH_SIZE);
-
-    sigVerifyBatchesInProgress++;
-    workerPool.push(f, batch);
+    });
 }
@@ -6,10 +6,13 @@
 #define DASH_CRYPTO_BLS_WORKER_H
 
 #include <bls/bls.h>
+#include <bls/bls_verify_backend.h>
 
 #include <ctpl_stl.h>
 
+#include <deque>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <utility>
 
@@ -48,10 +51,17 @@ private:
     int sigVerifyBatchesInProgress{0};
     std::vector<SigVerifyJob> sigVerifyQueue;
 
+    //! Performs the actual pairing work for sig verification batches, CPU pool by default
+    std::unique_ptr<CBLSVerifyBackend> verifyBackend;
+
 public:
     CBLSWorker();
     ~CBLSWorker();
 
+    //! Replace the verification backend, e.g. with an accelerator offload engine.
+    //! Must be called before any verification is in flight (i.e. right after construction).
+    void SetVerifyBackend(std::unique_ptr<CBLSVerifyBackend> backend);
+
     void Start();
     void Stop();
 
@@ -141,38 +151,44 @@ class CBLSWorkerCache
 {
 private:
     CBLSWorker& worker;
+    //! Per entry type limit on cached results. 0 means unbounded (the historic
+    //! behavior, fine for per-object caches with a naturally limited key set).
+    const size_t maxCacheSize;
 
     std::mutex cacheCs;
     std::map<uint256, std::shared_future<BLSVerificationVectorPtr> > vvecCache;
+    std::deque<uint256> vvecCacheOrder;
     std::map<uint256, std::shared_future<CBLSSecretKey> > secretKeyShareCache;
+    std::deque<uint256> secretKeyShareCacheOrder;
     std::map<uint256, std::shared_future<CBLSPublicKey> > publicKeyShareCache;
+    std::deque<uint256> publicKeyShareCacheOrder;
 
 public:
-    explicit CBLSWorkerCache(CBLSWorker& _worker) :
-        worker(_worker) {}
+    explicit CBLSWorkerCache(CBLSWorker& _worker, size_t _maxCacheSize = 0) :
+        worker(_worker), maxCacheSize(_maxCacheSize) {}
 
     BLSVerificationVectorPtr BuildQuorumVerificationVector(const uint256& cacheKey, const std::vector<BLSVerificationVectorPtr>& vvecs)
     {
-        return GetOrBuild(cacheKey, vvecCache, [this, &vvecs]() {
+        return GetOrBuild(cacheKey, vvecCache, vvecCacheOrder, [this, &vvecs]() {
             return worker.BuildQuorumVerificationVector(vvecs);
         });
     }
     CBLSSecretKey AggregateSecretKeys(const uint256& cacheKey, const BLSSecretKeyVector& skShares)
     {
-        return GetOrBuild(cacheKey, secretKeyShareCache, [this, &skShares]() {
+        return GetOrBuild(cacheKey, secretKeyShareCache, secretKeyShareCacheOrder, [this, &skShares]() {
             return worker.AggregateSecretKeys(skShares);
         });
     }
     CBLSPublicKey BuildPubKeyShare(const uint256& cacheKey, const BLSVerificationVectorPtr& vvec, const CBLSId& id)
     {
-        return GetOrBuild(cacheKey, publicKeyShareCache, [&vvec, &id]() {
+        return GetOrBuild(cacheKey, publicKeyShareCache, publicKeyShareCacheOrder, [&vvec, &id]() {
             return CBLSWorker::BuildPubKeyShare(vvec, id);
         });
     }
 
 private:
     template <typename T, typename Builder>
-    T GetOrBuild(const uint256& cacheKey, std::map<uint256, std::shared_future<T> >& cache, Builder&& builder)
+    T GetOrBuild(const uint256& cacheKey, std::map<uint256, std::shared_future<T> >& cache, std::deque<uint256>& insertionOrder, Builder&& builder)
     {
         cacheCs.lock();
         auto it = cache.find(cacheKey);
@@ -184,6 +200,16 @@ private:
 
         std::promise<T> p;
         cache.emplace(cacheKey, p.get_future());
+        if (maxCacheSize != 0) {
+            // Bounded mode: evict in insertion order. Evicting a key only
+            // drops the memoization; builders that already hold the future
+            // keep working on their own copy.
+            insertionOrder.push_back(cacheKey);
+            while (insertionOrder.size() > maxCacheSize) {
+                cache.erase(insertionOrder.front());
+                insertionOrder.pop_front();
+            }
+        }
         cacheCs.unlock();
 
         T v = builder();
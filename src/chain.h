@@ -125,6 +125,10 @@ enum BlockStatus: uint32_t {
     BLOCK_FAILED_MASK        =   BLOCK_FAILED_VALID | BLOCK_FAILED_CHILD,
 
     BLOCK_CONFLICT_CHAINLOCK =   128, //!< conflicts with chainlock system
+
+    //! undo data in rev*.dat uses the compact layout (see CompactBlockUndo); set
+    //! per block when written with -compressundo so both layouts can coexist
+    BLOCK_UNDO_COMPRESSED    =   256,
 };
 
 /** The block chain is a tree shaped structure starting with the
@@ -75,11 +75,13 @@ void CCoinJoinClientQueueManager::ProcessDSQueue(const CNode& peer, CDataStream&
         if (!lockRecv) return;
 
         // process every dsq only once
-        for (const auto& q : vecCoinJoinQueue) {
+        const auto itPair = mapCoinJoinQueue.equal_range(dsq.masternodeOutpoint);
+        for (auto it = itPair.first; it != itPair.second; ++it) {
+            const auto& q = it->second;
             if (q == dsq) {
                 return;
             }
-            if (q.fReady == dsq.fReady && q.masternodeOutpoint == dsq.masternodeOutpoint) {
+            if (q.fReady == dsq.fReady) {
                 // no way the same mn can send another dsq with the same readiness this soon
                 LogPrint(BCLog::COINJOIN, "DSQUEUE -- Peer %s is sending WAY too many dsq messages for a masternode with collateral %s\n", peer.GetLogString(), dsq.masternodeOutpoint.ToStringShort());
                 return;
@@ -129,7 +131,7 @@ void CCoinJoinClientQueueManager::ProcessDSQueue(const CNode& peer, CDataStream&
 
         {TRY_LOCK(cs_vecqueue, lockRecv);
         if (!lockRecv) return;
-        vecCoinJoinQueue.push_back(dsq);}
+        mapCoinJoinQueue.emplace(dsq.masternodeOutpoint, dsq);}
         dsq.Relay(connman);
     }
 }
@@ -756,7 +758,7 @@ bool CCoinJoinClientManager::CheckAutomaticBackup()
 //
 // Passively run mixing in the background to mix funds based on the given configuration.
 //
-bool CCoinJoinClientSession::DoAutomaticDenominating(CTxMemPool& mempool, CConnman& connman, bool fDryRun)
+bool CCoinJoinClientSession::DoAutomaticDenominating(CTxMemPool& mempool, CConnman& connman, bool fDryRun, const std::set<int>& setSiblingDenoms)
 {
     if (fMasternodeMode) return false; // no client-side mixing on masternodes
     if (nState != POOL_STATE_IDLE) return false;
@@ -925,12 +927,12 @@ bool CCoinJoinClientSession::DoAutomaticDenominating(CTxMemPool& mempool, CConnm
     } // LOCK(mixingWallet.cs_wallet);
 
     // Always attempt to join an existing queue
-    if (JoinExistingQueue(nBalanceNeedsAnonymized, connman)) {
+    if (JoinExistingQueue(nBalanceNeedsAnonymized, connman, setSiblingDenoms)) {
         return true;
     }
 
     // If we were unable to find/join an existing queue then start a new one.
-    if (StartNewQueue(nBalanceNeedsAnonymized, connman)) return true;
+    if (StartNewQueue(nBalanceNeedsAnonymized, connman, setSiblingDenoms)) return true;
 
     strAutoDenomResult = _("No compatible Masternode found.");
     return false;
@@ -963,6 +965,16 @@ bool CCoinJoinClientManager::DoAutomaticDenominating(CTxMemPool& mempool, CConnm
         LogPrint(BCLog::COINJOIN, "  vecMasternodesUsed: new size: %d, threshold: %d\n", (int)vecMasternodesUsed.size(), nThreshold_high);
     }
 
+    // These checks don't depend on any specific session, no need to repeat
+    // them on every loop iteration below
+    if (!CheckAutomaticBackup()) return false;
+
+    if (WaitForAnotherBlock()) {
+        strAutoDenomResult = _("Last successful action was too recent.");
+        LogPrint(BCLog::COINJOIN, "CCoinJoinClientManager::DoAutomaticDenominating -- %s\n", strAutoDenomResult.original);
+        return false;
+    }
+
     bool fResult = true;
     AssertLockNotHeld(cs_deqsessions);
     LOCK(cs_deqsessions);
@@ -970,15 +982,17 @@ bool CCoinJoinClientManager::DoAutomaticDenominating(CTxMemPool& mempool, CConnm
         deqSessions.emplace_back(mixingWallet, m_mn_sync);
     }
     for (auto& session : deqSessions) {
-        if (!CheckAutomaticBackup()) return false;
-
-        if (WaitForAnotherBlock()) {
-            strAutoDenomResult = _("Last successful action was too recent.");
-            LogPrint(BCLog::COINJOIN, "CCoinJoinClientManager::DoAutomaticDenominating -- %s\n", strAutoDenomResult.original);
-            return false;
+        // Denominations the other sessions are mixing right now. Passing them
+        // down lets each session claim its own denomination, so the sessions
+        // form per-denomination pipelines instead of piling onto one denom.
+        std::set<int> setSiblingDenoms;
+        for (const auto& other : deqSessions) {
+            if (&other != &session && other.nSessionDenom != 0) {
+                setSiblingDenoms.emplace(other.nSessionDenom);
+            }
         }
 
-        fResult &= session.DoAutomaticDenominating(mempool, connman, fDryRun);
+        fResult &= session.DoAutomaticDenominating(mempool, connman, fDryRun, setSiblingDenoms);
     }
 
     return fResult;
@@ -1027,7 +1041,7 @@ CDeterministicMNCPtr CCoinJoinClientManager::GetRandomNotUsedMasternode()
     return nullptr;
 }
 
-bool CCoinJoinClientSession::JoinExistingQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman)
+bool CCoinJoinClientSession::JoinExistingQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman, const std::set<int>& setSiblingDenoms)
 {
     if (!CCoinJoinClientOptions::IsEnabled()) return false;
     if (coinJoinClientQueueManager == nullptr) return false;
@@ -1057,9 +1071,17 @@ bool CCoinJoinClientSession::JoinExistingQueue(CAmount nBalanceNeedsAnonymized,
         }
 
         // mixing rate limit i.e. nLastDsq check should already pass in DSQUEUE ProcessMessage
-        // in order for dsq to get into vecCoinJoinQueue, so we should be safe to mix already,
+        // in order for dsq to get into mapCoinJoinQueue, so we should be safe to mix already,
         // no need for additional verification here
 
+        // a sibling session is mixing this denomination already, spread the
+        // sessions across denominations instead of competing for the same coins
+        if (setSiblingDenoms.count(dsq.nDenom)) {
+            LogPrint(BCLog::COINJOIN, "CCoinJoinClientSession::JoinExistingQueue -- skipping queue, denomination %d (%s) is mixed by another session\n",
+                dsq.nDenom, CCoinJoin::DenominationToString(dsq.nDenom));
+            continue;
+        }
+
         LogPrint(BCLog::COINJOIN, "CCoinJoinClientSession::JoinExistingQueue -- trying queue: %s\n", dsq.ToString());
 
         std::vector<CTxDSIn> vecTxDSInTmp;
@@ -1092,7 +1114,7 @@ bool CCoinJoinClientSession::JoinExistingQueue(CAmount nBalanceNeedsAnonymized,
     return false;
 }
 
-bool CCoinJoinClientSession::StartNewQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman)
+bool CCoinJoinClientSession::StartNewQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman, const std::set<int>& setSiblingDenoms)
 {
     if (!CCoinJoinClientOptions::IsEnabled()) return false;
     if (nBalanceNeedsAnonymized <= 0) return false;
@@ -1110,6 +1132,18 @@ bool CCoinJoinClientSession::StartNewQueue(CAmount nBalanceNeedsAnonymized, CCon
         return false;
     }
 
+    // Prefer denominations no sibling session is mixing yet, as long as that
+    // leaves something to pick from
+    std::set<CAmount> setAmountsFree;
+    for (const auto& nAmount : setAmounts) {
+        if (setSiblingDenoms.count(CCoinJoin::AmountToDenomination(nAmount)) == 0) {
+            setAmountsFree.emplace(nAmount);
+        }
+    }
+    if (!setAmountsFree.empty()) {
+        setAmounts = std::move(setAmountsFree);
+    }
+
     // otherwise, try one randomly
     while (nTries < 10) {
         auto dmn = coinJoinClientManagers.at(mixingWallet.GetName())->GetRandomNotUsedMasternode();
@@ -11,6 +11,7 @@
 
 #include <utility>
 #include <atomic>
+#include <set>
 
 class CDeterministicMN;
 using CDeterministicMNCPtr = std::shared_ptr<const CDeterministicMN>;
@@ -97,8 +98,8 @@ private:
 
     bool CreateCollateralTransaction(CMutableTransaction& txCollateral, std::string& strReason);
 
-    bool JoinExistingQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman);
-    bool StartNewQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman);
+    bool JoinExistingQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman, const std::set<int>& setSiblingDenoms);
+    bool StartNewQueue(CAmount nBalanceNeedsAnonymized, CConnman& connman, const std::set<int>& setSiblingDenoms);
 
     /// step 0: select denominated inputs and txouts
     bool SelectDenominate(std::string& strErrorRet, std::vector<CTxDSIn>& vecTxDSInRet);
@@ -137,8 +138,10 @@ public:
 
     bool GetMixingMasternodeInfo(CDeterministicMNCPtr& ret) const;
 
-    /// Passively run mixing in the background according to the configuration in settings
-    bool DoAutomaticDenominating(CTxMemPool& mempool, CConnman& connman, bool fDryRun = false) LOCKS_EXCLUDED(cs_coinjoin);
+    /// Passively run mixing in the background according to the configuration in settings.
+    /// setSiblingDenoms holds the denominations the manager's other sessions are mixing,
+    /// which this session avoids as long as there are free ones to pick from.
+    bool DoAutomaticDenominating(CTxMemPool& mempool, CConnman& connman, bool fDryRun = false, const std::set<int>& setSiblingDenoms = {}) LOCKS_EXCLUDED(cs_coinjoin);
 
     /// As a client, submit part of a future mixing transaction to a Masternode to start the process
     bool SubmitDenominate(CConnman& connman);
@@ -109,13 +109,41 @@ bool CCoinJoinBroadcastTx::Sign()
     return true;
 }
 
+//! Verified DSTX signature cache. Popular DSTX-es arrive from many peers in a
+//! short window and BLS verification of the very same broadcast each time is
+//! wasted work. The key commits to the signed hash, the operator key and the
+//! signature bytes themselves, so a replay with a different (garbage) signature
+//! or after an operator key rotation can never hit the cache.
+static constexpr size_t DSTX_VERIFIED_CACHE_MAX{1000};
+static Mutex cs_dstx_verified_cache;
+static std::set<uint256> dstxVerifiedCache GUARDED_BY(cs_dstx_verified_cache);
+
 bool CCoinJoinBroadcastTx::CheckSignature(const CBLSPublicKey& blsPubKey) const
 {
-    if (!CBLSSignature(vchSig).VerifyInsecure(blsPubKey, GetSignatureHash())) {
+    const uint256 hash = GetSignatureHash();
+
+    CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
+    ss << hash << blsPubKey.GetHash() << vchSig;
+    const uint256 cacheKey = ss.GetHash();
+
+    {
+        LOCK(cs_dstx_verified_cache);
+        if (dstxVerifiedCache.count(cacheKey)) {
+            return true;
+        }
+    }
+
+    if (!CBLSSignature(vchSig).VerifyInsecure(blsPubKey, hash)) {
         LogPrint(BCLog::COINJOIN, "CCoinJoinBroadcastTx::CheckSignature -- VerifyInsecure() failed\n");
         return false;
     }
 
+    LOCK(cs_dstx_verified_cache);
+    if (dstxVerifiedCache.size() >= DSTX_VERIFIED_CACHE_MAX) {
+        dstxVerifiedCache.clear();
+    }
+    dstxVerifiedCache.emplace(cacheKey);
+
     return true;
 }
 
@@ -163,7 +191,7 @@ void CCoinJoinBaseSession::SetNull()
 void CCoinJoinBaseManager::SetNull()
 {
     LOCK(cs_vecqueue);
-    vecCoinJoinQueue.clear();
+    mapCoinJoinQueue.clear();
 }
 
 void CCoinJoinBaseManager::CheckQueue()
@@ -172,11 +200,11 @@ void CCoinJoinBaseManager::CheckQueue()
     if (!lockDS) return; // it's ok to fail here, we run this quite frequently
 
     // check mixing queue objects for timeouts
-    auto it = vecCoinJoinQueue.begin();
-    while (it != vecCoinJoinQueue.end()) {
-        if (it->IsTimeOutOfBounds()) {
-            LogPrint(BCLog::COINJOIN, "CCoinJoinBaseManager::%s -- Removing a queue (%s)\n", __func__, it->ToString());
-            it = vecCoinJoinQueue.erase(it);
+    auto it = mapCoinJoinQueue.begin();
+    while (it != mapCoinJoinQueue.end()) {
+        if (it->second.IsTimeOutOfBounds()) {
+            LogPrint(BCLog::COINJOIN, "CCoinJoinBaseManager::%s -- Removing a queue (%s)\n", __func__, it->second.ToString());
+            it = mapCoinJoinQueue.erase(it);
         } else {
             ++it;
         }
@@ -188,7 +216,8 @@ bool CCoinJoinBaseManager::GetQueueItemAndTry(CCoinJoinQueue& dsqRet)
     TRY_LOCK(cs_vecqueue, lockDS);
     if (!lockDS) return false; // it's ok to fail here, we run this quite frequently
 
-    for (auto& dsq : vecCoinJoinQueue) {
+    for (auto& p : mapCoinJoinQueue) {
+        auto& dsq = p.second;
         // only try each queue once
         if (dsq.fTried || dsq.IsTimeOutOfBounds()) continue;
         dsq.fTried = true;
@@ -17,6 +17,7 @@
 #include <util/translation.h>
 #include <version.h>
 
+#include <map>
 #include <utility>
 
 class CCoinJoin;
@@ -364,8 +365,10 @@ class CCoinJoinBaseManager
 protected:
     mutable Mutex cs_vecqueue;
 
-    // The current mixing sessions in progress on the network
-    std::vector<CCoinJoinQueue> vecCoinJoinQueue GUARDED_BY(cs_vecqueue);
+    // The current mixing sessions in progress on the network, keyed by
+    // masternode collateral so that incoming dsq messages can be matched
+    // against known queues without scanning all of them
+    std::multimap<COutPoint, CCoinJoinQueue> mapCoinJoinQueue GUARDED_BY(cs_vecqueue);
 
     void SetNull() LOCKS_EXCLUDED(cs_vecqueue);
     void CheckQueue() LOCKS_EXCLUDED(cs_vecqueue);
@@ -373,7 +376,7 @@ protected:
 public:
     CCoinJoinBaseManager() = default;
 
-    int GetQueueSize() const LOCKS_EXCLUDED(cs_vecqueue) { LOCK(cs_vecqueue); return vecCoinJoinQueue.size(); }
+    int GetQueueSize() const LOCKS_EXCLUDED(cs_vecqueue) { LOCK(cs_vecqueue); return mapCoinJoinQueue.size(); }
     bool GetQueueItemAndTry(CCoinJoinQueue& dsqRet) LOCKS_EXCLUDED(cs_vecqueue);
 };
 
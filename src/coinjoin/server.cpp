@@ -70,8 +70,7 @@ void CCoinJoinServer::ProcessDSACCEPT(CNode& peer, CDataStream& vRecv)
 
             auto mnOutpoint = WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.outpoint);
 
-            if (ranges::any_of(vecCoinJoinQueue,
-                               [&mnOutpoint](const auto& q){return q.masternodeOutpoint == mnOutpoint;})) {
+            if (mapCoinJoinQueue.count(mnOutpoint) > 0) {
                 // refuse to create another queue this often
                 LogPrint(BCLog::COINJOIN, "DSACCEPT -- last dsq is still in queue, refuse to mix\n");
                 PushStatus(peer, STATUS_REJECTED, ERR_RECENT);
@@ -134,11 +133,13 @@ void CCoinJoinServer::ProcessDSQUEUE(const CNode& peer, CDataStream& vRecv)
         if (!lockRecv) return;
 
         // process every dsq only once
-        for (const auto& q : vecCoinJoinQueue) {
+        const auto itPair = mapCoinJoinQueue.equal_range(dsq.masternodeOutpoint);
+        for (auto it = itPair.first; it != itPair.second; ++it) {
+            const auto& q = it->second;
             if (q == dsq) {
                 return;
             }
-            if (q.fReady == dsq.fReady && q.masternodeOutpoint == dsq.masternodeOutpoint) {
+            if (q.fReady == dsq.fReady) {
                 // no way the same mn can send another dsq with the same readiness this soon
                 LogPrint(BCLog::COINJOIN, "DSQUEUE -- Peer %s is sending WAY too many dsq messages for a masternode with collateral %s\n", peer.GetLogString(), dsq.masternodeOutpoint.ToStringShort());
                 return;
@@ -179,7 +180,7 @@ void CCoinJoinServer::ProcessDSQUEUE(const CNode& peer, CDataStream& vRecv)
 
         TRY_LOCK(cs_vecqueue, lockRecv);
         if (!lockRecv) return;
-        vecCoinJoinQueue.push_back(dsq);
+        mapCoinJoinQueue.emplace(dsq.masternodeOutpoint, dsq);
         dsq.Relay(connman);
     }
 }
@@ -729,7 +730,7 @@ bool CCoinJoinServer::CreateNewSession(const CCoinJoinAccept& dsa, PoolMessage&
         dsq.Sign();
         dsq.Relay(connman);
         LOCK(cs_vecqueue);
-        vecCoinJoinQueue.push_back(dsq);
+        mapCoinJoinQueue.emplace(dsq.masternodeOutpoint, dsq);
     }
 
     vecSessionCollaterals.push_back(MakeTransactionRef(dsa.txCollateral));
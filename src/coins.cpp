@@ -33,7 +33,11 @@ size_t CCoinsViewBacked::EstimateSize() const { return base->EstimateSize(); }
 
 SaltedOutpointHasher::SaltedOutpointHasher() : k0(GetRand(std::numeric_limits<uint64_t>::max())), k1(GetRand(std::numeric_limits<uint64_t>::max())) {}
 
-CCoinsViewCache::CCoinsViewCache(CCoinsView *baseIn) : CCoinsViewBacked(baseIn), cachedCoinsUsage(0) {}
+CCoinsViewCache::CCoinsViewCache(CCoinsView *baseIn, bool huge_pages) :
+    CCoinsViewBacked(baseIn),
+    cacheCoinsMemoryResource(huge_pages ? CCoinsMapMemoryResource::HUGE_PAGE_SIZE_BYTES : 262144, huge_pages),
+    cacheCoins(0, CCoinsMap::hasher{}, CCoinsMap::key_equal{}, &cacheCoinsMemoryResource),
+    cachedCoinsUsage(0) {}
 
 size_t CCoinsViewCache::DynamicMemoryUsage() const {
     return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage;
@@ -41,11 +45,28 @@ size_t CCoinsViewCache::DynamicMemoryUsage() const {
 
 CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const {
     CCoinsMap::iterator it = cacheCoins.find(outpoint);
-    if (it != cacheCoins.end())
+    if (it != cacheCoins.end()) {
+        ++cachedCoinsHits;
         return it;
+    }
+    ++cachedCoinsMisses;
     Coin tmp;
-    if (!base->GetCoin(outpoint, tmp))
-        return cacheCoins.end();
+    if (!base->GetCoin(outpoint, tmp)) {
+        if (m_negative_entries >= MAX_COINS_NEGATIVE_ENTRIES) {
+            return cacheCoins.end();
+        }
+        // Remember the miss as a spent FRESH entry, so that repeated probes
+        // for the same absent output (mempool races, orphan storms) don't pay
+        // for a backing-store lookup each time. No invalidation is needed: the
+        // output can only come into existence through AddCoin/BatchWrite on
+        // this cache, which overwrites the entry in place, and FRESH entries
+        // that are not DIRTY are never flushed downwards.
+        CCoinsMap::iterator ret = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::tuple<>()).first;
+        ret->second.flags = CCoinsCacheEntry::FRESH;
+        ++m_negative_entries;
+        cachedCoinsUsage += ret->second.coin.DynamicMemoryUsage();
+        return ret;
+    }
     CCoinsMap::iterator ret = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::forward_as_tuple(std::move(tmp))).first;
     if (ret->second.coin.IsSpent()) {
         // The parent only has an empty entry for this outpoint; we can consider our
@@ -65,15 +86,16 @@ bool CCoinsViewCache::GetCoin(const COutPoint &outpoint, Coin &coin) const {
     return false;
 }
 
-void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possible_overwrite) {
+int64_t CCoinsViewCache::AddCoinInternal(const COutPoint &outpoint, Coin&& coin, bool possible_overwrite) {
     assert(!coin.IsSpent());
-    if (coin.out.scriptPubKey.IsUnspendable()) return;
+    if (coin.out.scriptPubKey.IsUnspendable()) return 0;
+    int64_t usage_delta = 0;
     CCoinsMap::iterator it;
     bool inserted;
     std::tie(it, inserted) = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::tuple<>());
     bool fresh = false;
     if (!inserted) {
-        cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+        usage_delta -= it->second.coin.DynamicMemoryUsage();
     }
     if (!possible_overwrite) {
         if (!it->second.coin.IsSpent()) {
@@ -96,23 +118,37 @@ void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possi
     }
     it->second.coin = std::move(coin);
     it->second.flags |= CCoinsCacheEntry::DIRTY | (fresh ? CCoinsCacheEntry::FRESH : 0);
-    cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+    usage_delta += it->second.coin.DynamicMemoryUsage();
+    return usage_delta;
 }
 
-void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool check_for_overwrite) {
-    bool fCoinbase = tx.IsCoinBase();
+void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possible_overwrite) {
+    cachedCoinsUsage += AddCoinInternal(outpoint, std::move(coin), possible_overwrite);
+}
+
+void CCoinsViewCache::AddCoins(const CTransaction& tx, int nHeight, bool check_for_overwrite) {
+    const bool fCoinbase = tx.IsCoinBase();
     const uint256& txid = tx.GetHash();
+    int64_t usage_delta = 0;
     for (size_t i = 0; i < tx.vout.size(); ++i) {
-        bool overwrite = check_for_overwrite ? cache.HaveCoin(COutPoint(txid, i)) : fCoinbase;
+        const COutPoint outpoint(txid, i);
         // Coinbase transactions can always be overwritten, in order to correctly
         // deal with the pre-BIP30 occurrences of duplicate coinbase transactions.
-        cache.AddCoin(COutPoint(txid, i), Coin(tx.vout[i], nHeight, fCoinbase), overwrite);
+        const bool overwrite = check_for_overwrite ? HaveCoin(outpoint) : fCoinbase;
+        usage_delta += AddCoinInternal(outpoint, Coin(tx.vout[i], nHeight, fCoinbase), overwrite);
     }
+    cachedCoinsUsage += usage_delta;
+}
+
+void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool check_for_overwrite) {
+    cache.AddCoins(tx, nHeight, check_for_overwrite);
 }
 
 bool CCoinsViewCache::SpendCoin(const COutPoint &outpoint, Coin* moveout) {
     CCoinsMap::iterator it = FetchCoin(outpoint);
-    if (it == cacheCoins.end()) return false;
+    // An already-spent entry may be a negative-cache marker (see FetchCoin);
+    // either way there is nothing to spend.
+    if (it == cacheCoins.end() || it->second.coin.IsSpent()) return false;
     cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
     if (moveout) {
         *moveout = std::move(it->second.coin);
@@ -157,57 +193,69 @@ void CCoinsViewCache::SetBestBlock(const uint256 &hashBlockIn) {
     hashBlock = hashBlockIn;
 }
 
+void CCoinsViewCache::Reserve(size_t nAdditional) {
+    cacheCoins.reserve(cacheCoins.size() + nAdditional);
+}
+
+//! Merge a single dirty entry from a child cache into a parent cache map,
+//! keeping cachedCoinsUsage in sync. Shared between CCoinsViewCache and
+//! CCoinsViewShardedCache, which only differ in how the target map is chosen.
+static void MergeCacheEntry(CCoinsMap& cacheCoins, size_t& cachedCoinsUsage, const COutPoint& outpoint, CCoinsCacheEntry&& entryIn)
+{
+    CCoinsMap::iterator itUs = cacheCoins.find(outpoint);
+    if (itUs == cacheCoins.end()) {
+        // The parent cache does not have an entry, while the child cache does.
+        // We can ignore it if it's both spent and FRESH in the child
+        if (!(entryIn.flags & CCoinsCacheEntry::FRESH && entryIn.coin.IsSpent())) {
+            // Create the coin in the parent cache, move the data up
+            // and mark it as dirty.
+            CCoinsCacheEntry& entry = cacheCoins[outpoint];
+            entry.coin = std::move(entryIn.coin);
+            cachedCoinsUsage += entry.coin.DynamicMemoryUsage();
+            entry.flags = CCoinsCacheEntry::DIRTY;
+            // We can mark it FRESH in the parent if it was FRESH in the child
+            // Otherwise it might have just been flushed from the parent's cache
+            // and already exist in the grandparent
+            if (entryIn.flags & CCoinsCacheEntry::FRESH) {
+                entry.flags |= CCoinsCacheEntry::FRESH;
+            }
+        }
+    } else {
+        // Found the entry in the parent cache
+        if ((entryIn.flags & CCoinsCacheEntry::FRESH) && !itUs->second.coin.IsSpent()) {
+            // The coin was marked FRESH in the child cache, but the coin
+            // exists in the parent cache. If this ever happens, it means
+            // the FRESH flag was misapplied and there is a logic error in
+            // the calling code.
+            throw std::logic_error("FRESH flag misapplied to coin that exists in parent cache");
+        }
+
+        if ((itUs->second.flags & CCoinsCacheEntry::FRESH) && entryIn.coin.IsSpent()) {
+            // The grandparent cache does not have an entry, and the coin
+            // has been spent. We can just delete it from the parent cache.
+            cachedCoinsUsage -= itUs->second.coin.DynamicMemoryUsage();
+            cacheCoins.erase(itUs);
+        } else {
+            // A normal modification.
+            cachedCoinsUsage -= itUs->second.coin.DynamicMemoryUsage();
+            itUs->second.coin = std::move(entryIn.coin);
+            cachedCoinsUsage += itUs->second.coin.DynamicMemoryUsage();
+            itUs->second.flags |= CCoinsCacheEntry::DIRTY;
+            // NOTE: It isn't safe to mark the coin as FRESH in the parent
+            // cache. If it already existed and was spent in the parent
+            // cache then marking it FRESH would prevent that spentness
+            // from being flushed to the grandparent.
+        }
+    }
+}
+
 bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn) {
     for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); it = mapCoins.erase(it)) {
         // Ignore non-dirty entries (optimization).
         if (!(it->second.flags & CCoinsCacheEntry::DIRTY)) {
             continue;
         }
-        CCoinsMap::iterator itUs = cacheCoins.find(it->first);
-        if (itUs == cacheCoins.end()) {
-            // The parent cache does not have an entry, while the child cache does.
-            // We can ignore it if it's both spent and FRESH in the child
-            if (!(it->second.flags & CCoinsCacheEntry::FRESH && it->second.coin.IsSpent())) {
-                // Create the coin in the parent cache, move the data up
-                // and mark it as dirty.
-                CCoinsCacheEntry& entry = cacheCoins[it->first];
-                entry.coin = std::move(it->second.coin);
-                cachedCoinsUsage += entry.coin.DynamicMemoryUsage();
-                entry.flags = CCoinsCacheEntry::DIRTY;
-                // We can mark it FRESH in the parent if it was FRESH in the child
-                // Otherwise it might have just been flushed from the parent's cache
-                // and already exist in the grandparent
-                if (it->second.flags & CCoinsCacheEntry::FRESH) {
-                    entry.flags |= CCoinsCacheEntry::FRESH;
-                }
-            }
-        } else {
-            // Found the entry in the parent cache
-            if ((it->second.flags & CCoinsCacheEntry::FRESH) && !itUs->second.coin.IsSpent()) {
-                // The coin was marked FRESH in the child cache, but the coin
-                // exists in the parent cache. If this ever happens, it means
-                // the FRESH flag was misapplied and there is a logic error in
-                // the calling code.
-                throw std::logic_error("FRESH flag misapplied to coin that exists in parent cache");
-            }
-
-            if ((itUs->second.flags & CCoinsCacheEntry::FRESH) && it->second.coin.IsSpent()) {
-                // The grandparent cache does not have an entry, and the coin
-                // has been spent. We can just delete it from the parent cache.
-                cachedCoinsUsage -= itUs->second.coin.DynamicMemoryUsage();
-                cacheCoins.erase(itUs);
-            } else {
-                // A normal modification.
-                cachedCoinsUsage -= itUs->second.coin.DynamicMemoryUsage();
-                itUs->second.coin = std::move(it->second.coin);
-                cachedCoinsUsage += itUs->second.coin.DynamicMemoryUsage();
-                itUs->second.flags |= CCoinsCacheEntry::DIRTY;
-                // NOTE: It isn't safe to mark the coin as FRESH in the parent
-                // cache. If it already existed and was spent in the parent
-                // cache then marking it FRESH would prevent that spentness
-                // from being flushed to the grandparent.
-            }
-        }
+        MergeCacheEntry(cacheCoins, cachedCoinsUsage, it->first, std::move(it->second));
     }
     hashBlock = hashBlockIn;
     return true;
@@ -217,6 +265,7 @@ bool CCoinsViewCache::Flush() {
     bool fOk = base->BatchWrite(cacheCoins, hashBlock);
     cacheCoins.clear();
     cachedCoinsUsage = 0;
+    m_negative_entries = 0;
     return fOk;
 }
 
@@ -261,8 +310,192 @@ void CCoinsViewCache::ReallocateCache()
 {
     // Cache should be empty when we're calling this.
     assert(cacheCoins.size() == 0);
+    m_negative_entries = 0;
     cacheCoins.~CCoinsMap();
-    ::new (&cacheCoins) CCoinsMap();
+    // Also recreate the backing pool resource, as that is what actually
+    // returns the node memory to the system
+    cacheCoinsMemoryResource.~CCoinsMapMemoryResource();
+    ::new (&cacheCoinsMemoryResource) CCoinsMapMemoryResource{};
+    ::new (&cacheCoins) CCoinsMap{0, CCoinsMap::hasher{}, CCoinsMap::key_equal{}, &cacheCoinsMemoryResource};
+}
+
+CCoinsViewShardedCache::CCoinsViewShardedCache(CCoinsView* baseIn) : CCoinsViewBacked(baseIn)
+{
+    static_assert((SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "SHARD_COUNT must be a power of two");
+}
+
+bool CCoinsViewShardedCache::GetCoin(const COutPoint& outpoint, Coin& coin) const
+{
+    Shard& shard = ShardFor(outpoint);
+    {
+        LOCK(shard.cs);
+        CCoinsMap::const_iterator it = shard.map.find(outpoint);
+        if (it != shard.map.end()) {
+            coin = it->second.coin;
+            return !coin.IsSpent();
+        }
+    }
+    // Miss: fetch from the base view outside the shard lock so a slow backing
+    // store read doesn't block other accesses to the same shard. Two threads
+    // racing on the same outpoint just means one redundant base read.
+    Coin tmp;
+    if (!base->GetCoin(outpoint, tmp)) {
+        return false;
+    }
+    coin = tmp;
+    LOCK(shard.cs);
+    auto [it, inserted] = shard.map.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::forward_as_tuple(std::move(tmp)));
+    if (inserted) {
+        if (it->second.coin.IsSpent()) {
+            // The parent only has an empty entry for this outpoint; we can consider our
+            // version as fresh.
+            it->second.flags = CCoinsCacheEntry::FRESH;
+        }
+        shard.cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+    }
+    return !coin.IsSpent();
+}
+
+bool CCoinsViewShardedCache::HaveCoin(const COutPoint& outpoint) const
+{
+    Coin coin;
+    return GetCoin(outpoint, coin);
+}
+
+bool CCoinsViewShardedCache::HaveCoinInCache(const COutPoint& outpoint) const
+{
+    Shard& shard = ShardFor(outpoint);
+    LOCK(shard.cs);
+    CCoinsMap::const_iterator it = shard.map.find(outpoint);
+    return (it != shard.map.end() && !it->second.coin.IsSpent());
+}
+
+void CCoinsViewShardedCache::AddCoin(const COutPoint& outpoint, Coin&& coin, bool possible_overwrite)
+{
+    assert(!coin.IsSpent());
+    if (coin.out.scriptPubKey.IsUnspendable()) return;
+    Shard& shard = ShardFor(outpoint);
+    LOCK(shard.cs);
+    auto [it, inserted] = shard.map.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::tuple<>());
+    bool fresh = false;
+    if (!inserted) {
+        shard.cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+    }
+    if (!possible_overwrite) {
+        if (!it->second.coin.IsSpent()) {
+            throw std::logic_error("Attempted to overwrite an unspent coin (when possible_overwrite is false)");
+        }
+        // See CCoinsViewCache::AddCoin for the reasoning behind the FRESH rules.
+        fresh = !(it->second.flags & CCoinsCacheEntry::DIRTY);
+    }
+    it->second.coin = std::move(coin);
+    it->second.flags |= CCoinsCacheEntry::DIRTY | (fresh ? CCoinsCacheEntry::FRESH : 0);
+    shard.cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+}
+
+bool CCoinsViewShardedCache::SpendCoin(const COutPoint& outpoint, Coin* moveto)
+{
+    Shard& shard = ShardFor(outpoint);
+    // Unlike GetCoin, the base read happens under the shard lock here: spends
+    // are not on the concurrent read hot path and this keeps the
+    // fetch-then-modify sequence atomic.
+    LOCK(shard.cs);
+    CCoinsMap::iterator it = shard.map.find(outpoint);
+    if (it == shard.map.end()) {
+        Coin tmp;
+        if (!base->GetCoin(outpoint, tmp)) return false;
+        it = shard.map.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::forward_as_tuple(std::move(tmp))).first;
+        shard.cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+    }
+    shard.cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+    if (moveto) {
+        *moveto = std::move(it->second.coin);
+    }
+    if (it->second.flags & CCoinsCacheEntry::FRESH) {
+        shard.map.erase(it);
+    } else {
+        it->second.flags |= CCoinsCacheEntry::DIRTY;
+        it->second.coin.Clear();
+    }
+    return true;
+}
+
+uint256 CCoinsViewShardedCache::GetBestBlock() const
+{
+    LOCK(m_cs_best_block);
+    if (m_hash_block.IsNull())
+        m_hash_block = base->GetBestBlock();
+    return m_hash_block;
+}
+
+void CCoinsViewShardedCache::SetBestBlock(const uint256& hashBlockIn)
+{
+    LOCK(m_cs_best_block);
+    m_hash_block = hashBlockIn;
+}
+
+bool CCoinsViewShardedCache::BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlockIn)
+{
+    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); it = mapCoins.erase(it)) {
+        // Ignore non-dirty entries (optimization).
+        if (!(it->second.flags & CCoinsCacheEntry::DIRTY)) {
+            continue;
+        }
+        Shard& shard = ShardFor(it->first);
+        LOCK(shard.cs);
+        MergeCacheEntry(shard.map, shard.cachedCoinsUsage, it->first, std::move(it->second));
+    }
+    SetBestBlock(hashBlockIn);
+    return true;
+}
+
+bool CCoinsViewShardedCache::Flush()
+{
+    // Collect the dirty entries of all shards into a single map so the base
+    // view sees one batch (and, for CCoinsViewDB, a single best-block update).
+    CCoinsMap allCoins;
+    for (Shard& shard : m_shards) {
+        LOCK(shard.cs);
+        for (auto& [outpoint, entry] : shard.map) {
+            if (entry.flags & CCoinsCacheEntry::DIRTY) {
+                allCoins.emplace(outpoint, std::move(entry));
+            }
+        }
+        shard.map.clear();
+        shard.cachedCoinsUsage = 0;
+    }
+    return base->BatchWrite(allCoins, GetBestBlock());
+}
+
+void CCoinsViewShardedCache::Uncache(const COutPoint& outpoint)
+{
+    Shard& shard = ShardFor(outpoint);
+    LOCK(shard.cs);
+    CCoinsMap::iterator it = shard.map.find(outpoint);
+    if (it != shard.map.end() && it->second.flags == 0) {
+        shard.cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+        shard.map.erase(it);
+    }
+}
+
+unsigned int CCoinsViewShardedCache::GetCacheSize() const
+{
+    unsigned int nRet{0};
+    for (const Shard& shard : m_shards) {
+        LOCK(shard.cs);
+        nRet += shard.map.size();
+    }
+    return nRet;
+}
+
+size_t CCoinsViewShardedCache::DynamicMemoryUsage() const
+{
+    size_t nRet{0};
+    for (const Shard& shard : m_shards) {
+        LOCK(shard.cs);
+        nRet += memusage::DynamicUsage(shard.map) + shard.cachedCoinsUsage;
+    }
+    return nRet;
 }
 
 static const size_t MAX_OUTPUTS_PER_BLOCK = MaxBlockSize() /  ::GetSerializeSize(CTxOut(), PROTOCOL_VERSION); // TODO: merge with similar definition in undo.h.
@@ -12,11 +12,14 @@
 #include <memusage.h>
 #include <primitives/transaction.h>
 #include <serialize.h>
+#include <support/allocators/pool.h>
+#include <sync.h>
 #include <uint256.h>
 
 #include <assert.h>
 #include <stdint.h>
 
+#include <array>
 #include <functional>
 #include <unordered_map>
 
@@ -157,7 +160,20 @@ struct CCoinsCacheEntry
     explicit CCoinsCacheEntry(Coin&& coin_) : coin(std::move(coin_)), flags(0) {}
 };
 
-typedef std::unordered_map<COutPoint, CCoinsCacheEntry, SaltedOutpointHasher> CCoinsMap;
+/**
+ * CCoinsMap entries come out of a PoolResource owned by the cache (one node is
+ * the map's value pair plus libstdc++'s bookkeeping pointers), so that the
+ * hundreds of thousands of small allocs/frees per connected block bypass the
+ * global heap. Default constructed maps fall back to the heap.
+ */
+using CCoinsMap = std::unordered_map<COutPoint,
+                                     CCoinsCacheEntry,
+                                     SaltedOutpointHasher,
+                                     std::equal_to<COutPoint>,
+                                     PoolAllocator<std::pair<const COutPoint, CCoinsCacheEntry>,
+                                                   sizeof(std::pair<const COutPoint, CCoinsCacheEntry>) + sizeof(void*) * 4>>;
+
+using CCoinsMapMemoryResource = CCoinsMap::allocator_type::ResourceType;
 
 /** Cursor for iterating over CoinsView state */
 class CCoinsViewCursor
@@ -236,6 +252,10 @@ public:
 
 
 /** CCoinsView that adds a memory cache for transactions to another CCoinsView */
+//! Upper bound on the number of negative entries a CCoinsViewCache keeps
+//! between flushes (each one costs a map node, ~100 bytes). See FetchCoin.
+static constexpr size_t MAX_COINS_NEGATIVE_ENTRIES{50000};
+
 class CCoinsViewCache : public CCoinsViewBacked
 {
 protected:
@@ -244,13 +264,31 @@ protected:
      * declared as "const".
      */
     mutable uint256 hashBlock;
+    /* The backing memory for cacheCoins entries. Declared before the map so it outlives it. */
+    mutable CCoinsMapMemoryResource cacheCoinsMemoryResource{};
     mutable CCoinsMap cacheCoins;
 
     /* Cached dynamic memory usage for the inner Coin objects. */
     mutable size_t cachedCoinsUsage;
 
+    /* Cumulative FetchCoin probe counters, exposed by the getcachestats RPC.
+     * Externally synchronized like the rest of this class. */
+    mutable uint64_t cachedCoinsHits{0};
+    mutable uint64_t cachedCoinsMisses{0};
+
+    /* Number of negative (absent-in-base) entries materialized in cacheCoins
+     * since the last Flush(), to bound their footprint. See FetchCoin. */
+    mutable size_t m_negative_entries{0};
+
 public:
-    CCoinsViewCache(CCoinsView *baseIn);
+    /**
+     * @param[in] huge_pages  Back the cache's memory resource with 2MB huge
+     *                        pages (see PoolResource). Worthwhile for the
+     *                        chainstate tip cache, which can grow to several
+     *                        GB with a large -dbcache; pointless for the
+     *                        short-lived caches layered on top of it.
+     */
+    explicit CCoinsViewCache(CCoinsView *baseIn, bool huge_pages = false);
 
     /**
      * By deleting the copy constructor, we prevent accidentally using it when one intends to create a cache on top of a base cache.
@@ -262,6 +300,10 @@ public:
     bool HaveCoin(const COutPoint &outpoint) const override;
     uint256 GetBestBlock() const override;
     void SetBestBlock(const uint256 &hashBlock);
+    //! Pre-size the cache for nAdditional upcoming insertions, so that bulk
+    //! loads (e.g. restoring a whole block's worth of undo coins) do not
+    //! rehash the map repeatedly mid-way.
+    void Reserve(size_t nAdditional);
     bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) override;
     CCoinsViewCursor* Cursor() const override {
         throw std::logic_error("CCoinsViewCache cursor iteration not supported.");
@@ -292,6 +334,14 @@ public:
      */
     void AddCoin(const COutPoint& outpoint, Coin&& coin, bool possible_overwrite);
 
+    /**
+     * Add all outputs of a transaction in one pass, updating the cache usage
+     * accounting once per transaction rather than once per output. Semantics
+     * per output match AddCoin; see the free AddCoins() for the meaning of
+     * check_for_overwrite.
+     */
+    void AddCoins(const CTransaction& tx, int nHeight, bool check_for_overwrite = false);
+
     /**
      * Spend a coin. Pass moveto in order to get the deleted data.
      * If no unspent output exists for the passed outpoint, this call
@@ -318,6 +368,12 @@ public:
     //! Calculate the size of the cache (in bytes)
     size_t DynamicMemoryUsage() const;
 
+    //! Number of FetchCoin calls answered from this cache
+    uint64_t GetCacheHits() const { return cachedCoinsHits; }
+
+    //! Number of FetchCoin calls that had to consult the base view
+    uint64_t GetCacheMisses() const { return cachedCoinsMisses; }
+
     /**
      * Amount of dash coming in to a transaction
      * Note that lightweight clients may not know anything besides the hash of previous transactions,
@@ -344,6 +400,88 @@ private:
      * memory usage.
      */
     CCoinsMap::iterator FetchCoin(const COutPoint &outpoint) const;
+
+    /**
+     * AddCoin without the cachedCoinsUsage update: returns the delta the
+     * caller must apply, so batch insertions (AddCoins) account once per
+     * transaction.
+     */
+    int64_t AddCoinInternal(const COutPoint& outpoint, Coin&& coin, bool possible_overwrite);
+};
+
+/**
+ * CCoinsView cache sharded over multiple independently locked maps.
+ *
+ * Unlike CCoinsViewCache, which relies on external synchronization (cs_main),
+ * this cache may be read and written from multiple threads concurrently: every
+ * shard is guarded by its own mutex and an outpoint always maps to the same
+ * shard, so lookups and modifications of distinct outpoints never contend.
+ * The backing view must itself be safe for concurrent reads (CCoinsViewDB is;
+ * CCoinsViewCache is not, since its FetchCoin mutates the cache map).
+ *
+ * Flush() and ReallocateCache() are not safe to run concurrently with any
+ * other access and follow the usual single-writer flush discipline.
+ */
+class CCoinsViewShardedCache : public CCoinsViewBacked
+{
+public:
+    static constexpr size_t SHARD_COUNT{64};
+
+    explicit CCoinsViewShardedCache(CCoinsView* baseIn);
+    CCoinsViewShardedCache(const CCoinsViewShardedCache&) = delete;
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override;
+    bool HaveCoin(const COutPoint& outpoint) const override;
+    uint256 GetBestBlock() const override;
+    void SetBestBlock(const uint256& hashBlock);
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock) override;
+    CCoinsViewCursor* Cursor() const override
+    {
+        throw std::logic_error("CCoinsViewShardedCache cursor iteration not supported.");
+    }
+
+    //! Check whether the cache (and only the cache) holds an unspent coin.
+    bool HaveCoinInCache(const COutPoint& outpoint) const;
+
+    //! Same semantics as CCoinsViewCache::AddCoin.
+    void AddCoin(const COutPoint& outpoint, Coin&& coin, bool possible_overwrite);
+
+    //! Same semantics as CCoinsViewCache::SpendCoin.
+    bool SpendCoin(const COutPoint& outpoint, Coin* moveto = nullptr);
+
+    //! Push all shards to the base view in a single batch and empty the cache.
+    bool Flush();
+
+    //! Drop an unmodified entry from the cache, if present.
+    void Uncache(const COutPoint& outpoint);
+
+    //! Calculate the size of the cache (in number of transaction outputs)
+    unsigned int GetCacheSize() const;
+
+    //! Calculate the size of the cache (in bytes)
+    size_t DynamicMemoryUsage() const;
+
+private:
+    struct Shard {
+        mutable Mutex cs;
+        /* Declared before the map so it outlives it. */
+        mutable CCoinsMapMemoryResource resource;
+        mutable CCoinsMap map GUARDED_BY(cs);
+        mutable size_t cachedCoinsUsage GUARDED_BY(cs){0};
+
+        Shard() : map(0, CCoinsMap::hasher{}, CCoinsMap::key_equal{}, &resource) {}
+    };
+
+    Shard& ShardFor(const COutPoint& outpoint) const
+    {
+        return m_shards[m_hasher(outpoint) & (SHARD_COUNT - 1)];
+    }
+
+    const SaltedOutpointHasher m_hasher;
+    mutable std::array<Shard, SHARD_COUNT> m_shards;
+
+    mutable Mutex m_cs_best_block;
+    mutable uint256 m_hash_block GUARDED_BY(m_cs_best_block);
 };
 
 //! Utility function to add all of a transaction's outputs to a cache.
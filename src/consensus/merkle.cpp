@@ -42,6 +42,10 @@
 */
 
 
+/* Hashing is done one tree level at a time through SHA256D64, which processes
+   all pairs of a level in one call and internally dispatches to the widest
+   double-SHA256 transform the CPU supports (8-way AVX2, 4-way SSE4.1, ...).
+   There is no per-pair CHash256 loop to vectorize here. */
 uint256 ComputeMerkleRoot(std::vector<uint256> hashes, bool* mutated) {
     bool mutation = false;
     while (hashes.size() > 1) {
@@ -3,6 +3,11 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <crypto/siphash.h>
+#include <crypto/common.h>
+
+#include <assert.h>
+
+#include <compat/cpuid.h>
 
 #define ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
 
@@ -171,3 +176,81 @@ uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint3
     SIPROUND;
     return v0 ^ v1 ^ v2 ^ v3;
 }
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+namespace siphash_avx2
+{
+void SipHashUint256_4way(uint64_t k0, uint64_t k1, const uint256* const* vals, uint64_t* out);
+}
+#endif
+
+namespace {
+
+typedef void (*SipHashUint256_4wayType)(uint64_t, uint64_t, const uint256* const*, uint64_t*);
+SipHashUint256_4wayType SipHashUint256_4way = nullptr;
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL) && defined(HAVE_GETCPUID)
+/** Check whether the OS has enabled AVX registers. */
+bool AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+#endif
+
+void SelfTest()
+{
+    if (!SipHashUint256_4way) return;
+
+    uint256 vals[4];
+    const uint256* ptrs[4];
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 32; j++) {
+            *(vals[i].begin() + j) = static_cast<unsigned char>(i * 61 + j * 7);
+        }
+        ptrs[i] = &vals[i];
+    }
+    const uint64_t k0 = 0x0706050403020100ULL;
+    const uint64_t k1 = 0x0F0E0D0C0B0A0908ULL;
+    uint64_t out[4];
+    SipHashUint256_4way(k0, k1, ptrs, out);
+    for (int i = 0; i < 4; i++) {
+        assert(out[i] == SipHashUint256(k0, k1, vals[i]));
+    }
+}
+
+} // namespace
+
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, const uint256* const* vals, uint64_t* out, size_t count)
+{
+    size_t i = 0;
+    if (SipHashUint256_4way) {
+        for (; i + 4 <= count; i += 4) {
+            SipHashUint256_4way(k0, k1, vals + i, out + i);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = SipHashUint256(k0, k1, *vals[i]);
+    }
+}
+
+std::string SipHashAutoDetect()
+{
+    std::string ret = "standard";
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL) && defined(HAVE_GETCPUID)
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    const bool have_xsave = (ecx >> 27) & 1;
+    const bool have_avx = (ecx >> 28) & 1;
+    bool have_avx2 = false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    have_avx2 = (ebx >> 5) & 1;
+    if (have_avx2 && have_avx && have_xsave && AVXEnabled()) {
+        SipHashUint256_4way = siphash_avx2::SipHashUint256_4way;
+        ret = "avx2(4way)";
+    }
+#endif
+    SelfTest();
+    return ret;
+}
@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <string>
+
 #include <uint256.h>
 
 /** SipHash-2-4 */
@@ -44,4 +46,18 @@ public:
 uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val);
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra);
 
+/** Compute SipHashUint256 for a batch of values.
+ *
+ *  Equivalent to calling SipHashUint256 for every element of vals, but uses a
+ *  4-way SIMD kernel for groups of four when the CPU supports one. Intended
+ *  for workloads that hash many txids with the same key, e.g. compact block
+ *  short ID calculation over the mempool.
+ */
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, const uint256* const* vals, uint64_t* out, size_t count);
+
+/** Pick the best available batch SipHash implementation for the current CPU
+ *  and self-test it against the scalar code. Returns the implementation name.
+ */
+std::string SipHashAutoDetect();
+
 #endif // BITCOIN_CRYPTO_SIPHASH_H
@@ -0,0 +1,76 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include <uint256.h>
+
+namespace siphash_avx2 {
+namespace {
+
+inline __m256i Rotl(const __m256i x, int b)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(x, b), _mm256_srli_epi64(x, 64 - b));
+}
+
+/** Rotation by 32 is a lane-wise dword swap, cheaper than shift+or. */
+inline __m256i Rotl32(const __m256i x)
+{
+    return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+#define SIPROUND do { \
+    v0 = _mm256_add_epi64(v0, v1); v1 = Rotl(v1, 13); v1 = _mm256_xor_si256(v1, v0); \
+    v0 = Rotl32(v0); \
+    v2 = _mm256_add_epi64(v2, v3); v3 = Rotl(v3, 16); v3 = _mm256_xor_si256(v3, v2); \
+    v0 = _mm256_add_epi64(v0, v3); v3 = Rotl(v3, 21); v3 = _mm256_xor_si256(v3, v0); \
+    v2 = _mm256_add_epi64(v2, v1); v1 = Rotl(v1, 17); v1 = _mm256_xor_si256(v1, v2); \
+    v2 = Rotl32(v2); \
+} while (0)
+
+inline __m256i LoadWord(const uint256* const* vals, int word)
+{
+    return _mm256_set_epi64x(vals[3]->GetUint64(word), vals[2]->GetUint64(word),
+                             vals[1]->GetUint64(word), vals[0]->GetUint64(word));
+}
+
+} // namespace
+
+/** Four independent SipHashUint256 computations, one per 64-bit lane. */
+void SipHashUint256_4way(uint64_t k0, uint64_t k1, const uint256* const* vals, uint64_t* out)
+{
+    __m256i v0 = _mm256_set1_epi64x(0x736f6d6570736575ULL ^ k0);
+    __m256i v1 = _mm256_set1_epi64x(0x646f72616e646f6dULL ^ k1);
+    __m256i v2 = _mm256_set1_epi64x(0x6c7967656e657261ULL ^ k0);
+    __m256i v3 = _mm256_set1_epi64x(0x7465646279746573ULL ^ k1);
+
+    for (int word = 0; word < 4; word++) {
+        const __m256i d = LoadWord(vals, word);
+        v3 = _mm256_xor_si256(v3, d);
+        SIPROUND;
+        SIPROUND;
+        v0 = _mm256_xor_si256(v0, d);
+    }
+
+    const __m256i t = _mm256_set1_epi64x(((uint64_t)4) << 59);
+    v3 = _mm256_xor_si256(v3, t);
+    SIPROUND;
+    SIPROUND;
+    v0 = _mm256_xor_si256(v0, t);
+    v2 = _mm256_xor_si256(v2, _mm256_set1_epi64x(0xFF));
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+
+    const __m256i result = _mm256_xor_si256(_mm256_xor_si256(v0, v1), _mm256_xor_si256(v2, v3));
+    _mm256_storeu_si256((__m256i*)out, result);
+}
+
+} // namespace siphash_avx2
+
+#endif // ENABLE_AVX2
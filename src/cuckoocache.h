@@ -439,6 +439,22 @@ public:
         }
     }
 
+    /** prefetch hints the CPU to pull the hash locations for a given
+     * element into cache. Issuing it once the element's hash is known, but
+     * before the caller is ready to probe (e.g. while still acquiring a
+     * lock), overlaps the (likely) cache misses on the table with other
+     * work. It is a pure hint and never modifies the table, so it is safe
+     * to call without any synchronization.
+     *
+     * @param e the element whose locations to prefetch
+     */
+    inline void prefetch(const Element& e) const
+    {
+        std::array<uint32_t, 8> locs = compute_hashes(e);
+        for (const uint32_t loc : locs)
+            __builtin_prefetch(&table[loc], 0, 1);
+    }
+
     /** contains iterates through the hash locations for a given element
      * and checks to see if it is present.
      *
@@ -12,6 +12,7 @@
 #include <util/system.h>
 #include <util/strencodings.h>
 
+#include <type_traits>
 #include <typeindex>
 
 #include <leveldb/db.h>
@@ -193,6 +194,20 @@ public:
 
 };
 
+/** Per-database LevelDB tuning knobs. The defaults reproduce the options historically
+ * applied to every database; databases with particular access patterns can deviate,
+ * e.g. more bloom bits for point-lookup heavy databases or compression where values
+ * are compressible. */
+struct CDBWrapperOptions
+{
+    //! Bloom filter bits per key
+    int bloom_filter_bits{10};
+    //! Compress table blocks with snappy
+    bool compression{false};
+    //! Block cache size in bytes; 0 derives it from the database cache size as before
+    size_t block_cache_bytes{0};
+};
+
 class CDBWrapper
 {
     friend const std::vector<unsigned char>& dbwrapper_private::GetObfuscateKey(const CDBWrapper &w);
@@ -240,8 +255,9 @@ public:
      * @param[in] fWipe       If true, remove all existing data.
      * @param[in] obfuscate   If true, store data obfuscated via simple XOR. If false, XOR
      *                        with a zero'd byte array.
+     * @param[in] db_options  Per-database LevelDB tuning, see CDBWrapperOptions.
      */
-    CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory = false, bool fWipe = false, bool obfuscate = false);
+    CDBWrapper(const fs::path& path, size_t nCacheSize, bool fMemory = false, bool fWipe = false, bool obfuscate = false, const CDBWrapperOptions& db_options = CDBWrapperOptions{});
     ~CDBWrapper();
 
     CDBWrapper(const CDBWrapper&) = delete;
@@ -574,7 +590,8 @@ protected:
 
     template <typename V>
     struct ValueHolderImpl : ValueHolder {
-        ValueHolderImpl(const V &_value, size_t _memoryUsage) : ValueHolder(_memoryUsage), value(_value) {}
+        template <typename V2>
+        ValueHolderImpl(V2&& _value, size_t _memoryUsage) : ValueHolder(_memoryUsage), value(std::forward<V2>(_value)) {}
 
         virtual void Write(const CDataStream& ssKey, CommitTarget &commitTarget) override {
             // we're moving the value instead of copying it. This means that Write() can only be called once per
@@ -602,12 +619,12 @@ public:
     CDBTransaction(Parent &_parent, CommitTarget &_commitTarget) : parent(_parent), commitTarget(_commitTarget) {}
 
     template <typename K, typename V>
-    void Write(const K& key, const V& v) {
-        Write(KeyToDataStream(key), v);
+    void Write(const K& key, V&& v) {
+        Write(KeyToDataStream(key), std::forward<V>(v));
     }
 
     template <typename V>
-    void Write(const CDataStream& ssKey, const V& v) {
+    void Write(const CDataStream& ssKey, V&& v) {
         auto valueMemoryUsage = ::GetSerializeSize(v, CLIENT_VERSION);
 
         if (deletes.erase(ssKey)) {
@@ -617,7 +634,9 @@ public:
         if (it->second) {
             memoryUsage -= ssKey.size() + it->second->memoryUsage;
         }
-        it->second = std::make_unique<ValueHolderImpl<V>>(v, valueMemoryUsage);
+        // moves instead of copies when the caller hands over an rvalue, which
+        // is what Commit() of a child transaction does for every value
+        it->second = std::make_unique<ValueHolderImpl<std::decay_t<V>>>(std::forward<V>(v), valueMemoryUsage);
 
         memoryUsage += ssKey.size() + valueMemoryUsage;
     }
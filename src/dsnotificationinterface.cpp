@@ -9,6 +9,7 @@
 #endif // ENABLE_WALLET
 #include <dsnotificationinterface.h>
 #include <governance/governance.h>
+#include <masternode/payments.h>
 #include <masternode/sync.h>
 #include <validation.h>
 
@@ -66,6 +67,8 @@ void CDSNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindexNew, con
     if (fInitialDownload)
         return;
 
+    CMasternodePayments::UpdatedBlockTip(pindexNew);
+
     CCoinJoin::UpdatedBlockTip(pindexNew, *llmq_ctx->clhandler, m_mn_sync);
 #ifdef ENABLE_WALLET
     for (auto& pair : coinJoinClientManagers) {
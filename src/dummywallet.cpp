@@ -66,6 +66,7 @@ void DummyWalletInit::AddWalletOptions(ArgsManager& argsman) const
         "-flushwallet",
         "-privdb",
         "-walletrejectlongchains",
+        "-sqlitewal",
         "-unsafesqlitesync"
     });
 }
@@ -240,24 +240,37 @@ std::vector<CDeterministicMNCPtr> CDeterministicMNList::GetProjectedMNPayees(int
         return;
     });
 
+    // Sort unique MNs decorated with their precomputed last-paid key and
+    // expand by voting weight afterwards. This is equivalent to sorting the
+    // weight-expanded list (copies of one MN compare equal and end up
+    // adjacent) but compares cached ints instead of chasing pdmnState twice
+    // per comparison, and sorts one entry per MN instead of per weight unit.
+    std::vector<std::pair<int, CDeterministicMNCPtr>> candidates;
+    candidates.reserve(GetAllMNsCount());
     ForEachMNShared(true, [&](const CDeterministicMNCPtr& dmn) {
-        if (dmn == hpmn_to_be_skipped) return;
-        for ([[maybe_unused]] auto _ : irange::range(GetMnType(dmn->nType).voting_weight)) {
-            result.emplace_back(dmn);
+        candidates.emplace_back(CompareByLastPaid_GetHeight(*dmn), dmn);
+    });
+
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<int, CDeterministicMNCPtr>& a, const std::pair<int, CDeterministicMNCPtr>& b) {
+        if (a.first == b.first) {
+            return a.second->proTxHash < b.second->proTxHash;
         }
+        return a.first < b.first;
     });
 
-    if (hpmn_to_be_skipped != nullptr) {
-        // if hpmn is in the middle of payments, add entries for already paid ones to the end of the list
-        for ([[maybe_unused]] auto _ : irange::range(hpmn_to_be_skipped->pdmnState->nConsecutivePayments)) {
-            result.emplace_back(hpmn_to_be_skipped);
+    for (const auto& p : candidates) {
+        const auto& dmn = p.second;
+        // if hpmn is in the middle of payments, only add entries for the already
+        // paid ones; it sorts to the end of the list via its last-paid height
+        const int weight = dmn == hpmn_to_be_skipped ?
+                hpmn_to_be_skipped->pdmnState->nConsecutivePayments :
+                int(GetMnType(dmn->nType).voting_weight);
+        for ([[maybe_unused]] auto _ : irange::range(weight)) {
+            result.emplace_back(dmn);
         }
+        if (result.size() >= size_t(nCount)) break;
     }
 
-    std::sort(result.begin() + remaining_hpmn_payments, result.end(), [&](const CDeterministicMNCPtr& a, const CDeterministicMNCPtr& b) {
-        return CompareByLastPaid(a.get(), b.get());
-    });
-
     result.resize(nCount);
 
     return result;
@@ -268,17 +281,25 @@ std::vector<CDeterministicMNCPtr> CDeterministicMNList::CalculateQuorum(size_t m
     auto scores = CalculateScores(modifier, onlyHighPerformanceMasternodes);
 
     // sort is descending order
-    std::sort(scores.rbegin(), scores.rend(), [](const std::pair<arith_uint256, CDeterministicMNCPtr>& a, const std::pair<arith_uint256, CDeterministicMNCPtr>& b) {
+    const auto cmpDescending = [](const std::pair<arith_uint256, CDeterministicMNCPtr>& a, const std::pair<arith_uint256, CDeterministicMNCPtr>& b) {
         if (a.first == b.first) {
             // this should actually never happen, but we should stay compatible with how the non-deterministic MNs did the sorting
-            return a.second->collateralOutpoint < b.second->collateralOutpoint;
-        }
-        return a.first < b.first;
-    });
+            return b.second->collateralOutpoint < a.second->collateralOutpoint;
+        }
+        return b.first < a.first;
+    };
+    const size_t nResultSize = std::min(maxSize, scores.size());
+    if (nResultSize < scores.size()) {
+        // quorum sizes are much smaller than the MN count; only the top
+        // entries need to end up in sorted order
+        std::partial_sort(scores.begin(), scores.begin() + nResultSize, scores.end(), cmpDescending);
+    } else {
+        std::sort(scores.begin(), scores.end(), cmpDescending);
+    }
 
     // take top maxSize entries and return it
     std::vector<CDeterministicMNCPtr> result;
-    result.resize(std::min(maxSize, scores.size()));
+    result.resize(nResultSize);
     for (size_t i = 0; i < result.size(); i++) {
         result[i] = std::move(scores[i].second);
     }
@@ -332,44 +353,57 @@ int CDeterministicMNList::CalcPenalty(int percent) const
 void CDeterministicMNList::PoSePunish(const uint256& proTxHash, int penalty, bool debugLogs)
 {
     assert(penalty > 0);
+    ApplyPoSeChanges({{proTxHash, penalty}}, debugLogs);
+}
 
-    auto dmn = GetMN(proTxHash);
-    if (!dmn) {
-        throw(std::runtime_error(strprintf("%s: Can't find a masternode with proTxHash=%s", __func__, proTxHash.ToString())));
+void CDeterministicMNList::PoSeDecrease(const uint256& proTxHash)
+{
+    ApplyPoSeChanges({{proTxHash, -1}}, false);
+}
+
+void CDeterministicMNList::ApplyPoSeChanges(const std::vector<std::pair<uint256, int>>& deltas, bool debugLogs)
+{
+    if (deltas.empty()) {
+        return;
     }
 
-    int maxPenalty = CalcMaxPoSePenalty();
+    const int maxPenalty = CalcMaxPoSePenalty();
 
-    auto newState = std::make_shared<CDeterministicMNState>(*dmn->pdmnState);
-    newState->nPoSePenalty += penalty;
-    newState->nPoSePenalty = std::min(maxPenalty, newState->nPoSePenalty);
+    for (const auto& [proTxHash, delta] : deltas) {
+        assert(delta != 0);
+        auto p = mnMap.find(proTxHash);
+        if (!p) {
+            throw(std::runtime_error(strprintf("%s: Can't find a masternode with proTxHash=%s", __func__, proTxHash.ToString())));
+        }
+        const auto& oldDmn = **p;
 
-    if (debugLogs) {
-        LogPrintf("CDeterministicMNList::%s -- punished MN %s, penalty %d->%d (max=%d)\n",
-                  __func__, proTxHash.ToString(), dmn->pdmnState->nPoSePenalty, newState->nPoSePenalty, maxPenalty);
-    }
+        auto newState = std::make_shared<CDeterministicMNState>(*oldDmn.pdmnState);
+        if (delta > 0) {
+            newState->nPoSePenalty = std::min(maxPenalty, newState->nPoSePenalty + delta);
 
-    if (newState->nPoSePenalty >= maxPenalty && !newState->IsBanned()) {
-        newState->BanIfNotBanned(nHeight);
-        if (debugLogs) {
-            LogPrintf("CDeterministicMNList::%s -- banned MN %s at height %d\n",
-                      __func__, proTxHash.ToString(), nHeight);
+            if (debugLogs) {
+                LogPrintf("CDeterministicMNList::%s -- punished MN %s, penalty %d->%d (max=%d)\n",
+                          __func__, proTxHash.ToString(), oldDmn.pdmnState->nPoSePenalty, newState->nPoSePenalty, maxPenalty);
+            }
+
+            if (newState->nPoSePenalty >= maxPenalty && !newState->IsBanned()) {
+                newState->BanIfNotBanned(nHeight);
+                if (debugLogs) {
+                    LogPrintf("CDeterministicMNList::%s -- banned MN %s at height %d\n",
+                              __func__, proTxHash.ToString(), nHeight);
+                }
+            }
+        } else {
+            assert(oldDmn.pdmnState->nPoSePenalty > 0 && !oldDmn.pdmnState->IsBanned());
+            newState->nPoSePenalty = std::max(0, newState->nPoSePenalty + delta);
         }
-    }
-    UpdateMN(proTxHash, newState);
-}
 
-void CDeterministicMNList::PoSeDecrease(const uint256& proTxHash)
-{
-    auto dmn = GetMN(proTxHash);
-    if (!dmn) {
-        throw(std::runtime_error(strprintf("%s: Can't find a masternode with proTxHash=%s", __func__, proTxHash.ToString())));
+        // PoSe changes never touch addr/keys/platformNodeID, so unlike UpdateMN
+        // there is no unique property bookkeeping to do; replace the entry directly
+        auto newDmn = std::make_shared<CDeterministicMN>(oldDmn);
+        newDmn->pdmnState = std::move(newState);
+        mnMap = mnMap.set(proTxHash, newDmn);
     }
-    assert(dmn->pdmnState->nPoSePenalty > 0 && !dmn->pdmnState->IsBanned());
-
-    auto newState = std::make_shared<CDeterministicMNState>(*dmn->pdmnState);
-    newState->nPoSePenalty--;
-    UpdateMN(proTxHash, newState);
 }
 
 CDeterministicMNListDiff CDeterministicMNList::BuildDiff(const CDeterministicMNList& to) const
@@ -818,10 +852,11 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
         }
 
         if (tx.nType == TRANSACTION_PROVIDER_REGISTER) {
-            CProRegTx proTx;
-            if (!GetTxPayload(tx, proTx)) {
+            const auto opt_proTx = GetTxPayloadCached<CProRegTx>(tx);
+            if (!opt_proTx) {
                 return _state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-protx-payload");
             }
+            const CProRegTx& proTx = *opt_proTx;
 
             if (proTx.nType == MnType::HighPerformance && !llmq::utils::IsV19Active(pindexPrev)) {
                 return _state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-protx-payload");
@@ -881,10 +916,11 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                     __func__, tx.GetHash().ToString(), nHeight, proTx.ToString());
             }
         } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_SERVICE) {
-            CProUpServTx proTx;
-            if (!GetTxPayload(tx, proTx)) {
+            const auto opt_proTx = GetTxPayloadCached<CProUpServTx>(tx);
+            if (!opt_proTx) {
                 return _state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-protx-payload");
             }
+            const CProUpServTx& proTx = *opt_proTx;
 
             if (proTx.nType == MnType::HighPerformance && !llmq::utils::IsV19Active(pindexPrev)) {
                 return _state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-protx-payload");
@@ -930,10 +966,11 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                     __func__, proTx.proTxHash.ToString(), nHeight, proTx.ToString());
             }
         } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REGISTRAR) {
-            CProUpRegTx proTx;
-            if (!GetTxPayload(tx, proTx)) {
+            const auto opt_proTx = GetTxPayloadCached<CProUpRegTx>(tx);
+            if (!opt_proTx) {
                 return _state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-protx-payload");
             }
+            const CProUpRegTx& proTx = *opt_proTx;
 
             CDeterministicMNCPtr dmn = newList.GetMN(proTx.proTxHash);
             if (!dmn) {
@@ -956,10 +993,11 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                     __func__, proTx.proTxHash.ToString(), nHeight, proTx.ToString());
             }
         } else if (tx.nType == TRANSACTION_PROVIDER_UPDATE_REVOKE) {
-            CProUpRevTx proTx;
-            if (!GetTxPayload(tx, proTx)) {
+            const auto opt_proTx = GetTxPayloadCached<CProUpRevTx>(tx);
+            if (!opt_proTx) {
                 return _state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-protx-payload");
             }
+            const CProUpRevTx& proTx = *opt_proTx;
 
             CDeterministicMNCPtr dmn = newList.GetMN(proTx.proTxHash);
             if (!dmn) {
@@ -977,10 +1015,11 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
                     __func__, proTx.proTxHash.ToString(), nHeight, proTx.ToString());
             }
         } else if (tx.nType == TRANSACTION_QUORUM_COMMITMENT) {
-            llmq::CFinalCommitmentTxPayload qc;
-            if (!GetTxPayload(tx, qc)) {
+            const auto opt_qc = GetTxPayloadCached<llmq::CFinalCommitmentTxPayload>(tx);
+            if (!opt_qc) {
                 return _state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-qc-payload");
             }
+            const llmq::CFinalCommitmentTxPayload& qc = *opt_qc;
             if (!qc.commitment.IsNull()) {
                 const auto& llmq_params_opt = llmq::GetLLMQParams(qc.commitment.llmqType);
                 if (!llmq_params_opt.has_value()) {
@@ -1068,36 +1107,38 @@ void CDeterministicMNManager::HandleQuorumCommitment(const llmq::CFinalCommitmen
 
     auto members = llmq::utils::GetAllQuorumMembers(qc.llmqType, pQuorumBaseBlockIndex);
 
+    // punish MNs for failed DKG participation
+    // The idea is to immediately ban a MN when it fails 2 DKG sessions with only a few blocks in-between
+    // If there were enough blocks between failures, the MN has a chance to recover as he reduces his penalty by 1 for every block
+    // If it however fails 3 times in the timespan of a single payment cycle, it should definitely get banned
+    // Collected and applied as one batch: failed quorums punish many MNs at once and this runs inside ConnectBlock
+    std::vector<std::pair<uint256, int>> penalties;
+    const int penalty = mnList.CalcPenalty(66);
     for (size_t i = 0; i < members.size(); i++) {
         if (!mnList.HasMN(members[i]->proTxHash)) {
             continue;
         }
         if (!qc.validMembers[i]) {
-            // punish MN for failed DKG participation
-            // The idea is to immediately ban a MN when it fails 2 DKG sessions with only a few blocks in-between
-            // If there were enough blocks between failures, the MN has a chance to recover as he reduces his penalty by 1 for every block
-            // If it however fails 3 times in the timespan of a single payment cycle, it should definitely get banned
-            mnList.PoSePunish(members[i]->proTxHash, mnList.CalcPenalty(66), debugLogs);
+            penalties.emplace_back(members[i]->proTxHash, penalty);
         }
     }
+    mnList.ApplyPoSeChanges(penalties, debugLogs);
 }
 
 void CDeterministicMNManager::DecreasePoSePenalties(CDeterministicMNList& mnList)
 {
-    std::vector<uint256> toDecrease;
+    std::vector<std::pair<uint256, int>> toDecrease;
     toDecrease.reserve(mnList.GetAllMNsCount() / 10);
     // only iterate and decrease for valid ones (not PoSe banned yet)
     // if a MN ever reaches the maximum, it stays in PoSe banned state until revived
     mnList.ForEachMN(true /* onlyValid */, [&](auto& dmn) {
         // There is no reason to check if this MN is banned here since onlyValid=true will only run on non-banned MNs
         if (dmn.pdmnState->nPoSePenalty > 0) {
-            toDecrease.emplace_back(dmn.proTxHash);
+            toDecrease.emplace_back(dmn.proTxHash, -1);
         }
     });
 
-    for (const auto& proTxHash : toDecrease) {
-        mnList.PoSeDecrease(proTxHash);
-    }
+    mnList.ApplyPoSeChanges(toDecrease, false);
 }
 
 CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex* pindex)
@@ -1115,6 +1156,10 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex*
             break;
         }
 
+        if (mnListsHistoricalCache.get(pindex->GetBlockHash(), snapshot)) {
+            break;
+        }
+
         if (m_evoDb.Read(std::make_pair(DB_LIST_SNAPSHOT, pindex->GetBlockHash()), snapshot)) {
             mnListsCache.emplace(pindex->GetBlockHash(), snapshot);
             break;
@@ -1150,6 +1195,15 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex*
             snapshot.SetBlockHash(diffIndex->GetBlockHash());
             snapshot.SetHeight(diffIndex->nHeight);
         }
+        // Leave stepping stones behind so that later queries into this range replay at most
+        // HISTORICAL_SNAPSHOT_INTERVAL diffs (lists are copy-on-write, so the copies are cheap)
+        if ((diffIndex->nHeight % HISTORICAL_SNAPSHOT_INTERVAL) == 0) {
+            mnListsHistoricalCache.insert(diffIndex->GetBlockHash(), snapshot);
+        }
+    }
+
+    if (!listDiffIndexes.empty()) {
+        mnListsHistoricalCache.insert(snapshot.GetBlockHash(), snapshot);
     }
 
     if (tipIndex) {
@@ -16,6 +16,7 @@
 #include <saltedhasher.h>
 #include <scheduler.h>
 #include <sync.h>
+#include <unordered_lru_cache.h>
 
 #include <immer/map.hpp>
 
@@ -381,6 +382,17 @@ public:
      */
     void PoSeDecrease(const uint256& proTxHash);
 
+    /**
+     * Applies a batch of PoSe penalty changes in one pass. A positive delta punishes with the
+     * same banning semantics as PoSePunish, a negative delta decreases the penalty score.
+     * PoSe changes never touch any unique property, so this path skips the unique property
+     * bookkeeping of UpdateMN and computes the max penalty only once. Prefer this over
+     * per-MN calls when many MNs are affected at once (e.g. failed DKG sessions), as it
+     * runs inside ConnectBlock.
+     * @param deltas
+     */
+    void ApplyPoSeChanges(const std::vector<std::pair<uint256, int>>& deltas, bool debugLogs);
+
     [[nodiscard]] CDeterministicMNListDiff BuildDiff(const CDeterministicMNList& to) const;
     [[nodiscard]] CSimplifiedMNListDiff BuildSimplifiedDiff(const CDeterministicMNList& to, bool extended) const;
     [[nodiscard]] CDeterministicMNList ApplyDiff(const CBlockIndex* pindex, const CDeterministicMNListDiff& diff) const;
@@ -539,6 +551,11 @@ class CDeterministicMNManager
     static constexpr int DISK_SNAPSHOT_PERIOD = 576; // once per day
     static constexpr int DISK_SNAPSHOTS = 3; // keep cache for 3 disk snapshots to have 2 full days covered
     static constexpr int LIST_DIFFS_CACHE_SIZE = DISK_SNAPSHOT_PERIOD * DISK_SNAPSHOTS;
+    // While replaying diffs for a historical query, materialized lists are additionally cached at
+    // this interval, so that later queries into the same range stop after at most this many diff
+    // applications instead of replaying from the last disk snapshot every time
+    static constexpr int HISTORICAL_SNAPSHOT_INTERVAL = 64;
+    static constexpr size_t HISTORICAL_LISTS_CACHE_SIZE = 32;
 
 public:
     CCriticalSection cs;
@@ -556,6 +573,10 @@ private:
 
     std::unordered_map<uint256, CDeterministicMNList, StaticSaltedHasher> mnListsCache GUARDED_BY(cs);
     std::unordered_map<uint256, CDeterministicMNListDiff, StaticSaltedHasher> mnListDiffsCache GUARDED_BY(cs);
+    // Bounded LRU of materialized historical lists fed by GetListForBlock replays. Unlike
+    // mnListsCache this may hold lists far behind the tip (explorer style protx listdiff scans)
+    // without growing with scan depth.
+    unordered_lru_cache<uint256, CDeterministicMNList, StaticSaltedHasher> mnListsHistoricalCache GUARDED_BY(cs) {HISTORICAL_LISTS_CACHE_SIZE};
     const CBlockIndex* tipIndex GUARDED_BY(cs) {nullptr};
 
 public:
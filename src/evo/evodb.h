@@ -30,6 +30,16 @@ public:
     void Rollback();
 };
 
+/** Transaction-capable wrapper around the evo LevelDB instance.
+ *
+ * State is layered: curDBTransaction collects the changes of the block being
+ * processed right now and is dropped in O(changed keys) if the block fails
+ * (see CEvoDBScopedCommitter), while rootDBTransaction accumulates all
+ * committed-but-unflushed blocks and only hits disk in CommitRootTransaction.
+ * That flush is deliberately synchronous with the coins flush in
+ * FlushStateToDisk: the best block hash stored here is how startup detects a
+ * torn state between evodb and the coins database.
+ */
 class CEvoDB
 {
 public:
@@ -17,8 +17,42 @@
 #include <netmessagemaker.h>
 #include <validation.h>
 
+#include <map>
 #include <unordered_set>
 
+/** How long a successful MNAUTH verification is remembered per (proTxHash, operator key).
+ *  Matches the re-probe backoff in llmq::utils::AddQuorumProbeConnections, so that repeat
+ *  probes of the same masternode within one probe window don't redo the BLS pairing. */
+static constexpr int64_t MNAUTH_SESSION_CACHE_SECONDS{10 * 60};
+
+static Mutex cs_mnauth_session_cache;
+//! (proTxHash, pubKeyOperator hash) -> time of last successful MNAUTH verification.
+//! Keyed on the operator key hash so that operator key rotations invalidate entries
+//! naturally, same as NotifyMasternodeListChanged does for live connections.
+static std::map<std::pair<uint256, uint256>, int64_t> mnauthSessionCache GUARDED_BY(cs_mnauth_session_cache);
+
+static bool HasRecentMNAuthSession(const uint256& proTxHash, const uint256& pubKeyHash)
+{
+    LOCK(cs_mnauth_session_cache);
+    const auto it = mnauthSessionCache.find(std::make_pair(proTxHash, pubKeyHash));
+    return it != mnauthSessionCache.end() && GetAdjustedTime() - it->second < MNAUTH_SESSION_CACHE_SECONDS;
+}
+
+static void RememberMNAuthSession(const uint256& proTxHash, const uint256& pubKeyHash)
+{
+    LOCK(cs_mnauth_session_cache);
+    const auto now = GetAdjustedTime();
+    // opportunistically drop expired entries to keep the map tiny
+    for (auto it = mnauthSessionCache.begin(); it != mnauthSessionCache.end();) {
+        if (now - it->second >= MNAUTH_SESSION_CACHE_SECONDS) {
+            it = mnauthSessionCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    mnauthSessionCache[std::make_pair(proTxHash, pubKeyHash)] = now;
+}
+
 void CMNAuth::PushMNAUTH(CNode& peer, CConnman& connman, const CBlockIndex* tip)
 {
     LOCK(activeMasternodeInfoCs);
@@ -106,6 +140,19 @@ void CMNAuth::ProcessMessage(CNode& peer, CConnman& connman, std::string_view ms
         return;
     }
 
+    if (peer.m_masternode_probe_connection && HasRecentMNAuthSession(mnauth.proRegTxHash, dmn->pdmnState->pubKeyOperator.GetHash())) {
+        // Probe connections are outbound to the masternode's registered service, are dropped
+        // right after MNAUTH and grant no relay privileges; their only effect is the liveness
+        // timestamp. If this masternode proved ownership of the same operator key within the
+        // probe window already, skip the BLS pairing - quorum rotation probes the same
+        // masternodes once per quorum type in quick succession.
+        LogPrint(BCLog::NET_NETCONN, "CMNAuth::ProcessMessage -- Masternode probe successful for %s (cached session), disconnecting. peer=%d\n",
+                 mnauth.proRegTxHash.ToString(), peer.GetId());
+        mmetaman.GetMetaInfo(mnauth.proRegTxHash)->SetLastOutboundSuccess(GetAdjustedTime());
+        peer.fDisconnect = true;
+        return;
+    }
+
     uint256 signHash;
     int nOurNodeVersion{PROTOCOL_VERSION};
     if (Params().NetworkIDString() != CBaseChainParams::MAIN && gArgs.IsArgSet("-pushversion")) {
@@ -130,6 +177,8 @@ void CMNAuth::ProcessMessage(CNode& peer, CConnman& connman, std::string_view ms
         return;
     }
 
+    RememberMNAuthSession(mnauth.proRegTxHash, dmn->pdmnState->pubKeyOperator.GetHash());
+
     if (!peer.fInbound) {
         mmetaman.GetMetaInfo(mnauth.proRegTxHash)->SetLastOutboundSuccess(GetAdjustedTime());
         if (peer.m_masternode_probe_connection) {
@@ -18,7 +18,10 @@
 #include <base58.h>
 #include <chainparams.h>
 #include <consensus/merkle.h>
+#include <saltedhasher.h>
+#include <sync.h>
 #include <univalue.h>
+#include <unordered_lru_cache.h>
 #include <validation.h>
 #include <key_io.h>
 #include <util/underlying.h>
@@ -235,6 +238,22 @@ void CSimplifiedMNListDiff::ToJson(UniValue& obj, bool extended) const
     }
 }
 
+// Cache of recently built diffs. Light clients sync against the same (baseBlock, tip) pair,
+// so the same diff is typically requested many times per block. The content of a diff is
+// fully determined by the key (reorgs don't change what a diff between two given blocks
+// looks like), so entries never go stale and plain LRU eviction is enough.
+static Mutex cs_mnListDiffCache;
+static unordered_lru_cache<uint256, CSimplifiedMNListDiff, StaticSaltedHasher, 32> mnListDiffCache GUARDED_BY(cs_mnListDiffCache);
+
+static uint256 GetMNListDiffCacheKey(const uint256& baseBlockHash, const uint256& blockHash, bool extended)
+{
+    CHashWriter hw(SER_GETHASH, 0);
+    hw << baseBlockHash;
+    hw << blockHash;
+    hw << extended;
+    return hw.GetHash();
+}
+
 bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet,
                                const llmq::CQuorumBlockProcessor& quorum_block_processor, std::string& errorRet, bool extended)
 {
@@ -265,6 +284,14 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
         return false;
     }
 
+    const uint256 cacheKey = GetMNListDiffCacheKey(baseBlockHash, blockHash, extended);
+    {
+        LOCK(cs_mnListDiffCache);
+        if (mnListDiffCache.get(cacheKey, mnListDiffRet)) {
+            return true;
+        }
+    }
+
     LOCK(deterministicMNManager->cs);
 
     auto baseDmnList = deterministicMNManager->GetListForBlock(baseBlockIndex);
@@ -298,5 +325,8 @@ bool BuildSimplifiedMNListDiff(const uint256& baseBlockHash, const uint256& bloc
     vMatch[0] = true; // only coinbase matches
     mnListDiffRet.cbTxMerkleTree = CPartialMerkleTree(vHashes, vMatch);
 
+    LOCK(cs_mnListDiffCache);
+    mnListDiffCache.insert(cacheKey, mnListDiffRet);
+
     return true;
 }
@@ -7,11 +7,15 @@
 
 #include <consensus/validation.h>
 #include <primitives/transaction.h>
+#include <saltedhasher.h>
 #include <serialize.h>
 #include <streams.h>
+#include <sync.h>
 #include <uint256.h>
+#include <unordered_lru_cache.h>
 #include <version.h>
 
+#include <memory>
 #include <string_view>
 #include <vector>
 
@@ -48,6 +52,43 @@ inline bool GetTxPayload(const CTransaction& tx, T& obj, bool assert_type = true
     return tx.nType == obj.SPECIALTX_TYPE && GetTxPayload(tx.vExtraPayload, obj);
 }
 
+//! How many deserialized payloads to keep per payload type
+static constexpr size_t SPECIALTX_PAYLOAD_CACHE_SIZE{512};
+
+/**
+ * Like GetTxPayload, but memoizes successfully deserialized payloads in a
+ * small per-type LRU cache keyed by tx hash. The same payload is typically
+ * parsed several times over a tx lifetime (mempool acceptance, block
+ * validation, masternode list building); all but the first parse become a
+ * map lookup. Failed parses are not cached. The returned payload is shared
+ * and must not be modified. Returns nullptr if the payload does not
+ * deserialize or the tx type does not match.
+ */
+template <typename T>
+std::shared_ptr<const T> GetTxPayloadCached(const CTransaction& tx)
+{
+    static Mutex cs;
+    static unordered_lru_cache<uint256, std::shared_ptr<const T>, StaticSaltedHasher, SPECIALTX_PAYLOAD_CACHE_SIZE> cache GUARDED_BY(cs);
+
+    const uint256& txHash = tx.GetHash();
+    {
+        LOCK(cs);
+        std::shared_ptr<const T> ret;
+        if (cache.get(txHash, ret)) {
+            return ret;
+        }
+    }
+    // deserialize outside the lock
+    auto obj = std::make_shared<T>();
+    if (!GetTxPayload(tx, *obj)) {
+        return nullptr;
+    }
+    std::shared_ptr<const T> ret = std::move(obj);
+    LOCK(cs);
+    cache.insert(txHash, ret);
+    return ret;
+}
+
 template <typename T>
 void SetTxPayload(CMutableTransaction& tx, const T& payload)
 {
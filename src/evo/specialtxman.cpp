@@ -13,9 +13,12 @@
 #include <hash.h>
 #include <llmq/blockprocessor.h>
 #include <llmq/commitment.h>
+#include <llmq/utils.h>
 #include <primitives/block.h>
 #include <validation.h>
 
+#include <array>
+
 bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, CValidationState& state, const CCoinsViewCache& view, bool check_sigs)
 {
     AssertLockHeld(cs_main);
@@ -52,6 +55,72 @@ bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, CVali
     return state.Invalid(ValidationInvalidReason::TX_BAD_SPECIAL, false, REJECT_INVALID, "bad-tx-type-check");
 }
 
+/** Statically dispatched payload pre-check, shared by all provider tx types:
+ *  deserializes (via the payload cache) and runs the payload's trivial,
+ *  context-free validation. */
+template <typename ProTx>
+static bool PreCheckProTxPayload(const CTransaction& tx, bool is_v19_active, CValidationState& state)
+{
+    const auto ptx = GetTxPayloadCached<ProTx>(tx);
+    if (!ptx) {
+        return state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-protx-payload");
+    }
+    if (auto maybe_err = ptx->IsTriviallyValid(is_v19_active); maybe_err.did_err) {
+        return state.Invalid(maybe_err.reason, false, REJECT_INVALID, std::string(maybe_err.error_str));
+    }
+    return true;
+}
+
+static bool PreCheckSpecialTx(const CTransaction& tx, bool is_v19_active, CValidationState& state)
+{
+    if (tx.nVersion != 3 || tx.nType == TRANSACTION_NORMAL) {
+        return true;
+    }
+
+    try {
+        switch (tx.nType) {
+        case TRANSACTION_PROVIDER_REGISTER:
+            return PreCheckProTxPayload<CProRegTx>(tx, is_v19_active, state);
+        case TRANSACTION_PROVIDER_UPDATE_SERVICE:
+            return PreCheckProTxPayload<CProUpServTx>(tx, is_v19_active, state);
+        case TRANSACTION_PROVIDER_UPDATE_REGISTRAR:
+            return PreCheckProTxPayload<CProUpRegTx>(tx, is_v19_active, state);
+        case TRANSACTION_PROVIDER_UPDATE_REVOKE:
+            return PreCheckProTxPayload<CProUpRevTx>(tx, is_v19_active, state);
+        case TRANSACTION_COINBASE: {
+            if (!GetTxPayloadCached<CCbTx>(tx)) {
+                return state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-cbtx-payload");
+            }
+            return true;
+        }
+        case TRANSACTION_QUORUM_COMMITMENT: {
+            if (!GetTxPayloadCached<llmq::CFinalCommitmentTxPayload>(tx)) {
+                return state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "bad-qc-payload");
+            }
+            return true;
+        }
+        }
+    } catch (const std::exception& e) {
+        LogPrintf("%s -- failed: %s\n", __func__, e.what());
+        return state.Invalid(ValidationInvalidReason::CONSENSUS, false, REJECT_INVALID, "failed-check-special-tx");
+    }
+
+    // unknown types are left for CheckSpecialTx to reject under cs_main
+    return true;
+}
+
+bool PreCheckSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindexPrev, CValidationState& state)
+{
+    const bool is_v19_active = llmq::utils::IsV19Active(pindexPrev);
+    for (const auto& ptr_tx : block.vtx) {
+        if (!PreCheckSpecialTx(*ptr_tx, is_v19_active, state)) {
+            // pass the state returned by the function above
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ProcessSpecialTx(const CTransaction& tx, const CBlockIndex* pindex, CValidationState& state)
 {
     if (tx.nVersion != 3 || tx.nType == TRANSACTION_NORMAL) {
@@ -108,10 +177,15 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, ll
         static int64_t nTimeQuorum = 0;
         static int64_t nTimeDMN = 0;
         static int64_t nTimeMerkle = 0;
+        // cumulative check time and tx count, indexed by the TRANSACTION_* constants
+        static std::array<int64_t, 16> nTimePerType{};
+        static std::array<int64_t, 16> nCountPerType{};
 
         int64_t nTime1 = GetTimeMicros();
 
+        const bool fBenchmark = LogAcceptCategory(BCLog::BENCHMARK);
         for (const auto& ptr_tx : block.vtx) {
+            const int64_t nTimeTx = fBenchmark ? GetTimeMicros() : 0;
             if (!CheckSpecialTx(*ptr_tx, pindex->pprev, state, view, fCheckCbTxMerleRoots)) {
                 // pass the state returned by the function above
                 return false;
@@ -120,11 +194,21 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, ll
                 // pass the state returned by the function above
                 return false;
             }
+            if (fBenchmark && ptr_tx->nVersion == 3 && ptr_tx->nType != TRANSACTION_NORMAL && ptr_tx->nType < (int)nTimePerType.size()) {
+                nTimePerType[ptr_tx->nType] += GetTimeMicros() - nTimeTx;
+                nCountPerType[ptr_tx->nType]++;
+            }
         }
 
         int64_t nTime2 = GetTimeMicros();
         nTimeLoop += nTime2 - nTime1;
         LogPrint(BCLog::BENCHMARK, "        - Loop: %.2fms [%.2fs]\n", 0.001 * (nTime2 - nTime1), nTimeLoop * 0.000001);
+        if (fBenchmark) {
+            for (size_t i = 0; i < nCountPerType.size(); i++) {
+                if (nCountPerType[i] == 0) continue;
+                LogPrint(BCLog::BENCHMARK, "          - special tx type %d: %d txs [%.2fs]\n", i, nCountPerType[i], nTimePerType[i] * 0.000001);
+            }
+        }
 
         if (!quorum_block_processor.ProcessBlock(block, pindex, state, fJustCheck, fCheckCbTxMerleRoots)) {
             // pass the state returned by the function above
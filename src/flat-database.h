@@ -43,6 +43,11 @@ private:
 
         // serialize, checksum data up to that point, then append checksum
         CDataStream ssObj(SER_DISK, CLIENT_VERSION);
+        // size the stream exactly up front; large snapshots (e.g. the mn list)
+        // would otherwise reallocate repeatedly while growing
+        CSizeComputer sc(SER_DISK, CLIENT_VERSION);
+        sc << strMagicMessage << Params().MessageStart() << objToSave;
+        ssObj.reserve(sc.size() + sizeof(uint256));
         ssObj << strMagicMessage; // specific magic message for this type of object
         ssObj << Params().MessageStart(); // network specific magic number
         ssObj << objToSave;
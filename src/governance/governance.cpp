@@ -8,7 +8,9 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <consensus/validation.h>
+#include <dbwrapper.h>
 #include <evo/deterministicmns.h>
+#include <flat-database.h>
 #include <governance/classes.h>
 #include <governance/validators.h>
 #include <masternode/meta.h>
@@ -23,6 +25,13 @@
 
 std::unique_ptr<CGovernanceManager> governance;
 
+static const char DB_GOVERNANCE_OBJECT = 'O';
+static const char DB_GOVERNANCE_AUX = 'A';
+static const char DB_GOVERNANCE_VERSION = 'V';
+
+//! Database cache size for the governance db, it only has to cover the write batches
+static const size_t GOVERNANCE_DB_CACHE_SIZE = 1 << 22; // 4 MiB
+
 int nSubmittedFinalBudget;
 
 const std::string CGovernanceManager::SERIALIZATION_VERSION_STRING = "CGovernanceManager-Version-16";
@@ -45,6 +54,112 @@ CGovernanceManager::CGovernanceManager() :
 {
 }
 
+CGovernanceManager::~CGovernanceManager() = default;
+
+bool CGovernanceManager::LoadDatabase(bool fWipe)
+{
+    // governance objects and vote lists are text-heavy and compress well
+    const CDBWrapperOptions db_options{/*bloom_filter_bits=*/10, /*compression=*/true};
+    m_db = std::make_unique<CDBWrapper>(GetDataDir() / "governance", GOVERNANCE_DB_CACHE_SIZE, false, fWipe, false, db_options);
+
+    std::string strVersion;
+    bool fHasVersion = m_db->Read(DB_GOVERNANCE_VERSION, strVersion);
+    if (fHasVersion && strVersion != SERIALIZATION_VERSION_STRING) {
+        // governance state can always be re-synced from the network, so just start over
+        LogPrintf("CGovernanceManager::%s -- governance db has incompatible version, wiping\n", __func__);
+        m_db = std::make_unique<CDBWrapper>(GetDataDir() / "governance", GOVERNANCE_DB_CACHE_SIZE, false, /*fWipe=*/true, false, db_options);
+        fHasVersion = false;
+    }
+
+    if (!fHasVersion) {
+        m_db->Write(DB_GOVERNANCE_VERSION, SERIALIZATION_VERSION_STRING);
+        if (!fWipe) {
+            // One-time migration from the legacy monolithic governance.dat. The file is
+            // left in place but never read again since the version key is now set.
+            CFlatDB<CGovernanceManager> flatdb("governance.dat", "magicGovernanceCache");
+            if (!flatdb.Load(*this)) {
+                return false;
+            }
+            {
+                LOCK(cs);
+                for (const auto& objPair : mapObjects) {
+                    setDirtyObjects.insert(objPair.first);
+                }
+            }
+            FlushDatabase(/*fForce=*/true);
+            LogPrintf("CGovernanceManager::%s -- migrated %s to the governance db\n", __func__, ToString());
+        }
+        return true;
+    }
+
+    int64_t nStart = GetTimeMillis();
+
+    LOCK(cs);
+    Clear();
+
+    // The auxiliary records may be missing, e.g. right after a migration crashdown,
+    // they are all safe to start from scratch
+    m_db->Read(std::make_pair(DB_GOVERNANCE_AUX, 'e'), mapErasedGovernanceObjects);
+    m_db->Read(std::make_pair(DB_GOVERNANCE_AUX, 'i'), cmapInvalidVotes);
+    m_db->Read(std::make_pair(DB_GOVERNANCE_AUX, 'o'), cmmapOrphanVotes);
+    m_db->Read(std::make_pair(DB_GOVERNANCE_AUX, 'l'), mapLastMasternodeObject);
+    m_db->Read(std::make_pair(DB_GOVERNANCE_AUX, 'm'), *lastMNListForVotingKeys);
+
+    std::unique_ptr<CDBIterator> it(m_db->NewIterator());
+    it->Seek(std::make_pair(DB_GOVERNANCE_OBJECT, uint256()));
+    while (it->Valid()) {
+        std::pair<char, uint256> curKey;
+        if (!it->GetKey(curKey) || curKey.first != DB_GOVERNANCE_OBJECT) {
+            break;
+        }
+        CGovernanceObject govobj;
+        if (!it->GetValue(govobj)) {
+            return error("CGovernanceManager::%s -- unable to read governance object %s", __func__, curKey.second.ToString());
+        }
+        mapObjects.emplace(curKey.second, std::move(govobj));
+        it->Next();
+    }
+
+    LogPrintf("CGovernanceManager::%s -- %s  %dms\n", __func__, ToString(), GetTimeMillis() - nStart);
+    return true;
+}
+
+void CGovernanceManager::FlushDatabase(bool fForce)
+{
+    if (m_db == nullptr) return;
+
+    int64_t nStart = GetTimeMillis();
+    CDBBatch batch(*m_db);
+    size_t nDirty{0};
+
+    {
+        LOCK(cs);
+        if (setDirtyObjects.empty() && !fForce) return;
+
+        for (const uint256& nHash : setDirtyObjects) {
+            auto it = mapObjects.find(nHash);
+            if (it != mapObjects.end()) {
+                batch.Write(std::make_pair(DB_GOVERNANCE_OBJECT, nHash), it->second);
+            } else {
+                batch.Erase(std::make_pair(DB_GOVERNANCE_OBJECT, nHash));
+            }
+            ++nDirty;
+        }
+        setDirtyObjects.clear();
+
+        // The auxiliary maps are small compared to the objects and their vote files,
+        // just rewrite them on every flush
+        batch.Write(std::make_pair(DB_GOVERNANCE_AUX, 'e'), mapErasedGovernanceObjects);
+        batch.Write(std::make_pair(DB_GOVERNANCE_AUX, 'i'), cmapInvalidVotes);
+        batch.Write(std::make_pair(DB_GOVERNANCE_AUX, 'o'), cmmapOrphanVotes);
+        batch.Write(std::make_pair(DB_GOVERNANCE_AUX, 'l'), mapLastMasternodeObject);
+        batch.Write(std::make_pair(DB_GOVERNANCE_AUX, 'm'), *lastMNListForVotingKeys);
+    }
+
+    m_db->WriteBatch(batch);
+    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- wrote %d dirty objects  %dms\n", __func__, nDirty, GetTimeMillis() - nStart);
+}
+
 // Accessors for thread-safe access to maps
 bool CGovernanceManager::HaveObjectForHash(const uint256& nHash) const
 {
@@ -107,7 +222,7 @@ void CGovernanceManager::ProcessMessage(CNode& peer, CConnman& connman, std::str
         vRecv >> filter;
 
         if (nProp == uint256()) {
-            SyncObjects(peer, connman);
+            SyncObjects(peer, filter, connman);
         } else {
             SyncSingleObjVotes(peer, nProp, filter, connman);
         }
@@ -282,6 +397,8 @@ void CGovernanceManager::AddGovernanceObject(CGovernanceObject& govobj, CConnman
         return;
     }
 
+    setDirtyObjects.insert(nHash);
+
     // SHOULD WE ADD THIS OBJECT TO ANY OTHER MANAGERS?
 
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::AddGovernanceObject -- Before trigger block, GetDataAsPlainString = %s, nObjectType = %d\n",
@@ -326,6 +443,7 @@ void CGovernanceManager::UpdateCachesAndClean()
             continue;
         }
         it->second.ClearMasternodeVotes();
+        setDirtyObjects.insert(nHash);
     }
 
     ScopedLockBool guard(cs, fRateChecksEnabled, false);
@@ -354,6 +472,8 @@ void CGovernanceManager::UpdateCachesAndClean()
 
             // UPDATE SENTINEL SIGNALING VARIABLES
             pObj->UpdateSentinelVariables();
+
+            setDirtyObjects.insert(nHash);
         }
 
         // IF DELETE=TRUE, THEN CLEAN THE MESS UP!
@@ -392,15 +512,17 @@ void CGovernanceManager::UpdateCachesAndClean()
             }
 
             mapErasedGovernanceObjects.insert(std::make_pair(nHash, nTimeExpired));
+            setDirtyObjects.insert(nHash);
             mapObjects.erase(it++);
         } else {
             // NOTE: triggers are handled via triggerman
             if (pObj->GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL) {
                 bool fAllowScript = (VersionBitsTipState(Params().GetConsensus(), Consensus::DEPLOYMENT_DIP0024) == ThresholdState::ACTIVE);
-                CProposalValidator validator(pObj->GetDataAsHexString(), fAllowScript);
+                CProposalValidator validator(pObj->GetDataAsJson(), fAllowScript);
                 if (!validator.Validate()) {
                     LogPrint(BCLog::GOBJECT, "CGovernanceManager::UpdateCachesAndClean -- set for deletion expired obj %s\n", strHash);
                     pObj->PrepareDeletion(nNow);
+                    setDirtyObjects.insert(nHash);
                 }
             }
             ++it;
@@ -617,7 +739,7 @@ void CGovernanceManager::SyncSingleObjVotes(CNode& peer, const uint256& nProp, c
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- sent %d votes to peer=%d\n", __func__, nVoteCount, peer.GetId());
 }
 
-void CGovernanceManager::SyncObjects(CNode& peer, CConnman& connman) const
+void CGovernanceManager::SyncObjects(CNode& peer, const CBloomFilter& filter, CConnman& connman) const
 {
     // do not provide any data until our node is synced
     if (!::masternodeSync->IsSynced()) return;
@@ -639,6 +761,11 @@ void CGovernanceManager::SyncObjects(CNode& peer, CConnman& connman) const
 
     bool fAllowScript = WITH_LOCK(cs_main, return VersionBitsTipState(Params().GetConsensus(), Consensus::DEPLOYMENT_DIP0024) == ThresholdState::ACTIVE);
 
+    // An empty filter (older peers, fresh nodes) means "sync everything";
+    // contains() on an empty filter matches everything, hence the guard.
+    const bool fUseFilter = !filter.IsEmpty() && filter.IsWithinSizeConstraints();
+    int nObjSkipped = 0;
+
     LOCK(cs);
 
     // all valid objects, no votes
@@ -655,11 +782,17 @@ void CGovernanceManager::SyncObjects(CNode& peer, CConnman& connman) const
             continue;
         }
 
+        if (fUseFilter && filter.contains(nHash)) {
+            // The peer told us it already has this object
+            ++nObjSkipped;
+            continue;
+        }
+
         if (fAllowScript && peer.nVersion < GOVSCRIPT_PROTO_VERSION && govobj.GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL) {
             // We know this proposal is valid locally, otherwise we would not store it.
             // But we don't want to relay it to pre-GOVSCRIPT_PROTO_VERSION peers if payment_address is p2sh
             // because they won't accept it anyway and will simply ban us eventually.
-            CProposalValidator validator(govobj.GetDataAsHexString(), false /* no script */);
+            CProposalValidator validator(govobj.GetDataAsJson(), false /* no script */);
             if (!validator.Validate(false /* ignore expiration */)) {
                 // The only way we could get here is when proposal is valid but payment_address is actually p2sh.
                 LogPrintf("CGovernanceManager::%s -- not syncing p2sh govobj to older node: %s, peer=%d\n", __func__,
@@ -676,7 +809,23 @@ void CGovernanceManager::SyncObjects(CNode& peer, CConnman& connman) const
 
     CNetMsgMaker msgMaker(peer.GetSendVersion());
     connman.PushMessage(&peer, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ, nObjCount));
-    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- sent %d objects to peer=%d\n", __func__, nObjCount, peer.GetId());
+    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- sent %d objects (%d filtered out as already known) to peer=%d\n", __func__, nObjCount, nObjSkipped, peer.GetId());
+}
+
+CBloomFilter CGovernanceManager::GetSyncObjectFilter() const
+{
+    LOCK(cs);
+    if (mapObjects.empty()) {
+        // An empty filter means "sync everything", which is also what a node
+        // with no objects wants.
+        return CBloomFilter();
+    }
+    CBloomFilter filter(std::max<unsigned int>(mapObjects.size(), Params().GetConsensus().nGovernanceFilterElements),
+                        GOVERNANCE_FILTER_FP_RATE, GetRandInt(999999), BLOOM_UPDATE_ALL);
+    for (const auto& objPair : mapObjects) {
+        filter.insert(objPair.first);
+    }
+    return filter;
 }
 
 void CGovernanceManager::MasternodeRateUpdate(const CGovernanceObject& govobj)
@@ -824,6 +973,9 @@ bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote,
     }
 
     bool fOk = govobj.ProcessVote(vote, exception) && cmapVoteToObject.Insert(nHashVote, &govobj);
+    if (fOk) {
+        setDirtyObjects.insert(nHashGovobj);
+    }
     LEAVE_CRITICAL_SECTION(cs)
     return fOk;
 }
@@ -1264,6 +1416,7 @@ void CGovernanceManager::RemoveInvalidVotes()
             if (removed.empty()) {
                 continue;
             }
+            setDirtyObjects.insert(p.first);
             for (auto& voteHash : removed) {
                 cmapVoteToObject.Erase(voteHash);
                 cmapInvalidVotes.Erase(voteHash);
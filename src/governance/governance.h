@@ -11,6 +11,7 @@
 
 class CBloomFilter;
 class CBlockIndex;
+class CDBWrapper;
 class CInv;
 
 class CGovernanceManager;
@@ -195,6 +196,14 @@ private:
     // used to check for changed voting keys
     CDeterministicMNListPtr lastMNListForVotingKeys;
 
+    // incremental on-disk store, objects (with their votes) are keyed individually
+    // so that a flush only has to rewrite what actually changed
+    std::unique_ptr<CDBWrapper> m_db;
+
+    // hashes of objects whose state or votes changed since the last flush; a hash
+    // with no matching map entry means the object was erased
+    hash_s_t setDirtyObjects GUARDED_BY(cs);
+
     class ScopedLockBool
     {
         bool& ref;
@@ -221,7 +230,8 @@ public:
 
     CGovernanceManager();
 
-    virtual ~CGovernanceManager() = default;
+    // defined in the .cpp file, where CDBWrapper is a complete type
+    virtual ~CGovernanceManager();
 
     /**
      * This is called by AlreadyHave in net_processing.cpp as part of the inventory
@@ -231,7 +241,12 @@ public:
     bool ConfirmInventoryRequest(const CInv& inv);
 
     void SyncSingleObjVotes(CNode& peer, const uint256& nProp, const CBloomFilter& filter, CConnman& connman);
-    void SyncObjects(CNode& peer, CConnman& connman) const;
+    /** Sync all objects the peer does not already have, as indicated by the
+     * filter over its known object hashes. An empty filter syncs everything. */
+    void SyncObjects(CNode& peer, const CBloomFilter& filter, CConnman& connman) const;
+    /** Filter over our own object hashes, sent along with a full governance
+     * sync request so the peer only announces objects we are missing. */
+    CBloomFilter GetSyncObjectFilter() const;
 
     void ProcessMessage(CNode& peer, CConnman& connman, std::string_view msg_type, CDataStream& vRecv);
 
@@ -346,6 +361,14 @@ public:
 
     void InitOnLoad();
 
+    /** Open the incremental governance database and load all objects and votes from it.
+     *  Migrates from the legacy monolithic governance.dat on first run. */
+    bool LoadDatabase(bool fWipe);
+
+    /** Write objects which changed since the last flush (and the small auxiliary maps)
+     *  to the database. A no-op when nothing is dirty unless fForce is set. */
+    void FlushDatabase(bool fForce = false);
+
     int RequestGovernanceObjectVotes(CNode& peer, CConnman& connman);
     int RequestGovernanceObjectVotes(const std::vector<CNode*>& vNodesCopy, CConnman& connman);
 
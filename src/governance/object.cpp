@@ -212,6 +212,7 @@ bool CGovernanceObject::ProcessVote(const CGovernanceVote& vote, CGovernanceExce
     voteInstanceRef = vote_instance_t(vote.GetOutcome(), nVoteTimeUpdate, vote.GetTimestamp());
     fileVotes.AddVote(vote);
     fDirtyCache = true;
+    mapVoteCountCache.clear();
     // SEND NOTIFICATION TO SCRIPT/ZMQ
     GetMainSignals().NotifyGovernanceVote(std::make_shared<const CGovernanceVote>(vote));
     return true;
@@ -229,6 +230,7 @@ void CGovernanceObject::ClearMasternodeVotes()
             fileVotes.RemoveVotesFromMasternode(it->first);
             mapCurrentMNVotes.erase(it++);
             fDirtyCache = true;
+            mapVoteCountCache.clear();
         } else {
             ++it;
         }
@@ -270,6 +272,7 @@ std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const COutPoint& mnOutpo
     }
     LogPrintf("CGovernanceObject::%s -- Removed %d invalid votes for %s from MN %s:\n%s", __func__, removedVotes.size(), nParentHash.ToString(), mnOutpoint.ToString(), removedStr); /* Continued */
     fDirtyCache = true;
+    mapVoteCountCache.clear();
 
     return removedVotes;
 }
@@ -420,6 +423,19 @@ std::string CGovernanceObject::GetDataAsPlainString() const
     return std::string(vchData.begin(), vchData.end());
 }
 
+std::shared_ptr<const UniValue> CGovernanceObject::GetDataAsJson() const
+{
+    LOCK(cs);
+    if (!fDataJSONParsed) {
+        fDataJSONParsed = true;
+        UniValue obj(UniValue::VOBJ);
+        if (obj.read(GetDataAsPlainString()) && obj.isObject()) {
+            cachedDataJSON = std::make_shared<const UniValue>(std::move(obj));
+        }
+    }
+    return cachedDataJSON;
+}
+
 UniValue CGovernanceObject::ToJson() const
 {
     UniValue obj(UniValue::VOBJ);
@@ -470,7 +486,7 @@ bool CGovernanceObject::IsValidLocally(std::string& strError, bool& fMissingConf
     switch (nObjectType) {
     case GOVERNANCE_OBJECT_PROPOSAL: {
         bool fAllowScript = (VersionBitsTipState(Params().GetConsensus(), Consensus::DEPLOYMENT_DIP0024) == ThresholdState::ACTIVE);
-        CProposalValidator validator(GetDataAsHexString(), fAllowScript);
+        CProposalValidator validator(GetDataAsJson(), fAllowScript);
         // Note: It's ok to have expired proposals
         // they are going to be cleared by CGovernanceManager::UpdateCachesAndClean()
         // TODO: should they be tagged as "expired" to skip vote downloading?
@@ -623,6 +639,16 @@ int CGovernanceObject::CountMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote
 
     LOCK(cs);
 
+    const auto cacheKey = std::make_pair(int(eVoteSignalIn), int(eVoteOutcomeIn));
+    if (nVoteCountCacheHeight == mnList.GetHeight()) {
+        if (auto it = mapVoteCountCache.find(cacheKey); it != mapVoteCountCache.end()) {
+            return it->second;
+        }
+    } else {
+        mapVoteCountCache.clear();
+        nVoteCountCacheHeight = mnList.GetHeight();
+    }
+
     int nCount = 0;
     for (const auto& votepair : mapCurrentMNVotes) {
         const vote_rec_t& recVote = votepair.second;
@@ -634,6 +660,7 @@ int CGovernanceObject::CountMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote
             if (dmn != nullptr) nCount += GetMnType(dmn->nType).voting_weight;
         }
     }
+    mapVoteCountCache.emplace(cacheKey, nCount);
     return nCount;
 }
 
@@ -694,7 +721,7 @@ void CGovernanceObject::Relay(CConnman& connman) const
         LOCK(cs_main);
         bool fAllowScript = (VersionBitsTipState(Params().GetConsensus(), Consensus::DEPLOYMENT_DIP0024) == ThresholdState::ACTIVE);
         if (fAllowScript) {
-            CProposalValidator validator(GetDataAsHexString(), false /* no script */);
+            CProposalValidator validator(GetDataAsJson(), false /* no script */);
             if (!validator.Validate(false /* ignore expiration */)) {
                 // The only way we could get here is when proposal is valid but payment_address is actually p2sh.
                 LogPrint(BCLog::GOBJECT, "CGovernanceObject::Relay -- won't relay %s to older peers\n", GetHash().ToString());
@@ -119,6 +119,27 @@ private:
     /// Data field - can be used for anything
     std::vector<unsigned char> vchData;
 
+    /// Lazily parsed copy of vchData, shared by all validation runs so that
+    /// maintenance doesn't hex+JSON decode the same payload over and over.
+    /// Holds nullptr (once fDataJSONParsed is set) if the payload is not a JSON object.
+    mutable std::shared_ptr<const UniValue> cachedDataJSON GUARDED_BY(cs);
+    mutable bool fDataJSONParsed GUARDED_BY(cs){false};
+
+    /** Memoized CountMatchingVotes tallies, keyed by (vote signal, outcome).
+     *  Only valid for a single MN list height (vote weights depend on MN
+     *  types) and cleared whenever votes change; trigger evaluation would
+     *  otherwise re-count the same tallies several times per block around
+     *  superblock time. */
+    mutable std::map<std::pair<int, int>, int> mapVoteCountCache GUARDED_BY(cs);
+    mutable int nVoteCountCacheHeight GUARDED_BY(cs){-1};
+
+    void ClearDataJSONCache() const
+    {
+        LOCK(cs);
+        cachedDataJSON.reset();
+        fDataJSONParsed = false;
+    }
+
     /// Masternode info for signed objects
     COutPoint masternodeOutpoint;
     std::vector<unsigned char> vchSig;
@@ -284,6 +305,11 @@ public:
     std::string GetDataAsHexString() const;
     std::string GetDataAsPlainString() const;
 
+    /** Parsed payload, cached after the first call (vchData is immutable
+     *  between deserializations). Returns nullptr if the payload is not a
+     *  valid JSON object. */
+    std::shared_ptr<const UniValue> GetDataAsJson() const;
+
     // SERIALIZER
 
     SERIALIZE_METHODS(CGovernanceObject, obj)
@@ -309,6 +335,7 @@ public:
         }
 
         // AFTER DESERIALIZATION OCCURS, CACHED VARIABLES MUST BE CALCULATED MANUALLY
+        SER_READ(obj, obj.ClearDataJSONCache());
     }
 
     UniValue ToJson() const;
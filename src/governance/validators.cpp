@@ -26,6 +26,18 @@ CProposalValidator::CProposalValidator(const std::string& strHexData, bool fAllo
     }
 }
 
+CProposalValidator::CProposalValidator(const std::shared_ptr<const UniValue>& objJSONIn, bool fAllowScript) :
+    objJSON(UniValue::VOBJ),
+    fJSONValid(false),
+    fAllowScript(fAllowScript),
+    strErrorMessages()
+{
+    if (objJSONIn && objJSONIn->isObject()) {
+        objJSON = *objJSONIn;
+        fJSONValid = true;
+    }
+}
+
 void CProposalValidator::ParseStrHexData(const std::string& strHexData)
 {
     std::vector<unsigned char> v = ParseHex(strHexData);
@@ -5,6 +5,7 @@
 #ifndef BITCOIN_GOVERNANCE_VALIDATORS_H
 #define BITCOIN_GOVERNANCE_VALIDATORS_H
 
+#include <memory>
 #include <string>
 
 #include <univalue.h>
@@ -19,6 +20,9 @@ private:
 
 public:
     explicit CProposalValidator(const std::string& strDataHexIn = std::string(), bool fAllowScript = false);
+    /** Construct from an already parsed payload (see CGovernanceObject::GetDataAsJson),
+     *  skipping the hex and JSON decoding. nullptr means the payload was unparsable. */
+    explicit CProposalValidator(const std::shared_ptr<const UniValue>& objJSONIn, bool fAllowScript = false);
 
     bool Validate(bool fCheckExpiration = true);
 
@@ -4,6 +4,8 @@
 
 #include <governance/votedb.h>
 
+#include <limits>
+
 CGovernanceObjectVoteFile::CGovernanceObjectVoteFile() :
     nMemoryVotes(0),
     listVotes(),
@@ -27,6 +29,7 @@ void CGovernanceObjectVoteFile::AddVote(const CGovernanceVote& vote)
         return;
     listVotes.push_front(vote);
     mapVoteIndex.emplace(nHash, listVotes.begin());
+    mapMNVoteIndex.emplace(std::make_pair(vote.GetMasternodeOutpoint(), int(vote.GetSignal())), listVotes.begin());
     ++nMemoryVotes;
     RemoveOldVotes(vote);
 }
@@ -56,15 +59,12 @@ std::vector<CGovernanceVote> CGovernanceObjectVoteFile::GetVotes() const
 
 void CGovernanceObjectVoteFile::RemoveVotesFromMasternode(const COutPoint& outpointMasternode)
 {
-    auto it = listVotes.begin();
-    while (it != listVotes.end()) {
-        if (it->GetMasternodeOutpoint() == outpointMasternode) {
-            --nMemoryVotes;
-            mapVoteIndex.erase(it->GetHash());
-            listVotes.erase(it++);
-        } else {
-            ++it;
-        }
+    auto it = mapMNVoteIndex.lower_bound(std::make_pair(outpointMasternode, std::numeric_limits<int>::min()));
+    while (it != mapMNVoteIndex.end() && it->first.first == outpointMasternode) {
+        --nMemoryVotes;
+        mapVoteIndex.erase(it->second->GetHash());
+        listVotes.erase(it->second);
+        it = mapMNVoteIndex.erase(it);
     }
 }
 
@@ -72,19 +72,18 @@ std::set<uint256> CGovernanceObjectVoteFile::RemoveInvalidVotes(const COutPoint&
 {
     std::set<uint256> removedVotes;
 
-    auto it = listVotes.begin();
-    while (it != listVotes.end()) {
-        if (it->GetMasternodeOutpoint() == outpointMasternode) {
-            bool useVotingKey = fProposal && (it->GetSignal() == VOTE_SIGNAL_FUNDING);
-            if (!it->IsValid(useVotingKey)) {
-                removedVotes.emplace(it->GetHash());
-                --nMemoryVotes;
-                mapVoteIndex.erase(it->GetHash());
-                listVotes.erase(it++);
-                continue;
-            }
+    auto it = mapMNVoteIndex.lower_bound(std::make_pair(outpointMasternode, std::numeric_limits<int>::min()));
+    while (it != mapMNVoteIndex.end() && it->first.first == outpointMasternode) {
+        bool useVotingKey = fProposal && (it->second->GetSignal() == VOTE_SIGNAL_FUNDING);
+        if (!it->second->IsValid(useVotingKey)) {
+            removedVotes.emplace(it->second->GetHash());
+            --nMemoryVotes;
+            mapVoteIndex.erase(it->second->GetHash());
+            listVotes.erase(it->second);
+            it = mapMNVoteIndex.erase(it);
+        } else {
+            ++it;
         }
-        ++it;
     }
 
     return removedVotes;
@@ -92,16 +91,16 @@ std::set<uint256> CGovernanceObjectVoteFile::RemoveInvalidVotes(const COutPoint&
 
 void CGovernanceObjectVoteFile::RemoveOldVotes(const CGovernanceVote& vote)
 {
-    auto it = listVotes.begin();
-    while (it != listVotes.end()) {
-        if (it->GetMasternodeOutpoint() == vote.GetMasternodeOutpoint() // same masternode
-            && it->GetParentHash() == vote.GetParentHash() // same governance object (e.g. same proposal)
-            && it->GetSignal() == vote.GetSignal() // same signal (e.g. "funding", "delete", etc.)
-            && it->GetTimestamp() < vote.GetTimestamp()) // older than new vote
+    auto range = mapMNVoteIndex.equal_range(std::make_pair(vote.GetMasternodeOutpoint(), int(vote.GetSignal())));
+    auto it = range.first;
+    while (it != range.second) {
+        if (it->second->GetParentHash() == vote.GetParentHash() // same governance object (e.g. same proposal)
+            && it->second->GetTimestamp() < vote.GetTimestamp()) // older than new vote
         {
             --nMemoryVotes;
-            mapVoteIndex.erase(it->GetHash());
-            listVotes.erase(it++);
+            mapVoteIndex.erase(it->second->GetHash());
+            listVotes.erase(it->second);
+            it = mapMNVoteIndex.erase(it);
         } else {
             ++it;
         }
@@ -111,6 +110,7 @@ void CGovernanceObjectVoteFile::RemoveOldVotes(const CGovernanceVote& vote)
 void CGovernanceObjectVoteFile::RebuildIndex()
 {
     mapVoteIndex.clear();
+    mapMNVoteIndex.clear();
     nMemoryVotes = 0;
     auto it = listVotes.begin();
     while (it != listVotes.end()) {
@@ -118,6 +118,7 @@ void CGovernanceObjectVoteFile::RebuildIndex()
         uint256 nHash = vote.GetHash();
         if (mapVoteIndex.find(nHash) == mapVoteIndex.end()) {
             mapVoteIndex[nHash] = it;
+            mapMNVoteIndex.emplace(std::make_pair(vote.GetMasternodeOutpoint(), int(vote.GetSignal())), it);
             ++nMemoryVotes;
             ++it;
         } else {
@@ -7,8 +7,10 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 #include <governance/vote.h>
+#include <saltedhasher.h>
 #include <serialize.h>
 #include <streams.h>
 #include <uint256.h>
@@ -26,7 +28,11 @@ class CGovernanceObjectVoteFile
 public: // Types
     using vote_l_t = std::list<CGovernanceVote>;
 
-    using vote_m_t = std::map<uint256, vote_l_t::iterator>;
+    using vote_m_t = std::unordered_map<uint256, vote_l_t::iterator, StaticSaltedHasher>;
+
+    // multimap because multiple votes of one masternode for the same signal can
+    // coexist until a newer one flushes the older ones out
+    using vote_mn_m_t = std::multimap<std::pair<COutPoint, int>, vote_l_t::iterator>;
 
 private:
     int nMemoryVotes;
@@ -35,6 +41,10 @@ private:
 
     vote_m_t mapVoteIndex;
 
+    // index of votes by masternode outpoint and signal, so that superseded votes can
+    // be found without scanning the whole list on every AddVote
+    vote_mn_m_t mapMNVoteIndex;
+
 public:
     CGovernanceObjectVoteFile();
 
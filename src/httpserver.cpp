@@ -16,6 +16,7 @@
 #include <util/translation.h>
 
 #include <deque>
+#include <set>
 #include <stdio.h>
 #include <string>
 
@@ -143,6 +144,9 @@ static struct evhttp* eventHTTP = nullptr;
 static std::vector<CSubNet> rpc_allow_subnets;
 //! Work queue for handling longer requests off the event loop thread
 static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue{nullptr};
+//! Separate work queue for known-heavy requests, serviced by its own worker
+//! threads so that slow calls don't stall short ones queued behind them
+static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue_slow{nullptr};
 //! Handlers for (sub)paths
 static std::vector<HTTPPathHandler> pathHandlers;
 //! Bound listening sockets
@@ -208,6 +212,59 @@ std::string RequestMethodString(HTTPRequest::RequestMethod m)
     }
 }
 
+//! How many body bytes to peek at when classifying a request
+static constexpr size_t MAX_RPC_CLASSIFY_PEEK_SIZE{4096};
+
+/** RPC methods that routinely run long enough to stall short calls queued behind them. */
+static const std::set<std::string> g_slow_rpc_methods{
+    "getaddressbalance",
+    "getaddressdeltas",
+    "getaddresstxids",
+    "getblock",
+    "getblockstats",
+    "getrawtransaction",
+    "gettxoutsetinfo",
+    "rescanblockchain",
+    "scantxoutset",
+    "verifychain",
+};
+
+/** Extract the JSON-RPC method name from the start of a request body without parsing
+ * the whole document. Returns an empty string if it cannot be found. */
+static std::string ExtractRPCMethod(const std::string& body)
+{
+    size_t pos = body.find("\"method\"");
+    if (pos == std::string::npos) return "";
+    pos = body.find_first_not_of(" \t\r\n", pos + 8);
+    if (pos == std::string::npos || body[pos] != ':') return "";
+    pos = body.find_first_not_of(" \t\r\n", pos + 1);
+    if (pos == std::string::npos || body[pos] != '"') return "";
+    size_t end = body.find('"', pos + 1);
+    if (end == std::string::npos) return "";
+    return body.substr(pos + 1, end - pos - 1);
+}
+
+/** Decide whether a request goes to the slow-lane work queue. Misclassification only
+ * affects scheduling, never correctness, so this is a cheap heuristic rather than a
+ * full JSON parse. */
+static bool IsSlowRequest(HTTPRequest& req, const std::string& uri)
+{
+    // REST block queries serve whole blocks
+    if (uri.compare(0, 11, "/rest/block") == 0) {
+        return true;
+    }
+    if (req.GetRequestMethod() != HTTPRequest::POST) {
+        return false;
+    }
+    const std::string body = req.PeekBody(MAX_RPC_CLASSIFY_PEEK_SIZE);
+    // Batched requests can contain anything, assume the worst
+    const size_t first = body.find_first_not_of(" \t\r\n");
+    if (first != std::string::npos && body[first] == '[') {
+        return true;
+    }
+    return g_slow_rpc_methods.count(ExtractRPCMethod(body)) != 0;
+}
+
 /** HTTP request callback */
 static void http_request_cb(struct evhttp_request* req, void* arg)
 {
@@ -261,9 +318,13 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
 
     // Dispatch to worker thread
     if (i != iend) {
+        WorkQueue<HTTPClosure>* queue = g_work_queue.get();
+        if (g_work_queue_slow && IsSlowRequest(*hreq, strURI)) {
+            queue = g_work_queue_slow.get();
+        }
         auto item{std::make_unique<HTTPWorkItem>(std::move(hreq), path, i->handler)};
-        assert(g_work_queue);
-        if (g_work_queue->Enqueue(item.get())) {
+        assert(queue);
+        if (queue->Enqueue(item.get())) {
             item.release(); /* if true, queue took ownership */
         } else {
             LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the -rpcworkqueue= setting\n");
@@ -403,6 +464,7 @@ bool InitHTTPServer()
     LogPrintf("HTTP: creating work queue of depth %d\n", workQueueDepth);
 
     g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
+    g_work_queue_slow = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -430,12 +492,16 @@ void StartHTTPServer()
 {
     LogPrint(BCLog::HTTP, "Starting HTTP server\n");
     int rpcThreads = std::max((long)gArgs.GetArg("-rpcthreads", DEFAULT_HTTP_THREADS), 1L);
-    LogPrintf("HTTP: starting %d worker threads\n", rpcThreads);
+    int rpcSlowThreads = std::max((long)gArgs.GetArg("-rpcslowthreads", DEFAULT_HTTP_SLOW_THREADS), 1L);
+    LogPrintf("HTTP: starting %d worker threads (%d for slow calls)\n", rpcThreads, rpcSlowThreads);
     g_thread_http = std::thread(ThreadHTTP, eventBase);
 
     for (int i = 0; i < rpcThreads; i++) {
         g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), i);
     }
+    for (int i = 0; i < rpcSlowThreads; i++) {
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue_slow.get(), rpcThreads + i);
+    }
 }
 
 void InterruptHTTPServer()
@@ -448,6 +514,9 @@ void InterruptHTTPServer()
     if (g_work_queue) {
         g_work_queue->Interrupt();
     }
+    if (g_work_queue_slow) {
+        g_work_queue_slow->Interrupt();
+    }
 }
 
 void StopHTTPServer()
@@ -479,6 +548,7 @@ void StopHTTPServer()
         eventBase = nullptr;
     }
     g_work_queue.reset();
+    g_work_queue_slow.reset();
     LogPrint(BCLog::HTTP, "Stopped HTTP server\n");
 }
 
@@ -558,6 +628,18 @@ std::string HTTPRequest::ReadBody()
     return rv;
 }
 
+std::string HTTPRequest::PeekBody(size_t max_size)
+{
+    struct evbuffer* buf = evhttp_request_get_input_buffer(req);
+    if (!buf)
+        return "";
+    size_t size = std::min(evbuffer_get_length(buf), max_size);
+    const char* data = (const char*)evbuffer_pullup(buf, size);
+    if (!data)
+        return "";
+    return std::string(data, size);
+}
+
 void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
 {
     struct evkeyvalq* headers = evhttp_request_get_output_headers(req);
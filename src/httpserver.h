@@ -9,6 +9,7 @@
 #include <functional>
 
 static const int DEFAULT_HTTP_THREADS=4;
+static const int DEFAULT_HTTP_SLOW_THREADS=2;
 static const int DEFAULT_HTTP_WORKQUEUE=16;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
 
@@ -97,6 +98,13 @@ public:
      */
     std::string ReadBody();
 
+    /**
+     * Peek at the start of the request body without consuming it.
+     *
+     * @param[in] max_size  Maximum number of bytes to return.
+     */
+    std::string PeekBody(size_t max_size);
+
     /**
      * Write output header.
      *
@@ -9,12 +9,17 @@
 #include <ui_interface.h>
 #include <util/translation.h>
 #include <validation.h>
+#include <version.h>
 #include <warnings.h>
 
 constexpr char DB_BEST_BLOCK = 'B';
 
 constexpr int64_t SYNC_LOG_INTERVAL = 30; // seconds
 constexpr int64_t SYNC_LOCATOR_WRITE_INTERVAL = 30; // seconds
+//! Commit the locator early once this many block bytes were indexed since the
+//! last commit, so an IO-bound sync bounds its replay-after-restart by data
+//! volume rather than by however many blocks fit in a wall clock interval.
+constexpr uint64_t SYNC_LOCATOR_WRITE_BYTES = 256 << 20;
 
 template <typename... Args>
 static void FatalError(const char* fmt, const Args&... args)
@@ -91,6 +96,7 @@ void BaseIndex::ThreadSync()
 
         int64_t last_log_time = 0;
         int64_t last_locator_write_time = 0;
+        uint64_t bytes_since_commit = 0;
         while (true) {
             if (m_interrupt) {
                 m_best_block_index = pindex;
@@ -126,24 +132,31 @@ void BaseIndex::ThreadSync()
                 last_log_time = current_time;
             }
 
-            if (last_locator_write_time + SYNC_LOCATOR_WRITE_INTERVAL < current_time) {
+            if (last_locator_write_time + SYNC_LOCATOR_WRITE_INTERVAL < current_time ||
+                bytes_since_commit >= SYNC_LOCATOR_WRITE_BYTES) {
                 m_best_block_index = pindex;
                 last_locator_write_time = current_time;
+                bytes_since_commit = 0;
                 // No need to handle errors in Commit. See rationale above.
                 Commit();
             }
 
-            CBlock block;
-            if (!ReadBlockFromDisk(block, pindex, consensus_params)) {
+            // Reading through the shared decoded-block cache lets several
+            // indexes syncing over the same range use a single disk read and
+            // deserialization per block.
+            size_t block_size{0};
+            std::shared_ptr<const CBlock> block = ReadCachedBlockFromDisk(pindex, consensus_params, &block_size);
+            if (!block) {
                 FatalError("%s: Failed to read block %s from disk",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
             }
-            if (!WriteBlock(block, pindex)) {
+            if (!WriteBlock(*block, pindex)) {
                 FatalError("%s: Failed to write block %s to index database",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
             }
+            bytes_since_commit += block_size;
         }
     }
 
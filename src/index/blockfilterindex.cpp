@@ -4,6 +4,7 @@
 
 #include <map>
 
+#include <chainparams.h>
 #include <dbwrapper.h>
 #include <index/blockfilterindex.h>
 #include <serialize.h>
@@ -32,6 +33,11 @@ constexpr char DB_FILTER_POS = 'P';
 constexpr unsigned int MAX_FLTR_FILE_SIZE = 0x1000000; // 16 MiB
 /** The pre-allocation chunk size for fltr?????.dat files */
 constexpr unsigned int FLTR_FILE_CHUNK_SIZE = 0x100000; // 1 MiB
+/** Number of blocks ahead of the sync position for which filters are built in the background.
+ *  Also bounds the number of concurrent build tasks. Filter construction (block and undo reads
+ *  plus hashing every scriptPubKey) dominates the initial sync, while the ordered header chaining
+ *  and DB writes done by the sync thread are cheap in comparison. */
+constexpr int FILTER_BUILD_LOOKAHEAD = 16;
 /** Maximum size of the cfheaders cache
  *  We have a limit to prevent a bug in filling this cache
  *  potentially turning into an OOM. At 2000 entries, this cache
@@ -214,16 +220,71 @@ size_t BlockFilterIndex::WriteFilterToDisk(FlatFilePos& pos, const BlockFilter&
     return data_size;
 }
 
-bool BlockFilterIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+static BlockFilter BuildFilterFromDisk(BlockFilterType filter_type, const CBlockIndex* pindex)
 {
+    CBlock block;
+    if (!ReadBlockFromDisk(block, pindex, Params().GetConsensus())) {
+        throw std::runtime_error(strprintf("unable to read block %s from disk", pindex->GetBlockHash().ToString()));
+    }
     CBlockUndo block_undo;
-    uint256 prev_header;
+    if (pindex->nHeight > 0 && !UndoReadFromDisk(block_undo, pindex)) {
+        throw std::runtime_error(strprintf("unable to read undo data for block %s", pindex->GetBlockHash().ToString()));
+    }
+    return BlockFilter(filter_type, block, block_undo);
+}
 
-    if (pindex->nHeight > 0) {
-        if (!UndoReadFromDisk(block_undo, pindex)) {
-            return false;
+void BlockFilterIndex::ScheduleFilterLookahead(const CBlockIndex* pindex)
+{
+    std::vector<const CBlockIndex*> to_schedule;
+    {
+        LOCK(cs_main);
+        const CBlockIndex* next = ::ChainActive().Next(pindex);
+        for (int i = 0; i < FILTER_BUILD_LOOKAHEAD && next != nullptr; ++i, next = ::ChainActive().Next(next)) {
+            auto it = m_pending_filters.find(next->nHeight);
+            if (it != m_pending_filters.end() && it->second.first == next->GetBlockHash()) {
+                continue;
+            }
+            to_schedule.push_back(next);
+        }
+    }
+
+    const BlockFilterType filter_type{m_filter_type};
+    for (const CBlockIndex* next : to_schedule) {
+        m_pending_filters[next->nHeight] = std::make_pair(next->GetBlockHash(),
+            std::async(std::launch::async, [filter_type, next] { return BuildFilterFromDisk(filter_type, next); }));
+    }
+}
+
+bool BlockFilterIndex::GetOrBuildFilter(const CBlock& block, const CBlockIndex* pindex, BlockFilter& filter)
+{
+    bool have_filter{false};
+    auto it = m_pending_filters.find(pindex->nHeight);
+    if (it != m_pending_filters.end() && it->second.first == pindex->GetBlockHash()) {
+        try {
+            filter = it->second.second.get();
+            have_filter = true;
+        } catch (const std::exception& e) {
+            LogPrintf("%s: %s: background filter construction failed: %s\n", __func__, GetName(), e.what());
         }
+    }
+    // Results at or below this height can no longer be consumed, e.g. after a reorg
+    m_pending_filters.erase(m_pending_filters.begin(), m_pending_filters.upper_bound(pindex->nHeight));
+
+    if (have_filter) return true;
+
+    CBlockUndo block_undo;
+    if (pindex->nHeight > 0 && !UndoReadFromDisk(block_undo, pindex)) {
+        return false;
+    }
+    filter = BlockFilter(m_filter_type, block, block_undo);
+    return true;
+}
 
+bool BlockFilterIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    uint256 prev_header;
+
+    if (pindex->nHeight > 0) {
         std::pair<uint256, DBVal> read_out;
         if (!m_db->Read(DBHeightKey(pindex->nHeight - 1), read_out)) {
             return false;
@@ -238,7 +299,14 @@ bool BlockFilterIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex
         prev_header = read_out.second.header;
     }
 
-    BlockFilter filter(m_filter_type, block, block_undo);
+    // Overlap the disk writes and header chaining done by this thread with filter
+    // construction for the upcoming blocks
+    ScheduleFilterLookahead(pindex);
+
+    BlockFilter filter;
+    if (!GetOrBuildFilter(block, pindex, filter)) {
+        return false;
+    }
 
     size_t bytes_written = WriteFilterToDisk(m_next_filter_pos, filter);
     if (bytes_written == 0) return false;
@@ -10,6 +10,9 @@
 #include <flatfile.h>
 #include <index/base.h>
 
+#include <future>
+#include <map>
+
 /** Interval between compact filter checkpoints. See BIP 157. */
 static constexpr int CFCHECKPT_INTERVAL = 1000;
 
@@ -42,6 +45,17 @@ private:
     /** cache of block hash to filter header, to avoid disk access when responding to getcfcheckpt. */
     std::unordered_map<uint256, uint256, FilterHeaderHasher> m_headers_cache GUARDED_BY(m_cs_headers_cache);
 
+    /** Filters for upcoming blocks being built in the background during the initial sync, keyed by
+     *  height. Only touched by the sync thread; the background tasks communicate exclusively
+     *  through the futures. Entries for reorged-out blocks are detected by the block hash and
+     *  rebuilt inline. */
+    std::map<int, std::pair<uint256, std::future<BlockFilter>>> m_pending_filters;
+
+    /** Kick off background filter construction for blocks following pindex on the active chain. */
+    void ScheduleFilterLookahead(const CBlockIndex* pindex);
+    /** Get the pre-built filter for pindex, falling back to building it from the passed block. */
+    bool GetOrBuildFilter(const CBlock& block, const CBlockIndex* pindex, BlockFilter& filter);
+
 protected:
     bool Init() override;
 
@@ -0,0 +1,117 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/blockstatsindex.h>
+
+#include <chain.h>
+#include <consensus/consensus.h>
+#include <rpc/blockchain.h>
+#include <undo.h>
+#include <util/system.h>
+#include <validation.h>
+
+constexpr char DB_BLOCK_STATS = 's';
+
+std::unique_ptr<BlockStatsIndex> g_block_stats_index;
+
+BlockStatsIndex::BlockStatsIndex(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    m_db(std::make_unique<BaseIndex::DB>(GetDataDir() / "indexes" / "blockstats", n_cache_size, f_memory, f_wipe))
+{}
+
+/** Compute the full stats record for one block. Mirrors the per-block loop in
+ *  getblockstats, but unconditionally computes every statistic since the
+ *  record is written once and queried many times. */
+static CBlockStatsRecord ComputeBlockStats(const CBlock& block, const CBlockUndo& block_undo)
+{
+    CBlockStatsRecord record;
+    record.nTxCount = block.vtx.size();
+
+    CAmount maxfee = 0;
+    CAmount maxfeerate = 0;
+    CAmount minfee = MAX_MONEY;
+    CAmount minfeerate = MAX_MONEY;
+    int64_t maxtxsize = 0;
+    int64_t mintxsize = MaxBlockSize();
+    std::vector<CAmount> fee_array;
+    std::vector<std::pair<CAmount, int64_t>> feerate_array;
+    std::vector<int64_t> txsize_array;
+
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        const auto& tx = block.vtx.at(i);
+        record.nOutputs += tx->vout.size();
+
+        CAmount tx_total_out = 0;
+        for (const CTxOut& out : tx->vout) {
+            tx_total_out += out.nValue;
+            record.nUtxoSizeInc += GetSerializeSize(out, PROTOCOL_VERSION) + PER_UTXO_OVERHEAD;
+        }
+
+        if (tx->IsCoinBase()) {
+            continue;
+        }
+
+        record.nInputs += tx->vin.size(); // Don't count coinbase's fake input
+        record.nTotalOut += tx_total_out; // Don't count coinbase reward
+
+        const int64_t tx_size = tx->GetTotalSize();
+        txsize_array.push_back(tx_size);
+        maxtxsize = std::max(maxtxsize, tx_size);
+        mintxsize = std::min(mintxsize, tx_size);
+        record.nTotalSize += tx_size;
+
+        CAmount tx_total_in = 0;
+        const auto& txundo = block_undo.vtxundo.at(i - 1);
+        for (const Coin& coin : txundo.vprevout) {
+            const CTxOut& prevoutput = coin.out;
+
+            tx_total_in += prevoutput.nValue;
+            record.nUtxoSizeInc -= GetSerializeSize(prevoutput, PROTOCOL_VERSION) + PER_UTXO_OVERHEAD;
+        }
+
+        const CAmount txfee = tx_total_in - tx_total_out;
+        fee_array.push_back(txfee);
+        maxfee = std::max(maxfee, txfee);
+        minfee = std::min(minfee, txfee);
+        record.nTotalFee += txfee;
+
+        const CAmount feerate = tx_size ? txfee / tx_size : 0;
+        feerate_array.emplace_back(std::make_pair(feerate, tx_size));
+        maxfeerate = std::max(maxfeerate, feerate);
+        minfeerate = std::min(minfeerate, feerate);
+    }
+
+    // Store the normalized values getblockstats reports for empty blocks
+    record.nMinFee = (minfee == MAX_MONEY) ? 0 : minfee;
+    record.nMaxFee = maxfee;
+    record.nMinFeeRate = (minfeerate == MAX_MONEY) ? 0 : minfeerate;
+    record.nMaxFeeRate = maxfeerate;
+    record.nMinTxSize = (mintxsize == static_cast<int64_t>(MaxBlockSize())) ? 0 : mintxsize;
+    record.nMaxTxSize = maxtxsize;
+    record.nMedianFee = CalculateTruncatedMedian(fee_array);
+    record.nMedianTxSize = CalculateTruncatedMedian(txsize_array);
+
+    CAmount feerate_percentiles[NUM_GETBLOCKSTATS_PERCENTILES] = { 0 };
+    CalculatePercentilesBySize(feerate_percentiles, feerate_array, record.nTotalSize);
+    record.vFeeRatePercentiles.assign(feerate_percentiles, feerate_percentiles + NUM_GETBLOCKSTATS_PERCENTILES);
+
+    return record;
+}
+
+bool BlockStatsIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    CBlockUndo block_undo;
+    if (pindex->nHeight > 0) {
+        if (!UndoReadFromDisk(block_undo, pindex)) {
+            return false;
+        }
+    }
+
+    const CBlockStatsRecord record = ComputeBlockStats(block, block_undo);
+    return m_db->Write(std::make_pair(DB_BLOCK_STATS, pindex->GetBlockHash()), record);
+}
+
+bool BlockStatsIndex::LookupBlockStats(const uint256& block_hash, CBlockStatsRecord& record) const
+{
+    return m_db->Read(std::make_pair(DB_BLOCK_STATS, block_hash), record);
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEX_BLOCKSTATSINDEX_H
+#define BITCOIN_INDEX_BLOCKSTATSINDEX_H
+
+#include <amount.h>
+#include <index/base.h>
+#include <serialize.h>
+
+#include <vector>
+
+static constexpr bool DEFAULT_BLOCKSTATSINDEX{false};
+
+/** Per-block statistics as reported by getblockstats, materialized once when
+ *  the block is connected. All values are stored in their final, normalized
+ *  form (e.g. min fields are 0 rather than MAX_MONEY for empty blocks), so
+ *  the RPC can emit them without further processing. */
+struct CBlockStatsRecord {
+    int64_t nTxCount{0};      //!< number of transactions, including coinbase
+    int64_t nInputs{0};       //!< number of inputs, excluding coinbase
+    int64_t nOutputs{0};      //!< number of outputs
+    CAmount nTotalOut{0};     //!< total output value, excluding coinbase
+    int64_t nTotalSize{0};    //!< total size of all non-coinbase transactions
+    CAmount nTotalFee{0};
+    CAmount nMinFee{0};
+    CAmount nMaxFee{0};
+    CAmount nMedianFee{0};    //!< truncated median fee
+    CAmount nMinFeeRate{0};   //!< in duffs per byte
+    CAmount nMaxFeeRate{0};   //!< in duffs per byte
+    int64_t nMinTxSize{0};
+    int64_t nMaxTxSize{0};
+    int64_t nMedianTxSize{0}; //!< truncated median transaction size
+    int64_t nUtxoSizeInc{0};  //!< net change in serialized utxo index size
+    //! feerates at the 10th, 25th, 50th, 75th and 90th percentile size unit
+    std::vector<CAmount> vFeeRatePercentiles;
+
+    SERIALIZE_METHODS(CBlockStatsRecord, obj)
+    {
+        READWRITE(obj.nTxCount, obj.nInputs, obj.nOutputs, obj.nTotalOut, obj.nTotalSize,
+                  obj.nTotalFee, obj.nMinFee, obj.nMaxFee, obj.nMedianFee,
+                  obj.nMinFeeRate, obj.nMaxFeeRate, obj.nMinTxSize, obj.nMaxTxSize,
+                  obj.nMedianTxSize, obj.nUtxoSizeInc, obj.vFeeRatePercentiles);
+    }
+};
+
+/**
+ * BlockStatsIndex computes the getblockstats record for every block as it is
+ * connected and stores it in LevelDB keyed by block hash. With the index
+ * enabled, monitoring dashboards polling getblockstats are answered with a
+ * single ~150 byte index read instead of reading and re-processing the block
+ * and undo files on every call.
+ */
+class BlockStatsIndex final : public BaseIndex
+{
+private:
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+protected:
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    BaseIndex::DB& GetDB() const override { return *m_db; }
+
+    const char* GetName() const override { return "blockstatsindex"; }
+
+public:
+    /** Constructs the index, which becomes available to be queried. */
+    explicit BlockStatsIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    /// Read the stats record for the given block. Returns false if the block
+    /// has not been indexed (yet).
+    bool LookupBlockStats(const uint256& block_hash, CBlockStatsRecord& record) const;
+};
+
+/// The global block statistics index.
+extern std::unique_ptr<BlockStatsIndex> g_block_stats_index;
+
+#endif // BITCOIN_INDEX_BLOCKSTATSINDEX_H
@@ -0,0 +1,242 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <coins.h>
+#include <index/coinstatsindex.h>
+#include <node/coinstats.h>
+#include <serialize.h>
+#include <undo.h>
+#include <util/system.h>
+#include <validation.h>
+
+std::unique_ptr<CoinStatsIndex> g_coin_stats_index;
+
+namespace {
+
+constexpr char DB_COINSTATS{'S'};
+
+//! The complete running state of the index, stored under a single key and
+//! written in the same batch as the best block locator.
+struct DBState {
+    uint256 block_hash;
+    int32_t height{0};
+    MuHash3072 muhash;
+    uint64_t transaction_output_count{0};
+    uint64_t bogo_size{0};
+    CAmount total_amount{0};
+
+    SERIALIZE_METHODS(DBState, obj)
+    {
+        READWRITE(obj.block_hash, obj.height, obj.muhash, obj.transaction_output_count, obj.bogo_size, obj.total_amount);
+    }
+};
+
+} // namespace
+
+CoinStatsIndex::CoinStatsIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+{
+    fs::path path{GetDataDir() / "indexes" / "coinstats"};
+    fs::create_directories(path);
+    m_db = std::make_unique<BaseIndex::DB>(path, n_cache_size, f_memory, f_wipe);
+}
+
+bool CoinStatsIndex::Init()
+{
+    DBState db_state;
+    if (m_db->Read(DB_COINSTATS, db_state)) {
+        LOCK(m_mutex);
+        m_muhash = db_state.muhash;
+        m_state_block_hash = db_state.block_hash;
+        m_state_height = db_state.height;
+        m_transaction_output_count = db_state.transaction_output_count;
+        m_bogo_size = db_state.bogo_size;
+        m_total_amount = db_state.total_amount;
+    }
+    return BaseIndex::Init();
+}
+
+bool CoinStatsIndex::CommitInternal(CDBBatch& batch)
+{
+    {
+        LOCK(m_mutex);
+        DBState db_state;
+        db_state.block_hash = m_state_block_hash;
+        db_state.height = m_state_height;
+        db_state.muhash = m_muhash;
+        db_state.transaction_output_count = m_transaction_output_count;
+        db_state.bogo_size = m_bogo_size;
+        db_state.total_amount = m_total_amount;
+        batch.Write(DB_COINSTATS, db_state);
+    }
+    return BaseIndex::CommitInternal(batch);
+}
+
+bool CoinStatsIndex::ApplyBlock(const CBlock& block, const CBlockIndex* pindex, bool fRemove)
+{
+    // The genesis block's outputs are never added to the coins database
+    // (ConnectBlock skips it), so only the state pointer advances for it.
+    if (pindex->pprev != nullptr) {
+        CBlockUndo block_undo;
+        if (!UndoReadFromDisk(block_undo, pindex)) {
+            return error("%s: failed to read undo data for block %s", __func__, pindex->GetBlockHash().ToString());
+        }
+
+        for (size_t i = 0; i < block.vtx.size(); ++i) {
+            const CTransaction& tx{*block.vtx[i]};
+
+            for (uint32_t j = 0; j < tx.vout.size(); ++j) {
+                const CTxOut& out{tx.vout[j]};
+                // Skip unspendable coins, they are never added to the UTXO set
+                if (out.scriptPubKey.IsUnspendable()) continue;
+
+                const Coin coin{out, pindex->nHeight, tx.IsCoinBase()};
+                const COutPoint outpoint{tx.GetHash(), j};
+                if (!fRemove) {
+                    m_muhash.Insert(MakeUCharSpan(TxOutSer(outpoint, coin)));
+                    ++m_transaction_output_count;
+                    m_bogo_size += GetBogoSize(coin.out.scriptPubKey);
+                    m_total_amount += coin.out.nValue;
+                } else {
+                    m_muhash.Remove(MakeUCharSpan(TxOutSer(outpoint, coin)));
+                    --m_transaction_output_count;
+                    m_bogo_size -= GetBogoSize(coin.out.scriptPubKey);
+                    m_total_amount -= coin.out.nValue;
+                }
+            }
+
+            // The coinbase tx has no undo data since it spends no coins
+            if (tx.IsCoinBase()) continue;
+
+            const CTxUndo& tx_undo{block_undo.vtxundo.at(i - 1)};
+            for (size_t j = 0; j < tx.vin.size(); ++j) {
+                const Coin& coin{tx_undo.vprevout.at(j)};
+                const COutPoint& outpoint{tx.vin[j].prevout};
+                if (!fRemove) {
+                    m_muhash.Remove(MakeUCharSpan(TxOutSer(outpoint, coin)));
+                    --m_transaction_output_count;
+                    m_bogo_size -= GetBogoSize(coin.out.scriptPubKey);
+                    m_total_amount -= coin.out.nValue;
+                } else {
+                    m_muhash.Insert(MakeUCharSpan(TxOutSer(outpoint, coin)));
+                    ++m_transaction_output_count;
+                    m_bogo_size += GetBogoSize(coin.out.scriptPubKey);
+                    m_total_amount += coin.out.nValue;
+                }
+            }
+        }
+    }
+
+    if (!fRemove) {
+        m_state_block_hash = pindex->GetBlockHash();
+        m_state_height = pindex->nHeight;
+    } else {
+        assert(pindex->pprev != nullptr);
+        m_state_block_hash = pindex->pprev->GetBlockHash();
+        m_state_height = pindex->pprev->nHeight;
+    }
+    return true;
+}
+
+bool CoinStatsIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    LOCK(m_mutex);
+
+    // The best block locator is committed before the blocks it refers to are
+    // processed, so after a crash the first block handed to us on restart may
+    // have been applied already.
+    if (m_state_block_hash == pindex->GetBlockHash()) {
+        return true;
+    }
+
+    const bool contiguous = pindex->pprev == nullptr ?
+        m_state_block_hash.IsNull() :
+        m_state_block_hash == pindex->pprev->GetBlockHash();
+    if (!contiguous) {
+        // Replay any ancestor blocks the accumulator state is missing. The
+        // state can only trail the locator by a small number of blocks, so a
+        // bounded walk is sufficient.
+        std::vector<const CBlockIndex*> gap;
+        const CBlockIndex* walk{pindex->pprev};
+        while (walk != nullptr && walk->GetBlockHash() != m_state_block_hash && gap.size() < 100) {
+            gap.push_back(walk);
+            walk = walk->pprev;
+        }
+        const bool found = m_state_block_hash.IsNull() ?
+            walk == nullptr :
+            (walk != nullptr && walk->GetBlockHash() == m_state_block_hash);
+        if (!found) {
+            return error("%s: muhash state block %s is not a recent ancestor of block %s", __func__,
+                         m_state_block_hash.ToString(), pindex->GetBlockHash().ToString());
+        }
+        for (auto rit = gap.rbegin(); rit != gap.rend(); ++rit) {
+            CBlock gap_block;
+            if (!ReadBlockFromDisk(gap_block, *rit, Params().GetConsensus())) {
+                return error("%s: failed to read block %s from disk", __func__, (*rit)->GetBlockHash().ToString());
+            }
+            if (!ApplyBlock(gap_block, *rit, /* fRemove */ false)) {
+                return false;
+            }
+        }
+    }
+
+    return ApplyBlock(block, pindex, /* fRemove */ false);
+}
+
+bool CoinStatsIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
+{
+    assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
+
+    {
+        LOCK(m_mutex);
+
+        const CBlockIndex* iter_tip{current_tip};
+        if (m_state_block_hash != current_tip->GetBlockHash()) {
+            // The state may trail the best block by one block, see WriteBlock
+            if (current_tip->pprev != nullptr && m_state_block_hash == current_tip->pprev->GetBlockHash()) {
+                iter_tip = current_tip->pprev;
+            } else {
+                return error("%s: muhash state block %s does not match current tip %s", __func__,
+                             m_state_block_hash.ToString(), current_tip->GetBlockHash().ToString());
+            }
+        }
+
+        while (iter_tip != new_tip) {
+            CBlock block;
+            if (!ReadBlockFromDisk(block, iter_tip, Params().GetConsensus())) {
+                return error("%s: failed to read block %s from disk", __func__, iter_tip->GetBlockHash().ToString());
+            }
+            if (!ApplyBlock(block, iter_tip, /* fRemove */ true)) {
+                return false;
+            }
+            iter_tip = iter_tip->pprev;
+        }
+    }
+
+    return BaseIndex::Rewind(current_tip, new_tip);
+}
+
+bool CoinStatsIndex::LookupStats(CCoinsStats& stats) const
+{
+    LOCK(m_mutex);
+
+    if (m_state_block_hash.IsNull()) {
+        return false; // Not indexed anything yet
+    }
+
+    stats.hashBlock = m_state_block_hash;
+    stats.nHeight = m_state_height;
+    stats.nTransactionOutputs = m_transaction_output_count;
+    stats.coins_count = m_transaction_output_count;
+    stats.nBogoSize = m_bogo_size;
+    stats.nTotalAmount = m_total_amount;
+
+    uint256 out;
+    MuHash3072 muhash{m_muhash};
+    muhash.Finalize(out);
+    stats.hashSerialized = out;
+
+    stats.index_used = true;
+    return true;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEX_COINSTATSINDEX_H
+#define BITCOIN_INDEX_COINSTATSINDEX_H
+
+#include <amount.h>
+#include <crypto/muhash.h>
+#include <index/base.h>
+#include <node/coinstats.h>
+#include <sync.h>
+
+static constexpr bool DEFAULT_COINSTATSINDEX{false};
+
+/**
+ * CoinStatsIndex maintains a running MuHash of the UTXO set together with
+ * aggregate statistics about it, updated incrementally as blocks are
+ * connected and disconnected. With the index enabled, gettxoutsetinfo with
+ * hash_type=muhash is answered in O(1) instead of walking the whole coins DB
+ * with a cursor.
+ *
+ * Unlike the other indexes there is no per-block data; the running state is
+ * committed in the same batch as the best block locator, and since the
+ * locator may be committed one block ahead of the last applied block during
+ * the initial sync, the state remembers which block it belongs to and heals
+ * one-block gaps by replaying from disk.
+ */
+class CoinStatsIndex final : public BaseIndex
+{
+private:
+    std::unique_ptr<BaseIndex::DB> m_db;
+
+    mutable Mutex m_mutex;
+    MuHash3072 m_muhash GUARDED_BY(m_mutex);
+    uint256 m_state_block_hash GUARDED_BY(m_mutex);
+    int32_t m_state_height GUARDED_BY(m_mutex){0};
+    uint64_t m_transaction_output_count GUARDED_BY(m_mutex){0};
+    uint64_t m_bogo_size GUARDED_BY(m_mutex){0};
+    CAmount m_total_amount GUARDED_BY(m_mutex){0};
+
+    /// Add one block's coins to the running state, or remove them again
+    /// (in reverse) during a reorg.
+    bool ApplyBlock(const CBlock& block, const CBlockIndex* pindex, bool fRemove) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+
+protected:
+    bool Init() override;
+
+    bool CommitInternal(CDBBatch& batch) override;
+
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
+
+    BaseIndex::DB& GetDB() const override { return *m_db; }
+
+    const char* GetName() const override { return "coinstatsindex"; }
+
+public:
+    /** Constructs the index, which becomes available to be queried. */
+    explicit CoinStatsIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    /// Fill stats with the indexed values for the index's current best block.
+    bool LookupStats(CCoinsStats& stats) const;
+};
+
+/// The global UTXO set hash object.
+extern std::unique_ptr<CoinStatsIndex> g_coin_stats_index;
+
+#endif // BITCOIN_INDEX_COINSTATSINDEX_H
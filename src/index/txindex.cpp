@@ -13,6 +13,7 @@
 constexpr char DB_BEST_BLOCK = 'B';
 constexpr char DB_TXINDEX = 't';
 constexpr char DB_TXINDEX_BLOCK = 'T';
+constexpr char DB_TXINDEX_TX = 'x';
 
 std::unique_ptr<TxIndex> g_txindex;
 
@@ -28,8 +29,14 @@ public:
     /// transaction hash is not indexed.
     bool ReadTxPos(const uint256& txid, CDiskTxPos& pos) const;
 
-    /// Write a batch of transaction positions to the DB.
-    bool WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos);
+    /// Read a transaction stored inline in the DB (-txindexfull only). Returns false if no inline
+    /// record exists for this transaction hash.
+    bool ReadStoredTx(const uint256& txid, uint256& block_hash, CTransactionRef& tx) const;
+
+    /// Write a batch of transaction positions to the DB. If v_txs is non-empty, the serialized
+    /// transactions themselves are stored alongside.
+    bool WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos,
+                  const std::vector<std::pair<uint256, std::pair<uint256, CTransactionRef>>>& v_txs);
 
     /// Migrate txindex data from the block tree DB, where it may be for older nodes that have not
     /// been upgraded yet to the new database.
@@ -45,12 +52,27 @@ bool TxIndex::DB::ReadTxPos(const uint256 &txid, CDiskTxPos& pos) const
     return Read(std::make_pair(DB_TXINDEX, txid), pos);
 }
 
-bool TxIndex::DB::WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos)
+bool TxIndex::DB::ReadStoredTx(const uint256& txid, uint256& block_hash, CTransactionRef& tx) const
+{
+    std::pair<uint256, CTransactionRef> value;
+    if (!Read(std::make_pair(DB_TXINDEX_TX, txid), value)) {
+        return false;
+    }
+    block_hash = value.first;
+    tx = std::move(value.second);
+    return true;
+}
+
+bool TxIndex::DB::WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos,
+                           const std::vector<std::pair<uint256, std::pair<uint256, CTransactionRef>>>& v_txs)
 {
     CDBBatch batch(*this);
     for (const auto& tuple : v_pos) {
         batch.Write(std::make_pair(DB_TXINDEX, tuple.first), tuple.second);
     }
+    for (const auto& tuple : v_txs) {
+        batch.Write(std::make_pair(DB_TXINDEX_TX, tuple.first), tuple.second);
+    }
     return WriteBatch(batch);
 }
 
@@ -191,8 +213,8 @@ bool TxIndex::DB::MigrateData(CBlockTreeDB& block_tree_db, const CBlockLocator&
     return true;
 }
 
-TxIndex::TxIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
-    : m_db(std::make_unique<TxIndex::DB>(n_cache_size, f_memory, f_wipe))
+TxIndex::TxIndex(size_t n_cache_size, bool f_memory, bool f_wipe, bool f_store_txs)
+    : m_db(std::make_unique<TxIndex::DB>(n_cache_size, f_memory, f_wipe)), m_store_txs(f_store_txs)
 {}
 
 TxIndex::~TxIndex() {}
@@ -218,18 +240,33 @@ bool TxIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
 
     CDiskTxPos pos(pindex->GetBlockPos(), GetSizeOfCompactSize(block.vtx.size()));
     std::vector<std::pair<uint256, CDiskTxPos>> vPos;
+    std::vector<std::pair<uint256, std::pair<uint256, CTransactionRef>>> vTxs;
     vPos.reserve(block.vtx.size());
+    if (m_store_txs) {
+        vTxs.reserve(block.vtx.size());
+    }
+    const uint256 block_hash = pindex->GetBlockHash();
     for (const auto& tx : block.vtx) {
         vPos.emplace_back(tx->GetHash(), pos);
         pos.nTxOffset += ::GetSerializeSize(*tx, CLIENT_VERSION);
+        if (m_store_txs) {
+            vTxs.emplace_back(tx->GetHash(), std::make_pair(block_hash, tx));
+        }
     }
-    return m_db->WriteTxs(vPos);
+    return m_db->WriteTxs(vPos, vTxs);
 }
 
 BaseIndex::DB& TxIndex::GetDB() const { return *m_db; }
 
 bool TxIndex::FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRef& tx) const
 {
+    // Inline records may be missing for blocks indexed before -txindexfull was
+    // turned on (a -reindex rebuilds them), so fall through to the disk
+    // position in that case.
+    if (m_store_txs && m_db->ReadStoredTx(tx_hash, block_hash, tx)) {
+        return true;
+    }
+
     CDiskTxPos postx;
     if (!m_db->ReadTxPos(tx_hash, postx)) {
         return false;
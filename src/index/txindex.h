@@ -9,10 +9,17 @@
 #include <index/base.h>
 #include <txdb.h>
 
+/** Default for -txindexfull */
+static constexpr bool DEFAULT_TXINDEX_FULL{false};
+
 /**
  * TxIndex is used to look up transactions included in the blockchain by hash.
  * The index is written to a LevelDB database and records the filesystem
  * location of each transaction by transaction hash.
+ *
+ * With -txindexfull, the serialized transaction itself is additionally stored
+ * inline in the database, so lookups are served straight from LevelDB without
+ * random reads into the block files.
  */
 class TxIndex final : public BaseIndex
 {
@@ -22,6 +29,9 @@ protected:
 private:
     const std::unique_ptr<DB> m_db;
 
+    /// Whether serialized transactions are stored inline in addition to their disk positions.
+    const bool m_store_txs;
+
 protected:
     /// Override base class init to migrate from old database.
     bool Init() override;
@@ -34,7 +44,7 @@ protected:
 
 public:
     /// Constructs the index, which becomes available to be queried.
-    explicit TxIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+    explicit TxIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false, bool f_store_txs = DEFAULT_TXINDEX_FULL);
 
     // Destructor is declared because this class contains a unique_ptr to an incomplete type.
     virtual ~TxIndex() override;
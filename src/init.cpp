@@ -21,12 +21,15 @@
 #include <node/coinstats.h>
 #include <compat/sanity.h>
 #include <consensus/validation.h>
+#include <crypto/siphash.h>
 #include <fs.h>
 #include <hash.h>
 #include <httpserver.h>
 #include <httprpc.h>
 #include <interfaces/chain.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
+#include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <interfaces/node.h>
 #include <key.h>
@@ -60,6 +63,7 @@
 #include <util/strencodings.h>
 #include <util/system.h>
 #include <util/threadnames.h>
+#include <util/threadpolicy.h>
 #include <util/translation.h>
 #include <util/validation.h>
 #include <validation.h>
@@ -98,6 +102,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <future>
 #include <memory>
 #include <set>
 #include <thread>
@@ -138,6 +143,17 @@ static CDSNotificationInterface* pdsNotificationInterface = nullptr;
 
 static const char* FEE_ESTIMATES_FILENAME="fee_estimates.dat";
 
+/** Write the current fee estimator state to fee_estimates.dat */
+static void FlushFeeEstimates()
+{
+    fs::path est_path = GetDataDir() / FEE_ESTIMATES_FILENAME;
+    CAutoFile est_fileout(fsbridge::fopen(est_path, "wb"), SER_DISK, CLIENT_VERSION);
+    if (!est_fileout.IsNull())
+        ::feeEstimator.Write(est_fileout);
+    else
+        LogPrintf("%s: Failed to write fee estimates to %s\n", __func__, est_path.string());
+}
+
 static const char* DEFAULT_ASMAP_FILENAME="ip_asn.map";
 /**
  * The PID file facilities.
@@ -210,6 +226,12 @@ void Interrupt(NodeContext& node)
         g_txindex->Interrupt();
     }
     ForEachBlockFilterIndex([](BlockFilterIndex& index) { index.Interrupt(); });
+    if (g_coin_stats_index) {
+        g_coin_stats_index->Interrupt();
+    }
+    if (g_block_stats_index) {
+        g_block_stats_index->Interrupt();
+    }
 }
 
 /** Preparing steps before shutting down or restarting the wallet */
@@ -262,17 +284,44 @@ void PrepareShutdown(NodeContext& node)
     // CValidationInterface callbacks, flush them...
     GetMainSignals().FlushBackgroundCallbacks();
 
-    if (!fRPCInWarmup) {
-        // STORE DATA CACHES INTO SERIALIZED DAT FILES
-        CFlatDB<CMasternodeMetaMan> flatdb1("mncache.dat", "magicMasternodeCache");
-        flatdb1.Dump(mmetaman);
-        CFlatDB<CNetFulfilledRequestManager> flatdb4("netfulfilled.dat", "magicFulfilledCache");
-        flatdb4.Dump(netfulfilledman);
-        CFlatDB<CSporkManager> flatdb6("sporks.dat", "magicSporkCache");
-        flatdb6.Dump(*::sporkManager);
-        if (!fDisableGovernance) {
-            CFlatDB<CGovernanceManager> flatdb3("governance.dat", "magicGovernanceCache");
-            flatdb3.Dump(*::governance);
+    // STORE DATA CACHES INTO SERIALIZED DAT FILES
+    // These stores go to independent files of independent subsystems (all of
+    // which are quiescent by now), so flush them in parallel: this phase then
+    // costs as much as the slowest store instead of the sum of all of them,
+    // which matters for masternodes whose PoSe score counts every second of
+    // downtime during an upgrade.
+    {
+        const int64_t nStart = GetTimeMillis();
+        std::vector<std::thread> flushThreads;
+        if (!fRPCInWarmup) {
+            flushThreads.emplace_back([] {
+                CFlatDB<CMasternodeMetaMan> flatdb1("mncache.dat", "magicMasternodeCache");
+                flatdb1.Dump(mmetaman);
+            });
+            flushThreads.emplace_back([] {
+                CFlatDB<CNetFulfilledRequestManager> flatdb4("netfulfilled.dat", "magicFulfilledCache");
+                flatdb4.Dump(netfulfilledman);
+            });
+            flushThreads.emplace_back([] {
+                CFlatDB<CSporkManager> flatdb6("sporks.dat", "magicSporkCache");
+                flatdb6.Dump(*::sporkManager);
+            });
+            if (!fDisableGovernance) {
+                flushThreads.emplace_back([] {
+                    ::governance->FlushDatabase(/*fForce=*/true);
+                });
+            }
+        }
+        if (node.mempool && node.mempool->IsLoaded() && node.args->GetArg("-persistmempool", DEFAULT_PERSIST_MEMPOOL)) {
+            flushThreads.emplace_back([&node] {
+                DumpMempool(*node.mempool);
+            });
+        }
+        for (auto& flushThread : flushThreads) {
+            flushThread.join();
+        }
+        if (!flushThreads.empty()) {
+            LogPrintf("%s: flushed %d data stores in %dms\n", __func__, flushThreads.size(), GetTimeMillis() - nStart);
         }
     }
 
@@ -282,19 +331,10 @@ void PrepareShutdown(NodeContext& node)
     node.connman.reset();
     node.banman.reset();
 
-    if (node.mempool && node.mempool->IsLoaded() && node.args->GetArg("-persistmempool", DEFAULT_PERSIST_MEMPOOL)) {
-        DumpMempool(*node.mempool);
-    }
-
     if (fFeeEstimatesInitialized)
     {
         ::feeEstimator.FlushUnconfirmed();
-        fs::path est_path = GetDataDir() / FEE_ESTIMATES_FILENAME;
-        CAutoFile est_fileout(fsbridge::fopen(est_path, "wb"), SER_DISK, CLIENT_VERSION);
-        if (!est_fileout.IsNull())
-            ::feeEstimator.Write(est_fileout);
-        else
-            LogPrintf("%s: Failed to write fee estimates to %s\n", __func__, est_path.string());
+        FlushFeeEstimates();
         fFeeEstimatesInitialized = false;
     }
 
@@ -329,6 +369,14 @@ void PrepareShutdown(NodeContext& node)
     }
     ForEachBlockFilterIndex([](BlockFilterIndex& index) { index.Stop(); });
     DestroyAllBlockFilterIndexes();
+    if (g_coin_stats_index) {
+        g_coin_stats_index->Stop();
+        g_coin_stats_index.reset();
+    }
+    if (g_block_stats_index) {
+        g_block_stats_index->Stop();
+        g_block_stats_index.reset();
+    }
 
     // Any future callbacks will be dropped. This should absolutely be safe - if
     // missing a callback results in an unrecoverable situation, unclean shutdown
@@ -512,16 +560,19 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-alertnotify=<cmd>", "Execute command when an alert is raised (%s in cmd is replaced by message)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-assumevalid=<hex>", strprintf("If this block is in the chain assume that it and its ancestors are valid and potentially skip their script verification (0 to verify all, default: %s, testnet: %s)", defaultChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnetChainParams->GetConsensus().defaultAssumeValid.GetHex()), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-assumechainlocks", strprintf("Assume blocks covered by a verified chainlock have valid scripts and skip their script verification, like -assumevalid but following the network's chainlock. Mainly useful to speed up -reindex-chainstate (default: %u)", 0), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksdir=<dir>", "Specify directory to hold blocks subdirectory for *.dat files (default: <datadir>)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #if HAVE_SYSTEM
-    argsman.AddArg("-blocknotify=<cmd>", "Execute command when the best block changes (%s in cmd is replaced by block hash)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blocknotify=<cmd>", "Execute command when the best block changes (%s in cmd is replaced by block hash). Spawns a process per event; latency-sensitive local consumers should use a ZMQ notifier over an ipc:// endpoint instead, see doc/zmq.md", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-blockreconstructionextratxn=<n>", strprintf("Extra transactions to keep in memory for compact block reconstructions (default: %u)", DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksonly", strprintf("Whether to reject transactions from network peers. Automatic broadcast and rebroadcast of any transactions from inbound peers is disabled, unless the peer has the 'forcerelay' permission. RPC transactions are not affected. (default: %u)", DEFAULT_BLOCKSONLY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-compressundo", strprintf("Write newly created block undo (rev*.dat) records in a compact format, reducing undo write volume and disk usage. Records written this way cannot be read by older versions (default: %u)", DEFAULT_COMPRESS_UNDO), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-conf=<file>", strprintf("Specify path to read-only configuration file. Relative paths will be prefixed by datadir location. (default: %s)", BITCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-datadir=<dir>", "Specify data directory", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbbatchsize", strprintf("Maximum database write batch size in bytes (default: %u)", nDefaultDbBatchSize), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbcache=<n>", strprintf("Maximum database cache size <n> MiB (%d to %d, default: %d). In addition, unused mempool memory is shared for this cache (see -maxmempool).", nMinDbCache, nMaxDbCache, nDefaultDbCache), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dbcachehugepages", strprintf("Back the coins cache with 2MB huge pages where the OS supports it, reducing TLB pressure for large -dbcache values (default: %u)", fDefaultDbCacheHugePages), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-debuglogfile=<file>", strprintf("Specify location of debug log file. Relative paths will be prefixed by a net-specific datadir location. (-nodebuglogfile to disable; default: %s)", DEFAULT_DEBUGLOGFILE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-includeconf=<file>", "Specify additional configuration file, relative to the -datadir path (only useable from configuration file, not command line)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-loadblock=<file>", "Imports blocks from external file on startup", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -533,6 +584,8 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-par=<n>", strprintf("Set the number of script verification threads (%u to %d, 0 = auto, <0 = leave that many cores free, default: %d)",
         -GetNumCores(), MAX_SCRIPTCHECK_THREADS, DEFAULT_SCRIPTCHECK_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-persistmempool", strprintf("Whether to save the mempool on shutdown and load on restart (default: %u)", DEFAULT_PERSIST_MEMPOOL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-schedulerthreads=<n>", "Set the number of background scheduler service threads. More than one allows independent periodic tasks to run concurrently (default: 1)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-threadpolicy=<spec>", "Set CPU affinity and scheduling for a group of worker threads, as <name-prefix>:<cpulist>[:<nice>[:<sched>]] with <sched> one of other, batch, fifo<prio>, rr<prio>. Can be specified multiple times; the first spec whose prefix matches a thread's name wins (e.g. -threadpolicy=scriptch:2-5 -threadpolicy=sigshares::-5:fifo10). Only supported on Linux", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-pid=<file>", strprintf("Specify pid file. Relative paths will be prefixed by a net-specific datadir location. (default: %s)", BITCOIN_PID_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-prune=<n>", strprintf("Reduce storage requirements by enabling pruning (deleting) of old blocks. This allows the pruneblockchain RPC to be called to delete specific blocks, and enables automatic pruning of old blocks if a target size in MiB is provided. This mode is incompatible with -txindex, -rescan and -disablegovernance=false. "
             "Warning: Reverting this setting requires re-downloading the entire blockchain. "
@@ -552,10 +605,13 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-spentindex", strprintf("Maintain a full spent index, used to query the spending txid and input index for an outpoint (default: %u)", DEFAULT_SPENTINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::INDEXING);
     argsman.AddArg("-timestampindex", strprintf("Maintain a timestamp index for block hashes, used to query blocks hashes by a range of timestamps (default: %u)", DEFAULT_TIMESTAMPINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::INDEXING);
     argsman.AddArg("-txindex", strprintf("Maintain a full transaction index, used by the getrawtransaction rpc call (default: %u)", DEFAULT_TXINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::INDEXING);
+    argsman.AddArg("-txindexfull", strprintf("Store serialized transactions inline in the transaction index, so that getrawtransaction is served without block file reads at the cost of additional disk usage. Requires -txindex. Changing this option for an existing index requires -reindex (default: %u)", DEFAULT_TXINDEX_FULL), ArgsManager::ALLOW_ANY, OptionsCategory::INDEXING);
     argsman.AddArg("-blockfilterindex=<type>",
                  strprintf("Maintain an index of compact filters by block (default: %s, values: %s).", DEFAULT_BLOCKFILTERINDEX, ListBlockFilterTypes()) +
                  " If <type> is not supplied or if <type> = 1, indexes for all known types are enabled.",
                  ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blockstatsindex", strprintf("Maintain per-block statistics records, used by the getblockstats RPC (default: %u)", DEFAULT_BLOCKSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::INDEXING);
+    argsman.AddArg("-coinstatsindex", strprintf("Maintain an incremental hash of the UTXO set, used by the gettxoutsetinfo RPC (default: %u)", DEFAULT_COINSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::INDEXING);
 
     argsman.AddArg("-asmap=<file>", strprintf("Specify asn mapping used for bucketing of the peers (default: %s). Relative paths will be prefixed by the net-specific datadir location.", DEFAULT_ASMAP_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-addnode=<ip>", "Add a node to connect to and attempt to keep the connection open (see the `addnode` RPC command help for more info). This option can be specified multiple times to add multiple nodes.", ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::CONNECTION);
@@ -714,6 +770,8 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-limitdescendantsize=<n>", strprintf("Do not accept transactions if any ancestor would have more than <n> kilobytes of in-mempool descendants (default: %u).", DEFAULT_DESCENDANT_SIZE_LIMIT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-stopafterblockimport", strprintf("Stop running after importing blocks from disk (default: %u)", DEFAULT_STOPAFTERBLOCKIMPORT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-stopatheight", strprintf("Stop running after reaching the given height in the main chain (default: %u)", DEFAULT_STOPATHEIGHT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-txinvbroadcastinterval=<n>", "Average transaction inv trickle interval in seconds (default: 5). Larger values aggregate announcements into fewer inv messages and reduce announcement bandwidth at the cost of relay latency", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-verifydbthreads=<n>", strprintf("Number of worker threads used for the block verification of -checkblocks (default: %d, 0 = determine from the number of cores)", DEFAULT_VERIFYDB_THREADS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-watchquorums=<n>", strprintf("Watch and validate quorum communication (default: %u)", llmq::DEFAULT_WATCH_QUORUMS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-addrmantest", "Allows to test address relay on localhost", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
 
@@ -725,7 +783,8 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-logtimemicros", strprintf("Add microsecond precision to debug timestamps (default: %u)", DEFAULT_LOGTIMEMICROS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-logtimestamps", strprintf("Prepend debug output with timestamp (default: %u)", DEFAULT_LOGTIMESTAMPS), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-logthreadnames", strprintf("Prepend debug output with name of the originating thread (only available on platforms supporting thread_local) (default: %u)", DEFAULT_LOGTHREADNAMES), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
-    argsman.AddArg("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache and script execution cache sizes to <n> MiB (default: %u)", DEFAULT_MAX_SIG_CACHE_SIZE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-maxsigcachesize=<n>", strprintf("Limit signature cache size to <n> MiB; unless -maxscriptcachesize is given, half of this is used for the script execution cache instead (default: %u)", DEFAULT_MAX_SIG_CACHE_SIZE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-maxscriptcachesize=<n>", strprintf("Limit script execution cache size to <n> MiB, independently of -maxsigcachesize (default: %u)", DEFAULT_MAX_SCRIPT_CACHE_SIZE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxtipage=<n>", strprintf("Maximum tip age in seconds to consider node in initial block download (default: %u)", DEFAULT_MAX_TIP_AGE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-mocktime=<n>", "Replace actual time with " + UNIX_EPOCH_TIME + "(default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-minsporkkeys=<n>", "Overrides minimum spork signers to change spork value. Only useful for regtest and devnet. Using this on mainnet or testnet will ban you.", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
@@ -768,6 +827,7 @@ void SetupServerArgs(NodeContext& node)
     argsman.AddArg("-rpcport=<port>", strprintf("Listen for JSON-RPC connections on <port> (default: %u, testnet: %u, regtest: %u)", defaultBaseParams->RPCPort(), testnetBaseParams->RPCPort(), regtestBaseParams->RPCPort()), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpcservertimeout=<n>", strprintf("Timeout during HTTP requests (default: %d)", DEFAULT_HTTP_SERVER_TIMEOUT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpcthreads=<n>", strprintf("Set the number of threads to service RPC calls (default: %d)", DEFAULT_HTTP_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg("-rpcslowthreads=<n>", strprintf("Set the number of threads to service known-slow RPC calls, so they can't stall short calls queued behind them (default: %d)", DEFAULT_HTTP_SLOW_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcuser=<user>", "Username for JSON-RPC connections", ArgsManager::ALLOW_ANY | ArgsManager::SENSITIVE, OptionsCategory::RPC);
     argsman.AddArg("-rpcwhitelist=<whitelist>", "Set a whitelist to filter incoming RPC calls for a specific user. The field <whitelist> comes in the format: <USERNAME>:<rpc 1>,<rpc 2>,...,<rpc n>. If multiple whitelists are set for a given user, they are set-intersected. See -rpcwhitelistdefault documentation for information on default whitelist behavior.", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcwhitelistdefault", "Sets default behavior for rpc whitelisting. Unless rpcwhitelistdefault is set to 0, if any -rpcwhitelist is set, the rpc server acts as if all rpc users are subject to empty-unless-otherwise-specified whitelists. If rpcwhitelistdefault is set to 1 and no -rpcwhitelist is set, rpc server acts as if all rpc users are subject to empty whitelists.", ArgsManager::ALLOW_BOOL, OptionsCategory::RPC);
@@ -1026,6 +1086,13 @@ static void PeriodicStats(ArgsManager& args, const CTxMemPool& mempool)
         statsClient.gauge("transactions.mempool.memoryUsageBytes", (int64_t) mempool.DynamicMemoryUsage(), 1.0f);
         statsClient.gauge("transactions.mempool.minFeePerKb", mempool.GetMinFee(args.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000).GetFeePerK(), 1.0f);
     }
+
+    // cumulative since startup, the backend can compute rates from these
+    for (const auto& [lockName, lockStats] : GetLockContentionStats()) {
+        statsClient.gauge("locks." + lockName + ".contentions", lockStats.count, 1.0f);
+        statsClient.gauge("locks." + lockName + ".waitTotalUs", lockStats.total_wait_usec, 1.0f);
+        statsClient.gauge("locks." + lockName + ".waitMaxUs", lockStats.max_wait_usec, 1.0f);
+    }
 }
 
 /** Sanity checks
@@ -1322,6 +1389,12 @@ bool AppInitParameterInteraction(const ArgsManager& args)
         if (!g_enabled_filter_types.empty()) {
             return InitError(_("Prune mode is incompatible with -blockfilterindex."));
         }
+        if (args.GetBoolArg("-coinstatsindex", DEFAULT_COINSTATSINDEX)) {
+            return InitError(_("Prune mode is incompatible with -coinstatsindex."));
+        }
+        if (args.GetBoolArg("-blockstatsindex", DEFAULT_BLOCKSTATSINDEX)) {
+            return InitError(_("Prune mode is incompatible with -blockstatsindex."));
+        }
     }
 
     if (args.IsArgSet("-devnet")) {
@@ -1397,6 +1470,11 @@ bool AppInitParameterInteraction(const ArgsManager& args)
     else
         LogPrintf("Validating signatures for all blocks.\n");
 
+    fAssumeChainLocks = args.GetBoolArg("-assumechainlocks", false);
+    if (fAssumeChainLocks) {
+        LogPrintf("Assuming chainlocked blocks have valid signatures.\n");
+    }
+
     if (args.IsArgSet("-minimumchainwork")) {
         const std::string minChainWorkStr = args.GetArg("-minimumchainwork", "");
         if (!IsHexNumber(minChainWorkStr)) {
@@ -1576,6 +1654,8 @@ bool AppInitSanityChecks()
     // Initialize elliptic curve code
     std::string sha256_algo = SHA256AutoDetect();
     LogPrintf("Using the '%s' SHA256 implementation\n", sha256_algo);
+    std::string siphash_algo = SipHashAutoDetect();
+    LogPrintf("Using the '%s' SipHash implementation\n", siphash_algo);
     RandomInit();
     ECC_Start();
     globalVerifyHandle.reset(new ECCVerifyHandle());
@@ -1668,6 +1748,15 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
     InitSignatureCache();
     InitScriptExecutionCache();
 
+    {
+        // Parse thread policies before any worker threads are spawned, so that
+        // every pool picks its policy up as its threads are named.
+        std::string error;
+        if (!util::InitThreadPolicies(args.GetArgs("-threadpolicy"), error)) {
+            return InitError(Untranslated(error));
+        }
+    }
+
     int script_threads = args.GetArg("-par", DEFAULT_SCRIPTCHECK_THREADS);
     if (script_threads <= 0) {
         // -par=0 means autodetect (number of cores - 1 script threads)
@@ -1712,8 +1801,11 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
     assert(!node.scheduler);
     node.scheduler = std::make_unique<CScheduler>();
 
-    // Start the lightweight task scheduler thread
-    node.scheduler->m_service_thread = std::thread([&] { TraceThread("scheduler", [&] { node.scheduler->serviceQueue(); }); });
+    // Start the lightweight task scheduler thread(s)
+    const int num_scheduler_threads = std::max<int64_t>(1, args.GetArg("-schedulerthreads", 1));
+    for (int i = 0; i < num_scheduler_threads; i++) {
+        node.scheduler->m_service_threads.emplace_back([&] { TraceThread("scheduler", [&] { node.scheduler->serviceQueue(); }); });
+    }
 
     // Gather some entropy once per minute.
     node.scheduler->scheduleEvery([]{
@@ -1749,11 +1841,20 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
     // ********************************************************* Step 5: verify wallet database integrity
 
     if (!g_wallet_init_interface.InitAutoBackup()) return false;
-    for (const auto& client : node.chain_clients) {
-        if (!client->verify()) {
-            return false;
+    // Wallet database verification only touches the wallet directory while the
+    // block/evo/llmq databases loaded in step 7 live elsewhere, so run it
+    // concurrently with the chain load and join right before the wallets are
+    // actually loaded in step 9. On any early return the future's destructor
+    // waits for the verification thread, so shutdown stays well ordered.
+    std::future<bool> chain_clients_verified = std::async(std::launch::async, [&node] {
+        util::ThreadRename("walletverify");
+        for (const auto& client : node.chain_clients) {
+            if (!client->verify()) {
+                return false;
+            }
         }
-    }
+        return true;
+    });
 
     // ********************************************************* Step 6: network initialization
     // Note that we absolutely cannot open any actual connections
@@ -1766,6 +1867,38 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
     assert(!node.connman);
     node.connman = std::make_unique<CConnman>(GetRand(std::numeric_limits<uint64_t>::max()), GetRand(std::numeric_limits<uint64_t>::max()));
 
+    // Read asmap file if configured. This must happen before the background
+    // peers.dat load below: CAddrMan::Unserialize reads m_asmap for bucket
+    // placement, so setting it while the load runs would be a data race.
+    if (args.IsArgSet("-asmap")) {
+        fs::path asmap_path = fs::path(args.GetArg("-asmap", ""));
+        if (asmap_path.empty()) {
+            asmap_path = DEFAULT_ASMAP_FILENAME;
+        }
+        if (!asmap_path.is_absolute()) {
+            asmap_path = GetDataDir() / asmap_path;
+        }
+        if (!fs::exists(asmap_path)) {
+            InitError(strprintf(_("Could not find asmap file %s"), asmap_path));
+            return false;
+        }
+        std::vector<bool> asmap = CAddrMan::DecodeAsmap(asmap_path);
+        if (asmap.size() == 0) {
+            InitError(strprintf(_("Could not parse asmap file %s"), asmap_path));
+            return false;
+        }
+        const uint256 asmap_version = SerializeHash(asmap);
+        node.connman->SetAsmap(std::move(asmap));
+        LogPrintf("Using asmap version %s for IP bucketing\n", asmap_version.ToString());
+    } else {
+        LogPrintf("Using /16 prefix for IP bucketing\n");
+    }
+
+    // Start reading peers.dat in the background so the deserialization
+    // overlaps with loading the block index; CConnman::Start() joins the
+    // thread before addrman is used.
+    node.connman->StartAddressLoad();
+
     // Make mempool generally available in the node context. For example the connection manager, wallet, or RPC threads,
     // which are all started after this, may use it from the node context.
     assert(!node.mempool);
@@ -1907,31 +2040,6 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
             return InitError(ResolveErrMsg("externalip", strAddr));
     }
 
-    // Read asmap file if configured
-    if (args.IsArgSet("-asmap")) {
-        fs::path asmap_path = fs::path(args.GetArg("-asmap", ""));
-        if (asmap_path.empty()) {
-            asmap_path = DEFAULT_ASMAP_FILENAME;
-        }
-        if (!asmap_path.is_absolute()) {
-            asmap_path = GetDataDir() / asmap_path;
-        }
-        if (!fs::exists(asmap_path)) {
-            InitError(strprintf(_("Could not find asmap file %s"), asmap_path));
-            return false;
-        }
-        std::vector<bool> asmap = CAddrMan::DecodeAsmap(asmap_path);
-        if (asmap.size() == 0) {
-            InitError(strprintf(_("Could not parse asmap file %s"), asmap_path));
-            return false;
-        }
-        const uint256 asmap_version = SerializeHash(asmap);
-        node.connman->SetAsmap(std::move(asmap));
-        LogPrintf("Using asmap version %s for IP bucketing\n", asmap_version.ToString());
-    } else {
-        LogPrintf("Using /16 prefix for IP bucketing\n");
-    }
-
 #if ENABLE_ZMQ
     g_zmq_notification_interface = CZMQNotificationInterface::Create();
 
@@ -2070,22 +2178,46 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
                     return InitError(_("Incorrect or no devnet genesis block found. Wrong datadir for devnet specified?"));
                 }
 
+                // Check for changed index states. A chainstate replay re-runs
+                // ConnectBlock for every block already on disk and thereby
+                // rebuilds all optional indexes, so -reindex-chainstate is
+                // enough to change them - no need to rebuild the block index
+                // from raw block files.
+
                 // Check for changed -addressindex state
                 if (fAddressIndex != args.GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX)) {
-                    strLoadError = _("You need to rebuild the database using -reindex to change -addressindex");
-                    break;
+                    if (fReindexChainState) {
+                        fAddressIndex = args.GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX);
+                        pblocktree->WriteFlag("addressindex", fAddressIndex);
+                        LogPrintf("%s: address index %s via -reindex-chainstate\n", __func__, fAddressIndex ? "enabled" : "disabled");
+                    } else {
+                        strLoadError = _("You need to rebuild the database using -reindex or -reindex-chainstate to change -addressindex");
+                        break;
+                    }
                 }
 
                 // Check for changed -timestampindex state
                 if (fTimestampIndex != args.GetBoolArg("-timestampindex", DEFAULT_TIMESTAMPINDEX)) {
-                    strLoadError = _("You need to rebuild the database using -reindex to change -timestampindex");
-                    break;
+                    if (fReindexChainState) {
+                        fTimestampIndex = args.GetBoolArg("-timestampindex", DEFAULT_TIMESTAMPINDEX);
+                        pblocktree->WriteFlag("timestampindex", fTimestampIndex);
+                        LogPrintf("%s: timestamp index %s via -reindex-chainstate\n", __func__, fTimestampIndex ? "enabled" : "disabled");
+                    } else {
+                        strLoadError = _("You need to rebuild the database using -reindex or -reindex-chainstate to change -timestampindex");
+                        break;
+                    }
                 }
 
                 // Check for changed -spentindex state
                 if (fSpentIndex != args.GetBoolArg("-spentindex", DEFAULT_SPENTINDEX)) {
-                    strLoadError = _("You need to rebuild the database using -reindex to change -spentindex");
-                    break;
+                    if (fReindexChainState) {
+                        fSpentIndex = args.GetBoolArg("-spentindex", DEFAULT_SPENTINDEX);
+                        pblocktree->WriteFlag("spentindex", fSpentIndex);
+                        LogPrintf("%s: spent index %s via -reindex-chainstate\n", __func__, fSpentIndex ? "enabled" : "disabled");
+                    } else {
+                        strLoadError = _("You need to rebuild the database using -reindex or -reindex-chainstate to change -spentindex");
+                        break;
+                    }
                 }
 
                 // Check for changed -prune state.  What we are concerned about is a user who has pruned blocks
@@ -2273,7 +2405,7 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
 
     // ********************************************************* Step 8: start indexers
     if (args.GetBoolArg("-txindex", DEFAULT_TXINDEX)) {
-        g_txindex = std::make_unique<TxIndex>(nTxIndexCache, false, fReindex);
+        g_txindex = std::make_unique<TxIndex>(nTxIndexCache, false, fReindex, args.GetBoolArg("-txindexfull", DEFAULT_TXINDEX_FULL));
         g_txindex->Start();
     }
 
@@ -2282,7 +2414,20 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
         GetBlockFilterIndex(filter_type)->Start();
     }
 
+    if (args.GetBoolArg("-coinstatsindex", DEFAULT_COINSTATSINDEX)) {
+        g_coin_stats_index = std::make_unique<CoinStatsIndex>(/* cache size */ 0, false, fReindex);
+        g_coin_stats_index->Start();
+    }
+
+    if (args.GetBoolArg("-blockstatsindex", DEFAULT_BLOCKSTATSINDEX)) {
+        g_block_stats_index = std::make_unique<BlockStatsIndex>(/* cache size */ 0, false, fReindex);
+        g_block_stats_index->Start();
+    }
+
     // ********************************************************* Step 9: load wallet
+    if (!chain_clients_verified.get()) {
+        return false;
+    }
     for (const auto& client : node.chain_clients) {
         if (!client->load()) {
             return false;
@@ -2352,19 +2497,12 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
         }
     }
 
-    strDBName = "governance.dat";
     uiInterface.InitMessage(_("Loading governance cache...").translated);
-    CFlatDB<CGovernanceManager> flatdb3(strDBName, "magicGovernanceCache");
+    if (!::governance->LoadDatabase(!fLoadCacheFiles || fDisableGovernance)) {
+        return InitError(strprintf(_("Failed to load governance cache from %s"), (pathDB / "governance").string()));
+    }
     if (fLoadCacheFiles && !fDisableGovernance) {
-        if(!flatdb3.Load(*::governance)) {
-            return InitError(strprintf(_("Failed to load governance cache from %s"), (pathDB / strDBName).string()));
-        }
         ::governance->InitOnLoad();
-    } else {
-        CGovernanceManager governanceTmp;
-        if(!flatdb3.Dump(governanceTmp)) {
-            return InitError(strprintf(_("Failed to clear governance cache at %s"), (pathDB / strDBName).string()));
-        }
     }
 
     strDBName = "netfulfilled.dat";
@@ -2383,6 +2521,23 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
 
     // ********************************************************* Step 10b: schedule Dash-specific tasks
 
+    // Flush the chainstate from the scheduler thread once the coins cache
+    // grows LARGE, so that block connection (which holds cs_main while it
+    // flushes) rarely has to do the expensive full flush itself.
+    node.scheduler->scheduleEvery([]{
+        CValidationState state_dummy;
+        ::ChainstateActive().FlushStateToDisk(Params(), state_dummy, FlushStateMode::BACKGROUND);
+    }, std::chrono::minutes{1});
+
+    // Trim the mempool back to -maxmempool in the background. ATMP leaves eviction to
+    // this task while the pool is within a small headroom above the limit.
+    node.scheduler->scheduleEvery(std::bind(&TrimMempool, std::ref(*node.mempool)), std::chrono::seconds{10});
+
+    // Periodically checkpoint fee estimates. Without this the estimator state
+    // is only written at clean shutdown, and a crash costs estimate quality
+    // until the tracking windows refill after restart.
+    node.scheduler->scheduleEvery([]{ FlushFeeEstimates(); }, std::chrono::hours{1});
+
     node.scheduler->scheduleEvery(std::bind(&CNetFulfilledRequestManager::DoMaintenance, std::ref(netfulfilledman)), std::chrono::minutes{1});
     node.scheduler->scheduleEvery(std::bind(&CMasternodeSync::DoMaintenance, std::ref(*::masternodeSync)), std::chrono::seconds{1});
     node.scheduler->scheduleEvery(std::bind(&CMasternodeUtils::DoMaintenance, std::ref(*node.connman), std::ref(*::masternodeSync)), std::chrono::minutes{1});
@@ -2390,6 +2545,8 @@ bool AppInitMain(const CoreContext& context, NodeContext& node, interfaces::Bloc
 
     if (!fDisableGovernance) {
         node.scheduler->scheduleEvery(std::bind(&CGovernanceManager::DoMaintenance, std::ref(*::governance), std::ref(*node.connman)), std::chrono::minutes{5});
+        // Persist dirty governance objects incrementally instead of dumping everything at shutdown
+        node.scheduler->scheduleEvery(std::bind(&CGovernanceManager::FlushDatabase, std::ref(*::governance), false), std::chrono::minutes{5});
     }
 
     if (fMasternodeMode) {
@@ -7,6 +7,9 @@
 #include <base58.h>
 #include <bech32.h>
 #include <chainparams.h>
+#include <saltedhasher.h>
+#include <sync.h>
+#include <unordered_lru_cache.h>
 
 #include <algorithm>
 #include <assert.h>
@@ -145,7 +148,34 @@ std::string EncodeExtKey(const CExtKey& key)
 
 std::string EncodeDestination(const CTxDestination& dest)
 {
-    return std::visit(DestinationEncoder(Params()), dest);
+    // Base58check encoding runs two SHA256 passes per call, and the same
+    // destinations repeat heavily in verbose RPC responses and address index
+    // queries, so memoize recent encodings. The network prefix byte is part
+    // of the key to stay correct when tests switch chain params.
+    static Mutex cs;
+    static unordered_lru_cache<std::pair<uint32_t, uint160>, std::string, StaticSaltedHasher, 10000> cache GUARDED_BY(cs);
+
+    const CChainParams& params = Params();
+    std::pair<uint32_t, uint160> key;
+    if (const PKHash* id = std::get_if<PKHash>(&dest)) {
+        key = {params.Base58Prefix(CChainParams::PUBKEY_ADDRESS).at(0), *id};
+    } else if (const ScriptHash* id = std::get_if<ScriptHash>(&dest)) {
+        key = {0x100u | params.Base58Prefix(CChainParams::SCRIPT_ADDRESS).at(0), *id};
+    } else {
+        return std::visit(DestinationEncoder(params), dest);
+    }
+
+    {
+        LOCK(cs);
+        std::string ret;
+        if (cache.get(key, ret)) {
+            return ret;
+        }
+    }
+    std::string ret = std::visit(DestinationEncoder(params), dest);
+    LOCK(cs);
+    cache.insert(key, ret);
+    return ret;
 }
 
 CTxDestination DecodeDestination(const std::string& str)
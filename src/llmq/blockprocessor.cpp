@@ -525,6 +525,23 @@ bool CQuorumBlockProcessor::HasMinedCommitment(Consensus::LLMQType llmqType, con
     return fExists;
 }
 
+bool CQuorumBlockProcessor::HasMinedCommitmentAtHeight(Consensus::LLMQType llmqType, int nHeight) const
+{
+    const auto& llmq_params_opt = GetLLMQParams(llmqType);
+    assert(llmq_params_opt.has_value());
+
+    // Point lookups on the inversed height keys, much cheaper than a cursor scan
+    if (llmq_params_opt->useRotation) {
+        for (const auto quorumIndex : irange::range(llmq_params_opt->signingActiveQuorumCount)) {
+            if (m_evoDb.Exists(BuildInversedHeightKeyIndexed(llmqType, nHeight, quorumIndex))) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return m_evoDb.Exists(BuildInversedHeightKey(llmqType, nHeight));
+}
+
 CFinalCommitmentPtr CQuorumBlockProcessor::GetMinedCommitment(Consensus::LLMQType llmqType, const uint256& quorumHash, uint256& retMinedBlockHash) const
 {
     auto key = std::make_pair(DB_MINED_COMMITMENT, std::make_pair(llmqType, quorumHash));
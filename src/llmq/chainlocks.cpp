@@ -306,12 +306,12 @@ void CChainLocksHandler::TrySignChainTip()
             }
 
             for (const auto& txid : *txids) {
-                int64_t txAge = 0;
+                // A missing entry means the TX was first seen longer than the timeout ago
+                int64_t txAge{WAIT_FOR_ISLOCK_TIMEOUT};
                 {
                     LOCK(cs);
-                    auto it = txFirstSeenTime.find(txid);
-                    if (it != txFirstSeenTime.end()) {
-                        txAge = GetAdjustedTime() - it->second;
+                    if (auto firstSeenTime = txFirstSeenTime.Get(txid)) {
+                        txAge = GetAdjustedTime() - *firstSeenTime;
                     }
                 }
 
@@ -350,7 +350,7 @@ void CChainLocksHandler::TransactionAddedToMempool(const CTransactionRef& tx, in
     }
 
     LOCK(cs);
-    txFirstSeenTime.emplace(tx->GetHash(), nAcceptTime);
+    txFirstSeenTime.Emplace(tx->GetHash(), nAcceptTime);
 }
 
 void CChainLocksHandler::BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex)
@@ -381,7 +381,7 @@ void CChainLocksHandler::BlockConnected(const std::shared_ptr<const CBlock>& pbl
         }
 
         txids.emplace(tx->GetHash());
-        txFirstSeenTime.emplace(tx->GetHash(), curTime);
+        txFirstSeenTime.Emplace(tx->GetHash(), curTime);
     }
 
 }
@@ -435,7 +435,7 @@ CChainLocksHandler::BlockTxs::mapped_type CChainLocksHandler::GetBlockTxs(const
         LOCK(cs);
         blockTxs.emplace(blockHash, ret);
         for (const auto& txid : *ret) {
-            txFirstSeenTime.emplace(txid, blockTime);
+            txFirstSeenTime.Emplace(txid, blockTime);
         }
     }
     return ret;
@@ -457,12 +457,12 @@ bool CChainLocksHandler::IsTxSafeForMining(const CInstantSendManager& isman, con
         return true;
     }
 
-    int64_t txAge = 0;
+    // A missing entry means the TX was first seen longer than the timeout ago
+    int64_t txAge{WAIT_FOR_ISLOCK_TIMEOUT};
     {
         LOCK(cs);
-        auto it = txFirstSeenTime.find(txid);
-        if (it != txFirstSeenTime.end()) {
-            txAge = GetAdjustedTime() - it->second;
+        if (auto firstSeenTime = txFirstSeenTime.Get(txid)) {
+            txAge = GetAdjustedTime() - *firstSeenTime;
         }
     }
 
@@ -626,51 +626,38 @@ void CChainLocksHandler::Cleanup()
         }
     }
 
-    // need mempool.cs due to GetTransaction calls
-    LOCK2(cs_main, mempool.cs);
-    LOCK(cs);
+    // First-seen times expire a whole generation at a time; keep the dropped
+    // generation alive until cs is released so that its destruction doesn't
+    // delay TrySignChainTip.
+    CTxFirstSeenMap::TimeMap droppedTxTimes;
 
-    for (auto it = seenChainLocks.begin(); it != seenChainLocks.end(); ) {
-        if (GetTimeMillis() - it->second >= CLEANUP_SEEN_TIMEOUT) {
-            it = seenChainLocks.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    {
+        LOCK(cs_main);
+        LOCK(cs);
 
-    for (auto it = blockTxs.begin(); it != blockTxs.end(); ) {
-        auto* pindex = LookupBlockIndex(it->first);
-        if (InternalHasChainLock(pindex->nHeight, pindex->GetBlockHash())) {
-            for (const auto& txid : *it->second) {
-                txFirstSeenTime.erase(txid);
+        for (auto it = seenChainLocks.begin(); it != seenChainLocks.end(); ) {
+            if (GetTimeMillis() - it->second >= CLEANUP_SEEN_TIMEOUT) {
+                it = seenChainLocks.erase(it);
+            } else {
+                ++it;
             }
-            it = blockTxs.erase(it);
-        } else if (InternalHasConflictingChainLock(pindex->nHeight, pindex->GetBlockHash())) {
-            it = blockTxs.erase(it);
-        } else {
-            ++it;
         }
-    }
-    for (auto it = txFirstSeenTime.begin(); it != txFirstSeenTime.end(); ) {
-        uint256 hashBlock;
-        CTransactionRef tx = GetTransaction(/* block_index */ nullptr, &mempool, it->first, Params().GetConsensus(), hashBlock);
-        if (!tx) {
-            // tx has vanished, probably due to conflicts
-            it = txFirstSeenTime.erase(it);
-        } else if (!hashBlock.IsNull()) {
-            auto* pindex = LookupBlockIndex(hashBlock);
-            if (::ChainActive().Tip()->GetAncestor(pindex->nHeight) == pindex && ::ChainActive().Height() - pindex->nHeight >= 6) {
-                // tx got confirmed >= 6 times, so we can stop keeping track of it
-                it = txFirstSeenTime.erase(it);
+
+        for (auto it = blockTxs.begin(); it != blockTxs.end(); ) {
+            auto* pindex = LookupBlockIndex(it->first);
+            if (InternalHasChainLock(pindex->nHeight, pindex->GetBlockHash())) {
+                it = blockTxs.erase(it);
+            } else if (InternalHasConflictingChainLock(pindex->nHeight, pindex->GetBlockHash())) {
+                it = blockTxs.erase(it);
             } else {
                 ++it;
             }
-        } else {
-            ++it;
         }
-    }
 
-    lastCleanupTime = GetTimeMillis();
+        droppedTxTimes = txFirstSeenTime.Rotate(GetAdjustedTime(), WAIT_FOR_ISLOCK_TIMEOUT);
+
+        lastCleanupTime = GetTimeMillis();
+    }
 }
 
 bool AreChainLocksEnabled(const CSporkManager& sporkManager)
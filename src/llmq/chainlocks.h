@@ -17,6 +17,7 @@
 #include <sync.h>
 
 #include <atomic>
+#include <optional>
 #include <unordered_set>
 
 class CConnman;
@@ -72,7 +73,56 @@ private:
     };
     using BlockTxs = std::unordered_map<uint256, std::shared_ptr<std::unordered_set<uint256, StaticSaltedHasher>>, BlockHasher>;
     BlockTxs blockTxs GUARDED_BY(cs);
-    std::unordered_map<uint256, int64_t, StaticSaltedHasher> txFirstSeenTime GUARDED_BY(cs);
+
+    /** First-seen times of recent TXs, kept in two generations which rotate
+     * every WAIT_FOR_ISLOCK_TIMEOUT seconds: inserts go into the current
+     * generation and rotation drops the previous one as a whole, so eviction
+     * is O(1) instead of a full-map scan under cs. An entry stays retrievable
+     * for at least WAIT_FOR_ISLOCK_TIMEOUT after insertion, so a missing
+     * entry can only belong to a TX first seen longer than that ago. */
+    class CTxFirstSeenMap
+    {
+    public:
+        using TimeMap = std::unordered_map<uint256, int64_t, StaticSaltedHasher>;
+
+    private:
+        TimeMap mapCurrent;
+        TimeMap mapPrevious;
+        int64_t lastRotationTime{0};
+
+    public:
+        void Emplace(const uint256& txid, int64_t nTime)
+        {
+            if (mapPrevious.count(txid)) {
+                return;
+            }
+            mapCurrent.emplace(txid, nTime);
+        }
+        std::optional<int64_t> Get(const uint256& txid) const
+        {
+            auto it = mapCurrent.find(txid);
+            if (it == mapCurrent.end()) {
+                it = mapPrevious.find(txid);
+                if (it == mapPrevious.end()) {
+                    return std::nullopt;
+                }
+            }
+            return it->second;
+        }
+        //! Returns the dropped generation so that the caller can destroy it outside of cs
+        TimeMap Rotate(int64_t nNow, int64_t nMaxAge)
+        {
+            if (nNow - lastRotationTime < nMaxAge) {
+                return {};
+            }
+            lastRotationTime = nNow;
+            TimeMap mapDropped{std::move(mapPrevious)};
+            mapPrevious = std::move(mapCurrent);
+            mapCurrent = TimeMap{};
+            return mapDropped;
+        }
+    };
+    CTxFirstSeenMap txFirstSeenTime GUARDED_BY(cs);
 
     std::map<uint256, int64_t> seenChainLocks GUARDED_BY(cs);
 
@@ -9,6 +9,7 @@
 
 #include <chainparams.h>
 #include <consensus/validation.h>
+#include <hash.h>
 #include <llmq/utils.h>
 #include <logging.h>
 #include <validation.h>
@@ -25,6 +26,16 @@ CFinalCommitment::CFinalCommitment(const Consensus::LLMQParams& params, const ui
 {
 }
 
+//! Cache of final commitments whose BLS signatures already verified, the
+//! sigcache analogue for qfcommit. The relay path verifies commitments with
+//! checkSigs=true before they are mined, so block validation usually only pays
+//! a lookup here instead of 50-100ms of pairings per rotation block. The key
+//! commits to the full commitment and the quorum base block hash, since the
+//! member set (and with it the aggregate key) depends on the latter.
+static constexpr size_t COMMITMENT_VALID_CACHE_MAX{200};
+static Mutex cs_commitment_valid_cache;
+static std::set<uint256> commitmentValidCache GUARDED_BY(cs_commitment_valid_cache);
+
 template<typename... Types>
 void LogPrintfFinalCommitment(Types... out) {
     if (LogAcceptCategory(BCLog::LLMQ)) {
@@ -115,6 +126,14 @@ bool CFinalCommitment::Verify(const CBlockIndex* pQuorumBaseBlockIndex, bool che
 
     // sigs are only checked when the block is processed
     if (checkSigs) {
+        CHashWriter hw(SER_GETHASH, 0);
+        hw << *this << pQuorumBaseBlockIndex->GetBlockHash();
+        const uint256 cacheKey = hw.GetHash();
+        if (WITH_LOCK(cs_commitment_valid_cache, return commitmentValidCache.count(cacheKey) > 0)) {
+            LogPrintfFinalCommitment("q[%s] VALID (cached)\n", quorumHash.ToString());
+            return true;
+        }
+
         uint256 commitmentHash = utils::BuildCommitmentHash(llmq_params.type, quorumHash, validMembers, quorumPublicKey, quorumVvecHash);
         if (LogAcceptCategory(BCLog::LLMQ)) {
             std::stringstream ss3;
@@ -141,6 +160,12 @@ bool CFinalCommitment::Verify(const CBlockIndex* pQuorumBaseBlockIndex, bool che
             LogPrintfFinalCommitment("q[%s] invalid quorum signature\n", quorumHash.ToString());
             return false;
         }
+
+        LOCK(cs_commitment_valid_cache);
+        if (commitmentValidCache.size() >= COMMITMENT_VALID_CACHE_MAX) {
+            commitmentValidCache.clear();
+        }
+        commitmentValidCache.emplace(cacheKey);
     }
 
     LogPrintfFinalCommitment("q[%s] VALID\n", quorumHash.ToString());
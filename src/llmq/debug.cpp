@@ -134,12 +134,72 @@ UniValue CDKGDebugStatus::ToJson(int detailLevel) const
     return ret;
 }
 
+UniValue CDKGDebugEvent::ToJson() const
+{
+    UniValue ret(UniValue::VOBJ);
+
+    ret.pushKV("seq", nSeq);
+    ret.pushKV("time", nTime);
+    if (const auto& llmq_params_opt = GetLLMQParams(llmqType); llmq_params_opt.has_value()) {
+        ret.pushKV("llmqType", std::string(llmq_params_opt->name));
+    }
+    ret.pushKV("quorumIndex", quorumIndex);
+    ret.pushKV("quorumHash", quorumHash.ToString());
+    ret.pushKV("quorumHeight", (int)quorumHeight);
+    ret.pushKV("phase", ToUnderlying(phase));
+    ret.pushKV("sentContributions", sentContributions);
+    ret.pushKV("sentComplaint", sentComplaint);
+    ret.pushKV("sentJustification", sentJustification);
+    ret.pushKV("sentPrematureCommitment", sentPrematureCommitment);
+    ret.pushKV("aborted", aborted);
+
+    return ret;
+}
+
 void CDKGDebugManager::GetLocalDebugStatus(llmq::CDKGDebugStatus& ret) const
 {
     LOCK(cs);
     ret = localStatus;
 }
 
+UniValue CDKGDebugManager::GetDebugEventsJson(uint64_t nSinceSeq) const
+{
+    LOCK(cs);
+
+    UniValue eventsArr(UniValue::VARR);
+    for (const auto& ev : events) {
+        if (ev.nSeq <= nSinceSeq) {
+            continue;
+        }
+        eventsArr.push_back(ev.ToJson());
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("lastSeq", lastEventSeq);
+    ret.pushKV("events", eventsArr);
+    return ret;
+}
+
+void CDKGDebugManager::PushEvent(Consensus::LLMQType llmqType, int quorumIndex, const CDKGDebugSessionStatus& session)
+{
+    AssertLockHeld(cs);
+
+    CDKGDebugEvent ev;
+    ev.nSeq = ++lastEventSeq;
+    ev.nTime = GetAdjustedTime();
+    ev.llmqType = llmqType;
+    ev.quorumIndex = quorumIndex;
+    ev.quorumHash = session.quorumHash;
+    ev.quorumHeight = session.quorumHeight;
+    ev.phase = session.phase;
+    ev.statusBitset = session.statusBitset;
+
+    events.emplace_back(ev);
+    if (events.size() > MAX_DEBUG_EVENTS) {
+        events.pop_front();
+    }
+}
+
 void CDKGDebugManager::ResetLocalSessionStatus(Consensus::LLMQType llmqType, int quorumIndex)
 {
     LOCK(cs);
@@ -149,6 +209,7 @@ void CDKGDebugManager::ResetLocalSessionStatus(Consensus::LLMQType llmqType, int
         return;
     }
 
+    PushEvent(llmqType, quorumIndex, it->second);
     localStatus.sessions.erase(it);
     localStatus.nTime = GetAdjustedTime();
 }
@@ -170,6 +231,8 @@ void CDKGDebugManager::InitLocalSessionStatus(const Consensus::LLMQParams& llmqP
     session.statusBitset = 0;
     session.members.clear();
     session.members.resize((size_t)llmqParams.size);
+
+    PushEvent(llmqParams.type, quorumIndex, session);
 }
 
 void CDKGDebugManager::UpdateLocalSessionStatus(Consensus::LLMQType llmqType, int quorumIndex, std::function<bool(CDKGDebugSessionStatus& status)>&& func)
@@ -182,6 +245,7 @@ void CDKGDebugManager::UpdateLocalSessionStatus(Consensus::LLMQType llmqType, in
     }
 
     if (func(it->second)) {
+        PushEvent(llmqType, quorumIndex, it->second);
         localStatus.nTime = GetAdjustedTime();
     }
 }
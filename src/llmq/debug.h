@@ -9,6 +9,7 @@
 #include <sync.h>
 #include <univalue.h>
 
+#include <deque>
 #include <functional>
 #include <set>
 
@@ -89,16 +90,61 @@ public:
     UniValue ToJson(int detailLevel) const;
 };
 
+/** A single session-level status change (init, phase transition, sent
+ * message, abort, reset), kept in a bounded ring so monitoring can consume
+ * deltas instead of polling full session rebuilds. Member-level message
+ * receipts are deliberately not recorded here; they arrive by the hundreds
+ * per phase and are still available through the full status. */
+class CDKGDebugEvent
+{
+public:
+    uint64_t nSeq{0};
+    int64_t nTime{0};
+    Consensus::LLMQType llmqType{Consensus::LLMQType::LLMQ_NONE};
+    int quorumIndex{0};
+    uint256 quorumHash;
+    uint32_t quorumHeight{0};
+    QuorumPhase phase{0};
+
+    union {
+        struct
+        {
+            bool sentContributions : 1;
+            bool sentComplaint : 1;
+            bool sentJustification : 1;
+            bool sentPrematureCommitment : 1;
+
+            bool aborted : 1;
+        };
+        uint8_t statusBitset;
+    };
+
+public:
+    CDKGDebugEvent() : statusBitset(0) {}
+
+    UniValue ToJson() const;
+};
+
 class CDKGDebugManager
 {
 private:
+    //! Bound on the event ring; old events are dropped once it is full
+    static constexpr size_t MAX_DEBUG_EVENTS{256};
+
     mutable CCriticalSection cs;
     CDKGDebugStatus localStatus GUARDED_BY(cs);
+    std::deque<CDKGDebugEvent> events GUARDED_BY(cs);
+    uint64_t lastEventSeq GUARDED_BY(cs){0};
+
+    void PushEvent(Consensus::LLMQType llmqType, int quorumIndex, const CDKGDebugSessionStatus& session) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
 public:
     CDKGDebugManager();
 
     void GetLocalDebugStatus(CDKGDebugStatus& ret) const;
+    //! Events with a sequence number greater than nSinceSeq, plus the last
+    //! assigned sequence number to use for the next poll
+    UniValue GetDebugEventsJson(uint64_t nSinceSeq) const;
 
     void ResetLocalSessionStatus(Consensus::LLMQType llmqType, int quorumIndex);
     void InitLocalSessionStatus(const Consensus::LLMQParams& llmqParams, int quorumIndex, const uint256& quorumHash, int quorumHeight);
@@ -288,8 +288,6 @@ void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
 
     logger.Batch("received and relayed contribution. received=%d/%d, time=%d", receivedCount, members.size(), t1.count());
 
-    cxxtimer::Timer t2(true);
-
     if (!AreWeMember()) {
         // can't further validate
         return;
@@ -297,29 +295,10 @@ void CDKGSession::ReceiveMessage(const CDKGContribution& qc, bool& retBan)
 
     dkgManager.WriteVerifiedVvecContribution(params.type, m_quorum_base_block_index, qc.proTxHash, qc.vvec);
 
-    bool complain = false;
-    CBLSSecretKey skContribution;
-    if (!qc.contributions->Decrypt(*myIdx, WITH_LOCK(activeMasternodeInfoCs, return *activeMasternodeInfo.blsKeyOperator), skContribution, PROTOCOL_VERSION)) {
-        logger.Batch("contribution from %s could not be decrypted", member->dmn->proTxHash.ToString());
-        complain = true;
-    } else if (member->idx != myIdx && ShouldSimulateError(DKGError::type::COMPLAIN_LIE)) {
-        logger.Batch("lying/complaining for %s", member->dmn->proTxHash.ToString());
-        complain = true;
-    }
-
-    if (complain) {
-        member->weComplain = true;
-        dkgDebugManager.UpdateLocalMemberStatus(params.type, quorumIndex, member->idx, [&](CDKGDebugMemberStatus& status) {
-            status.weComplain = true;
-            return true;
-        });
-        return;
-    }
-
-    logger.Batch("decrypted our contribution share. time=%d", t2.count());
-
+    // Decryption and verification of our share is deferred to VerifyPendingContributions, where
+    // it's done for a whole batch of contributions at once. This keeps the expensive crypto out of
+    // the per-message path.
     bool verifyPending = false;
-    receivedSkContributions[member->idx] = skContribution;
     vecEncryptedContributions[member->idx] = qc.contributions;
     pendingContributionVerifications.emplace_back(member->idx);
     if (pendingContributionVerifications.size() >= 32) {
@@ -353,17 +332,40 @@ void CDKGSession::VerifyPendingContributions()
     std::vector<BLSVerificationVectorPtr> vvecs;
     BLSSecretKeyVector skContributions;
 
+    const CBLSSecretKey operatorKey = WITH_LOCK(activeMasternodeInfoCs, return *activeMasternodeInfo.blsKeyOperator);
+
     for (const auto& idx : pend) {
         const auto& m = members[idx];
         if (m->bad || m->weComplain) {
             continue;
         }
-        memberIndexes.emplace_back(idx);
-        vvecs.emplace_back(receivedVvecs[idx]);
-        skContributions.emplace_back(receivedSkContributions[idx]);
         // Write here to definitely store one contribution for each member no matter if
         // our share is valid or not, could be that others are still correct
         dkgManager.WriteEncryptedContributions(params.type, m_quorum_base_block_index, m->dmn->proTxHash, *vecEncryptedContributions[idx]);
+
+        bool complain = false;
+        CBLSSecretKey skContribution;
+        if (!vecEncryptedContributions[idx]->Decrypt(*myIdx, operatorKey, skContribution, PROTOCOL_VERSION)) {
+            logger.Batch("contribution from %s could not be decrypted", m->dmn->proTxHash.ToString());
+            complain = true;
+        } else if (idx != myIdx && ShouldSimulateError(DKGError::type::COMPLAIN_LIE)) {
+            logger.Batch("lying/complaining for %s", m->dmn->proTxHash.ToString());
+            complain = true;
+        }
+
+        if (complain) {
+            m->weComplain = true;
+            dkgDebugManager.UpdateLocalMemberStatus(params.type, quorumIndex, m->idx, [&](CDKGDebugMemberStatus& status) {
+                status.weComplain = true;
+                return true;
+            });
+            continue;
+        }
+
+        receivedSkContributions[idx] = skContribution;
+        memberIndexes.emplace_back(idx);
+        vvecs.emplace_back(receivedVvecs[idx]);
+        skContributions.emplace_back(skContribution);
     }
 
     auto result = blsWorker.VerifyContributionShares(myId, vvecs, skContributions);
@@ -379,6 +379,65 @@ bool CDKGSessionManager::GetVerifiedContributions(Consensus::LLMQType llmqType,
 {
     LOCK(contributionsCacheCs);
     auto members = utils::GetAllQuorumMembers(llmqType, pQuorumBaseBlockIndex);
+    const uint256& quorumHash = pQuorumBaseBlockIndex->GetBlockHash();
+
+    // Check which members aren't cached yet. All contributions of one quorum
+    // share the (prefix, llmqType, quorumHash) key prefix and are therefore
+    // stored contiguously, so instead of two point lookups per member we read
+    // the missing ones with a single range scan per prefix. This matters most
+    // when rebuilding quorum vvecs after a restart, where the cache is cold
+    // for all members at once.
+    std::set<uint256> toRead;
+    for (const auto i : irange::range(members.size())) {
+        if (validMembers[i] && contributionsCache.count({llmqType, quorumHash, members[i]->proTxHash}) == 0) {
+            toRead.emplace(members[i]->proTxHash);
+        }
+    }
+    if (!toRead.empty()) {
+        std::map<uint256, BLSVerificationVectorPtr> diskVvecs;
+        std::map<uint256, CBLSSecretKey> diskSkContributions;
+        std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
+        auto k = std::make_tuple(DB_VVEC, llmqType, quorumHash, uint256());
+        pcursor->Seek(k);
+        while (pcursor->Valid()) {
+            if (!pcursor->GetKey(k) || std::get<0>(k) != DB_VVEC || std::get<1>(k) != llmqType || std::get<2>(k) != quorumHash) {
+                break;
+            }
+            if (toRead.count(std::get<3>(k))) {
+                auto vvecPtr = std::make_shared<BLSVerificationVector>();
+                if (pcursor->GetValue(*vvecPtr)) {
+                    diskVvecs.emplace(std::get<3>(k), std::move(vvecPtr));
+                }
+            }
+            pcursor->Next();
+        }
+        k = std::make_tuple(DB_SKCONTRIB, llmqType, quorumHash, uint256());
+        pcursor->Seek(k);
+        while (pcursor->Valid()) {
+            if (!pcursor->GetKey(k) || std::get<0>(k) != DB_SKCONTRIB || std::get<1>(k) != llmqType || std::get<2>(k) != quorumHash) {
+                break;
+            }
+            if (toRead.count(std::get<3>(k))) {
+                CBLSSecretKey skContribution;
+                if (pcursor->GetValue(skContribution)) {
+                    diskSkContributions.emplace(std::get<3>(k), skContribution);
+                }
+            }
+            pcursor->Next();
+        }
+        for (const auto& proTxHash : toRead) {
+            auto itVvec = diskVvecs.find(proTxHash);
+            if (itVvec == diskVvecs.end()) {
+                return false;
+            }
+            CBLSSecretKey skContribution;
+            auto itSk = diskSkContributions.find(proTxHash);
+            if (itSk != diskSkContributions.end()) {
+                skContribution = itSk->second;
+            }
+            contributionsCache.emplace(ContributionsCacheKey{llmqType, quorumHash, proTxHash}, ContributionsCacheEntry{GetTimeMillis(), itVvec->second, skContribution});
+        }
+    }
 
     memberIndexesRet.clear();
     vvecsRet.clear();
@@ -388,20 +447,8 @@ bool CDKGSessionManager::GetVerifiedContributions(Consensus::LLMQType llmqType,
     skContributionsRet.reserve(members.size());
     for (const auto i : irange::range(members.size())) {
         if (validMembers[i]) {
-            const uint256& proTxHash = members[i]->proTxHash;
-            ContributionsCacheKey cacheKey = {llmqType, pQuorumBaseBlockIndex->GetBlockHash(), proTxHash};
-            auto it = contributionsCache.find(cacheKey);
-            if (it == contributionsCache.end()) {
-                auto vvecPtr = std::make_shared<BLSVerificationVector>();
-                CBLSSecretKey skContribution;
-                if (!db->Read(std::make_tuple(DB_VVEC, llmqType, pQuorumBaseBlockIndex->GetBlockHash(), proTxHash), *vvecPtr)) {
-                    return false;
-                }
-                db->Read(std::make_tuple(DB_SKCONTRIB, llmqType, pQuorumBaseBlockIndex->GetBlockHash(), proTxHash), skContribution);
-
-                it = contributionsCache.emplace(cacheKey, ContributionsCacheEntry{GetTimeMillis(), vvecPtr, skContribution}).first;
-            }
-
+            const auto it = contributionsCache.find({llmqType, quorumHash, members[i]->proTxHash});
+            assert(it != contributionsCache.end());
             memberIndexesRet.emplace_back(i);
             vvecsRet.emplace_back(it->second.vvec);
             skContributionsRet.emplace_back(it->second.skContribution);
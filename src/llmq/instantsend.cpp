@@ -40,6 +40,13 @@ static const std::string DB_ARCHIVED_BY_HASH = "is_a2";
 
 static const std::string DB_VERSION = "is_v";
 
+/** Compact the stale height-keyed tails of the islock DB once per this many
+ *  blocks (roughly daily at 2.5 minute spacing). Locks are write-once and
+ *  deleted shortly after they are chainlocked, so without targeted compaction
+ *  their tombstones pile up for background compactions which compete with
+ *  block flush IO. */
+static constexpr int ISDB_COMPACTION_INTERVAL{576};
+
 const int CInstantSendDb::CURRENT_VERSION;
 const uint8_t CInstantSendLock::islock_version;
 const uint8_t CInstantSendLock::isdlock_version;
@@ -92,22 +99,41 @@ void CInstantSendDb::Upgrade(const CTxMemPool& mempool)
     }
 }
 
+void CInstantSendDb::BeginGroupCommit()
+{
+    LOCK(cs_db);
+    assert(groupBatch == nullptr);
+    groupBatch = std::make_unique<CDBBatch>(*db);
+}
+
+void CInstantSendDb::EndGroupCommit()
+{
+    LOCK(cs_db);
+    assert(groupBatch != nullptr);
+    db->WriteBatch(*groupBatch);
+    groupBatch.reset();
+}
+
 void CInstantSendDb::WriteNewInstantSendLock(const uint256& hash, const CInstantSendLock& islock)
 {
     LOCK(cs_db);
-    CDBBatch batch(*db);
+    CDBBatch localBatch(*db);
+    CDBBatch& batch = groupBatch != nullptr ? *groupBatch : localBatch;
     batch.Write(std::make_tuple(DB_ISLOCK_BY_HASH, hash), islock);
     batch.Write(std::make_tuple(DB_HASH_BY_TXID, islock.txid), hash);
     for (const auto& in : islock.inputs) {
         batch.Write(std::make_tuple(DB_HASH_BY_OUTPOINT, in), hash);
     }
-    db->WriteBatch(batch);
+    if (groupBatch == nullptr) {
+        db->WriteBatch(localBatch);
+    }
 
     auto p = std::make_shared<CInstantSendLock>(islock);
     islockCache.insert(hash, p);
-    txidCache.insert(islock.txid, hash);
+    const InternedHash internedHash{hash};
+    txidCache.insert(islock.txid, internedHash);
     for (const auto& in : islock.inputs) {
-        outpointCache.insert(in, hash);
+        outpointCache.insert(in, internedHash);
     }
 }
 
@@ -144,6 +170,10 @@ static std::tuple<std::string, uint32_t, uint256> BuildInversedISLockKey(const s
 void CInstantSendDb::WriteInstantSendLockMined(const uint256& hash, int nHeight)
 {
     LOCK(cs_db);
+    if (groupBatch != nullptr) {
+        WriteInstantSendLockMined(*groupBatch, hash, nHeight);
+        return;
+    }
     CDBBatch batch(*db);
     WriteInstantSendLockMined(batch, hash, nHeight);
     db->WriteBatch(batch);
@@ -248,6 +278,17 @@ void CInstantSendDb::RemoveArchivedInstantSendLocks(int nUntilHeight)
     }
 
     db->WriteBatch(batch);
+
+    // Everything at or below nUntilHeight in the inversed-height ranges is now
+    // a tombstone (the mined entries were erased when the locks got
+    // chainlocked). Reclaim them in one targeted daily pass instead of leaving
+    // them to background compactions.
+    if (nUntilHeight % ISDB_COMPACTION_INTERVAL == 0) {
+        db->CompactRange(BuildInversedISLockKey(DB_ARCHIVED_BY_HEIGHT_AND_HASH, nUntilHeight, uint256()),
+                         BuildInversedISLockKey(DB_ARCHIVED_BY_HEIGHT_AND_HASH, 0, uint256()));
+        db->CompactRange(BuildInversedISLockKey(DB_MINED_BY_HEIGHT_AND_HASH, nUntilHeight, uint256()),
+                         BuildInversedISLockKey(DB_MINED_BY_HEIGHT_AND_HASH, 0, uint256()));
+    }
 }
 
 void CInstantSendDb::WriteBlockInstantSendLocks(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindexConnected)
@@ -335,18 +376,25 @@ CInstantSendLockPtr CInstantSendDb::GetInstantSendLockByHashInternal(const uint2
             ret = nullptr;
         }
     }
-    islockCache.insert(hash, ret);
+    // Only cache hits: historical lookups (explorers, RPC) for long-deleted
+    // locks would otherwise fill the LRU with nullptr entries and evict the
+    // active working set. Misses are kept off disk by the bloom filter.
+    if (ret) {
+        islockCache.insert(hash, ret);
+    }
     return ret;
 }
 
 uint256 CInstantSendDb::GetInstantSendLockHashByTxidInternal(const uint256& txid) const
 {
     AssertLockHeld(cs_db);
-    uint256 islockHash;
+    InternedHash islockHash;
     if (!txidCache.get(txid, islockHash)) {
-        if (!db->Read(std::make_tuple(DB_HASH_BY_TXID, txid), islockHash)) {
+        uint256 islockHashFromDb;
+        if (!db->Read(std::make_tuple(DB_HASH_BY_TXID, txid), islockHashFromDb)) {
             return {};
         }
+        islockHash = InternedHash{islockHashFromDb};
         txidCache.insert(txid, islockHash);
     }
     return islockHash;
@@ -361,11 +409,13 @@ CInstantSendLockPtr CInstantSendDb::GetInstantSendLockByTxid(const uint256& txid
 CInstantSendLockPtr CInstantSendDb::GetInstantSendLockByInput(const COutPoint& outpoint) const
 {
     LOCK(cs_db);
-    uint256 islockHash;
+    InternedHash islockHash;
     if (!outpointCache.get(outpoint, islockHash)) {
-        if (!db->Read(std::make_tuple(DB_HASH_BY_OUTPOINT, outpoint), islockHash)) {
+        uint256 islockHashFromDb;
+        if (!db->Read(std::make_tuple(DB_HASH_BY_OUTPOINT, outpoint), islockHashFromDb)) {
             return nullptr;
         }
+        islockHash = InternedHash{islockHashFromDb};
         outpointCache.insert(outpoint, islockHash);
     }
     return GetInstantSendLockByHashInternal(islockHash);
@@ -1014,6 +1064,10 @@ std::unordered_set<uint256, StaticSaltedHasher> CInstantSendManager::ProcessPend
             Misbehaving(nodeId, 20);
         }
     }
+    // Commit all locks accepted in this round as one atomic LevelDB write. During
+    // mempool floods this turns thousands of tiny per-lock writes into a single
+    // batched one per round.
+    db.BeginGroupCommit();
     for (const auto& p : pend) {
         const auto& hash = p.first;
         auto nodeId = p.second.first;
@@ -1040,6 +1094,7 @@ std::unordered_set<uint256, StaticSaltedHasher> CInstantSendManager::ProcessPend
             }
         }
     }
+    db.EndGroupCommit();
 
     return badISLocks;
 }
@@ -1229,9 +1284,10 @@ void CInstantSendManager::AddNonLockedTx(const CTransactionRef& tx, const CBlock
 
         if (did_insert) {
             nonLockedTxInfo.tx = tx;
+            const InternedHash internedTxid{tx->GetHash()};
             for (const auto &in: tx->vin) {
                 nonLockedTxs[in.prevout.hash].children.emplace(tx->GetHash());
-                nonLockedTxsByOutpoints.emplace(in.prevout, tx->GetHash());
+                nonLockedTxsByOutpoints.emplace(in.prevout, internedTxid);
             }
         }
     }
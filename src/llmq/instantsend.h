@@ -14,6 +14,7 @@
 #include <primitives/transaction.h>
 #include <threadinterrupt.h>
 #include <txmempool.h>
+#include <util/interned_hash.h>
 
 #include <unordered_map>
 #include <unordered_set>
@@ -75,9 +76,19 @@ private:
 
     std::unique_ptr<CDBWrapper> db GUARDED_BY(cs_db) {nullptr};
     mutable unordered_lru_cache<uint256, CInstantSendLockPtr, StaticSaltedHasher, 10000> islockCache GUARDED_BY(cs_db);
-    mutable unordered_lru_cache<uint256, uint256, StaticSaltedHasher, 10000> txidCache GUARDED_BY(cs_db);
+    // Both caches store the islock hash interned: the same hash is kept once per
+    // locked input in outpointCache, plus the txid mapping, but all handles share
+    // a single 32-byte slot.
+    mutable unordered_lru_cache<uint256, InternedHash, StaticSaltedHasher, 10000> txidCache GUARDED_BY(cs_db);
+
+    mutable unordered_lru_cache<COutPoint, InternedHash, SaltedOutpointHasher, 10000> outpointCache GUARDED_BY(cs_db);
+
+    /**
+     * While set, new lock writes accumulate here instead of being committed individually,
+     * see BeginGroupCommit/EndGroupCommit
+     */
+    std::unique_ptr<CDBBatch> groupBatch GUARDED_BY(cs_db);
 
-    mutable unordered_lru_cache<COutPoint, uint256, SaltedOutpointHasher, 10000> outpointCache GUARDED_BY(cs_db);
     void WriteInstantSendLockMined(CDBBatch& batch, const uint256& hash, int nHeight) EXCLUSIVE_LOCKS_REQUIRED(cs_db);
 
     void RemoveInstantSendLockMined(CDBBatch& batch, const uint256& hash, int nHeight) EXCLUSIVE_LOCKS_REQUIRED(cs_db);
@@ -117,11 +128,24 @@ private:
 
 public:
     explicit CInstantSendDb(bool unitTests, bool fWipe) :
-            db(std::make_unique<CDBWrapper>(unitTests ? "" : (GetDataDir() / "llmq/isdb"), 32 << 20, unitTests, fWipe))
+            // almost exclusively point lookups by hash/outpoint, so spend more bloom bits to keep misses off disk
+            db(std::make_unique<CDBWrapper>(unitTests ? "" : (GetDataDir() / "llmq/isdb"), 32 << 20, unitTests, fWipe, false, CDBWrapperOptions{/*bloom_filter_bits=*/16}))
     {}
 
     void Upgrade(const CTxMemPool& mempool) LOCKS_EXCLUDED(cs_db);
 
+    /**
+     * Makes all islock writes until the matching EndGroupCommit accumulate in a single
+     * CDBBatch which is then committed atomically, instead of one LevelDB write per lock.
+     * Lookups in the meantime are served by the in-memory caches, which are kept up to
+     * date immediately as usual.
+     */
+    void BeginGroupCommit() LOCKS_EXCLUDED(cs_db);
+    /**
+     * Atomically commits everything written since BeginGroupCommit
+     */
+    void EndGroupCommit() LOCKS_EXCLUDED(cs_db);
+
     /**
      * This method is called when an InstantSend Lock is processed and adds the lock to the database
      * @param hash The hash of the InstantSend Lock
@@ -251,7 +275,8 @@ private:
 
     mutable Mutex cs_nonLocked;
     std::unordered_map<uint256, NonLockedTxInfo, StaticSaltedHasher> nonLockedTxs GUARDED_BY(cs_nonLocked);
-    std::unordered_map<COutPoint, uint256, SaltedOutpointHasher> nonLockedTxsByOutpoints GUARDED_BY(cs_nonLocked);
+    // Values are interned: a txid is referenced here once per input
+    std::unordered_map<COutPoint, InternedHash, SaltedOutpointHasher> nonLockedTxsByOutpoints GUARDED_BY(cs_nonLocked);
 
     mutable Mutex cs_pendingRetry;
     std::unordered_set<uint256, StaticSaltedHasher> pendingRetryTxs GUARDED_BY(cs_pendingRetry);
@@ -7,6 +7,7 @@
 #include <llmq/blockprocessor.h>
 #include <llmq/dkgsession.h>
 #include <llmq/dkgsessionmgr.h>
+#include <llmq/signing.h>
 #include <llmq/utils.h>
 
 #include <evo/specialtx.h>
@@ -25,11 +26,21 @@
 
 #include <cxxtimer.hpp>
 
+#include <atomic>
+#include <optional>
+#include <utility>
+
 namespace llmq
 {
 
 static const std::string DB_QUORUM_SK_SHARE = "q_Qsk";
 static const std::string DB_QUORUM_QUORUM_VVEC = "q_Qqvvec";
+static const std::string DB_QUORUM_MEMBERS = "q_Qmem";
+
+// Limit on the entries (per result type) of the interpolation cache shared by
+// all quorum objects. Pubkey shares dominate: 400 member quorums need one
+// entry per member, so this covers ~25 active LLMQ_400_60 quorums worth.
+static constexpr size_t MAX_BLS_WORKER_CACHE_SIZE = 10000;
 
 std::unique_ptr<CQuorumManager> quorumManager;
 
@@ -72,7 +83,7 @@ std::string CQuorumDataRequest::GetErrorString() const
     return "UNDEFINED";
 }
 
-CQuorum::CQuorum(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker) : params(_params), blsCache(_blsWorker)
+CQuorum::CQuorum(const Consensus::LLMQParams& _params, const std::shared_ptr<CBLSWorkerCache>& _blsCache) : params(_params), blsCache(_blsCache)
 {
 }
 
@@ -131,7 +142,11 @@ CBLSPublicKey CQuorum::GetPubKeyShare(size_t memberIdx) const
         return CBLSPublicKey();
     }
     const auto& m = members[memberIdx];
-    return blsCache.BuildPubKeyShare(m->proTxHash, quorumVvec, CBLSId(m->proTxHash));
+    // The cache is shared between quorums, so scope the key to this quorum
+    CHashWriter hw(SER_GETHASH, 0);
+    hw << qc->quorumHash;
+    hw << m->proTxHash;
+    return blsCache->BuildPubKeyShare(hw.GetHash(), quorumVvec, CBLSId(m->proTxHash));
 }
 
 bool CQuorum::HasVerificationVector() const {
@@ -192,6 +207,7 @@ CQuorumManager::CQuorumManager(CEvoDB& _evoDb, CConnman& _connman, CBLSWorker& _
     m_evoDb(_evoDb),
     connman(_connman),
     blsWorker(_blsWorker),
+    blsWorkerCache(std::make_shared<CBLSWorkerCache>(_blsWorker, MAX_BLS_WORKER_CACHE_SIZE)),
     dkgManager(_dkgManager),
     quorumBlockProcessor(_quorumBlockProcessor),
     m_mn_sync(mn_sync)
@@ -227,6 +243,8 @@ void CQuorumManager::TriggerQuorumDataRecoveryThreads(const CBlockIndex* pIndex)
 
     LogPrint(BCLog::LLMQ, "CQuorumManager::%s -- Process block %s\n", __func__, pIndex->GetBlockHash().ToString());
 
+    std::vector<std::pair<CQuorumCPtr, uint16_t>> vecRecovery;
+
     for (const auto& params : Params().GetConsensus().llmqs) {
         const auto vecQuorums = ScanQuorums(params.type, pIndex, params.keepOldConnections);
 
@@ -262,10 +280,17 @@ void CQuorumManager::TriggerQuorumDataRecoveryThreads(const CBlockIndex* pIndex)
                 continue;
             }
 
-            // Finally start the thread which triggers the requests for this quorum
-            StartQuorumDataRecoveryThread(pQuorum, pIndex, nDataMask);
+            // Collect it for the recovery thread, mark it as being worked on right
+            // away so the next block doesn't trigger it a second time
+            pQuorum->fQuorumDataRecoveryThreadRunning = true;
+            vecRecovery.emplace_back(pQuorum, nDataMask);
         }
     }
+
+    if (!vecRecovery.empty()) {
+        // Finally start the thread which drives the requests for all collected quorums
+        StartQuorumDataRecoveryThread(std::move(vecRecovery), pIndex);
+    }
 }
 
 void CQuorumManager::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fInitialDownload) const
@@ -276,6 +301,12 @@ void CQuorumManager::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fInitial
 
     for (const auto& params : Params().GetConsensus().llmqs) {
         CheckQuorumConnections(params, pindexNew);
+        // Pre-warm the scan cache for the block signing sessions select their quorums
+        // from (SIGN_HEIGHT_OFFSET blocks behind the tip), so that quorum selection on
+        // the latency critical signing paths becomes a pure cache hit.
+        if (pindexNew->nHeight >= CSigningManager::SIGN_HEIGHT_OFFSET) {
+            ScanQuorums(params.type, pindexNew->GetAncestor(pindexNew->nHeight - CSigningManager::SIGN_HEIGHT_OFFSET), params.signingActiveQuorumCount);
+        }
     }
 
     {
@@ -375,8 +406,42 @@ CQuorumPtr CQuorumManager::BuildQuorumFromCommitment(const Consensus::LLMQType l
 
     const auto& llmq_params_opt = GetLLMQParams(llmqType);
     assert(llmq_params_opt.has_value());
-    auto quorum = std::make_shared<CQuorum>(llmq_params_opt.value(), blsWorker);
-    auto members = utils::GetAllQuorumMembers(qc->llmqType, pQuorumBaseBlockIndex);
+    auto quorum = std::make_shared<CQuorum>(llmq_params_opt.value(), blsWorkerCache);
+
+    // Use the persisted member list if we have one: it makes rebuilding all
+    // active quorums after a restart skip the modifier-hash sort over the
+    // whole MN list that GetAllQuorumMembers would redo per quorum.
+    std::vector<CDeterministicMNCPtr> members;
+    const auto membersDbKey = std::make_pair(DB_QUORUM_MEMBERS, std::make_pair(llmqType, quorumHash));
+    // Rotation quorums select members from a work block a few blocks before
+    // the quorum base block, so their states can't be re-resolved from the
+    // base block's list; keep recomputing those.
+    const bool fUseStoredMembers = !utils::IsQuorumRotationEnabled(llmq_params_opt.value(), pQuorumBaseBlockIndex);
+    std::vector<uint256> memberProTxHashes;
+    if (fUseStoredMembers && m_evoDb.GetRawDB().Read(membersDbKey, memberProTxHashes)) {
+        auto mnList = deterministicMNManager->GetListForBlock(pQuorumBaseBlockIndex);
+        members.reserve(memberProTxHashes.size());
+        for (const auto& proTxHash : memberProTxHashes) {
+            auto dmn = mnList.GetMN(proTxHash);
+            if (dmn == nullptr) {
+                // stale or corrupt record, fall back to recomputation
+                members.clear();
+                break;
+            }
+            members.emplace_back(std::move(dmn));
+        }
+    }
+    if (members.empty()) {
+        members = utils::GetAllQuorumMembers(qc->llmqType, pQuorumBaseBlockIndex);
+        if (fUseStoredMembers) {
+            memberProTxHashes.clear();
+            memberProTxHashes.reserve(members.size());
+            for (const auto& dmn : members) {
+                memberProTxHashes.emplace_back(dmn->proTxHash);
+            }
+            m_evoDb.GetRawDB().Write(membersDbKey, memberProTxHashes);
+        }
+    }
 
     quorum->Init(std::move(qc), pQuorumBaseBlockIndex, minedBlockHash, members);
 
@@ -414,7 +479,7 @@ bool CQuorumManager::BuildQuorumContributions(const CFinalCommitmentPtr& fqc, co
 
     cxxtimer::Timer t2(true);
     LOCK(quorum->cs);
-    quorum->quorumVvec = blsWorker.BuildQuorumVerificationVector(vvecs);
+    quorum->quorumVvec = blsWorkerCache->BuildQuorumVerificationVector(fqc->quorumVvecHash, vvecs);
     if (!quorum->HasVerificationVector()) {
         LogPrint(BCLog::LLMQ, "CQuorumManager::%s -- failed to build quorumVvec\n", __func__);
         // without the quorum vvec, there can't be a skShare, so we fail here. Failure is not fatal here, as it still
@@ -504,29 +569,52 @@ std::vector<CQuorumCPtr> CQuorumManager::ScanQuorums(Consensus::LLMQType llmqTyp
     size_t nScanCommitments{nCountRequested};
     std::vector<CQuorumCPtr> vecResultQuorums;
 
+    bool fCacheExists;
+    bool fPrevCacheExists{false};
+    size_t nCacheMaxSize;
     {
         LOCK(cs_scan_quorums);
         auto& cache = scanQuorumsCache[llmqType];
-        bool fCacheExists = cache.get(pindexStart->GetBlockHash(), vecResultQuorums);
-        if (fCacheExists) {
-            // We have exactly what requested so just return it
-            if (vecResultQuorums.size() == nCountRequested) {
-                return vecResultQuorums;
-            }
-            // If we have more cached than requested return only a subvector
-            if (vecResultQuorums.size() > nCountRequested) {
-                return {vecResultQuorums.begin(), vecResultQuorums.begin() + nCountRequested};
-            }
-            // If we have cached quorums but not enough, subtract what we have from the count and the set correct index where to start
-            // scanning for the rests
-            if (!vecResultQuorums.empty()) {
-                nScanCommitments -= vecResultQuorums.size();
-                pIndexScanCommitments = vecResultQuorums.back()->m_quorum_base_block_index->pprev;
-            }
+        nCacheMaxSize = cache.max_size();
+        fCacheExists = cache.get(pindexStart->GetBlockHash(), vecResultQuorums);
+        if (!fCacheExists && pindexStart->pprev != nullptr) {
+            // The start block advances by one with every connected block, so a fresh tip
+            // (or tip minus the signing offset) always misses the cache even though the
+            // quorum set rarely changes. If the scan for the previous block is still
+            // cached, remember it so it can be re-keyed below instead of rebuilt.
+            fPrevCacheExists = cache.get(pindexStart->pprev->GetBlockHash(), vecResultQuorums);
+        }
+    }
+    if (fPrevCacheExists) {
+        // The quorum set only differs from the previous block's if pindexStart itself
+        // mined a commitment of this type
+        if (quorumBlockProcessor.HasMinedCommitmentAtHeight(llmqType, pindexStart->nHeight)) {
+            vecResultQuorums.clear();
         } else {
-            // If there is nothing in cache request at least cache.max_size() because this gets cached then later
-            nScanCommitments = std::max(nCountRequested, cache.max_size());
+            fCacheExists = true;
+            LOCK(cs_scan_quorums);
+            const size_t nCacheEndIndex = std::min(vecResultQuorums.size(), nCacheMaxSize);
+            scanQuorumsCache[llmqType].emplace(pindexStart->GetBlockHash(), {vecResultQuorums.begin(), vecResultQuorums.begin() + nCacheEndIndex});
+        }
+    }
+    if (fCacheExists) {
+        // We have exactly what requested so just return it
+        if (vecResultQuorums.size() == nCountRequested) {
+            return vecResultQuorums;
         }
+        // If we have more cached than requested return only a subvector
+        if (vecResultQuorums.size() > nCountRequested) {
+            return {vecResultQuorums.begin(), vecResultQuorums.begin() + nCountRequested};
+        }
+        // If we have cached quorums but not enough, subtract what we have from the count and the set correct index where to start
+        // scanning for the rests
+        if (!vecResultQuorums.empty()) {
+            nScanCommitments -= vecResultQuorums.size();
+            pIndexScanCommitments = vecResultQuorums.back()->m_quorum_base_block_index->pprev;
+        }
+    } else {
+        // If there is nothing in cache request at least cache.max_size() because this gets cached then later
+        nScanCommitments = std::max(nCountRequested, nCacheMaxSize);
     }
 
     // Get the block indexes of the mined commitments to build the required quorums from
@@ -824,137 +912,199 @@ void CQuorumManager::StartCachePopulatorThread(const CQuorumCPtr pQuorum) const
     LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- start\n");
 
     // when then later some other thread tries to get keys, it will be much faster
-    workerPool.push([pQuorum, t, this](int threadId) {
-        for (const auto i : irange::range(pQuorum->members.size())) {
-            if (!quorumThreadInterrupt) {
-                break;
+    // Each member's pubkey share is an independent polynomial evaluation, so
+    // let several workers claim members from a shared counter (as in
+    // Aggregator::Start) instead of populating the cache serially. The cache
+    // itself already dedupes concurrent builds of the same share.
+    const size_t memberCount = pQuorum->members.size();
+    auto nextIdx = std::make_shared<std::atomic<size_t>>(0);
+    auto doneCount = std::make_shared<std::atomic<size_t>>(0);
+    const size_t numWorkers = std::max<size_t>(1, std::min(memberCount, (size_t)workerPool.size()));
+    for (size_t w = 0; w < numWorkers; w++) {
+        workerPool.push([pQuorum, t, this, nextIdx, doneCount, memberCount, numWorkers](int threadId) {
+            size_t i;
+            while ((i = nextIdx->fetch_add(1)) < memberCount) {
+                if (quorumThreadInterrupt) {
+                    break;
+                }
+                if (pQuorum->qc->validMembers[i]) {
+                    pQuorum->GetPubKeyShare(i);
+                }
             }
-            if (pQuorum->qc->validMembers[i]) {
-                pQuorum->GetPubKeyShare(i);
+            if (doneCount->fetch_add(1) + 1 == numWorkers) {
+                LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- done. time=%d\n", t.count());
             }
-        }
-        LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- done. time=%d\n", t.count());
-    });
+        });
+    }
 }
 
-void CQuorumManager::StartQuorumDataRecoveryThread(const CQuorumCPtr pQuorum, const CBlockIndex* pIndex, uint16_t nDataMaskIn) const
+void CQuorumManager::StartQuorumDataRecoveryThread(std::vector<std::pair<CQuorumCPtr, uint16_t>> vecQuorums, const CBlockIndex* pIndex) const
 {
-    if (pQuorum->fQuorumDataRecoveryThreadRunning) {
-        LogPrint(BCLog::LLMQ, "CQuorumManager::%s -- Already running\n", __func__);
-        return;
-    }
-    pQuorum->fQuorumDataRecoveryThreadRunning = true;
-
-    workerPool.push([pQuorum, pIndex, nDataMaskIn, this](int threadId) {
-        size_t nTries{0};
-        uint16_t nDataMask{nDataMaskIn};
-        int64_t nTimeLastSuccess{0};
-        uint256* pCurrentMemberHash{nullptr};
-        std::vector<uint256> vecMemberHashes;
-        const size_t nMyStartOffset{GetQuorumRecoveryStartOffset(pQuorum, pIndex)};
+    workerPool.push([vecQuorums = std::move(vecQuorums), pIndex, this](int threadId) {
+        // Per-quorum state of one data recovery. All quorums passed in are
+        // driven through this state machine by this single task, so a node
+        // which has to recover the data of many quorums (e.g. after a
+        // restart) pipelines the requests to their members instead of
+        // serializing whole recoveries behind the size of the worker pool.
+        struct RecoveryState {
+            CQuorumCPtr pQuorum;
+            uint16_t nDataMaskIn{0};
+            uint16_t nDataMask{0};
+            size_t nTries{0};
+            size_t nMyStartOffset{0};
+            int64_t nTimeLastSuccess{0};
+            int64_t nTimeConnect{0};
+            std::optional<uint256> currentMemberHash;
+            std::vector<uint256> vecMemberHashes;
+            bool fDone{false};
+        };
         const int64_t nRequestTimeout{10};
 
-        auto printLog = [&](const std::string& strMessage) {
-            const std::string strMember{pCurrentMemberHash == nullptr ? "nullptr" : pCurrentMemberHash->ToString()};
+        auto printLog = [](const RecoveryState& state, const std::string& strMessage) {
+            const std::string strMember{state.currentMemberHash ? state.currentMemberHash->ToString() : "nullptr"};
             LogPrint(BCLog::LLMQ, "CQuorumManager::StartQuorumDataRecoveryThread -- %s - for llmqType %d, quorumHash %s, nDataMask (%d/%d), pCurrentMemberHash %s, nTries %d\n",
-                strMessage, ToUnderlying(pQuorum->qc->llmqType), pQuorum->qc->quorumHash.ToString(), nDataMask, nDataMaskIn, strMember, nTries);
+                strMessage, ToUnderlying(state.pQuorum->qc->llmqType), state.pQuorum->qc->quorumHash.ToString(), state.nDataMask, state.nDataMaskIn, strMember, state.nTries);
         };
-        printLog("Start");
 
         while (!m_mn_sync->IsBlockchainSynced() && !quorumThreadInterrupt) {
             quorumThreadInterrupt.sleep_for(std::chrono::seconds(nRequestTimeout));
         }
 
         if (quorumThreadInterrupt) {
-            printLog("Aborted");
+            LogPrint(BCLog::LLMQ, "CQuorumManager::StartQuorumDataRecoveryThread -- Aborted\n");
+            for (const auto& [pQuorum, nDataMask] : vecQuorums) {
+                pQuorum->fQuorumDataRecoveryThreadRunning = false;
+            }
             return;
         }
 
-        vecMemberHashes.reserve(pQuorum->qc->validMembers.size());
-        for (auto& member : pQuorum->members) {
-            if (pQuorum->IsValidMember(member->proTxHash) && member->proTxHash != WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.proTxHash)) {
-                vecMemberHashes.push_back(member->proTxHash);
+        const auto proTxHashLocal = WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.proTxHash);
+
+        std::vector<RecoveryState> vecStates;
+        vecStates.reserve(vecQuorums.size());
+        for (const auto& [pQuorum, nDataMask] : vecQuorums) {
+            RecoveryState state;
+            state.pQuorum = pQuorum;
+            state.nDataMaskIn = nDataMask;
+            state.nDataMask = nDataMask;
+            state.nMyStartOffset = GetQuorumRecoveryStartOffset(pQuorum, pIndex);
+            state.vecMemberHashes.reserve(pQuorum->qc->validMembers.size());
+            for (const auto& member : pQuorum->members) {
+                if (pQuorum->IsValidMember(member->proTxHash) && member->proTxHash != proTxHashLocal) {
+                    state.vecMemberHashes.push_back(member->proTxHash);
+                }
             }
+            std::sort(state.vecMemberHashes.begin(), state.vecMemberHashes.end());
+            printLog(state, "Try to request");
+            vecStates.push_back(std::move(state));
         }
-        std::sort(vecMemberHashes.begin(), vecMemberHashes.end());
-
-        printLog("Try to request");
 
-        while (nDataMask > 0 && !quorumThreadInterrupt) {
-
-            if (nDataMask & llmq::CQuorumDataRequest::QUORUM_VERIFICATION_VECTOR &&
-                pQuorum->HasVerificationVector()) {
-                nDataMask &= ~llmq::CQuorumDataRequest::QUORUM_VERIFICATION_VECTOR;
-                printLog("Received quorumVvec");
+        // Runs one step of a recovery, returns true once the recovery is finished
+        auto stepState = [&](RecoveryState& state) {
+            if (state.nDataMask & llmq::CQuorumDataRequest::QUORUM_VERIFICATION_VECTOR &&
+                state.pQuorum->HasVerificationVector()) {
+                state.nDataMask &= ~llmq::CQuorumDataRequest::QUORUM_VERIFICATION_VECTOR;
+                printLog(state, "Received quorumVvec");
             }
 
-            if (nDataMask & llmq::CQuorumDataRequest::ENCRYPTED_CONTRIBUTIONS && pQuorum->GetSkShare().IsValid()) {
-                nDataMask &= ~llmq::CQuorumDataRequest::ENCRYPTED_CONTRIBUTIONS;
-                printLog("Received skShare");
+            if (state.nDataMask & llmq::CQuorumDataRequest::ENCRYPTED_CONTRIBUTIONS && state.pQuorum->GetSkShare().IsValid()) {
+                state.nDataMask &= ~llmq::CQuorumDataRequest::ENCRYPTED_CONTRIBUTIONS;
+                printLog(state, "Received skShare");
             }
 
-            if (nDataMask == 0) {
-                printLog("Success");
-                break;
+            if (state.nDataMask == 0) {
+                printLog(state, "Success");
+                return true;
             }
 
-            if ((GetAdjustedTime() - nTimeLastSuccess) > nRequestTimeout) {
-                if (nTries >= vecMemberHashes.size()) {
-                    printLog("All tried but failed");
-                    break;
+            if (state.nTimeConnect != 0) {
+                // A member was picked, wait until its staggered connect time has passed
+                if (GetTimeMillis() < state.nTimeConnect) {
+                    return false;
                 }
-                // Access the member list of the quorum with the calculated offset applied to balance the load equally
-                pCurrentMemberHash = &vecMemberHashes[(nMyStartOffset + nTries++) % vecMemberHashes.size()];
-                {
+                state.nTimeConnect = 0;
+                state.nTimeLastSuccess = GetAdjustedTime();
+                connman.AddPendingMasternode(*state.currentMemberHash);
+                printLog(state, "Connect");
+            } else if ((GetAdjustedTime() - state.nTimeLastSuccess) > nRequestTimeout) {
+                while (true) {
+                    if (state.nTries >= state.vecMemberHashes.size()) {
+                        printLog(state, "All tried but failed");
+                        return true;
+                    }
+                    // Access the member list of the quorum with the calculated offset applied to balance the load equally
+                    state.currentMemberHash = state.vecMemberHashes[(state.nMyStartOffset + state.nTries++) % state.vecMemberHashes.size()];
                     LOCK(cs_data_requests);
-                    const CQuorumDataRequestKey key(*pCurrentMemberHash, true, pQuorum->qc->quorumHash, pQuorum->qc->llmqType);
+                    const CQuorumDataRequestKey key(*state.currentMemberHash, true, state.pQuorum->qc->quorumHash, state.pQuorum->qc->llmqType);
                     auto it = mapQuorumDataRequests.find(key);
                     if (it != mapQuorumDataRequests.end() && !it->second.IsExpired(/*add_bias=*/true)) {
-                        printLog("Already asked");
+                        printLog(state, "Already asked");
                         continue;
                     }
+                    break;
                 }
-                // Sleep a bit depending on the start offset to balance out multiple requests to same masternode
-                quorumThreadInterrupt.sleep_for(std::chrono::milliseconds(nMyStartOffset * 100));
-                nTimeLastSuccess = GetAdjustedTime();
-                connman.AddPendingMasternode(*pCurrentMemberHash);
-                printLog("Connect");
+                // Delay the connect a bit depending on the start offset to balance out multiple requests to same masternode
+                state.nTimeConnect = GetTimeMillis() + state.nMyStartOffset * 100;
+                return false;
             }
 
             auto proTxHash = WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.proTxHash);
             connman.ForEachNode([&](CNode* pNode) {
                 auto verifiedProRegTxHash = pNode->GetVerifiedProRegTxHash();
-                if (pCurrentMemberHash == nullptr || verifiedProRegTxHash != *pCurrentMemberHash) {
+                if (!state.currentMemberHash || verifiedProRegTxHash != *state.currentMemberHash) {
                     return;
                 }
 
-                if (RequestQuorumData(pNode, pQuorum->qc->llmqType, pQuorum->m_quorum_base_block_index, nDataMask, proTxHash)) {
-                    nTimeLastSuccess = GetAdjustedTime();
-                    printLog("Requested");
+                if (RequestQuorumData(pNode, state.pQuorum->qc->llmqType, state.pQuorum->m_quorum_base_block_index, state.nDataMask, proTxHash)) {
+                    state.nTimeLastSuccess = GetAdjustedTime();
+                    printLog(state, "Requested");
                 } else {
                     LOCK(cs_data_requests);
-                    const CQuorumDataRequestKey key(*pCurrentMemberHash, true, pQuorum->qc->quorumHash, pQuorum->qc->llmqType);
+                    const CQuorumDataRequestKey key(*state.currentMemberHash, true, state.pQuorum->qc->quorumHash, state.pQuorum->qc->llmqType);
                     auto it = mapQuorumDataRequests.find(key);
                     if (it == mapQuorumDataRequests.end()) {
-                        printLog("Failed");
+                        printLog(state, "Failed");
                         pNode->fDisconnect = true;
-                        pCurrentMemberHash = nullptr;
-                        return;
+                        state.currentMemberHash = std::nullopt;
                     } else if (it->second.IsProcessed()) {
-                        printLog("Processed");
+                        printLog(state, "Processed");
                         pNode->fDisconnect = true;
-                        pCurrentMemberHash = nullptr;
-                        return;
+                        state.currentMemberHash = std::nullopt;
                     } else {
-                        printLog("Waiting");
-                        return;
+                        printLog(state, "Waiting");
                     }
                 }
             });
+            return false;
+        };
+
+        while (!quorumThreadInterrupt) {
+            bool fAllDone{true};
+            for (auto& state : vecStates) {
+                if (state.fDone) {
+                    continue;
+                }
+                if (stepState(state)) {
+                    state.fDone = true;
+                    state.pQuorum->fQuorumDataRecoveryThreadRunning = false;
+                    printLog(state, "Done");
+                } else {
+                    fAllDone = false;
+                }
+            }
+            if (fAllDone) {
+                break;
+            }
             quorumThreadInterrupt.sleep_for(std::chrono::seconds(1));
         }
-        pQuorum->fQuorumDataRecoveryThreadRunning = false;
-        printLog("Done");
+
+        // Reset the flags of unfinished recoveries if we got interrupted
+        for (const auto& state : vecStates) {
+            if (!state.fDone) {
+                state.pQuorum->fQuorumDataRecoveryThreadRunning = false;
+                printLog(state, "Aborted");
+            }
+        }
     });
 }
 
@@ -173,8 +173,9 @@ public:
 
 private:
     // Recovery of public key shares is very slow, so we start a background thread that pre-populates a cache so that
-    // the public key shares are ready when needed later
-    mutable CBLSWorkerCache blsCache;
+    // the public key shares are ready when needed later. The cache is shared across all quorum objects (and LLMQ
+    // types) via CQuorumManager, so rebuilding a CQuorum for the same commitment does not redo the interpolations.
+    const std::shared_ptr<CBLSWorkerCache> blsCache;
     mutable std::atomic<bool> fQuorumDataRecoveryThreadRunning{false};
 
     mutable CCriticalSection cs;
@@ -183,7 +184,7 @@ private:
     CBLSSecretKey skShare GUARDED_BY(cs);
 
 public:
-    CQuorum(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker);
+    CQuorum(const Consensus::LLMQParams& _params, const std::shared_ptr<CBLSWorkerCache>& _blsCache);
     ~CQuorum() = default;
     void Init(CFinalCommitmentPtr _qc, const CBlockIndex* _pQuorumBaseBlockIndex, const uint256& _minedBlockHash, const std::vector<CDeterministicMNCPtr>& _members);
 
@@ -215,6 +216,8 @@ private:
     CEvoDB& m_evoDb;
     CConnman& connman;
     CBLSWorker& blsWorker;
+    //! Size-bounded cache of vvec/pubkey-share interpolation results, shared by all CQuorum objects of all LLMQ types
+    const std::shared_ptr<CBLSWorkerCache> blsWorkerCache;
     CDKGSessionManager& dkgManager;
     CQuorumBlockProcessor& quorumBlockProcessor;
     const std::unique_ptr<CMasternodeSync>& m_mn_sync;
@@ -266,7 +269,10 @@ private:
     size_t GetQuorumRecoveryStartOffset(const CQuorumCPtr pQuorum, const CBlockIndex* pIndex) const;
 
     void StartCachePopulatorThread(const CQuorumCPtr pQuorum) const;
-    void StartQuorumDataRecoveryThread(const CQuorumCPtr pQuorum, const CBlockIndex* pIndex, uint16_t nDataMask) const;
+    /// Drives the data recovery of all given (quorum, data mask) pairs concurrently from a single
+    /// worker task, pipelining the QGETDATA requests to the quorums' members instead of serializing
+    /// whole recoveries behind the size of the worker pool.
+    void StartQuorumDataRecoveryThread(std::vector<std::pair<CQuorumCPtr, uint16_t>> vecQuorums, const CBlockIndex* pIndex) const;
 };
 
 extern std::unique_ptr<CQuorumManager> quorumManager;
@@ -223,6 +223,56 @@ void CRecoveredSigsDb::MigrateRecoveredSigs()
     LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%d -- done\n", __func__);
 }
 
+// The filters are keyed by uint256, so (llmqType, id) pairs are folded into one
+static uint256 RecoveredSigIdFilterKey(Consensus::LLMQType llmqType, const uint256& id)
+{
+    CHashWriter hw(SER_GETHASH, 0);
+    hw << llmqType;
+    hw << id;
+    return hw.GetHash();
+}
+
+void CRecoveredSigsDb::BuildRecoveredSigFilters()
+{
+    LOCK(cs);
+
+    std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
+
+    auto start_r = std::make_tuple(std::string("rs_r"), (Consensus::LLMQType)0, uint256());
+    pcursor->Seek(start_r);
+
+    while (pcursor->Valid()) {
+        decltype(start_r) k;
+
+        if (!pcursor->GetKey(k) || std::get<0>(k) != "rs_r") {
+            break;
+        }
+
+        // the (llmqType, id) and (llmqType, id, msgHash) keys share the same prefix, dedup them
+        auto filterKey = RecoveredSigIdFilterKey(std::get<1>(k), std::get<2>(k));
+        if (!sigForIdFilter.Contains(filterKey)) {
+            sigForIdFilter.Insert(filterKey);
+        }
+
+        pcursor->Next();
+    }
+
+    auto start_s = std::make_tuple(std::string("rs_s"), uint256());
+    pcursor->Seek(start_s);
+
+    while (pcursor->Valid()) {
+        decltype(start_s) k;
+
+        if (!pcursor->GetKey(k) || std::get<0>(k) != "rs_s") {
+            break;
+        }
+
+        sigForSessionFilter.Insert(std::get<1>(k));
+
+        pcursor->Next();
+    }
+}
+
 bool CRecoveredSigsDb::HasRecoveredSig(Consensus::LLMQType llmqType, const uint256& id, const uint256& msgHash) const
 {
     auto k = std::make_tuple(std::string("rs_r"), llmqType, id, msgHash);
@@ -238,6 +288,11 @@ bool CRecoveredSigsDb::HasRecoveredSigForId(Consensus::LLMQType llmqType, const
         if (hasSigForIdCache.get(cacheKey, ret)) {
             return ret;
         }
+        if (!sigForIdFilter.IsSaturated() && !sigForIdFilter.Contains(RecoveredSigIdFilterKey(llmqType, id))) {
+            // definitely not in the db
+            hasSigForIdCache.insert(cacheKey, false);
+            return false;
+        }
     }
 
 
@@ -257,6 +312,11 @@ bool CRecoveredSigsDb::HasRecoveredSigForSession(const uint256& signHash) const
         if (hasSigForSessionCache.get(signHash, ret)) {
             return ret;
         }
+        if (!sigForSessionFilter.IsSaturated() && !sigForSessionFilter.Contains(signHash)) {
+            // definitely not in the db
+            hasSigForSessionCache.insert(signHash, false);
+            return false;
+        }
     }
 
     auto k = std::make_tuple(std::string("rs_s"), signHash);
@@ -352,6 +412,8 @@ void CRecoveredSigsDb::WriteRecoveredSig(const llmq::CRecoveredSig& recSig)
         hasSigForIdCache.insert(std::make_pair(recSig.getLlmqType(), recSig.getId()), true);
         hasSigForSessionCache.insert(signHash, true);
         hasSigForHashCache.insert(recSig.GetHash(), true);
+        sigForIdFilter.Insert(RecoveredSigIdFilterKey(recSig.getLlmqType(), recSig.getId()));
+        sigForSessionFilter.Insert(signHash);
     }
 }
 
@@ -638,6 +700,37 @@ void CSigningManager::CollectPendingRecoveredSigsToVerify(
         }
 
         std::unordered_set<std::pair<NodeId, uint256>, StaticSaltedHasher> uniqueSignHashes;
+
+        // Priority lanes: during signature storms a backlog of low-value recovered sigs
+        // must not delay chainlock signatures (and after that InstantSend locks), so
+        // drain sigs of those llmqTypes from all nodes first. Whatever budget remains
+        // goes to the usual random per-node round-robin below.
+        auto collectByType = [&](Consensus::LLMQType llmqType) {
+            if (llmqType == Consensus::LLMQType::LLMQ_NONE) {
+                return;
+            }
+            for (auto& p : pendingRecoveredSigs) {
+                NodeId nodeId = p.first;
+                auto& ns = p.second;
+                for (auto it = ns.begin(); it != ns.end() && uniqueSignHashes.size() < maxUniqueSessions;) {
+                    const auto& recSig = *it;
+                    if (recSig->getLlmqType() != llmqType) {
+                        ++it;
+                        continue;
+                    }
+                    if (!db.HasRecoveredSigForHash(recSig->GetHash())) {
+                        uniqueSignHashes.emplace(nodeId, recSig->buildSignHash());
+                        retSigShares[nodeId].emplace_back(recSig);
+                    }
+                    it = ns.erase(it);
+                }
+            }
+        };
+        const auto& consensusParams = Params().GetConsensus();
+        collectByType(consensusParams.llmqTypeChainLocks);
+        collectByType(consensusParams.llmqTypeDIP0024InstantSend);
+        collectByType(consensusParams.llmqTypeInstantSend);
+
         utils::IterateNodesRandom(pendingRecoveredSigs, [&]() {
             return uniqueSignHashes.size() < maxUniqueSessions;
         }, [&](NodeId nodeId, std::list<std::shared_ptr<const CRecoveredSig>>& ns) {
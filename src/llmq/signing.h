@@ -14,6 +14,7 @@
 #include <saltedhasher.h>
 #include <sync.h>
 #include <univalue.h>
+#include <util/cuckoofilter.h>
 
 #include <unordered_map>
 
@@ -112,11 +113,20 @@ private:
     mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForSessionCache GUARDED_BY(cs);
     mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForHashCache GUARDED_BY(cs);
 
+    // Approximate membership over the "rs_r" and "rs_s" keyspaces, built from the db at startup.
+    // A negative answer is authoritative (unless the filter saturated), so lookups for unknown
+    // ids/sessions are resolved without hitting LevelDB. The filters are insert-only; sigs removed
+    // by the cleanup keep answering "maybe" and simply fall through to the db as before.
+    mutable CuckooFilter sigForIdFilter GUARDED_BY(cs){1 << 20};
+    mutable CuckooFilter sigForSessionFilter GUARDED_BY(cs){1 << 20};
+
 public:
     explicit CRecoveredSigsDb(bool fMemory, bool fWipe) :
-            db(std::make_unique<CDBWrapper>(fMemory ? "" : (GetDataDir() / "llmq/recsigdb"), 8 << 20, fMemory, fWipe))
+            // almost exclusively point lookups by hash, so spend more bloom bits to keep misses off disk
+            db(std::make_unique<CDBWrapper>(fMemory ? "" : (GetDataDir() / "llmq/recsigdb"), 8 << 20, fMemory, fWipe, false, CDBWrapperOptions{/*bloom_filter_bits=*/16}))
     {
         MigrateRecoveredSigs();
+        BuildRecoveredSigFilters();
     }
 
     bool HasRecoveredSig(Consensus::LLMQType llmqType, const uint256& id, const uint256& msgHash) const;
@@ -139,6 +149,7 @@ public:
 
 private:
     void MigrateRecoveredSigs();
+    void BuildRecoveredSigFilters();
 
     bool ReadRecoveredSig(Consensus::LLMQType llmqType, const uint256& id, CRecoveredSig& ret) const;
     void RemoveRecoveredSig(CDBBatch& batch, Consensus::LLMQType llmqType, const uint256& id, bool deleteHashKey, bool deleteTimeKey) EXCLUSIVE_LOCKS_REQUIRED(cs);
@@ -156,6 +167,7 @@ class CSigningManager
 {
     friend class CSigSharesManager;
 
+public:
     // when selecting a quorum for signing and verification, we use CQuorumManager::SelectQuorum with this offset as
     // starting height for scanning. This is because otherwise the resulting signatures would not be verifiable by nodes
     // which are not 100% at the chain tip.
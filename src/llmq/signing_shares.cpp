@@ -11,12 +11,14 @@
 
 #include <bls/bls_batchverifier.h>
 #include <chainparams.h>
+#include <dbwrapper.h>
 #include <evo/deterministicmns.h>
 #include <masternode/node.h>
 #include <net_processing.h>
 #include <netmessagemaker.h>
 #include <spork.h>
 #include <util/irange.h>
+#include <util/trace.h>
 #include <util/underlying.h>
 
 #include <cxxtimer.hpp>
@@ -176,6 +178,17 @@ void CSigSharesNodeState::RemoveSession(const uint256& signHash)
 
 //////////////////////
 
+CSigSharesManager::CSigSharesManager(CConnman& _connman, CQuorumManager& _qman, CSigningManager& _sigman, bool unitTests, bool fWipe) :
+    db(std::make_unique<CDBWrapper>(unitTests ? "" : (GetDataDir() / "llmq/sigsharesdb"), 1 << 20, unitTests, fWipe)),
+    connman(_connman),
+    qman(_qman),
+    sigman(_sigman)
+{
+    workInterrupt.reset();
+}
+
+CSigSharesManager::~CSigSharesManager() = default;
+
 void CSigSharesManager::StartWorkerThread()
 {
     // can't start new thread if we have one running already
@@ -183,6 +196,8 @@ void CSigSharesManager::StartWorkerThread()
         assert(false);
     }
 
+    RestoreJournaledSigShares();
+
     workThread = std::thread(&TraceThread<std::function<void()> >,
         "sigshares",
         std::function<void()>(std::bind(&CSigSharesManager::WorkThreadMain, this)));
@@ -198,6 +213,9 @@ void CSigSharesManager::StopWorkerThread()
     if (workThread.joinable()) {
         workThread.join();
     }
+
+    // persist whatever accumulated since the worker thread's last flush
+    CommitSigShareJournal();
 }
 
 void CSigSharesManager::RegisterAsRecoveredSigsListener()
@@ -447,10 +465,8 @@ bool CSigSharesManager::ProcessMessageBatchedSigShares(const CNode& pfrom, const
         return true;
     }
 
-    LOCK(cs);
-    auto& nodeState = nodeStates[pfrom.GetId()];
-    for (const auto& s : sigSharesToProcess) {
-        nodeState.pendingIncomingSigShares.Add(s.GetKey(), s);
+    for (auto& s : sigSharesToProcess) {
+        pendingIncomingSigSharesQueue.PushBack(std::make_pair(pfrom.GetId(), std::move(s)));
     }
     return true;
 }
@@ -487,21 +503,14 @@ void CSigSharesManager::ProcessMessageSigShare(NodeId fromId, const CSigShare& s
         return;
     }
 
-    {
-        LOCK(cs);
-
-        if (sigShares.Has(sigShare.GetKey())) {
-            return;
-        }
-
-        if (sigman.HasRecoveredSigForId(sigShare.getLlmqType(), sigShare.getId())) {
-            return;
-        }
-
-        auto& nodeState = nodeStates[fromId];
-        nodeState.pendingIncomingSigShares.Add(sigShare.GetKey(), sigShare);
+    if (sigman.HasRecoveredSigForId(sigShare.getLlmqType(), sigShare.getId())) {
+        return;
     }
 
+    // Duplicates (including shares we already moved into sigShares) are filtered when the
+    // queue is drained under cs in CollectPendingSigSharesToVerify, so no lock is needed here.
+    pendingIncomingSigSharesQueue.PushBack(std::make_pair(fromId, sigShare));
+
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, id=%s, msgHash=%s, member=%d, node=%d\n", __func__,
              sigShare.GetSignHash().ToString(), sigShare.getId().ToString(), sigShare.getMsgHash().ToString(), sigShare.getQuorumMember(), fromId);
 }
@@ -554,6 +563,9 @@ void CSigSharesManager::CollectPendingSigSharesToVerify(
 {
     {
         LOCK(cs);
+        for (auto& [nodeId, sigShare] : pendingIncomingSigSharesQueue.TakeAll()) {
+            nodeStates[nodeId].pendingIncomingSigShares.Add(sigShare.GetKey(), sigShare);
+        }
         if (nodeStates.empty()) {
             return;
         }
@@ -565,6 +577,34 @@ void CSigSharesManager::CollectPendingSigSharesToVerify(
         // the whole verification process
 
         std::unordered_set<std::pair<NodeId, uint256>, StaticSaltedHasher> uniqueSignHashes;
+
+        // InstantSend lane: recovery bursts on the large chainlock quorums can fill the
+        // whole session budget for several rounds, delaying islocks. Drain shares of the
+        // (small, latency-critical) InstantSend quorum types first, still one share per
+        // random node visit so the batch-poisoning protection below stays intact.
+        const auto& consensusParams = Params().GetConsensus();
+        auto isInstantSendShare = [&consensusParams](const CSigShare& s) {
+            return s.getLlmqType() == consensusParams.llmqTypeDIP0024InstantSend ||
+                   s.getLlmqType() == consensusParams.llmqTypeInstantSend;
+        };
+        utils::IterateNodesRandom(nodeStates, [&]() {
+            return uniqueSignHashes.size() < maxUniqueSessions;
+        }, [&](NodeId nodeId, CSigSharesNodeState& ns) {
+            const CSigShare* pSigShare = ns.pendingIncomingSigShares.GetFirstMatching(isInstantSendShare);
+            if (pSigShare == nullptr) {
+                return false;
+            }
+            const auto& sigShare = *pSigShare;
+
+            AssertLockHeld(cs);
+            if (const bool alreadyHave = this->sigShares.Has(sigShare.GetKey()); !alreadyHave) {
+                uniqueSignHashes.emplace(nodeId, sigShare.GetSignHash());
+                retSigShares[nodeId].emplace_back(sigShare);
+            }
+            ns.pendingIncomingSigShares.Erase(sigShare.GetKey());
+            return true;
+        }, rnd);
+
         utils::IterateNodesRandom(nodeStates, [&]() {
             return uniqueSignHashes.size() < maxUniqueSessions;
         }, [&](NodeId nodeId, CSigSharesNodeState& ns) {
@@ -735,6 +775,27 @@ void CSigSharesManager::ProcessSigShare(const CSigShare& sigShare, const CConnma
         if (sigShareCount >= size_t(quorum->params.threshold)) {
             canTryRecovery = true;
         }
+
+        TRACE4(llmq, sigshare_received,
+            ToUnderlying(llmqType),
+            sigShare.getQuorumHash().data(),
+            sigShare.getQuorumMember(),
+            sigShareCount
+        );
+
+        // Journal sessions once they've collected enough shares to make restart
+        // recovery worthwhile. When a session crosses the threshold, all shares
+        // collected so far are queued; afterwards each new share is appended.
+        if (journaledSessions.count(sigShare.GetSignHash()) != 0) {
+            journalPendingWrites.emplace_back(sigShare);
+        } else if (sigShareCount >= MIN_JOURNAL_SHARES) {
+            journaledSessions.emplace(sigShare.GetSignHash());
+            if (const auto* sessionShares = sigShares.GetAllForSignHash(sigShare.GetSignHash())) {
+                for (const auto& [_, share] : *sessionShares) {
+                    journalPendingWrites.emplace_back(share);
+                }
+            }
+        }
     }
 
     if (canTryRecovery) {
@@ -785,6 +846,13 @@ void CSigSharesManager::TryRecoverSig(const CQuorumCPtr& quorum, const uint256&
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- recovered signature. id=%s, msgHash=%s, time=%d\n", __func__,
               id.ToString(), msgHash.ToString(), t.count());
 
+    TRACE4(llmq, recoveredsig,
+        ToUnderlying(quorum->params.type),
+        quorum->qc->quorumHash.data(),
+        id.data(),
+        t.count() // recovery duration in milliseconds
+    );
+
     auto rs = std::make_shared<CRecoveredSig>(quorum->params.type, quorum->qc->quorumHash, id, msgHash, recoveredSig);
 
     // There should actually be no need to verify the self-recovered signatures as it should always succeed. Let's
@@ -1381,6 +1449,95 @@ void CSigSharesManager::RemoveSigSharesForSession(const uint256& signHash)
     sigShares.EraseAllForSignHash(signHash);
     signedSessions.erase(signHash);
     timeSeenForSessions.erase(signHash);
+
+    if (journaledSessions.erase(signHash) != 0) {
+        journalPendingRemovals.emplace_back(signHash);
+    }
+}
+
+void CSigSharesManager::RestoreJournaledSigShares()
+{
+    std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
+
+    auto start = std::make_tuple(std::string("ss"), uint256(), (uint16_t)0);
+    pcursor->Seek(start);
+
+    CDBBatch deleteBatch(*db);
+    size_t restoredCount = 0;
+    size_t staleCount = 0;
+    int64_t now = GetAdjustedTime();
+
+    LOCK(cs);
+    while (pcursor->Valid()) {
+        decltype(start) k;
+        if (!pcursor->GetKey(k) || std::get<0>(k) != "ss") {
+            break;
+        }
+        CSigShare sigShare;
+        if (!pcursor->GetValue(sigShare) || sigman.HasRecoveredSigForSession(std::get<1>(k))) {
+            // corrupted entry or session already completed while we were down
+            deleteBatch.Erase(k);
+            staleCount++;
+            pcursor->Next();
+            continue;
+        }
+
+        sigShares.Add(sigShare.GetKey(), sigShare);
+        timeSeenForSessions.emplace(sigShare.GetSignHash(), now);
+        journaledSessions.emplace(sigShare.GetSignHash());
+        restoredCount++;
+
+        pcursor->Next();
+    }
+    pcursor.reset();
+
+    if (staleCount != 0) {
+        db->WriteBatch(deleteBatch);
+    }
+    if (restoredCount != 0 || staleCount != 0) {
+        LogPrintf("CSigSharesManager::%s -- restored %d journaled sig shares (%d sessions), dropped %d stale entries\n",
+                  __func__, restoredCount, journaledSessions.size(), staleCount);
+    }
+}
+
+void CSigSharesManager::CommitSigShareJournal()
+{
+    decltype(journalPendingWrites) writes;
+    decltype(journalPendingRemovals) removals;
+    {
+        LOCK(cs);
+        if (journalPendingWrites.empty() && journalPendingRemovals.empty()) {
+            return;
+        }
+        writes = std::move(journalPendingWrites);
+        removals = std::move(journalPendingRemovals);
+        journalPendingWrites.clear();
+        journalPendingRemovals.clear();
+    }
+
+    CDBBatch batch(*db);
+
+    if (!removals.empty()) {
+        std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
+        for (const auto& signHash : removals) {
+            auto start = std::make_tuple(std::string("ss"), signHash, (uint16_t)0);
+            pcursor->Seek(start);
+            while (pcursor->Valid()) {
+                decltype(start) k;
+                if (!pcursor->GetKey(k) || std::get<0>(k) != "ss" || std::get<1>(k) != signHash) {
+                    break;
+                }
+                batch.Erase(k);
+                pcursor->Next();
+            }
+        }
+    }
+
+    for (const auto& sigShare : writes) {
+        batch.Write(std::make_tuple(std::string("ss"), sigShare.GetSignHash(), sigShare.getQuorumMember()), sigShare);
+    }
+
+    db->WriteBatch(batch);
 }
 
 void CSigSharesManager::RemoveBannedNodeStates()
@@ -1441,6 +1598,9 @@ void CSigSharesManager::WorkThreadMain()
         fMoreWork |= sigman.ProcessPendingRecoveredSigs();
         fMoreWork |= ProcessPendingSigShares(connman);
         SignPendingSigShares();
+        // Requests queued while we were signing shouldn't have to wait out the
+        // full sleep below; loop around so they get batched right away.
+        fMoreWork |= WITH_LOCK(cs, return !pendingSigns.empty());
 
         if (GetTimeMillis() - lastSendTime > 100) {
             SendMessages();
@@ -1449,6 +1609,7 @@ void CSigSharesManager::WorkThreadMain()
 
         Cleanup();
         sigman.Cleanup();
+        CommitSigShareJournal();
 
         // TODO Wakeup when pending signing is needed?
         if (!fMoreWork && !workInterrupt.sleep_for(std::chrono::milliseconds(100))) {
@@ -1471,7 +1632,21 @@ void CSigSharesManager::SignPendingSigShares()
         v = std::move(pendingSigns);
     }
 
+    // The queue is drained in batches, so during sig share floods a recovered
+    // signature often arrives for a session while its request is still queued.
+    // Such requests are dropped here instead of producing a share nobody needs
+    // anymore. Batches may also contain duplicates of the same request (e.g.
+    // from re-sign attempts), which only need to be signed once.
+    std::set<std::tuple<Consensus::LLMQType, uint256, uint256>> batchSeen;
     for (const auto& [pQuorum, id, msgHash] : v) {
+        if (!batchSeen.emplace(pQuorum->params.type, id, msgHash).second) {
+            continue;
+        }
+        if (sigman.HasRecoveredSigForId(pQuorum->params.type, id)) {
+            LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- skipping sign request, recovered sig already present. id=%s, msgHash=%s\n", __func__,
+                     id.ToString(), msgHash.ToString());
+            continue;
+        }
         auto opt_sigShare = CreateSigShare(pQuorum, id, msgHash);
 
         if (opt_sigShare.has_value() && opt_sigShare->sigShare.Get().IsValid()) {
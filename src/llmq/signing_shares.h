@@ -13,12 +13,15 @@
 #include <serialize.h>
 #include <sync.h>
 #include <uint256.h>
+#include <util/mpscqueue.h>
 
 #include <optional>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
+class CDBWrapper;
 class CEvoDB;
 class CScheduler;
 class CSporkManager;
@@ -218,6 +221,19 @@ public:
         return &internalMap.begin()->second.begin()->second;
     }
 
+    template<typename Pred>
+    const T* GetFirstMatching(Pred&& pred) const
+    {
+        for (const auto& p : internalMap) {
+            for (const auto& p2 : p.second) {
+                if (pred(p2.second)) {
+                    return &p2.second;
+                }
+            }
+        }
+        return nullptr;
+    }
+
     [[nodiscard]] size_t Size() const
     {
         size_t s = 0;
@@ -369,6 +385,15 @@ private:
     static constexpr int64_t MAX_SEND_FOR_RECOVERY_TIMEOUT{10000};
     static constexpr size_t MAX_MSGS_SIG_SHARES{32};
 
+    // Sessions are only journaled to disk once they've collected this many shares;
+    // sessions below the threshold are cheap to re-fetch from the network after a restart
+    static constexpr size_t MIN_JOURNAL_SHARES{4};
+
+    // Incoming sig shares are pushed here lock-free by the net message threads and drained into
+    // nodeStates by the worker thread; see CollectPendingSigSharesToVerify. This keeps the
+    // message handler from ever contending on cs during sig share spikes.
+    MPSCQueue<std::pair<NodeId, CSigShare>> pendingIncomingSigSharesQueue;
+
     CCriticalSection cs;
 
     std::thread workThread;
@@ -396,6 +421,15 @@ private:
 
     FastRandomContext rnd GUARDED_BY(cs);
 
+    // Journal of in-flight signing sessions. Sessions which collected at least
+    // MIN_JOURNAL_SHARES shares are incrementally persisted here and restored on
+    // startup, so a restart mid-signing recovers from local IO instead of
+    // re-requesting everything over the network. See RestoreJournaledSigShares.
+    std::unique_ptr<CDBWrapper> db{nullptr};
+    std::unordered_set<uint256, StaticSaltedHasher> journaledSessions GUARDED_BY(cs);
+    std::vector<CSigShare> journalPendingWrites GUARDED_BY(cs);
+    std::vector<uint256> journalPendingRemovals GUARDED_BY(cs);
+
     CConnman& connman;
     const CQuorumManager& qman;
     CSigningManager& sigman;
@@ -403,12 +437,9 @@ private:
     std::atomic<uint32_t> recoveredSigsCounter{0};
 
 public:
-    explicit CSigSharesManager(CConnman& _connman, CQuorumManager& _qman, CSigningManager& _sigman) : connman(_connman), qman(_qman), sigman(_sigman)
-    {
-        workInterrupt.reset();
-    };
+    explicit CSigSharesManager(CConnman& _connman, CQuorumManager& _qman, CSigningManager& _sigman, bool unitTests, bool fWipe);
     CSigSharesManager() = delete;
-    ~CSigSharesManager() override = default;
+    ~CSigSharesManager() override;
 
     void StartWorkerThread();
     void StopWorkerThread();
@@ -456,6 +487,9 @@ private:
     void RemoveSigSharesForSession(const uint256& signHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void RemoveBannedNodeStates();
 
+    void RestoreJournaledSigShares();
+    void CommitSigShareJournal();
+
     void BanNode(NodeId nodeId);
 
     bool SendMessages();
@@ -13,6 +13,7 @@
 
 #include <base58.h>
 #include <chainparams.h>
+#include <hash.h>
 #include <serialize.h>
 #include <univalue.h>
 #include <validation.h>
@@ -117,11 +118,47 @@ void CQuorumRotationInfo::ToJson(UniValue& obj) const
     obj.pushKV("mnListDiffList", mnlistdifflist);
 }
 
+/** Cache of recently built qrinfo responses. Building one walks multiple
+ *  snapshots and mn list diffs, and a restart wave of platform nodes asks for
+ *  the same rotation info over and over. Responses are deterministic given
+ *  the request and the chain tip, so keys include the tip hash: a new block
+ *  (in particular a DKG boundary) changes every key and the stale entries are
+ *  dropped wholesale. */
+static constexpr size_t QUORUM_ROTATION_INFO_CACHE_MAX{4};
+static Mutex cs_qrinfo_cache;
+static uint256 qrinfoCacheTip GUARDED_BY(cs_qrinfo_cache);
+static std::map<uint256, CQuorumRotationInfo> qrinfoCache GUARDED_BY(cs_qrinfo_cache);
+
+static uint256 QuorumRotationInfoCacheKey(const CGetQuorumRotationInfo& request, const uint256& tipHash)
+{
+    CHashWriter hw(SER_GETHASH, 0);
+    hw << request.baseBlockHashes;
+    hw << request.blockRequestHash;
+    hw << request.extraShare;
+    hw << tipHash;
+    return hw.GetHash();
+}
+
 bool BuildQuorumRotationInfo(const CGetQuorumRotationInfo& request, CQuorumRotationInfo& response,
                              const CQuorumManager& qman, const CQuorumBlockProcessor& quorumBlockProcessor, std::string& errorRet)
 {
     AssertLockHeld(cs_main);
 
+    const uint256 tipHash = ::ChainActive().Tip() ? ::ChainActive().Tip()->GetBlockHash() : uint256();
+    const uint256 cacheKey = QuorumRotationInfoCacheKey(request, tipHash);
+    if (!tipHash.IsNull()) {
+        LOCK(cs_qrinfo_cache);
+        if (qrinfoCacheTip != tipHash) {
+            qrinfoCache.clear();
+            qrinfoCacheTip = tipHash;
+        }
+        auto it = qrinfoCache.find(cacheKey);
+        if (it != qrinfoCache.end()) {
+            response = it->second;
+            return true;
+        }
+    }
+
     std::vector<const CBlockIndex*> baseBlockIndexes;
     if (request.baseBlockHashes.size() == 0) {
         const CBlockIndex* blockIndex = ::ChainActive().Genesis();
@@ -349,6 +386,13 @@ bool BuildQuorumRotationInfo(const CGetQuorumRotationInfo& request, CQuorumRotat
         response.mnListDiffList.push_back(mnhneeded);
     }
 
+    if (!tipHash.IsNull()) {
+        LOCK(cs_qrinfo_cache);
+        if (qrinfoCacheTip == tipHash && qrinfoCache.size() < QUORUM_ROTATION_INFO_CACHE_MAX) {
+            qrinfoCache.emplace(cacheKey, response);
+        }
+    }
+
     return true;
 }
 
@@ -874,11 +874,16 @@ void AddQuorumProbeConnections(const Consensus::LLMQParams& llmqParams, const CB
         if (dmn->proTxHash == myProTxHash) {
             continue;
         }
-        auto lastOutbound = mmetaman.GetMetaInfo(dmn->proTxHash)->GetLastOutboundSuccess();
-        if (curTime - lastOutbound < 10 * 60) {
+        auto metaInfo = mmetaman.GetMetaInfo(dmn->proTxHash);
+        if (curTime - metaInfo->GetLastOutboundSuccess() < 10 * 60) {
             // avoid re-probing nodes too often
             continue;
         }
+        if (curTime - metaInfo->GetLastSeenTraffic() < 10 * 60) {
+            // passive liveness: we received authenticated traffic from this member
+            // recently, no need to spend an outbound slot on probing it
+            continue;
+        }
         probeConnections.emplace(dmn->proTxHash);
     }
 
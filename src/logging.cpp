@@ -294,7 +294,10 @@ namespace BCLog {
 
 void BCLog::Logger::LogPrintStr(const std::string& str)
 {
-    StdLockGuard scoped_lock(m_cs);
+    // Build the final line outside the lock; only the actual output below
+    // needs to be serialized. Reading m_started_new_line without the lock is
+    // fine: it only affects prefixing of continuation lines, which interleave
+    // arbitrarily between threads anyway.
     std::string str_prefixed = LogEscapeMessage(str);
 
     if (m_log_threadnames && m_started_new_line) {
@@ -304,6 +307,7 @@ void BCLog::Logger::LogPrintStr(const std::string& str)
 
     str_prefixed = LogTimestampStr(str_prefixed);
 
+    StdLockGuard scoped_lock(m_cs);
     m_started_new_line = !str.empty() && str[str.size()-1] == '\n';
 
     if (m_buffering) {
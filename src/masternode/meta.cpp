@@ -47,16 +47,20 @@ void CMasternodeMetaInfo::RemoveGovernanceObject(const uint256& nGovernanceObjec
 
 CMasternodeMetaInfoPtr CMasternodeMetaMan::GetMetaInfo(const uint256& proTxHash, bool fCreate)
 {
-    LOCK(cs);
-    auto it = metaInfos.find(proTxHash);
-    if (it != metaInfos.end()) {
-        return it->second;
+    {
+        std::shared_lock<std::shared_mutex> lock(cs);
+        auto it = metaInfos.find(proTxHash);
+        if (it != metaInfos.end()) {
+            return it->second;
+        }
     }
     if (!fCreate) {
         return nullptr;
     }
-    it = metaInfos.emplace(proTxHash, std::make_shared<CMasternodeMetaInfo>(proTxHash)).first;
-    return it->second;
+    std::unique_lock<std::shared_mutex> lock(cs);
+    // Another thread may have created the entry while the lock was dropped,
+    // emplace simply returns the existing one in that case.
+    return metaInfos.emplace(proTxHash, std::make_shared<CMasternodeMetaInfo>(proTxHash)).first->second;
 }
 
 // We keep track of dsq (mixing queues) count to avoid using same masternodes for mixing too often.
@@ -96,7 +100,8 @@ bool CMasternodeMetaMan::AddGovernanceVote(const uint256& proTxHash, const uint2
 
 void CMasternodeMetaMan::RemoveGovernanceObject(const uint256& nGovernanceObjectHash)
 {
-    LOCK(cs);
+    // Entries lock themselves, a shared lock on the map is enough
+    std::shared_lock<std::shared_mutex> lock(cs);
     for(const auto& p : metaInfos) {
         p.second->RemoveGovernanceObject(nGovernanceObjectHash);
     }
@@ -104,7 +109,7 @@ void CMasternodeMetaMan::RemoveGovernanceObject(const uint256& nGovernanceObject
 
 std::vector<uint256> CMasternodeMetaMan::GetAndClearDirtyGovernanceObjectHashes()
 {
-    LOCK(cs);
+    std::unique_lock<std::shared_mutex> lock(cs);
     std::vector<uint256> vecTmp = std::move(vecDirtyGovernanceObjectHashes);
     vecDirtyGovernanceObjectHashes.clear();
     return vecTmp;
@@ -112,7 +117,7 @@ std::vector<uint256> CMasternodeMetaMan::GetAndClearDirtyGovernanceObjectHashes(
 
 void CMasternodeMetaMan::Clear()
 {
-    LOCK(cs);
+    std::unique_lock<std::shared_mutex> lock(cs);
     metaInfos.clear();
     vecDirtyGovernanceObjectHashes.clear();
 }
@@ -120,7 +125,7 @@ void CMasternodeMetaMan::Clear()
 std::string CMasternodeMetaMan::ToString() const
 {
     std::ostringstream info;
-    LOCK(cs);
+    std::shared_lock<std::shared_mutex> lock(cs);
     info << "Masternodes: meta infos object count: " << (int)metaInfos.size() <<
          ", nDsqCount: " << (int)nDsqCount;
     return info.str();
@@ -10,6 +10,7 @@
 #include <univalue.h>
 
 #include <atomic>
+#include <shared_mutex>
 #include <uint256.h>
 #include <sync.h>
 
@@ -39,6 +40,9 @@ private:
     std::atomic<int> outboundAttemptCount{0};
     std::atomic<int64_t> lastOutboundAttempt{0};
     std::atomic<int64_t> lastOutboundSuccess{0};
+    // Last time we received any message on a connection authenticated (via MNAUTH)
+    // as this masternode. Session-scoped liveness, deliberately not serialized.
+    std::atomic<int64_t> lastSeenTraffic{0};
 
 public:
     CMasternodeMetaInfo() = default;
@@ -49,7 +53,8 @@ public:
         nMixingTxCount(ref.nMixingTxCount.load()),
         mapGovernanceObjectsVotedOn(ref.mapGovernanceObjectsVotedOn),
         lastOutboundAttempt(ref.lastOutboundAttempt.load()),
-        lastOutboundSuccess(ref.lastOutboundSuccess.load())
+        lastOutboundSuccess(ref.lastOutboundSuccess.load()),
+        lastSeenTraffic(ref.lastSeenTraffic.load())
     {
     }
 
@@ -86,6 +91,8 @@ public:
     int64_t GetLastOutboundAttempt() const { return lastOutboundAttempt; }
     void SetLastOutboundSuccess(int64_t t) { lastOutboundSuccess = t; outboundAttemptCount = 0; }
     int64_t GetLastOutboundSuccess() const { return lastOutboundSuccess; }
+    void SetLastSeenTraffic(int64_t t) { lastSeenTraffic = t; }
+    int64_t GetLastSeenTraffic() const { return lastSeenTraffic; }
 };
 using CMasternodeMetaInfoPtr = std::shared_ptr<CMasternodeMetaInfo>;
 
@@ -94,10 +101,15 @@ class CMasternodeMetaMan
 private:
     static const std::string SERIALIZATION_VERSION_STRING;
 
-    mutable CCriticalSection cs;
+    // Guards the metaInfos map itself, not the entries: each CMasternodeMetaInfo
+    // carries its own lock and atomics, so once a shared_ptr has been handed out
+    // it can be read and updated without coming back here. Lookups (CoinJoin
+    // queue handling, PoSe scoring, mnauth) vastly outnumber insertions, hence
+    // a shared mutex so that concurrent readers don't serialize each other.
+    mutable std::shared_mutex cs;
 
-    std::map<uint256, CMasternodeMetaInfoPtr> metaInfos GUARDED_BY(cs);
-    std::vector<uint256> vecDirtyGovernanceObjectHashes GUARDED_BY(cs);
+    std::map<uint256, CMasternodeMetaInfoPtr> metaInfos;
+    std::vector<uint256> vecDirtyGovernanceObjectHashes;
 
     // keep track of dsq count to prevent masternodes from gaming coinjoin queue
     std::atomic<int64_t> nDsqCount{0};
@@ -106,7 +118,7 @@ public:
     template<typename Stream>
     void Serialize(Stream &s) const
     {
-        LOCK(cs);
+        std::shared_lock<std::shared_mutex> lock(cs);
         std::vector<CMasternodeMetaInfo> tmpMetaInfo;
         for (const auto& p : metaInfos) {
             tmpMetaInfo.emplace_back(*p.second);
@@ -117,8 +129,9 @@ public:
     template<typename Stream>
     void Unserialize(Stream &s)
     {
-        LOCK(cs);
-        Clear();
+        std::unique_lock<std::shared_mutex> lock(cs);
+        metaInfos.clear();
+        vecDirtyGovernanceObjectHashes.clear();
         std::string strVersion;
         s >> strVersion;
         if (strVersion != SERIALIZATION_VERSION_STRING) {
@@ -14,8 +14,10 @@
 #include <logging.h>
 #include <masternode/sync.h>
 #include <primitives/block.h>
+#include <saltedhasher.h>
 #include <script/standard.h>
 #include <tinyformat.h>
+#include <unordered_lru_cache.h>
 #include <util/ranges.h>
 #include <util/system.h>
 #include <validation.h>
@@ -272,12 +274,42 @@ bool CMasternodePayments::GetMasternodeTxOuts(int nBlockHeight, CAmount blockRew
     return true;
 }
 
+// GetMNPayee scans the whole deterministic masternode list, and both block
+// validation and getblocktemplate need the payee for the same block index, so
+// memoize the selection per block hash. Keying by hash makes reorgs a
+// non-issue: stale branches simply age out of the LRU.
+static CDeterministicMNCPtr GetMNPayeeAtBlock(const CBlockIndex* pindex)
+{
+    static Mutex cs_cache;
+    static unordered_lru_cache<uint256, CDeterministicMNCPtr, StaticSaltedHasher> payeeCache GUARDED_BY(cs_cache){32};
+
+    const uint256 blockHash = pindex->GetBlockHash();
+    {
+        LOCK(cs_cache);
+        CDeterministicMNCPtr payee;
+        if (payeeCache.get(blockHash, payee)) {
+            return payee;
+        }
+    }
+    auto payee = deterministicMNManager->GetListForBlock(pindex).GetMNPayee(pindex);
+    LOCK(cs_cache);
+    payeeCache.insert(blockHash, payee);
+    return payee;
+}
+
+void CMasternodePayments::UpdatedBlockTip(const CBlockIndex* pindexNew)
+{
+    // Warm the payee cache for the next getblocktemplate call so that template
+    // creation right after a new block doesn't pay for the masternode list scan
+    GetMNPayeeAtBlock(pindexNew);
+}
+
 bool CMasternodePayments::GetBlockTxOuts(int nBlockHeight, CAmount blockReward, std::vector<CTxOut>& voutMasternodePaymentsRet)
 {
     voutMasternodePaymentsRet.clear();
 
     const CBlockIndex* pindex = WITH_LOCK(cs_main, return ::ChainActive()[nBlockHeight - 1]);
-    auto dmnPayee = deterministicMNManager->GetListForBlock(pindex).GetMNPayee(pindex);
+    auto dmnPayee = GetMNPayeeAtBlock(pindex);
     if (!dmnPayee) {
         return false;
     }
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+class CBlockIndex;
 class CGovernanceManager;
 class CMasternodePayments;
 class CBlock;
@@ -41,6 +42,8 @@ public:
     static bool IsTransactionValid(const CTransaction& txNew, int nBlockHeight, CAmount blockReward);
 
     static bool GetMasternodeTxOuts(int nBlockHeight, CAmount blockReward, std::vector<CTxOut>& voutMasternodePaymentsRet);
+
+    static void UpdatedBlockTip(const CBlockIndex* pindexNew);
 };
 
 #endif // BITCOIN_MASTERNODE_PAYMENTS_H
@@ -136,6 +136,12 @@ void CMasternodeSync::ProcessTick()
     nTimeLastProcess = GetTime();
     std::vector<CNode*> vNodesCopy = connman.CopyNodeVector(CConnman::FullyConnectedOnly);
 
+    // How many more peers we are allowed to send a full governance sync
+    // request to on this tick. Receipt is deduplicated by the governance
+    // manager (ConfirmInventoryRequest), so syncing from a few peers in
+    // parallel just spreads the object downloads across them.
+    int nGovSyncRequestsLeft = MASTERNODE_SYNC_GOV_PEERS_PER_TICK;
+
     // gradually request the rest of the votes after sync finished
     if(IsSynced()) {
         governance->RequestGovernanceObjectVotes(vNodesCopy, connman);
@@ -245,7 +251,9 @@ void CMasternodeSync::ProcessTick()
 
                 SendGovernanceSyncRequest(pnode);
 
-                break; //this will cause each peer to get one request each six seconds for the various assets we need
+                if (--nGovSyncRequestsLeft <= 0) {
+                    break; // requested from enough new peers for this tick, continue on the next one
+                }
             }
         }
     }
@@ -301,7 +309,10 @@ void CMasternodeSync::SendGovernanceSyncRequest(CNode* pnode)
 {
     CNetMsgMaker msgMaker(pnode->GetSendVersion());
 
-    CBloomFilter filter;
+    // Between long-running peers most of a full governance sync is redundant,
+    // so tell the peer which objects we already have. Older peers simply
+    // ignore the filter for object sync and send everything, as before.
+    CBloomFilter filter = governance->GetSyncObjectFilter();
 
     connman.PushMessage(pnode, msgMaker.Make(NetMsgType::MNGOVERNANCESYNC, uint256(), filter));
 }
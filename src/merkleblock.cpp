@@ -27,7 +27,26 @@ std::vector<bool> BytesToBits(const std::vector<unsigned char>& bytes)
     return ret;
 }
 
-CMerkleBlock::CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std::set<uint256>* txids)
+CBlockMerkleTree::CBlockMerkleTree(const std::vector<uint256>& vTxid)
+{
+    //we can never have zero txs in a merkle block, we always need the coinbase tx
+    assert(!vTxid.empty());
+    vLevels.emplace_back(vTxid);
+    while (vLevels.back().size() > 1) {
+        const std::vector<uint256>& below = vLevels.back();
+        std::vector<uint256> level;
+        level.reserve((below.size() + 1) / 2);
+        for (size_t pos = 0; pos < below.size(); pos += 2) {
+            const uint256& left = below[pos];
+            // duplicate the last hash on odd-width levels, as CalcHash does
+            const uint256& right = (pos + 1 < below.size()) ? below[pos + 1] : left;
+            level.push_back(Hash(left.begin(), left.end(), right.begin(), right.end()));
+        }
+        vLevels.push_back(std::move(level));
+    }
+}
+
+CMerkleBlock::CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std::set<uint256>* txids, const CBlockMerkleTree* tree)
 {
     header = block.GetBlockHeader();
 
@@ -63,7 +82,7 @@ CMerkleBlock::CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std:
         vHashes.push_back(hash);
     }
 
-    txn = CPartialMerkleTree(vHashes, vMatch);
+    txn = tree ? CPartialMerkleTree(*tree, vMatch) : CPartialMerkleTree(vHashes, vMatch);
 }
 
 uint256 CPartialMerkleTree::CalcHash(int height, unsigned int pos, const std::vector<uint256> &vTxid) {
@@ -142,6 +161,29 @@ uint256 CPartialMerkleTree::TraverseAndExtract(int height, unsigned int pos, uns
     }
 }
 
+void CPartialMerkleTree::TraverseAndBuild(int height, unsigned int pos, const CBlockMerkleTree& tree, const std::vector<bool> &vMatch) {
+    // determine whether this node is the parent of at least one matched txid
+    bool fParentOfMatch = false;
+    for (unsigned int p = pos << height; p < (pos+1) << height && p < nTransactions; p++)
+        fParentOfMatch |= vMatch[p];
+    // store as flag bit
+    vBits.push_back(fParentOfMatch);
+    if (height==0 || !fParentOfMatch) {
+        // if at height 0, or nothing interesting below, copy the prebuilt hash and stop
+        vHash.push_back(tree.GetHash(height, pos));
+    } else {
+        // otherwise, don't store any hash, but descend into the subtrees
+        TraverseAndBuild(height-1, pos*2, tree, vMatch);
+        if (pos*2+1 < CalcTreeWidth(height-1))
+            TraverseAndBuild(height-1, pos*2+1, tree, vMatch);
+    }
+}
+
+CPartialMerkleTree::CPartialMerkleTree(const CBlockMerkleTree& tree, const std::vector<bool> &vMatch) : nTransactions(tree.GetTxids().size()), fBad(false) {
+    // traverse the partial tree, copying node hashes out of the prebuilt tree
+    TraverseAndBuild(tree.GetHeight(), 0, tree, vMatch);
+}
+
 CPartialMerkleTree::CPartialMerkleTree(const std::vector<uint256> &vTxid, const std::vector<bool> &vMatch) : nTransactions(vTxid.size()), fBad(false) {
     // reset state
     vBits.clear();
@@ -51,6 +51,30 @@ std::vector<bool> BytesToBits(const std::vector<unsigned char>& bytes);
  *  - byte[]     flag bits, packed per 8 in a byte, least significant bit first (<= 2*N-1 bits)
  * The size constraints follow from this.
  */
+
+/**
+ * Fully materialized merkle tree over a block's txids: all internal hashes,
+ * stored per level. Built once per block (about 2*N hash computations), it
+ * lets any number of partial merkle trees be assembled from it by index
+ * walking - O(log N) hash copies per proof instead of O(N) hash computations.
+ * Intended to be cached alongside decoded blocks when serving filtered
+ * (SPV) block requests.
+ */
+class CBlockMerkleTree
+{
+    /** vLevels[0] holds the txids, vLevels.back() the merkle root */
+    std::vector<std::vector<uint256>> vLevels;
+
+public:
+    /** vTxid must be non-empty (a block always has a coinbase) */
+    explicit CBlockMerkleTree(const std::vector<uint256>& vTxid);
+
+    /** hash of the given tree node; duplicate-last-hash rule already applied */
+    const uint256& GetHash(int height, unsigned int pos) const { return vLevels[height][pos]; }
+    int GetHeight() const { return int(vLevels.size()) - 1; }
+    const std::vector<uint256>& GetTxids() const { return vLevels.front(); }
+};
+
 class CPartialMerkleTree
 {
 protected:
@@ -77,6 +101,9 @@ protected:
     /** recursive function that traverses tree nodes, storing the data as bits and hashes */
     void TraverseAndBuild(int height, unsigned int pos, const std::vector<uint256> &vTxid, const std::vector<bool> &vMatch);
 
+    /** as above, but copies node hashes out of a prebuilt tree instead of computing them */
+    void TraverseAndBuild(int height, unsigned int pos, const CBlockMerkleTree& tree, const std::vector<bool> &vMatch);
+
     /**
      * recursive function that traverses tree nodes, consuming the bits and hashes produced by TraverseAndBuild.
      * it returns the hash of the respective node and its respective index.
@@ -98,6 +125,9 @@ public:
     /** Construct a partial merkle tree from a list of transaction ids, and a mask that selects a subset of them */
     CPartialMerkleTree(const std::vector<uint256> &vTxid, const std::vector<bool> &vMatch);
 
+    /** Construct a partial merkle tree from a prebuilt full tree; no hashing is performed */
+    CPartialMerkleTree(const CBlockMerkleTree& tree, const std::vector<bool> &vMatch);
+
     CPartialMerkleTree();
 
     /**
@@ -141,10 +171,13 @@ public:
      * Note that this will call IsRelevantAndUpdate on the filter for each transaction,
      * thus the filter will likely be modified.
      */
-    CMerkleBlock(const CBlock& block, CBloomFilter& filter) : CMerkleBlock(block, &filter, nullptr) { }
+    CMerkleBlock(const CBlock& block, CBloomFilter& filter) : CMerkleBlock(block, &filter, nullptr, nullptr) { }
+
+    /** As above, but assembles the proof from a prebuilt merkle tree of the block's txids */
+    CMerkleBlock(const CBlock& block, CBloomFilter& filter, const CBlockMerkleTree& tree) : CMerkleBlock(block, &filter, nullptr, &tree) { }
 
     // Create from a CBlock, matching the txids in the set
-    CMerkleBlock(const CBlock& block, const std::set<uint256>& txids) : CMerkleBlock(block, nullptr, &txids) { }
+    CMerkleBlock(const CBlock& block, const std::set<uint256>& txids) : CMerkleBlock(block, nullptr, &txids, nullptr) { }
 
     CMerkleBlock() {}
 
@@ -152,7 +185,7 @@ public:
 
 private:
     // Combined constructor to consolidate code
-    CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std::set<uint256>* txids);
+    CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std::set<uint256>* txids, const CBlockMerkleTree* tree);
 };
 
 #endif // BITCOIN_MERKLEBLOCK_H
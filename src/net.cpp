@@ -36,6 +36,7 @@
 #include <string.h>
 #else
 #include <fcntl.h>
+#include <sys/uio.h>
 #endif
 
 #if HAVE_DECL_GETIFADDRS && HAVE_DECL_FREEIFADDRS
@@ -54,6 +55,7 @@
 #include <sys/event.h>
 #endif
 
+#include <array>
 #include <cstdint>
 #include <unordered_map>
 
@@ -679,35 +681,74 @@ bool CNode::ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete
         nBytes -= handled;
 
         if (m_deserializer->Complete()) {
-            // decompose a transport agnostic CNetMessage from the deserializer
-            uint32_t out_err_raw_size{0};
-            std::optional<CNetMessage> result{m_deserializer->GetMessage(nTimeMicros, out_err_raw_size)};
-            if (!result) {
-                // Message deserialization failed.  Drop the message but don't disconnect the peer.
-                // store the size of the corrupt message
-                mapRecvBytesPerMsgCmd.find(NET_MESSAGE_COMMAND_OTHER)->second += out_err_raw_size;
-                continue;
-            }
-
-            //store received bytes per message command
-            //to prevent a memory DOS, only allow valid commands
-            mapMsgCmdSize::iterator i = mapRecvBytesPerMsgCmd.find(result->m_command);
-            if (i == mapRecvBytesPerMsgCmd.end())
-                i = mapRecvBytesPerMsgCmd.find(NET_MESSAGE_COMMAND_OTHER);
-            assert(i != mapRecvBytesPerMsgCmd.end());
-            i->second += result->m_raw_message_size;
-            statsClient.count("bandwidth.message." + std::string(result->m_command) + ".bytesReceived", result->m_raw_message_size, 1.0f);
+            MessageCompleted(nTimeMicros, complete);
+        }
+    }
 
-            // push the message to the process queue,
-            vRecvMsg.push_back(std::move(*result));
+    return true;
+}
 
-            complete = true;
+bool CNode::ReceiveMsgBytesDirect(int& nBytes, bool& complete)
+{
+    complete = false;
+    nBytes = 0;
+    LOCK(cs_vRecv);
+    Span<char> buf = m_deserializer->GetReceiveBuffer();
+    if (buf.empty()) {
+        return false;
+    }
+    {
+        LOCK(cs_hSocket);
+        if (hSocket == INVALID_SOCKET) {
+            return false;
         }
+        nBytes = recv(hSocket, buf.data(), buf.size(), MSG_DONTWAIT);
+        if (nBytes < (int)buf.size()) {
+            fHasRecvData = false;
+        }
+    }
+    if (nBytes <= 0) {
+        // the caller handles closed sockets and errors
+        return true;
     }
 
+    int64_t nTimeMicros = GetTimeMicros();
+    nLastRecv = nTimeMicros / 1000000;
+    nRecvBytes += nBytes;
+    m_deserializer->MarkBytesReceived(nBytes);
+    if (m_deserializer->Complete()) {
+        MessageCompleted(nTimeMicros, complete);
+    }
     return true;
 }
 
+void CNode::MessageCompleted(int64_t nTimeMicros, bool& complete)
+{
+    // decompose a transport agnostic CNetMessage from the deserializer
+    uint32_t out_err_raw_size{0};
+    std::optional<CNetMessage> result{m_deserializer->GetMessage(nTimeMicros, out_err_raw_size)};
+    if (!result) {
+        // Message deserialization failed.  Drop the message but don't disconnect the peer.
+        // store the size of the corrupt message
+        mapRecvBytesPerMsgCmd.find(NET_MESSAGE_COMMAND_OTHER)->second += out_err_raw_size;
+        return;
+    }
+
+    //store received bytes per message command
+    //to prevent a memory DOS, only allow valid commands
+    mapMsgCmdSize::iterator i = mapRecvBytesPerMsgCmd.find(result->m_command);
+    if (i == mapRecvBytesPerMsgCmd.end())
+        i = mapRecvBytesPerMsgCmd.find(NET_MESSAGE_COMMAND_OTHER);
+    assert(i != mapRecvBytesPerMsgCmd.end());
+    i->second += result->m_raw_message_size;
+    statsClient.count("bandwidth.message." + std::string(result->m_command) + ".bytesReceived", result->m_raw_message_size, 1.0f);
+
+    // push the message to the process queue,
+    vRecvMsg.push_back(std::move(*result));
+
+    complete = true;
+}
+
 void CNode::SetSendVersion(int nVersionIn)
 {
     // Send version may only be changed in the version message, and
@@ -774,7 +815,7 @@ int V1TransportDeserializer::readHeader(const char *pch, unsigned int nBytes)
     return nCopy;
 }
 
-int V1TransportDeserializer::readData(const char *pch, unsigned int nBytes)
+unsigned int V1TransportDeserializer::growDataBuffer(unsigned int nBytes)
 {
     unsigned int nRemaining = hdr.nMessageSize - nDataPos;
     unsigned int nCopy = std::min(nRemaining, nBytes);
@@ -784,6 +825,13 @@ int V1TransportDeserializer::readData(const char *pch, unsigned int nBytes)
         vRecv.resize(std::min(hdr.nMessageSize, nDataPos + nCopy + 256 * 1024));
     }
 
+    return nCopy;
+}
+
+int V1TransportDeserializer::readData(const char *pch, unsigned int nBytes)
+{
+    unsigned int nCopy = growDataBuffer(nBytes);
+
     hasher.Write({(const unsigned char*)pch, nCopy});
     memcpy(&vRecv[nDataPos], pch, nCopy);
     nDataPos += nCopy;
@@ -791,6 +839,33 @@ int V1TransportDeserializer::readData(const char *pch, unsigned int nBytes)
     return nCopy;
 }
 
+Span<char> V1TransportDeserializer::GetReceiveBuffer()
+{
+    if (!in_data) {
+        return {};
+    }
+    unsigned int nRemaining = hdr.nMessageSize - nDataPos;
+    // A dedicated recv() is only worth it for payloads larger than the
+    // caller's staging buffer; smaller messages tend to arrive coalesced
+    // with other messages anyway, which a direct read can't exploit.
+    if (nRemaining < 0x10000) {
+        return {};
+    }
+    // Keep the bounded read-ahead allocation of readData() instead of
+    // allocating the full (attacker-supplied) message size at once.
+    unsigned int nAvail = growDataBuffer(256 * 1024);
+    return {(char*)&vRecv[nDataPos], nAvail};
+}
+
+void V1TransportDeserializer::MarkBytesReceived(unsigned int nBytes)
+{
+    assert(in_data && nDataPos + nBytes <= hdr.nMessageSize);
+    assert(vRecv.size() >= nDataPos + nBytes);
+
+    hasher.Write({(const unsigned char*)&vRecv[nDataPos], nBytes});
+    nDataPos += nBytes;
+}
+
 const uint256& V1TransportDeserializer::GetMessageHash() const
 {
     assert(Complete());
@@ -855,27 +930,51 @@ size_t CConnman::SocketSendData(CNode *pnode) EXCLUSIVE_LOCKS_REQUIRED(pnode->cs
     size_t nSentSize = 0;
 
     while (it != pnode->vSendMsg.end()) {
-        const auto &data = *it;
-        assert(data.size() > pnode->nSendOffset);
+        assert((*it)->size() > pnode->nSendOffset);
         int nBytes = 0;
+        size_t nGathered = 0;
         {
             LOCK(pnode->cs_hSocket);
             if (pnode->hSocket == INVALID_SOCKET)
                 break;
+#ifndef WIN32
+            // Gather as many queued buffers as possible into a single
+            // sendmsg() call, so flushing a backlog of small messages costs
+            // one syscall instead of one per message.
+            std::array<iovec, 64> iov;
+            size_t nIovs{0};
+            for (auto jt = it; jt != pnode->vSendMsg.end() && nIovs < iov.size(); ++jt) {
+                size_t nOffset = (jt == it) ? pnode->nSendOffset : 0;
+                iov[nIovs].iov_base = const_cast<unsigned char*>((*jt)->data()) + nOffset;
+                iov[nIovs].iov_len = (*jt)->size() - nOffset;
+                nGathered += iov[nIovs].iov_len;
+                nIovs++;
+            }
+            msghdr msg{};
+            msg.msg_iov = iov.data();
+            msg.msg_iovlen = nIovs;
+            nBytes = sendmsg(pnode->hSocket, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+#else
+            const auto& data = **it;
+            nGathered = data.size() - pnode->nSendOffset;
             nBytes = send(pnode->hSocket, reinterpret_cast<const char*>(data.data()) + pnode->nSendOffset, data.size() - pnode->nSendOffset, MSG_NOSIGNAL | MSG_DONTWAIT);
+#endif
         }
         if (nBytes > 0) {
             pnode->nLastSend = GetSystemTimeInSeconds();
             pnode->nSendBytes += nBytes;
             pnode->nSendOffset += nBytes;
             nSentSize += nBytes;
-            if (pnode->nSendOffset == data.size()) {
-                pnode->nSendOffset = 0;
-                pnode->nSendSize -= data.size();
-                pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
+            // pop all fully sent buffers, carrying a partially sent tail as
+            // the new offset into the next buffer
+            while (it != pnode->vSendMsg.end() && pnode->nSendOffset >= (*it)->size()) {
+                pnode->nSendOffset -= (*it)->size();
+                pnode->nSendSize -= (*it)->size();
                 it++;
-            } else {
-                // could not send full message; stop sending more
+            }
+            pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
+            if ((size_t)nBytes < nGathered) {
+                // could not send everything that was gathered; stop sending more
                 pnode->fCanSendData = false;
                 break;
             }
@@ -981,6 +1080,17 @@ bool CConnman::AttemptToEvictConnection()
             if (node->fDisconnect)
                 continue;
 
+            // Connection-slot QoS: intra-quorum relay connections and peers with a
+            // valid MNAUTH never compete with regular inbound traffic for slots.
+            // This also holds when this node is not a masternode itself (e.g. a
+            // relay node in front of one); such connections are naturally limited
+            // by the number of registered masternodes and are not counted against
+            // the inbound limit in AcceptConnection, so this is not usable for
+            // slot exhaustion attacks.
+            if (node->m_masternode_iqr_connection || !node->GetVerifiedProRegTxHash().IsNull()) {
+                continue;
+            }
+
             if (fMasternodeMode) {
                 // This handles eviction protected nodes. Nodes are always protected for a short time after the connection
                 // was accepted. This short time is meant for the VERSION/VERACK exchange and the possible MNAUTH that might
@@ -990,11 +1100,6 @@ bool CConnman::AttemptToEvictConnection()
                 if (node->nTimeFirstMessageReceived != 0 && !node->fFirstMessageIsMNAUTH) {
                     isProtected = false;
                 }
-                // if MNAUTH was valid, the node is always protected (and at the same time not accounted when
-                // checking incoming connection limits)
-                if (!node->GetVerifiedProRegTxHash().IsNull()) {
-                    isProtected = true;
-                }
                 if (isProtected) {
                     continue;
                 }
@@ -1105,6 +1210,23 @@ void CConnman::AcceptConnection(const ListenSocket& hListenSocket) {
         legacyWhitelisted = true;
     }
 
+    // Admission control before any shared-state work: during an inbound
+    // connection flood, drop excess attempts right after accept() via a token
+    // bucket so each dropped connection costs O(1) and never touches
+    // cs_vNodes, the banlist or CNode allocation. Whitelisted peers bypass.
+    if (hSocket != INVALID_SOCKET && !NetPermissions::HasFlag(permissionFlags, NetPermissionFlags::PF_NOBAN)) {
+        const int64_t nNow = GetTimeMillis();
+        m_accept_tokens = std::min<double>(INBOUND_ACCEPT_BURST,
+                m_accept_tokens + (nNow - m_accept_tokens_last_refill) * INBOUND_ACCEPT_RATE_PER_SEC / 1000.0);
+        m_accept_tokens_last_refill = nNow;
+        if (m_accept_tokens < 1.0) {
+            LogPrint(BCLog::NET, "connection dropped (accept rate limited)\n");
+            CloseSocket(hSocket);
+            return;
+        }
+        m_accept_tokens -= 1.0;
+    }
+
     {
         LOCK(cs_vNodes);
         for (const CNode* pnode : vNodes) {
@@ -1450,10 +1572,8 @@ void CConnman::InactivityCheck(CNode *pnode)
 
 bool CConnman::GenerateSelectSet(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set)
 {
-    for (const ListenSocket& hListenSocket : vhListenSocket) {
-        recv_set.insert(hListenSocket.socket);
-    }
-
+    // Note: listening sockets are handled by ThreadListenHandler and are
+    // deliberately not part of this set.
     {
         LOCK(cs_vNodes);
         for (CNode* pnode : vNodes)
@@ -1737,17 +1857,6 @@ void CConnman::SocketHandler()
 
     if (interruptNet) return;
 
-    //
-    // Accept new connections
-    //
-    for (const ListenSocket& hListenSocket : vhListenSocket)
-    {
-        if (hListenSocket.socket != INVALID_SOCKET && recv_set.count(hListenSocket.socket) > 0)
-        {
-            AcceptConnection(hListenSocket);
-        }
-    }
-
     std::vector<CNode*> vErrorNodes;
     std::vector<CNode*> vReceivableNodes;
     std::vector<CNode*> vSendableNodes;
@@ -1888,25 +1997,29 @@ void CConnman::SocketHandler()
 
 size_t CConnman::SocketRecvData(CNode *pnode)
 {
-    // typical socket buffer is 8K-64K
-    char pchBuf[0x10000];
     int nBytes = 0;
-    {
-        LOCK(pnode->cs_hSocket);
-        if (pnode->hSocket == INVALID_SOCKET)
-            return 0;
-        nBytes = recv(pnode->hSocket, pchBuf, sizeof(pchBuf), MSG_DONTWAIT);
-        if (nBytes < (int)sizeof(pchBuf)) {
-            pnode->fHasRecvData = false;
+    bool notify = false;
+    // When a large message payload is pending, receive it straight into the
+    // deserializer's buffer, skipping the copy through the stack buffer below.
+    if (!pnode->ReceiveMsgBytesDirect(nBytes, notify)) {
+        // typical socket buffer is 8K-64K
+        char pchBuf[0x10000];
+        {
+            LOCK(pnode->cs_hSocket);
+            if (pnode->hSocket == INVALID_SOCKET)
+                return 0;
+            nBytes = recv(pnode->hSocket, pchBuf, sizeof(pchBuf), MSG_DONTWAIT);
+            if (nBytes < (int)sizeof(pchBuf)) {
+                pnode->fHasRecvData = false;
+            }
         }
-    }
-    if (nBytes > 0)
-    {
-        bool notify = false;
-        if (!pnode->ReceiveMsgBytes(pchBuf, nBytes, notify)) {
+        if (nBytes > 0 && !pnode->ReceiveMsgBytes(pchBuf, nBytes, notify)) {
             LOCK(cs_vNodes);
             pnode->CloseSocketDisconnect(this);
         }
+    }
+    if (nBytes > 0)
+    {
         RecordBytesRecv(nBytes);
         if (notify) {
             size_t nSizeAdded = 0;
@@ -1975,6 +2088,48 @@ void CConnman::ThreadSocketHandler()
     }
 }
 
+void CConnman::ThreadListenHandler()
+{
+    // Accepting runs on its own thread so that an inbound connection storm
+    // can't delay IO for established peers in ThreadSocketHandler (and a slow
+    // socket handler round can't grow the kernel accept backlog). The set of
+    // listening sockets is small and fixed after Start(), so a plain select()
+    // is sufficient regardless of the configured socket events mode.
+    while (!interruptNet)
+    {
+        fd_set fdsetRecv;
+        FD_ZERO(&fdsetRecv);
+        SOCKET hSocketMax = 0;
+        for (const ListenSocket& hListenSocket : vhListenSocket) {
+            FD_SET(hListenSocket.socket, &fdsetRecv);
+            hSocketMax = std::max(hSocketMax, hListenSocket.socket);
+        }
+
+        struct timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = SELECT_TIMEOUT_MILLISECONDS * 1000;
+
+        int nSelect = select(hSocketMax + 1, &fdsetRecv, nullptr, nullptr, &timeout);
+        if (interruptNet) {
+            return;
+        }
+        if (nSelect == SOCKET_ERROR) {
+            int nErr = WSAGetLastError();
+            LogPrintf("listen socket select error %s\n", NetworkErrorString(nErr));
+            if (!interruptNet.sleep_for(std::chrono::milliseconds(SELECT_TIMEOUT_MILLISECONDS))) {
+                return;
+            }
+            continue;
+        }
+
+        for (const ListenSocket& hListenSocket : vhListenSocket) {
+            if (hListenSocket.socket != INVALID_SOCKET && FD_ISSET(hListenSocket.socket, &fdsetRecv)) {
+                AcceptConnection(hListenSocket);
+            }
+        }
+    }
+}
+
 void CConnman::WakeMessageHandler()
 {
     {
@@ -2717,8 +2872,18 @@ void CConnman::OpenNetworkConnection(const CAddress& addrConnect, bool fCountFai
         pnode->fFeeler = true;
     if (manual_connection)
         pnode->m_manual_connection = true;
-    if (masternode_connection == MasternodeConn::IsConnection)
+    if (masternode_connection == MasternodeConn::IsConnection) {
         pnode->m_masternode_connection = true;
+        // Quorum traffic is small and latency critical: keep the kernel send
+        // queue shallow so sig shares don't sit behind head-of-line blocking
+        // on congested links, and (where supported) only report the socket
+        // writable while the unsent queue is below the low-water mark.
+        LOCK(pnode->cs_hSocket);
+        if (pnode->hSocket != INVALID_SOCKET) {
+            SetSocketSendBuffer(pnode->hSocket, MASTERNODE_SO_SNDBUF);
+            SetSocketNotSentLowat(pnode->hSocket, MASTERNODE_TCP_NOTSENT_LOWAT);
+        }
+    }
     if (masternode_probe_connection == MasternodeProbeConn::IsConnection)
         pnode->m_masternode_probe_connection = true;
 
@@ -2748,6 +2913,12 @@ void CConnman::ThreadMessageHandler()
     {
         std::vector<CNode*> vNodesCopy = CopyNodeVector();
 
+        // Randomize the order in which we process messages per pass. The
+        // vector otherwise keeps connection order, so peers near its front
+        // would consistently be serviced first and an expensive message from
+        // them would repeatedly delay the same set of later peers.
+        Shuffle(vNodesCopy.begin(), vNodesCopy.end(), FastRandomContext());
+
         bool fMoreWork = false;
 
         bool fSkipSendMessagesForMasternodes = true;
@@ -2848,31 +3019,9 @@ bool CConnman::BindListenPort(const CService& addrBind, bilingual_str& strError,
         return false;
     }
 
-#ifdef USE_KQUEUE
-    if (socketEventsMode == SOCKETEVENTS_KQUEUE) {
-        struct kevent event;
-        EV_SET(&event, sock->Get(), EVFILT_READ, EV_ADD, 0, 0, nullptr);
-        if (kevent(kqueuefd, &event, 1, nullptr, 0, nullptr) != 0) {
-            strError = strprintf(_("Error: failed to add socket to kqueuefd (kevent returned error %s)"), NetworkErrorString(WSAGetLastError()));
-            LogPrintf("%s\n", strError.original);
-            return false;
-        }
-    }
-#endif
-
-#ifdef USE_EPOLL
-    if (socketEventsMode == SOCKETEVENTS_EPOLL) {
-        epoll_event event;
-        event.data.fd = sock->Get();
-        event.events = EPOLLIN;
-        if (epoll_ctl(epollfd, EPOLL_CTL_ADD, sock->Get(), &event) != 0) {
-            strError = strprintf(_("Error: failed to add socket to epollfd (epoll_ctl returned error %s)"), NetworkErrorString(WSAGetLastError()));
-            LogPrintf("%s\n", strError.original);
-            return false;
-        }
-    }
-#endif
-
+    // Listening sockets are polled by the dedicated ThreadListenHandler and
+    // thus aren't registered with the kqueue/epoll instance of the socket
+    // handler thread.
     vhListenSocket.push_back(ListenSocket(sock->Release(), permissions));
 
     if (addrBind.IsRoutable() && fDiscover && (permissions & PF_NOBAN) == 0)
@@ -2997,6 +3146,22 @@ bool CConnman::InitBinds(const std::vector<CService>& binds, const std::vector<N
     return fBound;
 }
 
+void CConnman::LoadAddresses()
+{
+    int64_t nStart = GetTimeMillis();
+    CAddrDB adb;
+    fAddressesLoaded = adb.Read(addrman);
+    if (fAddressesLoaded) {
+        LogPrintf("Loaded %i addresses from peers.dat  %dms\n", addrman.size(), GetTimeMillis() - nStart);
+    }
+}
+
+void CConnman::StartAddressLoad()
+{
+    assert(!threadAddressLoad.joinable());
+    threadAddressLoad = std::thread(&TraceThread<std::function<void()> >, "addrload", std::function<void()>(std::bind(&CConnman::LoadAddresses, this)));
+}
+
 bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
 {
     Init(connOptions);
@@ -3048,17 +3213,17 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     if (clientInterface) {
         clientInterface->InitMessage(_("Loading P2P addresses...").translated);
     }
-    // Load addresses from peers.dat
-    int64_t nStart = GetTimeMillis();
-    {
-        CAddrDB adb;
-        if (adb.Read(addrman))
-            LogPrintf("Loaded %i addresses from peers.dat  %dms\n", addrman.size(), GetTimeMillis() - nStart);
-        else {
-            addrman.Clear(); // Addrman can be in an inconsistent state after failure, reset it
-            LogPrintf("Recreating peers.dat\n");
-            DumpAddresses();
-        }
+    // Load addresses from peers.dat, unless a background load was kicked off
+    // earlier via StartAddressLoad(), in which case just wait for it
+    if (threadAddressLoad.joinable()) {
+        threadAddressLoad.join();
+    } else {
+        LoadAddresses();
+    }
+    if (!fAddressesLoaded) {
+        addrman.Clear(); // Addrman can be in an inconsistent state after failure, reset it
+        LogPrintf("Recreating peers.dat\n");
+        DumpAddresses();
     }
 
     uiInterface.InitMessage(_("Starting network threads...").translated);
@@ -3131,6 +3296,11 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     // Send and receive from sockets, accept connections
     threadSocketHandler = std::thread(&TraceThread<std::function<void()> >, "net", std::function<void()>(std::bind(&CConnman::ThreadSocketHandler, this)));
 
+    // Accept connections on the listening sockets
+    if (!vhListenSocket.empty()) {
+        threadListenHandler = std::thread(&TraceThread<std::function<void()> >, "listen", std::function<void()>(std::bind(&CConnman::ThreadListenHandler, this)));
+    }
+
     if (!gArgs.GetBoolArg("-dnsseed", true))
         LogPrintf("DNS seeding disabled\n");
     else
@@ -3211,6 +3381,8 @@ void CConnman::Interrupt()
 
 void CConnman::Stop()
 {
+    if (threadAddressLoad.joinable())
+        threadAddressLoad.join();
     if (threadMessageHandler.joinable())
         threadMessageHandler.join();
     if (threadOpenMasternodeConnections.joinable())
@@ -3221,6 +3393,8 @@ void CConnman::Stop()
         threadOpenAddedConnections.join();
     if (threadDNSAddressSeed.joinable())
         threadDNSAddressSeed.join();
+    if (threadListenHandler.joinable())
+        threadListenHandler.join();
     if (threadSocketHandler.joinable())
         threadSocketHandler.join();
 
@@ -3239,18 +3413,6 @@ void CConnman::Stop()
     }
     for (ListenSocket& hListenSocket : vhListenSocket)
         if (hListenSocket.socket != INVALID_SOCKET) {
-#ifdef USE_KQUEUE
-            if (socketEventsMode == SOCKETEVENTS_KQUEUE) {
-                struct kevent event;
-                EV_SET(&event, hListenSocket.socket, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
-                kevent(kqueuefd, &event, 1, nullptr, 0, nullptr);
-            }
-#endif
-#ifdef USE_EPOLL
-            if (socketEventsMode == SOCKETEVENTS_EPOLL) {
-                epoll_ctl(epollfd, EPOLL_CTL_DEL, hListenSocket.socket, nullptr);
-            }
-#endif
             if (!CloseSocket(hListenSocket.socket))
                 LogPrintf("CloseSocket(hListenSocket) failed with error %s\n", NetworkErrorString(WSAGetLastError()));
         }
@@ -3607,13 +3769,23 @@ void CConnman::RelayTransaction(const CTransaction& tx)
     RelayInv(inv);
 }
 
+/** Lock announcements gain a hop of latency for every message-handler idle
+ *  timeout they sit through; they are worth an explicit wake-up. */
+static bool IsLatencyCriticalInv(const CInv& inv)
+{
+    return inv.type == MSG_ISLOCK || inv.type == MSG_ISDLOCK || inv.type == MSG_CLSIG;
+}
+
 void CConnman::RelayInv(CInv &inv, const int minProtoVersion) {
-    LOCK(cs_vNodes);
-    for (const auto& pnode : vNodes) {
-        if (pnode->nVersion < minProtoVersion || !pnode->CanRelay())
-            continue;
-        pnode->PushInventory(inv);
+    {
+        LOCK(cs_vNodes);
+        for (const auto& pnode : vNodes) {
+            if (pnode->nVersion < minProtoVersion || !pnode->CanRelay())
+                continue;
+            pnode->PushInventory(inv);
+        }
     }
+    if (IsLatencyCriticalInv(inv)) WakeMessageHandler();
 }
 
 void CConnman::RelayInvFiltered(CInv &inv, const CTransaction& relatedTx, const int minProtoVersion)
@@ -3634,6 +3806,7 @@ void CConnman::RelayInvFiltered(CInv &inv, const CTransaction& relatedTx, const
         }
         pnode->PushInventory(inv);
     }
+    if (IsLatencyCriticalInv(inv)) WakeMessageHandler();
 }
 
 void CConnman::RelayInvFiltered(CInv &inv, const uint256& relatedTxHash, const int minProtoVersion)
@@ -3654,6 +3827,7 @@ void CConnman::RelayInvFiltered(CInv &inv, const uint256& relatedTxHash, const i
         }
         pnode->PushInventory(inv);
     }
+    if (IsLatencyCriticalInv(inv)) WakeMessageHandler();
 }
 
 void CConnman::RecordBytesRecv(uint64_t bytes)
@@ -3810,31 +3984,76 @@ bool CConnman::NodeFullyConnected(const CNode* pnode)
 
 void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 {
-    size_t nMessageSize = msg.data.size();
-    LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n", SanitizeString(msg.command), nMessageSize, pnode->GetId());
+    // Small payloads are appended to the header buffer, so the message costs
+    // one heap buffer and one iovec instead of two of each. Most steady-state
+    // traffic (pings, invs, addr trickles) falls into this class; large
+    // payloads are moved into their own buffer instead of being copied.
+    constexpr size_t nCoalesceLimit{1024};
 
     // make sure we use the appropriate network transport format
     std::vector<unsigned char> serializedHeader;
+    if (!msg.data.empty() && msg.data.size() <= nCoalesceLimit) {
+        serializedHeader.reserve(CMessageHeader::HEADER_SIZE + msg.data.size());
+    }
     pnode->m_serializer->prepareForTransport(msg, serializedHeader);
 
-    size_t nTotalSize = nMessageSize + serializedHeader.size();
-    statsClient.count("bandwidth.message." + SanitizeString(msg.command.c_str()) + ".bytesSent", nTotalSize, 1.0f);
-    statsClient.inc("message.sent." + SanitizeString(msg.command.c_str()), 1.0f);
+    std::shared_ptr<const std::vector<unsigned char>> data;
+    if (!msg.data.empty()) {
+        if (msg.data.size() <= nCoalesceLimit) {
+            serializedHeader.insert(serializedHeader.end(), msg.data.begin(), msg.data.end());
+        } else {
+            data = std::make_shared<const std::vector<unsigned char>>(std::move(msg.data));
+        }
+    }
+    PushSerializedMessage(pnode, msg.command, std::make_shared<const std::vector<unsigned char>>(std::move(serializedHeader)), data);
+}
+
+void CConnman::PushMessage(const std::vector<CNode*>& pnodes, CSerializedNetMsg&& msg)
+{
+    if (pnodes.empty()) {
+        return;
+    }
+
+    // All peers speak the same v1 transport, so the header (including the
+    // payload checksum) only needs to be computed once for the whole fan-out
+    std::vector<unsigned char> serializedHeader;
+    pnodes.front()->m_serializer->prepareForTransport(msg, serializedHeader);
+
+    auto sharedHeader = std::make_shared<const std::vector<unsigned char>>(std::move(serializedHeader));
+    std::shared_ptr<const std::vector<unsigned char>> sharedData;
+    if (!msg.data.empty()) {
+        sharedData = std::make_shared<const std::vector<unsigned char>>(std::move(msg.data));
+    }
+
+    for (CNode* pnode : pnodes) {
+        PushSerializedMessage(pnode, msg.command, sharedHeader, sharedData);
+    }
+}
+
+void CConnman::PushSerializedMessage(CNode* pnode, const std::string& command,
+                                     const std::shared_ptr<const std::vector<unsigned char>>& serializedHeader,
+                                     const std::shared_ptr<const std::vector<unsigned char>>& data)
+{
+    size_t nMessageSize = data ? data->size() : 0;
+    LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n", SanitizeString(command), nMessageSize, pnode->GetId());
+
+    size_t nTotalSize = nMessageSize + serializedHeader->size();
+    statsClient.count("bandwidth.message." + SanitizeString(command) + ".bytesSent", nTotalSize, 1.0f);
+    statsClient.inc("message.sent." + SanitizeString(command), 1.0f);
 
-    size_t nBytesSent = 0;
     {
         LOCK(pnode->cs_vSend);
         bool hasPendingData = !pnode->vSendMsg.empty();
 
         //log total amount of bytes per command
-        pnode->mapSendBytesPerMsgCmd[msg.command] += nTotalSize;
+        pnode->mapSendBytesPerMsgCmd[command] += nTotalSize;
         pnode->nSendSize += nTotalSize;
 
         if (pnode->nSendSize > nSendBufferMaxSize)
             pnode->fPauseSend = true;
-        pnode->vSendMsg.push_back(std::move(serializedHeader));
+        pnode->vSendMsg.push_back(serializedHeader);
         if (nMessageSize)
-            pnode->vSendMsg.push_back(std::move(msg.data));
+            pnode->vSendMsg.push_back(data);
         pnode->nSendMsgSize = pnode->vSendMsg.size();
 
         {
@@ -3852,8 +4071,6 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
         if (!hasPendingData && wakeupSelectNeeded)
             WakeSelect();
     }
-    if (nBytesSent)
-        RecordBytesSent(nBytesSent);
 }
 
 bool CConnman::ForNode(const CService& addr, std::function<bool(const CNode* pnode)> cond, std::function<bool(CNode* pnode)> func)
@@ -22,6 +22,7 @@
 #include <random.h>
 #include <saltedhasher.h>
 #include <streams.h>
+#include <support/allocators/counting.h>
 #include <sync.h>
 #include <threadinterrupt.h>
 #include <uint256.h>
@@ -97,6 +98,19 @@ static const int64_t DEFAULT_PEER_CONNECT_TIMEOUT = 60;
 static const bool DEFAULT_FORCEDNSSEED = false;
 static const size_t DEFAULT_MAXRECEIVEBUFFER = 5 * 1000;
 static const size_t DEFAULT_MAXSENDBUFFER    = 1 * 1000;
+/** Kernel send buffer for latency-critical masternode connections. Kept shallow
+ *  so small quorum messages aren't queued behind bulk data in the kernel;
+ *  regular peers keep the (deep) kernel-autotuned default for IBD throughput. */
+static const int MASTERNODE_SO_SNDBUF = 64 * 1024;
+/** TCP_NOTSENT_LOWAT for masternode connections, where supported. */
+static const int MASTERNODE_TCP_NOTSENT_LOWAT = 16 * 1024;
+/** Sustained rate (per second) at which non-whitelisted inbound connection
+ *  attempts are admitted past accept(). Generous for normal operation; during
+ *  a connection flood, attempts above this are dropped before any shared-state
+ *  work or CNode allocation happens. */
+static const int INBOUND_ACCEPT_RATE_PER_SEC = 25;
+/** Burst allowance for the inbound accept token bucket. */
+static const int INBOUND_ACCEPT_BURST = 100;
 
 #if defined USE_KQUEUE
 #define DEFAULT_SOCKETEVENTS "kqueue"
@@ -215,6 +229,11 @@ public:
 
     CConnman(uint64_t seed0, uint64_t seed1);
     ~CConnman();
+
+    /** Begin reading peers.dat on a background thread so the deserialization
+     *  overlaps with the rest of init. Optional; Start() joins the thread if
+     *  one was launched and falls back to a synchronous load otherwise. */
+    void StartAddressLoad();
     bool Start(CScheduler& scheduler, const Options& options);
 
     // TODO: Remove NO_THREAD_SAFETY_ANALYSIS. Lock cs_vNodes before reading the variable vNodes.
@@ -287,6 +306,10 @@ public:
     bool IsMasternodeOrDisconnectRequested(const CService& addr);
 
     void PushMessage(CNode* pnode, CSerializedNetMsg&& msg);
+    /** Queue the same message on multiple peers at once. The header (incl. the
+     *  payload checksum) and the payload are serialized exactly once and the
+     *  resulting buffers are shared by all the peers' send queues. */
+    void PushMessage(const std::vector<CNode*>& pnodes, CSerializedNetMsg&& msg);
 
     template<typename Condition, typename Callable>
     bool ForEachNodeContinueIf(const Condition& cond, Callable&& func)
@@ -486,7 +509,10 @@ public:
     */
     int64_t PoissonNextSendInbound(int64_t now, int average_interval_seconds);
 
-    void SetAsmap(std::vector<bool> asmap) { addrman.m_asmap = std::move(asmap); }
+    /** Set the ASN map used for peer bucketing. Must be called before
+     *  StartAddressLoad()/Start(): the peers.dat load reads m_asmap without
+     *  synchronization. */
+    void SetAsmap(std::vector<bool> asmap) { assert(!threadAddressLoad.joinable()); addrman.m_asmap = std::move(asmap); }
 
 private:
     struct ListenSocket {
@@ -525,6 +551,7 @@ private:
     void SocketEvents(std::set<SOCKET> &recv_set, std::set<SOCKET> &send_set, std::set<SOCKET> &error_set, bool fOnlyPoll);
     void SocketHandler();
     void ThreadSocketHandler();
+    void ThreadListenHandler();
     void ThreadDNSAddressSeed();
     void ThreadOpenMasternodeConnections();
 
@@ -544,8 +571,12 @@ private:
     NodeId GetNewNodeId();
 
     size_t SocketSendData(CNode *pnode);
+    void PushSerializedMessage(CNode* pnode, const std::string& command,
+                               const std::shared_ptr<const std::vector<unsigned char>>& serializedHeader,
+                               const std::shared_ptr<const std::vector<unsigned char>>& data);
     size_t SocketRecvData(CNode* pnode);
     void DumpAddresses();
+    void LoadAddresses();
 
     // Network stats
     void RecordBytesRecv(uint64_t bytes);
@@ -579,8 +610,14 @@ private:
     unsigned int nReceiveFloodSize{0};
 
     std::vector<ListenSocket> vhListenSocket;
+    // Inbound accept admission token bucket. Only ever touched on the listen
+    // handler thread, so no locking is needed.
+    double m_accept_tokens{INBOUND_ACCEPT_BURST};
+    int64_t m_accept_tokens_last_refill{0};
     std::atomic<bool> fNetworkActive{true};
     bool fAddressesInitialized{false};
+    //! Whether the (possibly backgrounded) peers.dat read succeeded
+    std::atomic<bool> fAddressesLoaded{false};
     CAddrMan addrman;
     std::deque<std::string> vOneShots GUARDED_BY(cs_vOneShots);
     CCriticalSection cs_vOneShots;
@@ -665,8 +702,10 @@ private:
     std::unordered_map<NodeId, CNode*> mapNodesWithDataToSend GUARDED_BY(cs_mapNodesWithDataToSend);
     mutable CCriticalSection cs_mapNodesWithDataToSend;
 
+    std::thread threadAddressLoad;
     std::thread threadDNSAddressSeed;
     std::thread threadSocketHandler;
+    std::thread threadListenHandler;
     std::thread threadOpenAddedConnections;
     std::thread threadOpenConnections;
     std::thread threadOpenMasternodeConnections;
@@ -843,6 +882,14 @@ public:
     virtual void SetVersion(int version) = 0;
     // read and deserialize data
     virtual int Read(const char *data, unsigned int bytes) = 0;
+    // returns a view of the internal receive buffer that the socket may be
+    // read into directly, skipping the copy through Read(). An empty span
+    // means no direct read is possible right now (e.g. header bytes are
+    // expected) and the caller must fall back to Read().
+    virtual Span<char> GetReceiveBuffer() = 0;
+    // account for bytes written directly into the buffer returned by
+    // GetReceiveBuffer()
+    virtual void MarkBytesReceived(unsigned int bytes) = 0;
     // decomposes a message from the context
     virtual std::optional<CNetMessage> GetMessage(int64_t time, uint32_t& out_err) = 0;
     virtual ~TransportDeserializer() {}
@@ -865,6 +912,7 @@ private:
     const uint256& GetMessageHash() const;
     int readHeader(const char *pch, unsigned int nBytes);
     int readData(const char *pch, unsigned int nBytes);
+    unsigned int growDataBuffer(unsigned int nBytes);
 
     void Reset() {
         vRecv.clear();
@@ -903,6 +951,8 @@ public:
         if (ret < 0) Reset();
         return ret;
     }
+    Span<char> GetReceiveBuffer() override;
+    void MarkBytesReceived(unsigned int nBytes) override;
     std::optional<CNetMessage> GetMessage(int64_t time, uint32_t& out_err_raw_size) override;
 };
 
@@ -936,7 +986,16 @@ public:
     size_t nSendSize{0}; // total size of all vSendMsg entries
     size_t nSendOffset{0}; // offset inside the first vSendMsg already sent
     uint64_t nSendBytes GUARDED_BY(cs_vSend){0};
-    std::list<std::vector<unsigned char>> vSendMsg GUARDED_BY(cs_vSend);
+    // serialized header/payload buffers queued for sending. The buffers are
+    // shared so that a message broadcast to many peers is serialized only once
+    using SendMsgBuf = std::shared_ptr<const std::vector<unsigned char>>;
+#ifdef ENABLE_PERF_TRACKING
+    // count send-queue node allocations per site for getmemoryinfo
+    using SendMsgList = std::list<SendMsgBuf, counting_allocator<SendMsgBuf, alloc_tracking::Site::NET_SENDMSG>>;
+#else
+    using SendMsgList = std::list<SendMsgBuf>;
+#endif
+    SendMsgList vSendMsg GUARDED_BY(cs_vSend);
     std::atomic<size_t> nSendMsgSize{0};
     CCriticalSection cs_vSend;
     CCriticalSection cs_hSocket;
@@ -1147,6 +1206,9 @@ private:
     NetPermissionFlags m_permissionFlags{ PF_NONE };
     std::list<CNetMessage> vRecvMsg;  // Used only by SocketHandler thread
 
+    //! Decompose the completed message from the deserializer and queue it on vRecvMsg
+    void MessageCompleted(int64_t nTimeMicros, bool& complete) EXCLUSIVE_LOCKS_REQUIRED(cs_vRecv);
+
     mutable CCriticalSection cs_addrName;
     std::string addrName GUARDED_BY(cs_addrName);
 
@@ -1182,6 +1244,13 @@ public:
     }
 
     bool ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete);
+    /** Receive pending message payload bytes from the socket directly into
+     *  the transport deserializer's buffer, avoiding the copy through the
+     *  caller's staging buffer. Returns false when no direct read is possible
+     *  and the caller should fall back to recv() + ReceiveMsgBytes(). When
+     *  true is returned, nBytes holds the raw recv() result and complete is
+     *  set as in ReceiveMsgBytes. */
+    bool ReceiveMsgBytesDirect(int& nBytes, bool& complete);
 
     void SetRecvVersion(int nVersionIn)
     {
@@ -30,6 +30,7 @@
 #include <util/check.h> // For NDEBUG compile time check
 #include <util/system.h>
 #include <util/strencodings.h>
+#include <util/trace.h>
 #include <util/validation.h>
 
 #include <list>
@@ -87,6 +88,12 @@ static constexpr std::chrono::seconds RELAY_TX_CACHE_TIME{15 * 60};
  *  Timeout = base + per_header * (expected number of headers) */
 static constexpr int64_t HEADERS_DOWNLOAD_TIMEOUT_BASE = 15 * 60 * 1000000; // 15 minutes
 static constexpr int64_t HEADERS_DOWNLOAD_TIMEOUT_PER_HEADER = 1000; // 1ms/header
+/** Number of preferred peers to sync headers from in parallel during initial
+ *  download. getheaders is locator-based so the peers serve overlapping
+ *  ranges, but the fastest peer sets the pace and duplicate headers are
+ *  rejected by a block-index lookup before any PoW is re-checked; a single
+ *  slow sync peer no longer bottlenecks the start of IBD. */
+static constexpr int MAX_HEADERS_SYNC_PEERS = 3;
 /** Protect at least this many outbound peers from disconnection due to slow/
  * behind headers chain.
  */
@@ -113,6 +120,12 @@ static const int PING_INTERVAL = 2 * 60;
 static const unsigned int MAX_LOCATOR_SZ = 101;
 /** Number of blocks that can be requested at any given time from a single peer. */
 static const int MAX_BLOCKS_IN_TRANSIT_PER_PEER = 16;
+/** During initial block download, only refill a peer's block request pipeline when there is room
+ *  for at least this many blocks. Single-block top-ups hand out the shared download window's
+ *  frontier one block at a time across all peers, which interleaves blocks from many peers into
+ *  the blk files in arrival order; batched refills keep per-peer runs contiguous on disk, which
+ *  later sequential readers (-reindex, index builds) benefit from. */
+static const int BLOCK_DOWNLOAD_CHUNK_SIZE = 8;
 /** Timeout in seconds during which a peer must stall block download progress before being disconnected. */
 static const unsigned int BLOCK_STALLING_TIMEOUT = 2;
 /** Maximum depth of blocks we're willing to serve as compact blocks to peers
@@ -215,6 +228,7 @@ namespace {
         uint256 hash;
         const CBlockIndex* pindex;                               //!< Optional.
         bool fValidatedHeaders;                                  //!< Whether this block has validated headers at the time of request.
+        int64_t nTimeRequested;                                  //!< When the block was requested (us), for delivery latency stats.
         std::unique_ptr<PartiallyDownloadedBlock> partialBlock;  //!< Optional, used for CMPCTBLOCK downloads
     };
     std::map<uint256, std::pair<NodeId, std::list<QueuedBlock>::iterator> > mapBlocksInFlight GUARDED_BY(cs_main);
@@ -234,8 +248,15 @@ namespace {
     /** When our tip was last updated. */
     std::atomic<int64_t> g_last_tip_update(0);
 
+    /** Entry in the relay map. Most relayed transactions are requested by
+     *  several peers; the serialized form is cached on the first GETDATA so
+     *  subsequent requests only copy bytes instead of re-serializing. */
+    struct CRelayedTx {
+        CTransactionRef tx;
+        std::shared_ptr<const std::vector<unsigned char>> serialized;
+    };
     /** Relay map */
-    typedef std::map<uint256, CTransactionRef> MapRelay;
+    typedef std::map<uint256, CRelayedTx> MapRelay;
     MapRelay mapRelay GUARDED_BY(cs_main);
     /** Expiration-time ordered list of (expire time, relay map entry) pairs. */
     std::deque<std::pair<int64_t, MapRelay::iterator>> vRelayExpiration GUARDED_BY(cs_main);
@@ -249,6 +270,8 @@ namespace {
         }
     };
     std::map<COutPoint, std::set<std::map<uint256, COrphanTx>::iterator, IteratorComparator>> mapOrphanTransactionsByPrev GUARDED_BY(g_cs_orphans);
+    //! Orphans grouped by announcing peer, so a disconnect doesn't scan the whole pool
+    std::map<NodeId, std::set<std::map<uint256, COrphanTx>::iterator, IteratorComparator>> mapOrphanTransactionsByPeer GUARDED_BY(g_cs_orphans);
 
     std::vector<std::map<uint256, COrphanTx>::iterator> g_orphan_list GUARDED_BY(g_cs_orphans); //! For random eviction
 
@@ -310,6 +333,15 @@ struct CNodeState {
      * otherwise: whether this peer sends non-last version in cmpctblocks/blocktxns.
      */
     bool fSupportsDesiredCmpctVersion;
+    //! Moving average of how long this peer takes to deliver a requested block (in microseconds), 0 if unmeasured.
+    int64_t m_block_delivery_ewma_usec{0};
+    /** Secondary compact block reconstruction in flight from this peer, for a
+     * block whose primary fill-in request went to another (possibly slow)
+     * peer. Bounds memory to one reconstruction per peer and lets us race
+     * getblocktxn requests to multiple announcers instead of being stuck
+     * behind the first one. */
+    std::unique_ptr<PartiallyDownloadedBlock> m_extra_partial_block;
+    uint256 m_extra_partial_block_hash;
 
     /** State used to enforce CHAIN_SYNC_TIMEOUT
       * Only in effect for outbound, non-manual, full-relay connections, with
@@ -446,6 +478,18 @@ unordered_limitedmap<uint256, std::chrono::microseconds, StaticSaltedHasher> g_e
 /** Map maintaining per-node state. */
 static std::map<NodeId, CNodeState> mapNodeState GUARDED_BY(cs_main);
 
+/** Hot per-peer fields mirrored out of CNodeState (SoA-style), so that the
+ *  periodic all-peer eviction scan can read them without taking cs_main.
+ *  Writers keep the mirror in sync while they hold cs_main anyway; the scan
+ *  only does relaxed atomic reads, so a marginally stale value merely shifts
+ *  which peer the eviction heuristic picks. */
+struct CNodeStateHot {
+    std::atomic<int64_t> m_last_block_announcement{0};
+    std::atomic<bool> m_chain_sync_protect{false};
+};
+static Mutex g_node_states_hot_mutex;
+static std::map<NodeId, std::shared_ptr<CNodeStateHot>> g_node_states_hot GUARDED_BY(g_node_states_hot_mutex);
+
 static CNodeState *State(NodeId pnode) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
     std::map<NodeId, CNodeState>::iterator it = mapNodeState.find(pnode);
     if (it == mapNodeState.end())
@@ -453,6 +497,15 @@ static CNodeState *State(NodeId pnode) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
     return &it->second;
 }
 
+static std::shared_ptr<CNodeStateHot> StateHot(NodeId pnode)
+{
+    LOCK(g_node_states_hot_mutex);
+    auto it = g_node_states_hot.find(pnode);
+    if (it == g_node_states_hot.end())
+        return nullptr;
+    return it->second;
+}
+
 static void UpdatePreferredDownload(const CNode& node, CNodeState* state) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
     nPreferredDownload -= state->fPreferredDownload;
@@ -525,6 +578,28 @@ static bool MarkBlockAsReceived(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs
     return false;
 }
 
+// Record how long the given peer took to deliver a block we requested from it.
+// The average feeds the choice of which high-bandwidth compact block slot to
+// recycle in MaybeSetPeerAsAnnouncingHeaderAndIDs. Must be called before the
+// matching MarkBlockAsReceived, which drops the request timestamp.
+static void RecordBlockDeliveryLatency(NodeId nodeid, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+{
+    const auto itInFlight = mapBlocksInFlight.find(hash);
+    if (itInFlight == mapBlocksInFlight.end() || itInFlight->second.first != nodeid) {
+        // We didn't request it from this peer, nothing to measure
+        return;
+    }
+    CNodeState* state = State(nodeid);
+    assert(state != nullptr);
+    const int64_t latency = GetTimeMicros() - itInFlight->second.second->nTimeRequested;
+    if (state->m_block_delivery_ewma_usec == 0) {
+        state->m_block_delivery_ewma_usec = latency;
+    } else {
+        // EWMA with 1/4 weight for the newest sample
+        state->m_block_delivery_ewma_usec = (state->m_block_delivery_ewma_usec * 3 + latency) / 4;
+    }
+}
+
 // returns false, still setting pit, if the block was already in flight from the same peer
 // pit will only be valid as long as the same cs_main lock is being held
 static bool MarkBlockAsInFlight(CTxMemPool& mempool, NodeId nodeid, const uint256& hash, const CBlockIndex *pindex = nullptr, std::list<QueuedBlock>::iterator **pit = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
@@ -544,7 +619,7 @@ static bool MarkBlockAsInFlight(CTxMemPool& mempool, NodeId nodeid, const uint25
     MarkBlockAsReceived(hash);
 
     std::list<QueuedBlock>::iterator it = state->vBlocksInFlight.insert(state->vBlocksInFlight.end(),
-            {hash, pindex, pindex != nullptr, std::unique_ptr<PartiallyDownloadedBlock>(pit ? new PartiallyDownloadedBlock(&mempool) : nullptr)});
+            {hash, pindex, pindex != nullptr, GetTimeMicros(), std::unique_ptr<PartiallyDownloadedBlock>(pit ? new PartiallyDownloadedBlock(&mempool) : nullptr)});
     state->nBlocksInFlight++;
     state->nBlocksInFlightValidHeaders += it->fValidatedHeaders;
     if (state->nBlocksInFlight == 1) {
@@ -622,13 +697,28 @@ static void MaybeSetPeerAsAnnouncingHeaderAndIDs(NodeId nodeid, CConnman& connma
             uint64_t nCMPCTBLOCKVersion = 1;
             if (lNodesAnnouncingHeaderAndIDs.size() >= 3) {
                 // As per BIP152, we only get 3 of our peers to announce
-                // blocks using compact encodings.
-                connman.ForNode(lNodesAnnouncingHeaderAndIDs.front(), [&connman, nCMPCTBLOCKVersion](CNode* pnodeStop){
+                // blocks using compact encodings. Demote the one with the
+                // worst measured block delivery latency (unmeasured peers
+                // count as worst, oldest slot breaks ties) so the genuinely
+                // fastest peers keep their slots.
+                auto itWorst = lNodesAnnouncingHeaderAndIDs.begin();
+                int64_t nWorstLatency{-1};
+                for (auto it = lNodesAnnouncingHeaderAndIDs.begin(); it != lNodesAnnouncingHeaderAndIDs.end(); ++it) {
+                    const CNodeState* slotState = State(*it);
+                    const int64_t nLatency{slotState == nullptr || slotState->m_block_delivery_ewma_usec == 0 ?
+                                               std::numeric_limits<int64_t>::max() :
+                                               slotState->m_block_delivery_ewma_usec};
+                    if (nLatency > nWorstLatency) {
+                        nWorstLatency = nLatency;
+                        itWorst = it;
+                    }
+                }
+                connman.ForNode(*itWorst, [&connman, nCMPCTBLOCKVersion](CNode* pnodeStop){
                     AssertLockHeld(cs_main);
                     connman.PushMessage(pnodeStop, CNetMsgMaker(pnodeStop->GetSendVersion()).Make(NetMsgType::SENDCMPCT, /*fAnnounceUsingCMPCTBLOCK=*/false, nCMPCTBLOCKVersion));
                     return true;
                 });
-                lNodesAnnouncingHeaderAndIDs.pop_front();
+                lNodesAnnouncingHeaderAndIDs.erase(itWorst);
             }
             connman.PushMessage(pfrom, CNetMsgMaker(pfrom->GetSendVersion()).Make(NetMsgType::SENDCMPCT, /*fAnnounceUsingCMPCTBLOCK=*/true, nCMPCTBLOCKVersion));
             lNodesAnnouncingHeaderAndIDs.push_back(pfrom->GetId());
@@ -895,6 +985,7 @@ void UpdateLastBlockAnnounceTime(NodeId node, int64_t time_in_seconds)
     LOCK(cs_main);
     CNodeState *state = State(node);
     if (state) state->m_last_block_announcement = time_in_seconds;
+    if (auto hot = StateHot(node)) hot->m_last_block_announcement.store(time_in_seconds, std::memory_order_relaxed);
 }
 
 // Returns true for outbound peers, excluding manual connections, feelers, and
@@ -912,6 +1003,10 @@ void PeerLogicValidation::InitializeNode(CNode *pnode) {
         LOCK(cs_main);
         mapNodeState.emplace_hint(mapNodeState.end(), std::piecewise_construct, std::forward_as_tuple(nodeid), std::forward_as_tuple(addr, std::move(addrName), pnode->fInbound, pnode->m_manual_connection));
     }
+    {
+        LOCK(g_node_states_hot_mutex);
+        g_node_states_hot.emplace_hint(g_node_states_hot.end(), nodeid, std::make_shared<CNodeStateHot>());
+    }
     if(!pnode->fInbound)
         PushNodeVersion(*pnode, m_connman, GetTime());
 }
@@ -953,6 +1048,10 @@ void PeerLogicValidation::FinalizeNode(NodeId nodeid, bool& fUpdateConnectionTim
     assert(g_outbound_peers_with_protect_from_disconnect >= 0);
 
     mapNodeState.erase(nodeid);
+    {
+        LOCK(g_node_states_hot_mutex);
+        g_node_states_hot.erase(nodeid);
+    }
 
     if (mapNodeState.empty()) {
         // Do a consistency check after the last peer is removed.
@@ -1021,6 +1120,7 @@ bool AddOrphanTx(const CTransactionRef& tx, NodeId peer) EXCLUSIVE_LOCKS_REQUIRE
     for (const CTxIn& txin : tx->vin) {
         mapOrphanTransactionsByPrev[txin.prevout].insert(ret.first);
     }
+    mapOrphanTransactionsByPeer[peer].insert(ret.first);
 
     AddToCompactExtraTransactions(tx);
 
@@ -1048,6 +1148,13 @@ int static EraseOrphanTx(uint256 hash) EXCLUSIVE_LOCKS_REQUIRED(g_cs_orphans)
             mapOrphanTransactionsByPrev.erase(itPrev);
     }
 
+    auto itPeer = mapOrphanTransactionsByPeer.find(it->second.fromPeer);
+    if (itPeer != mapOrphanTransactionsByPeer.end()) {
+        itPeer->second.erase(it);
+        if (itPeer->second.empty())
+            mapOrphanTransactionsByPeer.erase(itPeer);
+    }
+
     size_t old_pos = it->second.list_pos;
     assert(g_orphan_list[old_pos] == it);
     if (old_pos + 1 != g_orphan_list.size()) {
@@ -1071,13 +1178,16 @@ void EraseOrphansFor(NodeId peer)
 {
     LOCK(g_cs_orphans);
     int nErased = 0;
-    std::map<uint256, COrphanTx>::iterator iter = mapOrphanTransactions.begin();
-    while (iter != mapOrphanTransactions.end())
-    {
-        std::map<uint256, COrphanTx>::iterator maybeErase = iter++; // increment to avoid iterator becoming invalid
-        if (maybeErase->second.fromPeer == peer)
-        {
-            nErased += EraseOrphanTx(maybeErase->second.tx->GetHash());
+    auto itPeer = mapOrphanTransactionsByPeer.find(peer);
+    if (itPeer != mapOrphanTransactionsByPeer.end()) {
+        // EraseOrphanTx mutates the per-peer set, so collect the hashes first
+        std::vector<uint256> vEraseQueue;
+        vEraseQueue.reserve(itPeer->second.size());
+        for (const auto& it : itPeer->second) {
+            vEraseQueue.push_back(it->second.tx->GetHash());
+        }
+        for (const uint256& hash : vEraseQueue) {
+            nErased += EraseOrphanTx(hash);
         }
     }
     if (nErased > 0) LogPrint(BCLog::MEMPOOL, "Erased %d orphan tx from peer=%d\n", nErased, peer);
@@ -1257,7 +1367,8 @@ PeerLogicValidation::PeerLogicValidation(CConnman& connman, BanMan* banman, CSch
       m_chainman(chainman),
       m_mempool(pool),
       m_llmq_ctx(llmq_ctx),
-      m_stale_tip_check_time(0)
+      m_stale_tip_check_time(0),
+      m_tx_inv_broadcast_interval(std::max<int64_t>(1, gArgs.GetArg("-txinvbroadcastinterval", INVENTORY_BROADCAST_INTERVAL)))
 {
     // Initialize global variables that cannot be constructed at startup.
     recentRejects.reset(new CRollingBloomFilter(120000, 0.000001));
@@ -1283,6 +1394,58 @@ PeerLogicValidation::PeerLogicValidation(CConnman& connman, BanMan* banman, CSch
     // schedule next run for 10-15 minutes in the future
     const std::chrono::milliseconds delta = std::chrono::minutes{10} + GetRandMillis(std::chrono::minutes{5});
     scheduler.scheduleFromNow([&] { ReattemptInitialBroadcast(scheduler); }, delta);
+
+    m_block_prefetch_thread = std::thread(&TraceThread<std::function<void()> >, "blockprefetch", std::function<void()>(std::bind(&PeerLogicValidation::BlockPrefetchThread, this)));
+}
+
+PeerLogicValidation::~PeerLogicValidation()
+{
+    {
+        LOCK(m_block_prefetch_mutex);
+        m_block_prefetch_interrupt = true;
+    }
+    m_block_prefetch_cv.notify_all();
+    if (m_block_prefetch_thread.joinable()) {
+        m_block_prefetch_thread.join();
+    }
+}
+
+void PeerLogicValidation::BlockPrefetchThread()
+{
+    while (true) {
+        FlatFilePos pos;
+        {
+            WAIT_LOCK(m_block_prefetch_mutex, lock);
+            m_block_prefetch_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_block_prefetch_mutex) {
+                return m_block_prefetch_interrupt || !m_block_prefetch_queue.empty();
+            });
+            if (m_block_prefetch_interrupt) {
+                return;
+            }
+            pos = m_block_prefetch_queue.front();
+            m_block_prefetch_queue.pop_front();
+        }
+        PrefetchBlockFromDisk(pos);
+    }
+}
+
+void PeerLogicValidation::PrefetchBlocks(std::vector<FlatFilePos>&& positions)
+{
+    if (positions.empty()) {
+        return;
+    }
+    {
+        LOCK(m_block_prefetch_mutex);
+        for (const FlatFilePos& pos : positions) {
+            m_block_prefetch_queue.push_back(pos);
+        }
+        // Drop the oldest positions when flooded with requests; the worst
+        // case is a cold read on the message thread, same as before.
+        while (m_block_prefetch_queue.size() > MAX_BLOCKS_IN_TRANSIT_PER_PEER * 8) {
+            m_block_prefetch_queue.pop_front();
+        }
+    }
+    m_block_prefetch_cv.notify_one();
 }
 
 /**
@@ -1389,9 +1552,9 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex *pindex, const std:
         most_recent_compact_block = pcmpctblock;
     }
 
-    m_connman.ForEachNode([this, &pcmpctblock, pindex, &msgMaker, &hashBlock](CNode* pnode) {
+    std::vector<CNode*> vNodesToAnnounce;
+    m_connman.ForEachNode([this, pindex, &hashBlock, &vNodesToAnnounce](CNode* pnode) {
         AssertLockHeld(cs_main);
-        // TODO: Avoid the repeated-serialization here
         if (pnode->fDisconnect)
             return;
         ProcessBlockAvailability(pnode->GetId());
@@ -1403,10 +1566,16 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex *pindex, const std:
 
             LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerLogicValidation::NewPoWValidBlock",
                     hashBlock.ToString(), pnode->GetId());
-            m_connman.PushMessage(pnode, msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock));
+            pnode->AddRef();
+            vNodesToAnnounce.emplace_back(pnode);
             state.pindexBestHeaderSent = pindex;
         }
     });
+    if (!vNodesToAnnounce.empty()) {
+        // serialize the compact block once and share the buffers across all peers
+        m_connman.PushMessage(vNodesToAnnounce, msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock));
+    }
+    m_connman.ReleaseNodeVector(vNodesToAnnounce);
 }
 
 /**
@@ -1624,6 +1793,38 @@ static void RelayAddress(const CAddress& addr, bool fReachable, CConnman& connma
     connman.ForEachNodeThen(std::move(sortfunc), std::move(pushfunc));
 }
 
+/** Cache of full txid merkle trees for recently served filtered blocks. SPV
+ *  clients tend to request merkle proofs for the same (recent or popular)
+ *  blocks, and the tree only depends on the block, so building it once lets
+ *  each proof be assembled without rehashing all txids. ~64 bytes per tx. */
+static constexpr size_t BLOCK_MERKLE_TREE_CACHE_MAX{8};
+static Mutex cs_merkle_tree_cache;
+static std::map<uint256, std::shared_ptr<const CBlockMerkleTree>> g_merkle_tree_cache GUARDED_BY(cs_merkle_tree_cache);
+
+static std::shared_ptr<const CBlockMerkleTree> GetBlockMerkleTree(const CBlock& block)
+{
+    const uint256 blockHash = block.GetHash();
+    {
+        LOCK(cs_merkle_tree_cache);
+        auto it = g_merkle_tree_cache.find(blockHash);
+        if (it != g_merkle_tree_cache.end()) {
+            return it->second;
+        }
+    }
+    std::vector<uint256> vTxid;
+    vTxid.reserve(block.vtx.size());
+    for (const auto& tx : block.vtx) {
+        vTxid.push_back(tx->GetHash());
+    }
+    auto tree = std::make_shared<const CBlockMerkleTree>(vTxid);
+    LOCK(cs_merkle_tree_cache);
+    if (g_merkle_tree_cache.size() >= BLOCK_MERKLE_TREE_CACHE_MAX) {
+        g_merkle_tree_cache.clear();
+    }
+    g_merkle_tree_cache.emplace(blockHash, tree);
+    return tree;
+}
+
 void static ProcessGetBlockData(CNode& pfrom, const CChainParams& chainparams, const CInv& inv, CConnman& connman, llmq::CInstantSendManager& isman)
 {
     bool send = false;
@@ -1696,11 +1897,11 @@ void static ProcessGetBlockData(CNode& pfrom, const CChainParams& chainparams, c
         if (a_recent_block && a_recent_block->GetHash() == pindex->GetBlockHash()) {
             pblock = a_recent_block;
         } else {
-            // Send block from disk
-            std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
-            if (!ReadBlockFromDisk(*pblockRead, pindex, consensusParams))
+            // Send block from disk, via the shared decoded-block cache since
+            // peers tend to request the same recent blocks
+            pblock = ReadCachedBlockFromDisk(pindex, consensusParams);
+            if (!pblock)
                 assert(!"cannot load block from disk");
-            pblock = pblockRead;
         }
         if (pblock) {
             if (inv.type == MSG_BLOCK)
@@ -1712,7 +1913,7 @@ void static ProcessGetBlockData(CNode& pfrom, const CChainParams& chainparams, c
                     LOCK(pfrom.m_tx_relay->cs_filter);
                     if (pfrom.m_tx_relay->pfilter) {
                         sendMerkleBlock = true;
-                        merkleBlock = CMerkleBlock(*pblock, *pfrom.m_tx_relay->pfilter);
+                        merkleBlock = CMerkleBlock(*pblock, *pfrom.m_tx_relay->pfilter, *GetBlockMerkleTree(*pblock));
                     }
                 }
                 if (sendMerkleBlock) {
@@ -1824,7 +2025,14 @@ void static ProcessGetData(CNode& pfrom, const CChainParams& chainparams, CConnm
                     if (dstx) {
                         connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::DSTX, dstx));
                     } else {
-                        connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::TX, *mi->second));
+                        if (!mi->second.serialized) {
+                            CSerializedNetMsg msg = msgMaker.Make(NetMsgType::TX, *mi->second.tx);
+                            mi->second.serialized = std::make_shared<const std::vector<unsigned char>>(std::move(msg.data));
+                        }
+                        CSerializedNetMsg msg;
+                        msg.command = NetMsgType::TX;
+                        msg.data = *mi->second.serialized;
+                        connman.PushMessage(&pfrom, std::move(msg));
                     }
                     push = true;
                 } else {
@@ -2096,6 +2304,7 @@ static void ProcessHeadersMessage(CNode& pfrom, CConnman& connman, ChainstateMan
 
         if (received_new_header && pindexLast->nChainWork > ::ChainActive().Tip()->nChainWork) {
             nodestate->m_last_block_announcement = GetTime();
+            if (auto hot = StateHot(pfrom.GetId())) hot->m_last_block_announcement.store(nodestate->m_last_block_announcement, std::memory_order_relaxed);
         }
 
         if (nCount == MAX_HEADERS_RESULTS) {
@@ -2185,6 +2394,7 @@ static void ProcessHeadersMessage(CNode& pfrom, CConnman& connman, ChainstateMan
             if (g_outbound_peers_with_protect_from_disconnect < MAX_OUTBOUND_PEERS_TO_PROTECT_FROM_DISCONNECT && nodestate->pindexBestKnownBlock->nChainWork >= ::ChainActive().Tip()->nChainWork && !nodestate->m_chain_sync.m_protect) {
                 LogPrint(BCLog::NET, "Protecting outbound peer=%d from eviction\n", pfrom.GetId());
                 nodestate->m_chain_sync.m_protect = true;
+                if (auto hot = StateHot(pfrom.GetId())) hot->m_chain_sync_protect.store(true, std::memory_order_relaxed);
                 ++g_outbound_peers_with_protect_from_disconnect;
             }
         }
@@ -2560,6 +2770,13 @@ void PeerLogicValidation::ProcessMessage(
     LogPrint(BCLog::NET, "received: %s (%u bytes) peer=%d\n", SanitizeString(msg_type), vRecv.size(), pfrom.GetId());
     statsClient.inc("message.received." + SanitizeString(msg_type), 1.0f);
 
+    if (const uint256 verifiedProRegTxHash = pfrom.GetVerifiedProRegTxHash(); !verifiedProRegTxHash.IsNull()) {
+        // Any traffic on an MNAUTH'ed connection proves the masternode is alive.
+        // Record it so quorum PoSe probing can skip members we heard from recently
+        // instead of opening a dedicated probe connection.
+        mmetaman.GetMetaInfo(verifiedProRegTxHash)->SetLastSeenTraffic(GetAdjustedTime());
+    }
+
     if (gArgs.IsArgSet("-dropmessagestest") && GetRand(gArgs.GetArg("-dropmessagestest", 0)) == 0)
     {
         LogPrintf("dropmessagestest DROPPING RECV MESSAGE\n");
@@ -3018,9 +3235,9 @@ void PeerLogicValidation::ProcessMessage(
 
                 // Download if this is a nice peer, or we have no nice peers and this one might do.
                 bool fFetch = state->fPreferredDownload || (nPreferredDownload == 0 && !pfrom.fOneShot);
-                // Only actively request headers from a single peer, unless we're close to end of initial download.
-                if ((nSyncStarted == 0 && fFetch) || pindexBestHeader->GetBlockTime() > GetAdjustedTime() - nMaxTipAge) {
-                    // Make sure to mark this peer as the one we are currently syncing with etc.
+                // Only actively request headers from a few peers, unless we're close to end of initial download.
+                if ((nSyncStarted < MAX_HEADERS_SYNC_PEERS && fFetch) || pindexBestHeader->GetBlockTime() > GetAdjustedTime() - nMaxTipAge) {
+                    // Make sure to mark this peer as one we are currently syncing with etc.
                     state->fSyncStarted = true;
                     state->nHeadersSyncTimeout = GetTimeMicros() + HEADERS_DOWNLOAD_TIMEOUT_BASE + HEADERS_DOWNLOAD_TIMEOUT_PER_HEADER * (GetAdjustedTime() - pindexBestHeader->GetBlockTime())/(chainparams.GetConsensus().nPowTargetSpacing);
                     nSyncStarted++;
@@ -3084,6 +3301,27 @@ void PeerLogicValidation::ProcessMessage(
         }
 
         pfrom.vRecvGetData.insert(pfrom.vRecvGetData.end(), vInv.begin(), vInv.end());
+
+        // Kick off read-ahead for the requested blocks so that the
+        // synchronous reads in ProcessGetBlockData mostly hit the OS page
+        // cache instead of stalling the message thread on cold disk once
+        // per block.
+        {
+            std::vector<FlatFilePos> positions;
+            LOCK(cs_main);
+            for (const CInv& inv : vInv) {
+                if (inv.type != MSG_BLOCK && inv.type != MSG_FILTERED_BLOCK && inv.type != MSG_CMPCT_BLOCK) {
+                    continue;
+                }
+                const CBlockIndex* pindex = LookupBlockIndex(inv.hash);
+                if (pindex == nullptr || !(pindex->nStatus & BLOCK_HAVE_DATA)) {
+                    continue;
+                }
+                positions.push_back(pindex->GetBlockPos());
+            }
+            PrefetchBlocks(std::move(positions));
+        }
+
         ProcessGetData(pfrom, chainparams, m_connman, m_mempool, *m_llmq_ctx, interruptMsgProc);
         return;
     }
@@ -3513,6 +3751,7 @@ void PeerLogicValidation::ProcessMessage(
         // peer's last block announcement time
         if (received_new_header && pindex->nChainWork > ::ChainActive().Tip()->nChainWork) {
             nodestate->m_last_block_announcement = GetTime();
+            if (auto hot = StateHot(pfrom.GetId())) hot->m_last_block_announcement.store(nodestate->m_last_block_announcement, std::memory_order_relaxed);
         }
 
         std::map<uint256, std::pair<NodeId, std::list<QueuedBlock>::iterator> >::iterator blockInFlightIt = mapBlocksInFlight.find(pindex->GetBlockHash());
@@ -3594,10 +3833,27 @@ void PeerLogicValidation::ProcessMessage(
                     // TODO: don't ignore failures
                     return;
                 }
-                std::vector<CTransactionRef> dummy;
-                status = tempBlock.FillBlock(*pblock, dummy);
-                if (status == READ_STATUS_OK) {
-                    fBlockReconstructed = true;
+                BlockTransactionsRequest req;
+                for (size_t i = 0; i < cmpctblock.BlockTxCount(); i++) {
+                    if (!tempBlock.IsTxAvailable(i))
+                        req.indexes.push_back(i);
+                }
+                if (req.indexes.empty()) {
+                    std::vector<CTransactionRef> dummy;
+                    status = tempBlock.FillBlock(*pblock, dummy);
+                    if (status == READ_STATUS_OK) {
+                        fBlockReconstructed = true;
+                    }
+                } else if (fAlreadyInFlight) {
+                    // The primary fill-in request went to the first announcing
+                    // peer, which may be slow. Race a second getblocktxn to
+                    // this announcer so the reconstruction completes with the
+                    // faster of the two responses. One reconstruction slot per
+                    // peer; a newer announcement replaces a stale one.
+                    nodestate->m_extra_partial_block = std::make_unique<PartiallyDownloadedBlock>(std::move(tempBlock));
+                    nodestate->m_extra_partial_block_hash = pindex->GetBlockHash();
+                    req.blockhash = pindex->GetBlockHash();
+                    m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::GETBLOCKTXN, req));
                 }
             }
         } else {
@@ -3657,6 +3913,7 @@ void PeerLogicValidation::ProcessMessage(
                 // process from some other peer.  We do this after calling
                 // ProcessNewBlock so that a malleated cmpctblock announcement
                 // can't be used to interfere with block relay.
+                RecordBlockDeliveryLatency(pfrom.GetId(), pblock->GetHash());
                 MarkBlockAsReceived(pblock->GetHash());
             }
         }
@@ -3679,20 +3936,42 @@ void PeerLogicValidation::ProcessMessage(
         {
             LOCK(cs_main);
 
+            CNodeState* nodestate = State(pfrom.GetId());
             std::map<uint256, std::pair<NodeId, std::list<QueuedBlock>::iterator> >::iterator it = mapBlocksInFlight.find(resp.blockhash);
-            if (it == mapBlocksInFlight.end() || !it->second.second->partialBlock ||
-                    it->second.first != pfrom.GetId()) {
-                LogPrint(BCLog::NET, "Peer %d sent us block transactions for block we weren't expecting\n", pfrom.GetId());
-                return;
+            const bool fPrimaryRequest = it != mapBlocksInFlight.end() && it->second.second->partialBlock &&
+                    it->second.first == pfrom.GetId();
+            bool fExtraRequest = false;
+            if (!fPrimaryRequest) {
+                // Not the peer we sent the primary fill-in request to; this
+                // may be a response to a racing getblocktxn we sent to a
+                // second announcer of the same block.
+                fExtraRequest = nodestate != nullptr && nodestate->m_extra_partial_block &&
+                        nodestate->m_extra_partial_block_hash == resp.blockhash;
+                if (!fExtraRequest) {
+                    LogPrint(BCLog::NET, "Peer %d sent us block transactions for block we weren't expecting\n", pfrom.GetId());
+                    return;
+                }
+                const CBlockIndex* pindex = LookupBlockIndex(resp.blockhash);
+                if (pindex != nullptr && (pindex->nStatus & BLOCK_HAVE_DATA)) {
+                    // The other peer won the race, nothing left to reconstruct
+                    nodestate->m_extra_partial_block.reset();
+                    return;
+                }
             }
 
-            PartiallyDownloadedBlock& partialBlock = *it->second.second->partialBlock;
+            PartiallyDownloadedBlock& partialBlock = fExtraRequest ? *nodestate->m_extra_partial_block : *it->second.second->partialBlock;
             ReadStatus status = partialBlock.FillBlock(*pblock, resp.txn);
             if (status == READ_STATUS_INVALID) {
+                if (fExtraRequest) nodestate->m_extra_partial_block.reset();
                 MarkBlockAsReceived(resp.blockhash); // Reset in-flight state in case Misbehaving does not result in a disconnect
                 Misbehaving(pfrom.GetId(), 100, "invalid compact block/non-matching block transactions");
                 return;
             } else if (status == READ_STATUS_FAILED) {
+                if (fExtraRequest) {
+                    // The primary request is still in flight, let it finish the job
+                    nodestate->m_extra_partial_block.reset();
+                    return;
+                }
                 // Might have collided, fall back to getdata now :(
                 std::vector<CInv> invs;
                 invs.push_back(CInv(MSG_BLOCK, resp.blockhash));
@@ -3715,6 +3994,11 @@ void PeerLogicValidation::ProcessMessage(
                 // though the block was successfully read, and rely on the
                 // handling in ProcessNewBlock to ensure the block index is
                 // updated, reject messages go out, etc.
+                if (fExtraRequest) nodestate->m_extra_partial_block.reset();
+                RecordBlockDeliveryLatency(pfrom.GetId(), resp.blockhash);
+                // For an extra request this clears the slower primary peer's
+                // in-flight entry; FillBlock verified the transactions against
+                // the header's merkle root, so the block contents are authentic
                 MarkBlockAsReceived(resp.blockhash); // it is now an empty pointer
                 fBlockRead = true;
                 // mapBlockSource is only used for sending reject messages and DoS scores,
@@ -3799,6 +4083,7 @@ void PeerLogicValidation::ProcessMessage(
             LOCK(cs_main);
             // Also always process if we requested the block explicitly, as we may
             // need it even though it is not a candidate for a new best tip.
+            RecordBlockDeliveryLatency(pfrom.GetId(), hash);
             forceProcessing |= MarkBlockAsReceived(hash);
             // mapBlockSource is only used for sending reject messages and DoS scores,
             // so the race between here and cs_main in ProcessNewBlock is fine.
@@ -4226,7 +4511,14 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     unsigned int nMessageSize = msg.m_message_size;
 
     try {
+        [[maybe_unused]] const int64_t nProcessStartTime{GetTimeMicros()};
         ProcessMessage(*pfrom, msg_type, msg.m_recv, msg.m_time, chainparams, interruptMsgProc);
+        TRACE4(net, msg_processed,
+            pfrom->GetId(),
+            msg_type.c_str(),
+            nMessageSize,
+            GetTimeMicros() - nProcessStartTime // in microseconds (µs)
+        );
         if (interruptMsgProc)
             return false;
         if (!pfrom->vRecvGetData.empty())
@@ -4329,25 +4621,28 @@ void PeerLogicValidation::EvictExtraOutboundPeers(int64_t time_in_seconds)
         NodeId worst_peer = -1;
         int64_t oldest_block_announcement = std::numeric_limits<int64_t>::max();
 
+        // The scan only reads the mirrored hot fields, so it doesn't need
+        // cs_main - important with many peers, as holding cs_main for the
+        // whole walk would delay validation.
         m_connman.ForEachNode([&](CNode* pnode) {
-            AssertLockHeld(cs_main);
-
             // Don't disconnect masternodes just because they were slow in block announcement
             if (pnode->m_masternode_connection) return;
             // Ignore non-outbound peers, or nodes marked for disconnect already
             if (!IsOutboundDisconnectionCandidate(*pnode) || pnode->fDisconnect) return;
-            CNodeState *state = State(pnode->GetId());
-            if (state == nullptr) return; // shouldn't be possible, but just in case
+            auto hot = StateHot(pnode->GetId());
+            if (hot == nullptr) return; // shouldn't be possible, but just in case
             // Don't evict our protected peers
-            if (state->m_chain_sync.m_protect) return;
+            if (hot->m_chain_sync_protect.load(std::memory_order_relaxed)) return;
             // Don't evict our block-relay-only peers.
             if (pnode->m_block_relay_only_peer) return;
-            if (state->m_last_block_announcement < oldest_block_announcement || (state->m_last_block_announcement == oldest_block_announcement && pnode->GetId() > worst_peer)) {
+            const int64_t last_block_announcement = hot->m_last_block_announcement.load(std::memory_order_relaxed);
+            if (last_block_announcement < oldest_block_announcement || (last_block_announcement == oldest_block_announcement && pnode->GetId() > worst_peer)) {
                 worst_peer = pnode->GetId();
-                oldest_block_announcement = state->m_last_block_announcement;
+                oldest_block_announcement = last_block_announcement;
             }
         });
         if (worst_peer != -1) {
+            LOCK(cs_main);
             bool disconnected = m_connman.ForNode(worst_peer, [&](CNode *pnode) {
                 AssertLockHeld(cs_main);
 
@@ -4380,12 +4675,12 @@ void PeerLogicValidation::EvictExtraOutboundPeers(int64_t time_in_seconds)
 
 void PeerLogicValidation::CheckForStaleTipAndEvictPeers(const Consensus::Params &consensusParams)
 {
-    LOCK(cs_main);
-
     int64_t time_in_seconds = GetTime();
 
     EvictExtraOutboundPeers(time_in_seconds);
 
+    LOCK(cs_main);
+
     if (time_in_seconds > m_stale_tip_check_time) {
         // Check whether our tip is stale, and if so, allow using an extra
         // outbound peer
@@ -4517,8 +4812,8 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
             pindexBestHeader = ::ChainActive().Tip();
         bool fFetch = state.fPreferredDownload || (nPreferredDownload == 0 && !pto->fClient && !pto->fOneShot); // Download if this is a nice peer, or we have no nice peers and this one might do.
         if (!state.fSyncStarted && !pto->fClient && !fImporting && !fReindex && pto->CanRelay()) {
-            // Only actively request headers from a single peer, unless we're close to end of initial download.
-            if ((nSyncStarted == 0 && fFetch) || pindexBestHeader->GetBlockTime() > GetAdjustedTime() - nMaxTipAge) {
+            // Only actively request headers from a few peers, unless we're close to end of initial download.
+            if ((nSyncStarted < MAX_HEADERS_SYNC_PEERS && fFetch) || pindexBestHeader->GetBlockTime() > GetAdjustedTime() - nMaxTipAge) {
                 state.fSyncStarted = true;
                 state.nHeadersSyncTimeout = GetTimeMicros() + HEADERS_DOWNLOAD_TIMEOUT_BASE + HEADERS_DOWNLOAD_TIMEOUT_PER_HEADER * (GetAdjustedTime() - pindexBestHeader->GetBlockTime())/(consensusParams.nPowTargetSpacing);
                 nSyncStarted++;
@@ -4700,7 +4995,11 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
         {
             LOCK2(m_mempool.cs, pto->cs_inventory);
 
-            size_t reserve = INVENTORY_BROADCAST_MAX_PER_1MB_BLOCK * MaxBlockSize() / 1000000;
+            // Scale the per-trickle inv budget with the configured interval so
+            // a longer interval does not throttle overall relay throughput.
+            const unsigned int nInvBroadcastMax = INVENTORY_BROADCAST_MAX_PER_1MB_BLOCK / INVENTORY_BROADCAST_INTERVAL * m_tx_inv_broadcast_interval;
+
+            size_t reserve = nInvBroadcastMax * MaxBlockSize() / 1000000;
             if (!pto->m_block_relay_only_peer) {
                 LOCK(pto->m_tx_relay->cs_tx_inventory);
                 reserve = std::min<size_t>(pto->m_tx_relay->setInventoryTxToSend.size(), reserve);
@@ -4740,11 +5039,11 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
                 if (pto->m_tx_relay->nNextInvSend < current_time) {
                     fSendTrickle = true;
                     if (pto->fInbound) {
-                        pto->m_tx_relay->nNextInvSend = std::chrono::microseconds{m_connman.PoissonNextSendInbound(current_time.count(), INVENTORY_BROADCAST_INTERVAL)};
+                        pto->m_tx_relay->nNextInvSend = std::chrono::microseconds{m_connman.PoissonNextSendInbound(current_time.count(), m_tx_inv_broadcast_interval)};
                     } else {
                         // Use half the delay for regular outbound peers, as there is less privacy concern for them.
                         // and quarter the delay for Masternode outbound peers, as there is even less privacy concern in this case.
-                        pto->m_tx_relay->nNextInvSend = PoissonNextSend(current_time, std::chrono::seconds{INVENTORY_BROADCAST_INTERVAL >> 1 >> !pto->GetVerifiedProRegTxHash().IsNull()});
+                        pto->m_tx_relay->nNextInvSend = PoissonNextSend(current_time, std::chrono::seconds{m_tx_inv_broadcast_interval >> 1 >> !pto->GetVerifiedProRegTxHash().IsNull()});
                     }
                 }
 
@@ -4803,7 +5102,7 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
                     // No reason to drain out at many times the network's capacity,
                     // especially since we have many peers and some will draw much shorter delays.
                     unsigned int nRelayedTransactions = 0;
-                    while (!vInvTx.empty() && nRelayedTransactions < INVENTORY_BROADCAST_MAX_PER_1MB_BLOCK * MaxBlockSize() / 1000000) {
+                    while (!vInvTx.empty() && nRelayedTransactions < nInvBroadcastMax * MaxBlockSize() / 1000000) {
                         // Fetch the top element from the heap
                         std::pop_heap(vInvTx.begin(), vInvTx.end(), compareInvMempoolOrder);
                         std::set<uint256>::iterator it = vInvTx.back();
@@ -4831,7 +5130,7 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
                                 vRelayExpiration.pop_front();
                             }
 
-                            auto ret = mapRelay.insert(std::make_pair(hash, std::move(txinfo.tx)));
+                            auto ret = mapRelay.insert(std::make_pair(hash, CRelayedTx{std::move(txinfo.tx), nullptr}));
                             if (ret.second) {
                                 vRelayExpiration.push_back(std::make_pair(nNow + std::chrono::microseconds{RELAY_TX_CACHE_TIME}.count(), ret.first));
                             }
@@ -4897,8 +5196,9 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
         if (state.fSyncStarted && state.nHeadersSyncTimeout < std::numeric_limits<int64_t>::max()) {
             // Detect whether this is a stalling initial-headers-sync peer
             if (pindexBestHeader->GetBlockTime() <= GetAdjustedTime() - nMaxTipAge) {
-                if (nNow > state.nHeadersSyncTimeout && nSyncStarted == 1 && (nPreferredDownload - state.fPreferredDownload >= 1)) {
-                    // Disconnect a peer (without the noban permission) if it is our only sync peer,
+                if (nNow > state.nHeadersSyncTimeout && (nSyncStarted > 1 || (nPreferredDownload - state.fPreferredDownload >= 1))) {
+                    // Disconnect a peer (without the noban permission) if it is stalling headers
+                    // sync while we have other sync peers, or if it is our only sync peer
                     // and we have others we could be using instead.
                     // Note: If all our peers are inbound, then we won't
                     // disconnect our sync peer for stalling; we have bigger
@@ -4934,7 +5234,12 @@ bool PeerLogicValidation::SendMessages(CNode* pto)
         // Message: getdata (blocks)
         //
         std::vector<CInv> vGetData;
-        if (!pto->fClient && pto->CanRelay() && ((fFetch && !pto->m_limited_node) || !::ChainstateActive().IsInitialBlockDownload()) && state.nBlocksInFlight < MAX_BLOCKS_IN_TRANSIT_PER_PEER) {
+        // During IBD, wait until a whole chunk of the pipeline is free before refilling, so each
+        // getdata covers a contiguous block range (see BLOCK_DOWNLOAD_CHUNK_SIZE). Near the tip,
+        // top up immediately as latency matters more than on-disk ordering there.
+        const int nBlocksInFlightMax = ::ChainstateActive().IsInitialBlockDownload() ?
+            MAX_BLOCKS_IN_TRANSIT_PER_PEER - BLOCK_DOWNLOAD_CHUNK_SIZE + 1 : MAX_BLOCKS_IN_TRANSIT_PER_PEER;
+        if (!pto->fClient && pto->CanRelay() && ((fFetch && !pto->m_limited_node) || !::ChainstateActive().IsInitialBlockDownload()) && state.nBlocksInFlight < nBlocksInFlightMax) {
             std::vector<const CBlockIndex*> vToDownload;
             NodeId staller = -1;
             FindNextBlocksToDownload(pto->GetId(), MAX_BLOCKS_IN_TRANSIT_PER_PEER - state.nBlocksInFlight, vToDownload, staller, consensusParams);
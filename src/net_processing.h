@@ -7,10 +7,15 @@
 #define BITCOIN_NET_PROCESSING_H
 
 #include <consensus/params.h>
+#include <flatfile.h>
 #include <net.h>
 #include <sync.h>
 #include <validationinterface.h>
 
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 class CTxMemPool;
 class ChainstateManager;
 struct LLMQContext;
@@ -34,9 +39,21 @@ private:
 
     bool MaybeDiscourageAndDisconnect(CNode& pnode);
 
+    /** Worker paging queued block positions into the OS cache ahead of GETDATA serving */
+    void BlockPrefetchThread();
+    /** Queue block positions for the prefetch worker */
+    void PrefetchBlocks(std::vector<FlatFilePos>&& positions);
+
+    Mutex m_block_prefetch_mutex;
+    std::condition_variable m_block_prefetch_cv;
+    std::deque<FlatFilePos> m_block_prefetch_queue GUARDED_BY(m_block_prefetch_mutex);
+    bool m_block_prefetch_interrupt GUARDED_BY(m_block_prefetch_mutex){false};
+    std::thread m_block_prefetch_thread;
+
 public:
     PeerLogicValidation(CConnman& connman, BanMan* banman, CScheduler &scheduler, ChainstateManager& chainman, CTxMemPool& pool,
                         std::unique_ptr<LLMQContext>& llmq_ctx);
+    ~PeerLogicValidation();
 
     /**
      * Overridden from CValidationInterface.
@@ -80,7 +97,7 @@ public:
     /** Evict extra outbound peers. If we think our tip may be stale, connect to an extra outbound */
     void CheckForStaleTipAndEvictPeers(const Consensus::Params &consensusParams);
     /** If we have extra outbound peers, try to disconnect the one with the oldest block announcement */
-    void EvictExtraOutboundPeers(int64_t time_in_seconds) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    void EvictExtraOutboundPeers(int64_t time_in_seconds);
     /** Retrieve unbroadcast transactions from the mempool and reattempt sending to peers */
     void ReattemptInitialBroadcast(CScheduler& scheduler) const;
     /** Process a single message from a peer. Public for fuzz testing */
@@ -88,6 +105,12 @@ public:
 
 private:
     int64_t m_stale_tip_check_time; //!< Next time to check for stale tip
+
+    /** Average tx inv trickle interval in seconds (-txinvbroadcastinterval).
+     *  Longer intervals aggregate announcements into fewer, larger inv
+     *  messages and let more of them be suppressed as already-known, at the
+     *  cost of relay latency. */
+    const unsigned int m_tx_inv_broadcast_interval;
 };
 
 struct CNodeStateStats {
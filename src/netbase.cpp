@@ -743,6 +743,22 @@ bool SetSocketNoDelay(const SOCKET& hSocket)
     return rc == 0;
 }
 
+bool SetSocketSendBuffer(const SOCKET& hSocket, int nSize)
+{
+    int rc = setsockopt(hSocket, SOL_SOCKET, SO_SNDBUF, (const char*)&nSize, sizeof(int));
+    return rc == 0;
+}
+
+bool SetSocketNotSentLowat(const SOCKET& hSocket, int nBytes)
+{
+#ifdef TCP_NOTSENT_LOWAT
+    int rc = setsockopt(hSocket, IPPROTO_TCP, TCP_NOTSENT_LOWAT, (const char*)&nBytes, sizeof(int));
+    return rc == 0;
+#else
+    return false;
+#endif
+}
+
 void InterruptSocks5(bool interrupt)
 {
     interruptSocks5Recv = interrupt;
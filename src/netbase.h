@@ -207,6 +207,11 @@ bool ConnectThroughProxy(const proxyType& proxy, const std::string& strDest, uin
 bool SetSocketNonBlocking(const SOCKET& hSocket, bool fNonBlocking);
 /** Set the TCP_NODELAY flag on a socket */
 bool SetSocketNoDelay(const SOCKET& hSocket);
+/** Set the kernel send buffer size (SO_SNDBUF) for a socket */
+bool SetSocketSendBuffer(const SOCKET& hSocket, int nSize);
+/** Set TCP_NOTSENT_LOWAT so the socket only polls writable while its unsent
+ *  queue is below the given low-water mark. Returns false where unsupported. */
+bool SetSocketNotSentLowat(const SOCKET& hSocket, int nBytes);
 void InterruptSocks5(bool interrupt);
 
 /**
@@ -13,7 +13,9 @@ void CNetFulfilledRequestManager::AddFulfilledRequest(const CService& addr, cons
 {
     LOCK(cs_mapFulfilledRequests);
     CService addrSquashed = Params().AllowMultiplePorts() ? addr : CService(addr, 0);
-    mapFulfilledRequests[addrSquashed][strRequest] = GetTime() + Params().FulfilledRequestExpireTime();
+    int64_t nExpireTime = GetTime() + Params().FulfilledRequestExpireTime();
+    mapFulfilledRequests[addrSquashed][strRequest] = nExpireTime;
+    queueFulfilledExpiry.emplace(nExpireTime, std::make_pair(addrSquashed, strRequest));
 }
 
 bool CNetFulfilledRequestManager::HasFulfilledRequest(const CService& addr, const std::string& strRequest)
@@ -43,22 +45,25 @@ void CNetFulfilledRequestManager::CheckAndRemove()
     LOCK(cs_mapFulfilledRequests);
 
     int64_t now = GetTime();
-    fulfilledreqmap_t::iterator it = mapFulfilledRequests.begin();
 
-    while(it != mapFulfilledRequests.end()) {
-        fulfilledreqmapentry_t::iterator it_entry = it->second.begin();
-        while(it_entry != it->second.end()) {
-            if(now > it_entry->second) {
-                it->second.erase(it_entry++);
-            } else {
-                ++it_entry;
+    // All entries share the same TTL, so the expiry queue head is always the
+    // oldest entry and cleanup stops at the first one that is still valid.
+    while (!queueFulfilledExpiry.empty() && now > queueFulfilledExpiry.begin()->first) {
+        const auto& addr = queueFulfilledExpiry.begin()->second.first;
+        const auto& strRequest = queueFulfilledExpiry.begin()->second.second;
+        fulfilledreqmap_t::iterator it = mapFulfilledRequests.find(addr);
+        if (it != mapFulfilledRequests.end()) {
+            fulfilledreqmapentry_t::iterator it_entry = it->second.find(strRequest);
+            // the request might have been refreshed since this queue entry
+            // was added, in which case a newer queue entry covers it
+            if (it_entry != it->second.end() && now > it_entry->second) {
+                it->second.erase(it_entry);
+                if (it->second.empty()) {
+                    mapFulfilledRequests.erase(it);
+                }
             }
         }
-        if(it->second.size() == 0) {
-            mapFulfilledRequests.erase(it++);
-        } else {
-            ++it;
-        }
+        queueFulfilledExpiry.erase(queueFulfilledExpiry.begin());
     }
 }
 
@@ -66,6 +71,17 @@ void CNetFulfilledRequestManager::Clear()
 {
     LOCK(cs_mapFulfilledRequests);
     mapFulfilledRequests.clear();
+    queueFulfilledExpiry.clear();
+}
+
+void CNetFulfilledRequestManager::RebuildExpiryQueue()
+{
+    queueFulfilledExpiry.clear();
+    for (const auto& [addr, mapEntries] : mapFulfilledRequests) {
+        for (const auto& [strRequest, nExpireTime] : mapEntries) {
+            queueFulfilledExpiry.emplace(nExpireTime, std::make_pair(addr, strRequest));
+        }
+    }
 }
 
 std::string CNetFulfilledRequestManager::ToString() const
@@ -19,11 +19,18 @@ class CNetFulfilledRequestManager
 private:
     typedef std::map<std::string, int64_t> fulfilledreqmapentry_t;
     typedef std::map<CService, fulfilledreqmapentry_t> fulfilledreqmap_t;
+    typedef std::multimap<int64_t, std::pair<CService, std::string>> fulfilledreqexpiryqueue_t;
 
     //keep track of what node has/was asked for and when
     fulfilledreqmap_t mapFulfilledRequests;
+    // same entries ordered by expiry time, so cleanup only pops expired heads
+    // instead of scanning every peer; refreshed requests leave a stale entry
+    // behind which is skipped lazily
+    fulfilledreqexpiryqueue_t queueFulfilledExpiry;
     mutable CCriticalSection cs_mapFulfilledRequests;
 
+    void RebuildExpiryQueue();
+
 public:
     CNetFulfilledRequestManager() {}
 
@@ -31,6 +38,7 @@ public:
     {
         LOCK(obj.cs_mapFulfilledRequests);
         READWRITE(obj.mapFulfilledRequests);
+        SER_READ(obj, obj.RebuildExpiryQueue());
     }
 
     void AddFulfilledRequest(const CService& addr, const std::string& strRequest);
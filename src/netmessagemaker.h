@@ -19,7 +19,12 @@ public:
     {
         CSerializedNetMsg msg;
         msg.command = std::move(sCommand);
-        msg.data.reserve(4 * 1024);
+        // Size the buffer exactly up front: CSizeComputer is a cheap dry run
+        // and large payloads (blocks, mnlistdiffs) would otherwise grow the
+        // vector through repeated reallocations, doubling peak memory.
+        CSizeComputer sc(SER_NETWORK, nFlags | nVersion);
+        ::SerializeMany(sc, args...);
+        msg.data.reserve(sc.size());
         CVectorWriter{ SER_NETWORK, nFlags | nVersion, msg.data, 0, std::forward<Args>(args)... };
         return msg;
     }
@@ -16,7 +16,7 @@
 
 #include <map>
 
-static uint64_t GetBogoSize(const CScript& scriptPubKey)
+uint64_t GetBogoSize(const CScript& scriptPubKey)
 {
     return 32 /* txid */ +
            4 /* vout index */ +
@@ -44,16 +44,18 @@ static void ApplyHash(CCoinsStats& stats, CHashWriter& ss, const uint256& hash,
 
 static void ApplyHash(CCoinsStats& stats, std::nullptr_t, const uint256& hash, const std::map<uint32_t, Coin>& outputs, std::map<uint32_t, Coin>::const_iterator it) {}
 
-static void ApplyHash(CCoinsStats& stats, MuHash3072& muhash, const uint256& hash, const std::map<uint32_t, Coin>& outputs, std::map<uint32_t, Coin>::const_iterator it)
+CDataStream TxOutSer(const COutPoint& outpoint, const Coin& coin)
 {
-    COutPoint outpoint = COutPoint(hash, it->first);
-    Coin coin = it->second;
-
     CDataStream ss(SER_DISK, PROTOCOL_VERSION);
     ss << outpoint;
     ss << static_cast<uint32_t>(coin.nHeight * 2 + coin.fCoinBase);
     ss << coin.out;
-    muhash.Insert(MakeUCharSpan(ss));
+    return ss;
+}
+
+static void ApplyHash(CCoinsStats& stats, MuHash3072& muhash, const uint256& hash, const std::map<uint32_t, Coin>& outputs, std::map<uint32_t, Coin>::const_iterator it)
+{
+    muhash.Insert(MakeUCharSpan(TxOutSer(COutPoint(hash, it->first), it->second)));
 }
 
 template <typename T>
@@ -13,6 +13,10 @@
 #include <functional>
 
 class CCoinsView;
+class CDataStream;
+class Coin;
+class COutPoint;
+class CScript;
 
 enum class CoinStatsHashType {
     HASH_SERIALIZED,
@@ -33,8 +37,17 @@ struct CCoinsStats
 
     //! The number of coins contained.
     uint64_t coins_count{0};
+
+    //! Signals if the coinstatsindex was used to retrieve the statistics.
+    bool index_used{false};
 };
 
+uint64_t GetBogoSize(const CScript& script_pub_key);
+
+//! The coin serialization fed into the MuHash set hash, shared between the
+//! full UTXO set walk and the incremental coinstatsindex.
+CDataStream TxOutSer(const COutPoint& outpoint, const Coin& coin);
+
 //! Calculate statistics about the unspent transaction output set
 bool GetUTXOStats(CCoinsView* view, CCoinsStats& stats, const CoinStatsHashType hash_type, const std::function<void()>& interruption_point = {});
 
@@ -11,6 +11,14 @@
 
 //! Metadata describing a serialized version of a UTXO set from which an
 //! assumeutxo CChainState can be constructed.
+//!
+//! Snapshots written by dumptxoutset contain, after the m_coins_count
+//! serialized coins, the deterministic masternode list at the base block so
+//! that a future load path can bootstrap masternode payment and quorum
+//! validation without replaying the special transactions that built it.
+//! The activation side (mounting the snapshot as the active chainstate with
+//! background historical validation) is not wired up yet; it needs
+//! ChainstateManager support for multiple chainstates.
 class SnapshotMetadata
 {
 public:
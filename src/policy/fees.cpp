@@ -188,11 +188,18 @@ void TxConfirmStats::Record(int blocksToConfirm, double feerate)
 void TxConfirmStats::UpdateMovingAverages()
 {
     assert(confAvg.size() == failAvg.size());
-    for (unsigned int j = 0; j < buckets.size(); j++) {
-        for (unsigned int i = 0; i < confAvg.size(); i++) {
+    // Decay each period's bucket row in one linear pass. The rows are
+    // contiguous, so iterating buckets in the inner loop lets the compiler
+    // vectorize the multiply instead of striding across rows per bucket.
+    for (unsigned int i = 0; i < confAvg.size(); i++) {
+        for (unsigned int j = 0; j < buckets.size(); j++) {
             confAvg[i][j] *= decay;
+        }
+        for (unsigned int j = 0; j < buckets.size(); j++) {
             failAvg[i][j] *= decay;
         }
+    }
+    for (unsigned int j = 0; j < buckets.size(); j++) {
         m_feerate_avg[j] *= decay;
         txCtAvg[j] *= decay;
     }
@@ -198,6 +198,30 @@ private:
         }
     }
 
+    /* Growth policy for the appending paths (push_back/insert): round heap
+     * capacities up to the next power of two. This matches the allocator's
+     * size classes, which lets the realloc() in change_capacity() extend the
+     * allocation in place far more often, and bounds the number of
+     * reallocations per vector at log2(size). One-shot paths (resize,
+     * reserve) keep requesting exact capacities, as they typically allocate
+     * once at the final size. */
+    void grow_capacity(size_type new_size) {
+        size_type new_capacity = new_size;
+        if (new_size > N) {
+            new_capacity = 1;
+            while (new_capacity < new_size) {
+                size_type next = new_capacity << 1;
+                if (next <= new_capacity) {
+                    // shift overflowed; fall back to the exact request
+                    new_capacity = new_size;
+                    break;
+                }
+                new_capacity = next;
+            }
+        }
+        change_capacity(new_capacity);
+    }
+
     T* item_ptr(difference_type pos) { return is_direct() ? direct_ptr(pos) : indirect_ptr(pos); }
     const T* item_ptr(difference_type pos) const { return is_direct() ? direct_ptr(pos) : indirect_ptr(pos); }
 
@@ -365,7 +389,7 @@ public:
         size_type p = pos - begin();
         size_type new_size = size() + 1;
         if (capacity() < new_size) {
-            change_capacity(new_size + (new_size >> 1));
+            grow_capacity(new_size);
         }
         T* ptr = item_ptr(p);
         memmove(ptr + 1, ptr, (size() - p) * sizeof(T));
@@ -378,7 +402,7 @@ public:
         size_type p = pos - begin();
         size_type new_size = size() + count;
         if (capacity() < new_size) {
-            change_capacity(new_size + (new_size >> 1));
+            grow_capacity(new_size);
         }
         T* ptr = item_ptr(p);
         memmove(ptr + count, ptr, (size() - p) * sizeof(T));
@@ -392,7 +416,7 @@ public:
         difference_type count = last - first;
         size_type new_size = size() + count;
         if (capacity() < new_size) {
-            change_capacity(new_size + (new_size >> 1));
+            grow_capacity(new_size);
         }
         T* ptr = item_ptr(p);
         memmove(ptr + count, ptr, (size() - p) * sizeof(T));
@@ -445,7 +469,7 @@ public:
     void emplace_back(Args&&... args) {
         size_type new_size = size() + 1;
         if (capacity() < new_size) {
-            change_capacity(new_size + (new_size >> 1));
+            grow_capacity(new_size);
         }
         new(item_ptr(size())) T(std::forward<Args>(args)...);
         _size++;
@@ -11,10 +11,13 @@
 
 uint256 CBlockHeader::GetHash() const
 {
-    std::vector<unsigned char> vch(80);
-    CVectorWriter ss(SER_GETHASH, PROTOCOL_VERSION, vch, 0);
+    // A header always serializes to its fixed 80-byte wire format, so write it
+    // to the stack instead of paying for a heap allocation on every hash
+    unsigned char data[80];
+    SpanWriter ss(SER_GETHASH, PROTOCOL_VERSION, data);
     ss << *this;
-    return HashX11((const char *)vch.data(), (const char *)vch.data() + vch.size());
+    assert(ss.size() == sizeof(data));
+    return HashX11((const char *)data, (const char *)data + sizeof(data));
 }
 
 std::string CBlock::ToString() const
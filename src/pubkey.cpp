@@ -10,7 +10,15 @@
 
 namespace
 {
-/* Global secp256k1_context object used for verification. */
+/* Global secp256k1_context object used for verification.
+ *
+ * It is created once at startup and shared by all verifications, including
+ * the parallel script check threads, so the precomputed multiplication
+ * tables are paid for exactly once. Note that batching verifications is not
+ * an option for further speedups: ECDSA (unlike Schnorr) does not admit
+ * batch verification, since each signature fixes its own R and the check
+ * cannot be combined into one multi-scalar multiplication. Bulk workloads
+ * are instead spread across the script check threads. */
 secp256k1_context* secp256k1_context_verify = nullptr;
 } // namespace
 
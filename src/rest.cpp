@@ -9,6 +9,7 @@
 #include <core_io.h>
 #include <httpserver.h>
 #include <index/txindex.h>
+#include <key_io.h>
 #include <llmq/chainlocks.h>
 #include <llmq/context.h>
 #include <llmq/instantsend.h>
@@ -18,16 +19,21 @@
 #include <rpc/blockchain.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
+#include <spentindex.h>
 #include <streams.h>
 #include <sync.h>
 #include <txmempool.h>
 #include <util/check.h>
+#include <util/strencodings.h>
 #include <validation.h>
 #include <version.h>
 
 #include <univalue.h>
 
+#include <optional>
+
 static const size_t MAX_GETUTXOS_OUTPOINTS = 15; //allow a max of 15 outpoints to be queried at once
+static const size_t MAX_ADDRESSDELTAS_RECORDS = 100000; //cap a single address index scan response
 
 enum class RetFormat {
     UNDEF,
@@ -60,6 +66,22 @@ struct CCoin {
     }
 };
 
+//! One address index delta in the fixed-width record format served by
+//! /rest/addressdeltas/; the address itself is part of the request URI
+struct CAddressDeltaRecord {
+    int32_t nHeight{0};
+    uint32_t nTxIndex{0};
+    uint256 txhash;
+    uint32_t nIndex{0};
+    bool fSpending{false};
+    int64_t nSatoshis{0};
+
+    SERIALIZE_METHODS(CAddressDeltaRecord, obj)
+    {
+        READWRITE(obj.nHeight, obj.nTxIndex, obj.txhash, obj.nIndex, obj.fSpending, obj.nSatoshis);
+    }
+};
+
 static bool RESTERR(HTTPRequest* req, enum HTTPStatusCode status, std::string message)
 {
     req->WriteHeader("Content-Type", "text/plain");
@@ -144,6 +166,41 @@ static std::string AvailableDataFormatsString()
     return formats;
 }
 
+/**
+ * Parse a single-range "bytes=..." HTTP Range header value.
+ *
+ * Fills in the first/last byte positions; an absent first means a suffix
+ * range (last is the suffix length), an absent last means "to the end".
+ * Returns false if the value is not a well-formed single byte range, in
+ * which case the header is ignored and the full resource is served.
+ */
+static bool ParseByteRange(const std::string& value, std::optional<uint64_t>& first, std::optional<uint64_t>& last)
+{
+    first.reset();
+    last.reset();
+    if (value.rfind("bytes=", 0) != 0) return false;
+    const std::string spec = value.substr(6);
+    // Only a single range is supported; multipart replies are not worth the
+    // complexity for block data.
+    if (spec.find(',') != std::string::npos) return false;
+    const std::string::size_type dash = spec.find('-');
+    if (dash == std::string::npos) return false;
+    const std::string first_str = spec.substr(0, dash);
+    const std::string last_str = spec.substr(dash + 1);
+    if (first_str.empty() && last_str.empty()) return false;
+    uint64_t n;
+    if (!first_str.empty()) {
+        if (!ParseUInt64(first_str, &n)) return false;
+        first = n;
+    }
+    if (!last_str.empty()) {
+        if (!ParseUInt64(last_str, &n)) return false;
+        last = n;
+    }
+    if (first && last && *last < *first) return false;
+    return true;
+}
+
 static bool CheckWarmup(HTTPRequest* req)
 {
     std::string statusmessage;
@@ -242,7 +299,6 @@ static bool rest_block(HTTPRequest* req,
     if (!ParseHashStr(hashStr, hash))
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
 
-    CBlock block;
     CBlockIndex* pblockindex = nullptr;
     CBlockIndex* tip = nullptr;
     {
@@ -255,38 +311,88 @@ static bool rest_block(HTTPRequest* req,
 
         if (IsBlockPruned(pblockindex))
             return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not available (pruned data)");
+    }
+
+    // Binary responses honor a single-range Range header, serving the
+    // requested bytes straight from the block file without touching the rest
+    // of the block.
+    if (rf == RetFormat::BINARY) {
+        const std::pair<bool, std::string> range_header = req->GetHeader("range");
+        std::optional<uint64_t> range_first, range_last;
+        if (range_header.first && ParseByteRange(range_header.second, range_first, range_last)) {
+            uint64_t block_size{0};
+            std::vector<uint8_t> slice{};
+            // Probe the serialized size first so suffix and open-ended ranges
+            // can be resolved and Content-Range filled in.
+            if (!ReadRawBlockSliceFromDisk(slice, block_size, pblockindex, Params().MessageStart(), /* offset */ 0, /* length */ 0)) {
+                return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+            }
+
+            uint64_t start{0};
+            uint64_t end{0}; // inclusive
+            if (!range_first) {
+                // Suffix range: the last N bytes
+                if (*range_last == 0 || block_size == 0) {
+                    req->WriteHeader("Content-Range", strprintf("bytes */%u", block_size));
+                    return RESTERR(req, HTTP_RANGE_NOT_SATISFIABLE, "requested range not satisfiable");
+                }
+                start = *range_last >= block_size ? 0 : block_size - *range_last;
+                end = block_size - 1;
+            } else {
+                if (*range_first >= block_size) {
+                    req->WriteHeader("Content-Range", strprintf("bytes */%u", block_size));
+                    return RESTERR(req, HTTP_RANGE_NOT_SATISFIABLE, "requested range not satisfiable");
+                }
+                start = *range_first;
+                end = range_last ? std::min(*range_last, block_size - 1) : block_size - 1;
+            }
 
-        if (!ReadBlockFromDisk(block, pblockindex, Params().GetConsensus()))
+            if (!ReadRawBlockSliceFromDisk(slice, block_size, pblockindex, Params().MessageStart(), start, end - start + 1)) {
+                return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+            }
+            req->WriteHeader("Content-Type", "application/octet-stream");
+            req->WriteHeader("Accept-Ranges", "bytes");
+            req->WriteHeader("Content-Range", strprintf("bytes %u-%u/%u", start, end, block_size));
+            req->WriteReply(HTTP_PARTIAL_CONTENT, std::string{slice.begin(), slice.end()});
+            return true;
+        }
+    }
+
+    if (rf == RetFormat::JSON) {
+        // Explorer workloads hammer the same recent blocks; serve the decoded
+        // form from the shared block cache instead of re-deserializing.
+        std::shared_ptr<const CBlock> pblock = ReadCachedBlockFromDisk(pblockindex, Params().GetConsensus());
+        if (!pblock)
             return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        UniValue objBlock = blockToJSON(*pblock, tip, pblockindex, *llmq::chainLocksHandler, *llmq::quorumInstantSendManager, showTxDetails);
+        std::string strJSON = objBlock.write() + "\n";
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, strJSON);
+        return true;
     }
 
+    // Binary and hex responses just forward the serialized bytes, so read
+    // them raw instead of round tripping through a CBlock
+    std::vector<uint8_t> block_data{};
+    if (!ReadRawBlockFromDisk(block_data, pblockindex, Params().MessageStart()))
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+
     switch (rf) {
     case RetFormat::BINARY: {
-        CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
-        ssBlock << block;
-        std::string binaryBlock = ssBlock.str();
+        const std::string binaryBlock{block_data.begin(), block_data.end()};
         req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteHeader("Accept-Ranges", "bytes");
         req->WriteReply(HTTP_OK, binaryBlock);
         return true;
     }
 
     case RetFormat::HEX: {
-        CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
-        ssBlock << block;
-        std::string strHex = HexStr(ssBlock) + "\n";
+        const std::string strHex{HexStr(block_data) + "\n"};
         req->WriteHeader("Content-Type", "text/plain");
         req->WriteReply(HTTP_OK, strHex);
         return true;
     }
 
-    case RetFormat::JSON: {
-        UniValue objBlock = blockToJSON(block, tip, pblockindex, *llmq::chainLocksHandler, *llmq::quorumInstantSendManager, showTxDetails);
-        std::string strJSON = objBlock.write() + "\n";
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
-        return true;
-    }
-
     default: {
         return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
     }
@@ -667,6 +773,211 @@ static bool rest_blockhash_by_height(const CoreContext& context, HTTPRequest* re
     }
 }
 
+static bool rest_specialtxes(const CoreContext& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RetFormat rf = ParseDataFormat(param, strURIPart);
+    std::vector<std::string> path = SplitString(param, '/');
+
+    std::string hashStr;
+    int32_t nTxType = -1;
+    if (path.size() == 1) {
+        hashStr = path[0];
+    } else if (path.size() == 2) {
+        if (!ParseInt32(path[0], &nTxType) || nTxType < 0)
+            return RESTERR(req, HTTP_BAD_REQUEST, "Invalid type: " + SanitizeString(path[0]));
+        hashStr = path[1];
+    } else {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Use /rest/specialtxes/[<type>/]<blockhash>.<ext>.");
+    }
+
+    uint256 hash;
+    if (!ParseHashStr(hashStr, hash))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
+
+    CBlockIndex* pblockindex = nullptr;
+    {
+        LOCK(cs_main);
+        pblockindex = LookupBlockIndex(hash);
+        if (!pblockindex) {
+            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        }
+        if (IsBlockPruned(pblockindex))
+            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not available (pruned data)");
+    }
+
+    std::shared_ptr<const CBlock> pblock = ReadCachedBlockFromDisk(pblockindex, Params().GetConsensus());
+    if (!pblock)
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+
+    std::vector<CTransactionRef> special_txes;
+    for (const auto& tx : pblock->vtx) {
+        if (tx->nVersion != 3 || tx->nType == TRANSACTION_NORMAL
+            || (nTxType != -1 && tx->nType != nTxType)) {
+            continue;
+        }
+        special_txes.push_back(tx);
+    }
+
+    switch (rf) {
+    case RetFormat::BINARY: {
+        CDataStream ssTx(SER_NETWORK, PROTOCOL_VERSION);
+        for (const auto& tx : special_txes) {
+            ssTx << *tx;
+        }
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, ssTx.str());
+        return true;
+    }
+    case RetFormat::HEX: {
+        CDataStream ssTx(SER_NETWORK, PROTOCOL_VERSION);
+        for (const auto& tx : special_txes) {
+            ssTx << *tx;
+        }
+        std::string strHex = HexStr(ssTx) + "\n";
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, strHex);
+        return true;
+    }
+    case RetFormat::JSON: {
+        // Columnar layout: one array per field instead of one object per tx,
+        // so bulk exporters don't pay for repeated key assembly
+        UniValue txids(UniValue::VARR);
+        UniValue types(UniValue::VARR);
+        UniValue payloads(UniValue::VARR);
+        for (const auto& tx : special_txes) {
+            txids.push_back(tx->GetHash().GetHex());
+            types.push_back((int64_t)tx->nType);
+            payloads.push_back(HexStr(tx->vExtraPayload));
+        }
+        UniValue result(UniValue::VOBJ);
+        result.pushKV("txid", txids);
+        result.pushKV("type", types);
+        result.pushKV("payload", payloads);
+        std::string strJSON = result.write() + "\n";
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, strJSON);
+        return true;
+    }
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
+static bool rest_addressdeltas(const CoreContext& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string param;
+    const RetFormat rf = ParseDataFormat(param, strURIPart);
+    std::vector<std::string> path = SplitString(param, '/');
+
+    std::string addressStr;
+    int32_t start = 0;
+    int32_t end = 0;
+    if (path.size() == 1) {
+        addressStr = path[0];
+    } else if (path.size() == 3) {
+        if (!ParseInt32(path[0], &start) || !ParseInt32(path[1], &end) || start < 0 || end < start)
+            return RESTERR(req, HTTP_BAD_REQUEST, "Invalid height range");
+        addressStr = path[2];
+    } else {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Use /rest/addressdeltas/[<startheight>/<endheight>/]<address>.<ext>.");
+    }
+
+    if (!fAddressIndex)
+        return RESTERR(req, HTTP_BAD_REQUEST, "Address index not enabled");
+
+    uint160 hashBytes;
+    int type = 0;
+    {
+        CTxDestination dest = DecodeDestination(addressStr);
+        const PKHash* pkhash = std::get_if<PKHash>(&dest);
+        const ScriptHash* scripthash = std::get_if<ScriptHash>(&dest);
+        if (pkhash) {
+            hashBytes = uint160(*pkhash);
+            type = 1;
+        } else if (scripthash) {
+            hashBytes = uint160(*scripthash);
+            type = 2;
+        } else {
+            return RESTERR(req, HTTP_BAD_REQUEST, "Invalid address: " + SanitizeString(addressStr));
+        }
+    }
+
+    std::vector<std::pair<CAddressIndexKey, CAmount>> addressIndex;
+    if (!GetAddressIndex(hashBytes, type, addressIndex, start, end, /* startTxindex */ 0, MAX_ADDRESSDELTAS_RECORDS + 1))
+        return RESTERR(req, HTTP_NOT_FOUND, "No information available for address");
+    if (addressIndex.size() > MAX_ADDRESSDELTAS_RECORDS)
+        return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Error: max deltas exceeded (max: %d), narrow the height range", MAX_ADDRESSDELTAS_RECORDS));
+
+    std::vector<CAddressDeltaRecord> deltas;
+    deltas.reserve(addressIndex.size());
+    for (const auto& [key, satoshis] : addressIndex) {
+        CAddressDeltaRecord rec;
+        rec.nHeight = key.blockHeight;
+        rec.nTxIndex = key.txindex;
+        rec.txhash = key.txhash;
+        rec.nIndex = (uint32_t)key.index;
+        rec.fSpending = key.spending;
+        rec.nSatoshis = satoshis;
+        deltas.push_back(rec);
+    }
+
+    switch (rf) {
+    case RetFormat::BINARY: {
+        CDataStream ssDeltas(SER_NETWORK, PROTOCOL_VERSION);
+        ssDeltas << deltas;
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, ssDeltas.str());
+        return true;
+    }
+    case RetFormat::HEX: {
+        CDataStream ssDeltas(SER_NETWORK, PROTOCOL_VERSION);
+        ssDeltas << deltas;
+        std::string strHex = HexStr(ssDeltas) + "\n";
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, strHex);
+        return true;
+    }
+    case RetFormat::JSON: {
+        // Same columnar layout as /rest/specialtxes/; field names match the
+        // getaddressdeltas RPC
+        UniValue satoshis(UniValue::VARR);
+        UniValue txids(UniValue::VARR);
+        UniValue indexes(UniValue::VARR);
+        UniValue blockindexes(UniValue::VARR);
+        UniValue heights(UniValue::VARR);
+        UniValue spendings(UniValue::VARR);
+        for (const auto& rec : deltas) {
+            satoshis.push_back(rec.nSatoshis);
+            txids.push_back(rec.txhash.GetHex());
+            indexes.push_back((int64_t)rec.nIndex);
+            blockindexes.push_back((int64_t)rec.nTxIndex);
+            heights.push_back((int64_t)rec.nHeight);
+            spendings.push_back(rec.fSpending);
+        }
+        UniValue result(UniValue::VOBJ);
+        result.pushKV("satoshis", satoshis);
+        result.pushKV("txid", txids);
+        result.pushKV("index", indexes);
+        result.pushKV("blockindex", blockindexes);
+        result.pushKV("height", heights);
+        result.pushKV("spending", spendings);
+        std::string strJSON = result.write() + "\n";
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, strJSON);
+        return true;
+    }
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: " + AvailableDataFormatsString() + ")");
+    }
+    }
+}
+
 static const struct {
     const char* prefix;
     bool (*handler)(const CoreContext& context, HTTPRequest* req, const std::string& strReq);
@@ -680,6 +991,8 @@ static const struct {
       {"/rest/headers/", rest_headers},
       {"/rest/getutxos", rest_getutxos},
       {"/rest/blockhashbyheight/", rest_blockhash_by_height},
+      {"/rest/specialtxes/", rest_specialtxes},
+      {"/rest/addressdeltas/", rest_addressdeltas},
 };
 
 void StartREST(const CoreContext& context)
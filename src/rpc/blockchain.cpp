@@ -13,7 +13,10 @@
 #include <coins.h>
 #include <core_io.h>
 #include <consensus/validation.h>
+#include <evo/deterministicmns.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
+#include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <key_io.h>
 #include <llmq/context.h>
@@ -25,8 +28,10 @@
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <script/descriptor.h>
+#include <script/sigcache.h>
 #include <streams.h>
 #include <sync.h>
+#include <txdb.h>
 #include <txmempool.h>
 #include <undo.h>
 #include <util/strencodings.h>
@@ -183,6 +188,7 @@ UniValue blockToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIn
     result.pushKV("merkleroot", block.hashMerkleRoot.GetHex());
     bool chainLock = clhandler.HasChainLock(blockindex->nHeight, blockindex->GetBlockHash());
     UniValue txs(UniValue::VARR);
+    txs.reserve(block.vtx.size());
     for(const auto& tx : block.vtx)
     {
         if(txDetails)
@@ -192,12 +198,12 @@ UniValue blockToJSON(const CBlock& block, const CBlockIndex* tip, const CBlockIn
             bool fLocked = isman.IsLocked(tx->GetHash());
             objTx.pushKV("instantlock", fLocked || chainLock);
             objTx.pushKV("instantlock_internal", fLocked);
-            txs.push_back(objTx);
+            txs.push_back(std::move(objTx));
         }
         else
             txs.push_back(tx->GetHash().GetHex());
     }
-    result.pushKV("tx", txs);
+    result.pushKV("tx", std::move(txs));
     if (!block.vtx[0]->vExtraPayload.empty()) {
         CCbTx cbTx;
         if (GetTxPayload(block.vtx[0]->vExtraPayload, cbTx)) {
@@ -238,8 +244,8 @@ static UniValue getblockcount(const JSONRPCRequest& request)
         },
     }.Check(request);
 
-    LOCK(cs_main);
-    return ::ChainActive().Height();
+    const CBlockIndex* tip = GetChainTipSnapshot();
+    return tip ? tip->nHeight : -1;
 }
 
 static UniValue getbestblockhash(const JSONRPCRequest& request)
@@ -255,8 +261,9 @@ static UniValue getbestblockhash(const JSONRPCRequest& request)
         },
     }.Check(request);
 
-    LOCK(cs_main);
-    return ::ChainActive().Tip()->GetBlockHash().GetHex();
+    const CBlockIndex* tip = GetChainTipSnapshot();
+    CHECK_NONFATAL(tip);
+    return tip->GetBlockHash().GetHex();
 }
 
 static UniValue getbestchainlock(const JSONRPCRequest& request)
@@ -457,8 +464,7 @@ static UniValue getdifficulty(const JSONRPCRequest& request)
         },
     }.Check(request);
 
-    LOCK(cs_main);
-    return GetDifficulty(::ChainActive().Tip());
+    return GetDifficulty(GetChainTipSnapshot());
 }
 
 static std::vector<RPCResult> MempoolEntryDescription() { return {
@@ -487,10 +493,8 @@ static std::vector<RPCResult> MempoolEntryDescription() { return {
     RPCResult{RPCResult::Type::BOOL, "time", "True if this transaction was locked via InstantSend"}
 };}
 
-static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPoolEntry& e, llmq::CInstantSendManager* isman) EXCLUSIVE_LOCKS_REQUIRED(pool.cs)
+static void entryFieldsToJSON(UniValue& info, const CTxMemPoolEntry& e)
 {
-    AssertLockHeld(pool.cs);
-
     UniValue fees(UniValue::VOBJ);
     fees.pushKV("base", ValueFromAmount(e.GetFee()));
     fees.pushKV("modified", ValueFromAmount(e.GetModifiedFee()));
@@ -509,6 +513,14 @@ static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPool
     info.pushKV("ancestorcount", e.GetCountWithAncestors());
     info.pushKV("ancestorsize", e.GetSizeWithAncestors());
     info.pushKV("ancestorfees", e.GetModFeesWithAncestors());
+}
+
+static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPoolEntry& e, llmq::CInstantSendManager* isman) EXCLUSIVE_LOCKS_REQUIRED(pool.cs)
+{
+    AssertLockHeld(pool.cs);
+
+    entryFieldsToJSON(info, e);
+
     const CTransaction& tx = e.GetTx();
     std::set<std::string> setDepends;
     for (const CTxIn& txin : tx.vin)
@@ -536,28 +548,71 @@ static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPool
     info.pushKV("instantlock", isman ? (isman->IsLocked(tx.GetHash()) ? "true" : "false") : "unknown");
 }
 
+static void entryToJSON(const CTxMemPoolSnapshot& snapshot, UniValue& info, const CTxMemPoolEntry& e, const std::vector<uint256>& spentby, llmq::CInstantSendManager* isman)
+{
+    entryFieldsToJSON(info, e);
+
+    const CTransaction& tx = e.GetTx();
+    std::set<std::string> setDepends;
+    for (const CTxIn& txin : tx.vin)
+    {
+        if (snapshot.exists(txin.prevout.hash))
+            setDepends.insert(txin.prevout.hash.ToString());
+    }
+
+    UniValue depends(UniValue::VARR);
+    for (const std::string& dep : setDepends)
+    {
+        depends.push_back(dep);
+    }
+
+    info.pushKV("depends", depends);
+
+    UniValue spent(UniValue::VARR);
+    for (const uint256& child : spentby) {
+        spent.push_back(child.ToString());
+    }
+
+    info.pushKV("spentby", spent);
+    info.pushKV("instantlock", isman ? (isman->IsLocked(tx.GetHash()) ? "true" : "false") : "unknown");
+}
+
 UniValue MempoolToJSON(const CTxMemPool& pool, llmq::CInstantSendManager* isman, bool verbose)
 {
+    // serve from a shared snapshot so that mempool-wide dumps never hold
+    // pool.cs while building the (potentially large) result
+    auto snapshot = pool.GetSnapshot();
     if (verbose) {
-        LOCK(pool.cs);
+        // the snapshot has no link map, so collect in-pool children in one pass
+        std::unordered_map<uint256, std::vector<uint256>, SaltedTxidHasher> mapSpentBy;
+        for (const CTxMemPoolEntry& e : snapshot->entries) {
+            const uint256& txid = e.GetTx().GetHash();
+            for (const CTxIn& txin : e.GetTx().vin) {
+                if (snapshot->exists(txin.prevout.hash)) {
+                    mapSpentBy[txin.prevout.hash].push_back(txid);
+                }
+            }
+        }
+
+        const std::vector<uint256> emptySpentBy;
         UniValue o(UniValue::VOBJ);
-        for (const CTxMemPoolEntry& e : pool.mapTx) {
+        o.reserve(snapshot->entries.size());
+        for (const CTxMemPoolEntry& e : snapshot->entries) {
             const uint256& hash = e.GetTx().GetHash();
             UniValue info(UniValue::VOBJ);
-            entryToJSON(pool, info, e, isman);
+            auto it = mapSpentBy.find(hash);
+            entryToJSON(*snapshot, info, e, it != mapSpentBy.end() ? it->second : emptySpentBy, isman);
             // Mempool has unique entries so there is no advantage in using
             // UniValue::pushKV, which checks if the key already exists in O(N).
             // UniValue::__pushKV is used instead which currently is O(1).
-            o.__pushKV(hash.ToString(), info);
+            o.__pushKV(hash.ToString(), std::move(info));
         }
         return o;
     } else {
-        std::vector<uint256> vtxid;
-        pool.queryHashes(vtxid);
-
         UniValue a(UniValue::VARR);
-        for (const uint256& hash : vtxid)
-            a.push_back(hash.ToString());
+        a.reserve(snapshot->entries.size());
+        for (const CTxMemPoolEntry& e : snapshot->entries)
+            a.push_back(e.GetTx().GetHash().ToString());
 
         return a;
     }
@@ -802,13 +857,13 @@ static UniValue getblockhash(const JSONRPCRequest& request)
         },
     }.Check(request);
 
-    LOCK(cs_main);
+    const CBlockIndex* tip = GetChainTipSnapshot();
 
     int nHeight = request.params[0].get_int();
-    if (nHeight < 0 || nHeight > ::ChainActive().Height())
+    if (tip == nullptr || nHeight < 0 || nHeight > tip->nHeight)
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Block height out of range");
 
-    CBlockIndex* pblockindex = ::ChainActive()[nHeight];
+    const CBlockIndex* pblockindex = tip->GetAncestor(nHeight);
     return pblockindex->GetBlockHash().GetHex();
 }
 
@@ -979,19 +1034,21 @@ static UniValue getblockheaders(const JSONRPCRequest& request)
 
 static CBlock GetBlockChecked(const CBlockIndex* pblockindex)
 {
-    CBlock block;
     if (IsBlockPruned(pblockindex)) {
         throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
     }
 
-    if (!ReadBlockFromDisk(block, pblockindex, Params().GetConsensus())) {
+    std::shared_ptr<const CBlock> pblock = ReadCachedBlockFromDisk(pblockindex, Params().GetConsensus());
+    if (!pblock) {
         // Block not found on disk. This could be because we have the block
         // header in our index but not yet have the block or did not accept the
         // block.
         throw JSONRPCError(RPC_MISC_ERROR, "Block not found on disk");
     }
 
-    return block;
+    // Copying out of the shared cache is cheap: the transactions are
+    // shared_ptr-owned, so this is a vector of refcount bumps.
+    return *pblock;
 }
 
 static CBlockUndo GetUndoChecked(const CBlockIndex* pblockindex)
@@ -1165,15 +1222,19 @@ static UniValue getblock(const JSONRPCRequest& request)
             throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
         }
 
-        block = GetBlockChecked(pblockindex);
-    }
+        if (verbosity <= 0) {
+            // Only the serialized bytes are returned, don't deserialize the block
+            if (IsBlockPruned(pblockindex)) {
+                throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
+            }
+            std::vector<uint8_t> block_data{};
+            if (!ReadRawBlockFromDisk(block_data, pblockindex, Params().MessageStart())) {
+                throw JSONRPCError(RPC_MISC_ERROR, "Block not found on disk");
+            }
+            return HexStr(block_data);
+        }
 
-    if (verbosity <= 0)
-    {
-        CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
-        ssBlock << block;
-        std::string strHex = HexStr(ssBlock);
-        return strHex;
+        block = GetBlockChecked(pblockindex);
     }
 
     LLMQContext& llmq_ctx = EnsureLLMQContext(request.context);
@@ -1261,12 +1322,12 @@ static UniValue gettxoutsetinfo(const JSONRPCRequest& request)
             {
                 {RPCResult::Type::NUM, "height", "The current block height (index)"},
                 {RPCResult::Type::STR_HEX, "bestblock", "The hash of the block at the tip of the chain"},
-                {RPCResult::Type::NUM, "transactions", "The number of transactions with unspent outputs"},
+                {RPCResult::Type::NUM, "transactions", /* optional */ true, "The number of transactions with unspent outputs (not available when coinstatsindex is used)"},
                 {RPCResult::Type::NUM, "txouts", "The number of unspent transaction outputs"},
                 {RPCResult::Type::NUM, "bogosize", "A meaningless metric for UTXO set size"},
                 {RPCResult::Type::STR_HEX, "hash_serialized_2", /* optional */ true, "The serialized hash (only present if 'hash_serialized_2' hash_type is chosen)"},
                 {RPCResult::Type::STR_HEX, "muhash", /* optional */ true, "The serialized hash (only present if 'muhash' hash_type is chosen)"},
-                {RPCResult::Type::NUM, "disk_size", "The estimated size of the chainstate on disk"},
+                {RPCResult::Type::NUM, "disk_size", /* optional */ true, "The estimated size of the chainstate on disk (not available when coinstatsindex is used)"},
                 {RPCResult::Type::STR_AMOUNT, "total_amount", "The total amount"},
             }},
         RPCExamples{
@@ -1284,10 +1345,23 @@ static UniValue gettxoutsetinfo(const JSONRPCRequest& request)
 
     CCoinsView* coins_view = WITH_LOCK(cs_main, return &ChainstateActive().CoinsDB());
     NodeContext& node = EnsureNodeContext(request.context);
-    if (GetUTXOStats(coins_view, stats, hash_type, node.rpc_interruption_point)) {
+
+    // The index accumulates the muhash incrementally, so prefer it over a full
+    // UTXO set walk whenever it is available and caught up.
+    bool got_stats{false};
+    if (hash_type == CoinStatsHashType::MUHASH && g_coin_stats_index && g_coin_stats_index->BlockUntilSyncedToCurrentChain()) {
+        got_stats = g_coin_stats_index->LookupStats(stats);
+    }
+    if (!got_stats) {
+        got_stats = GetUTXOStats(coins_view, stats, hash_type, node.rpc_interruption_point);
+    }
+
+    if (got_stats) {
         ret.pushKV("height", (int64_t)stats.nHeight);
         ret.pushKV("bestblock", stats.hashBlock.GetHex());
-        ret.pushKV("transactions", (int64_t)stats.nTransactions);
+        if (!stats.index_used) {
+            ret.pushKV("transactions", (int64_t)stats.nTransactions);
+        }
         ret.pushKV("txouts", (int64_t)stats.nTransactionOutputs);
         ret.pushKV("bogosize", (int64_t)stats.nBogoSize);
         if (hash_type == CoinStatsHashType::HASH_SERIALIZED) {
@@ -1296,7 +1370,9 @@ static UniValue gettxoutsetinfo(const JSONRPCRequest& request)
         if (hash_type == CoinStatsHashType::MUHASH) {
               ret.pushKV("muhash", stats.hashSerialized.GetHex());
         }
-        ret.pushKV("disk_size", stats.nDiskSize);
+        if (!stats.index_used) {
+            ret.pushKV("disk_size", stats.nDiskSize);
+        }
         ret.pushKV("total_amount", ValueFromAmount(stats.nTotalAmount));
     } else {
         throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
@@ -1304,6 +1380,121 @@ static UniValue gettxoutsetinfo(const JSONRPCRequest& request)
     return ret;
 }
 
+static UniValue setdbcache(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"setdbcache",
+        "\nChanges the total size of the coins database and in-memory UTXO set caches at runtime, like -dbcache but without a restart.\n"
+        "The given size is split between the two caches the same way init splits -dbcache. When shrinking, the chain state is\n"
+        "flushed to disk and the memory is released immediately; when growing, the new room is used as the cache refills.\n"
+        "The block index and optional index database caches are sized at startup and are not affected.\n",
+        {
+            {"size", RPCArg::Type::NUM, RPCArg::Optional::NO, strprintf("The new total cache size in MiB (%d to %d)", nMinDbCache, nMaxDbCache)},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "coinsdb_cache_bytes", "New size of the coins database cache"},
+                {RPCResult::Type::NUM, "coinstip_cache_bytes", "New size of the in-memory UTXO set cache"},
+            }},
+        RPCExamples{
+            HelpExampleCli("setdbcache", "1024")
+    + HelpExampleRpc("setdbcache", "1024")
+        },
+    }.Check(request);
+
+    const int64_t nSizeMiB = request.params[0].get_int64();
+    if (nSizeMiB < nMinDbCache || nSizeMiB > nMaxDbCache) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Cache size out of range (%d to %d MiB)", nMinDbCache, nMaxDbCache));
+    }
+    int64_t nTotalCache = nSizeMiB << 20;
+
+    // Same 25%-50% split as AppInitMain, minus the carve-outs for the
+    // databases whose caches cannot be resized after startup
+    int64_t nCoinDBCache = std::min(nTotalCache / 2, (nTotalCache / 4) + (1 << 23));
+    nCoinDBCache = std::min(nCoinDBCache, nMaxCoinsDBCache << 20);
+    int64_t nCoinCacheUsage = nTotalCache - nCoinDBCache;
+
+    ChainstateManager& chainman = EnsureChainman(request.context);
+    LOCK(cs_main);
+    chainman.m_total_coinstip_cache = nCoinCacheUsage;
+    chainman.m_total_coinsdb_cache = nCoinDBCache;
+    // Propagates the new totals to each chainstate via ResizeCoinsCaches,
+    // which flushes and reallocates when shrinking
+    chainman.MaybeRebalanceCaches();
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("coinsdb_cache_bytes", nCoinDBCache);
+    ret.pushKV("coinstip_cache_bytes", nCoinCacheUsage);
+    return ret;
+}
+
+static UniValue getcachestats(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"getcachestats",
+        "\nReturns usage and cumulative hit/miss statistics for the validation caches.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::OBJ, "coins", "The in-memory UTXO set cache of the active chainstate",
+                {
+                    {RPCResult::Type::NUM, "entries", "Number of cached transaction outputs"},
+                    {RPCResult::Type::NUM, "usage_bytes", "Current memory usage"},
+                    {RPCResult::Type::NUM, "limit_bytes", "Configured size limit"},
+                    {RPCResult::Type::NUM, "hits", "Lookups answered from the cache"},
+                    {RPCResult::Type::NUM, "misses", "Lookups that had to consult the database"},
+                    {RPCResult::Type::NUM, "hit_ratio", "hits / (hits + misses)"},
+                }},
+                {RPCResult::Type::OBJ, "sigcache", "The signature verification cache",
+                {
+                    {RPCResult::Type::NUM, "hits", "Lookups answered from the cache"},
+                    {RPCResult::Type::NUM, "misses", "Signatures that had to be verified"},
+                    {RPCResult::Type::NUM, "hit_ratio", "hits / (hits + misses)"},
+                }},
+                {RPCResult::Type::OBJ, "scriptexecution", "The script execution cache",
+                {
+                    {RPCResult::Type::NUM, "hits", "Transactions whose scripts were already verified"},
+                    {RPCResult::Type::NUM, "misses", "Transactions whose scripts had to be executed"},
+                    {RPCResult::Type::NUM, "hit_ratio", "hits / (hits + misses)"},
+                }},
+            }},
+        RPCExamples{
+            HelpExampleCli("getcachestats", "")
+    + HelpExampleRpc("getcachestats", "")
+        },
+    }.Check(request);
+
+    const auto pushHitMiss = [](UniValue& obj, uint64_t hits, uint64_t misses) {
+        obj.pushKV("hits", hits);
+        obj.pushKV("misses", misses);
+        obj.pushKV("hit_ratio", (hits + misses) == 0 ? 0.0 : (double)hits / (double)(hits + misses));
+    };
+
+    UniValue ret(UniValue::VOBJ);
+
+    {
+        LOCK(cs_main);
+        CChainState& chainstate = EnsureChainman(request.context).ActiveChainstate();
+        const CCoinsViewCache& coins_cache = chainstate.CoinsTip();
+        UniValue coins(UniValue::VOBJ);
+        coins.pushKV("entries", (int64_t)coins_cache.GetCacheSize());
+        coins.pushKV("usage_bytes", (int64_t)coins_cache.DynamicMemoryUsage());
+        coins.pushKV("limit_bytes", (int64_t)chainstate.m_coinstip_cache_size_bytes);
+        pushHitMiss(coins, coins_cache.GetCacheHits(), coins_cache.GetCacheMisses());
+        ret.pushKV("coins", coins);
+    }
+
+    UniValue sigcache(UniValue::VOBJ);
+    pushHitMiss(sigcache, SignatureCacheHits(), SignatureCacheMisses());
+    ret.pushKV("sigcache", sigcache);
+
+    UniValue scriptcache(UniValue::VOBJ);
+    pushHitMiss(scriptcache, ScriptExecutionCacheHits(), ScriptExecutionCacheMisses());
+    ret.pushKV("scriptexecution", scriptcache);
+
+    return ret;
+}
+
 static UniValue gettxout(const JSONRPCRequest& request)
 {
     RPCHelpMan{"gettxout",
@@ -1505,6 +1696,7 @@ UniValue getblockchaininfo(const JSONRPCRequest& request)
                 {RPCResult::Type::NUM, "pruneheight", "lowest-height complete block stored (only present if pruning is enabled)"},
                 {RPCResult::Type::BOOL, "automatic_pruning", "whether automatic pruning is enabled (only present if pruning is enabled)"},
                 {RPCResult::Type::NUM, "prune_target_size", "the target size used by pruning (only present if automatic pruning is enabled)"},
+                {RPCResult::Type::NUM, "notification_queue_depth", "number of validation notifications still queued for delivery to listeners (wallets, indexes, zmq)"},
                 {RPCResult::Type::ARR, "softforks", "status of softforks in progress",
                 {
                     {RPCResult::Type::OBJ, "", "",
@@ -1578,6 +1770,8 @@ UniValue getblockchaininfo(const JSONRPCRequest& request)
         }
     }
 
+    obj.pushKV("notification_queue_depth", (int64_t)GetMainSignals().CallbacksPending());
+
     const Consensus::Params& consensusParams = Params().GetConsensus();
     UniValue softforks(UniValue::VARR);
     UniValue bip9_softforks(UniValue::VOBJ);
@@ -1734,16 +1928,17 @@ static UniValue getchaintips(const JSONRPCRequest& request)
 
 UniValue MempoolInfoToJSON(const CTxMemPool& pool, llmq::CInstantSendManager& isman)
 {
-    // Make sure this call is atomic in the pool.
-    LOCK(pool.cs);
+    // The snapshot was built atomically in the pool, so the reported values
+    // are consistent with each other without taking pool.cs here.
+    auto snapshot = pool.GetSnapshot();
     UniValue ret(UniValue::VOBJ);
-    ret.pushKV("loaded", pool.IsLoaded());
-    ret.pushKV("size", (int64_t)pool.size());
-    ret.pushKV("bytes", (int64_t)pool.GetTotalTxSize());
-    ret.pushKV("usage", (int64_t)pool.DynamicMemoryUsage());
+    ret.pushKV("loaded", snapshot->loaded);
+    ret.pushKV("size", (int64_t)snapshot->entries.size());
+    ret.pushKV("bytes", (int64_t)snapshot->totalTxSize);
+    ret.pushKV("usage", (int64_t)snapshot->dynamicUsage);
     size_t maxmempool = gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000;
     ret.pushKV("maxmempool", (int64_t) maxmempool);
-    ret.pushKV("mempoolminfee", ValueFromAmount(std::max(pool.GetMinFee(maxmempool), ::minRelayTxFee).GetFeePerK()));
+    ret.pushKV("mempoolminfee", ValueFromAmount(std::max(snapshot->minFeeRate, ::minRelayTxFee).GetFeePerK()));
     ret.pushKV("minrelaytxfee", ValueFromAmount(::minRelayTxFee.GetFeePerK()));
     ret.pushKV("instantsendlocks", (int64_t)isman.GetInstantSendLockCount());
 
@@ -1776,6 +1971,44 @@ static UniValue getmempoolinfo(const JSONRPCRequest& request)
     return MempoolInfoToJSON(EnsureMemPool(request.context), *(EnsureLLMQContext(request.context).isman));
 }
 
+static UniValue getmempoolfeehistogram(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"getmempoolfeehistogram",
+        "\nReturns a histogram of mempool transactions binned by modified fee rate.\n"
+        "Buckets are log-spaced; bucket boundaries are in duffs per kB. The histogram is\n"
+        "maintained incrementally, so this call does not walk the mempool and is cheap to poll.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::ARR, "", "non-empty buckets, highest fee rate first",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::NUM, "feerate_floor", "Lowest fee rate of this bucket in duffs per kB"},
+                    {RPCResult::Type::NUM, "count", "Number of transactions in this bucket"},
+                    {RPCResult::Type::NUM, "bytes", "Sum of transaction sizes in this bucket"},
+                }},
+            }},
+        RPCExamples{
+            HelpExampleCli("getmempoolfeehistogram", "")
+    + HelpExampleRpc("getmempoolfeehistogram", "")
+        },
+    }.Check(request);
+
+    const CTxMemPool& mempool = EnsureMemPool(request.context);
+    const auto histogram = mempool.GetFeeHistogram();
+
+    UniValue ret(UniValue::VARR);
+    for (size_t bucket = histogram.size(); bucket-- > 0;) {
+        if (histogram[bucket].count == 0) continue;
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("feerate_floor", CTxMemPool::FeeHistogramBucketFloor(bucket));
+        obj.pushKV("count", histogram[bucket].count);
+        obj.pushKV("bytes", histogram[bucket].bytes);
+        ret.push_back(obj);
+    }
+    return ret;
+}
+
 static UniValue preciousblock(const JSONRPCRequest& request)
 {
     RPCHelpMan{"preciousblock",
@@ -1968,22 +2201,6 @@ static UniValue getchaintxstats(const JSONRPCRequest& request)
     return ret;
 }
 
-template<typename T>
-static T CalculateTruncatedMedian(std::vector<T>& scores)
-{
-    size_t size = scores.size();
-    if (size == 0) {
-        return 0;
-    }
-
-    std::sort(scores.begin(), scores.end());
-    if (size % 2 == 0) {
-        return (scores[size / 2 - 1] + scores[size / 2]) / 2;
-    } else {
-        return scores[size / 2];
-    }
-}
-
 void CalculatePercentilesBySize(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_size)
 {
     if (scores.empty()) {
@@ -2021,9 +2238,6 @@ static inline bool SetHasKeys(const std::set<T>& set, const Tk& key, const Args&
     return (set.count(key) != 0) || SetHasKeys(set, args...);
 }
 
-// outpoint (needed for the utxo index) + nHeight + fCoinBase
-static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
-
 static UniValue getblockstats(const JSONRPCRequest& request)
 {
     RPCHelpMan{"getblockstats",
@@ -2085,6 +2299,9 @@ static UniValue getblockstats(const JSONRPCRequest& request)
     if (g_txindex) {
         g_txindex->BlockUntilSyncedToCurrentChain();
     }
+    if (g_block_stats_index) {
+        g_block_stats_index->BlockUntilSyncedToCurrentChain();
+    }
 
     LOCK(cs_main);
 
@@ -2123,10 +2340,63 @@ static UniValue getblockstats(const JSONRPCRequest& request)
         }
     }
 
+    const bool do_all = stats.size() == 0; // Calculate everything if nothing selected (default)
+
+    // With the blockstatsindex enabled, serve everything from the materialized
+    // per-block record instead of reading and re-processing the block and undo
+    // files. Fall back to the full computation while the index is still syncing.
+    CBlockStatsRecord record;
+    if (g_block_stats_index && g_block_stats_index->LookupBlockStats(pindex->GetBlockHash(), record)) {
+        UniValue feerates_res(UniValue::VARR);
+        for (const CAmount feerate : record.vFeeRatePercentiles) {
+            feerates_res.push_back(feerate);
+        }
+
+        UniValue ret_all(UniValue::VOBJ);
+        ret_all.pushKV("avgfee", (record.nTxCount > 1) ? record.nTotalFee / (record.nTxCount - 1) : 0);
+        ret_all.pushKV("avgfeerate", record.nTotalSize ? record.nTotalFee / record.nTotalSize : 0); // Unit: sat/byte
+        ret_all.pushKV("avgtxsize", (record.nTxCount > 1) ? record.nTotalSize / (record.nTxCount - 1) : 0);
+        ret_all.pushKV("blockhash", pindex->GetBlockHash().GetHex());
+        ret_all.pushKV("feerate_percentiles", feerates_res);
+        ret_all.pushKV("height", (int64_t)pindex->nHeight);
+        ret_all.pushKV("ins", record.nInputs);
+        ret_all.pushKV("maxfee", record.nMaxFee);
+        ret_all.pushKV("maxfeerate", record.nMaxFeeRate);
+        ret_all.pushKV("maxtxsize", record.nMaxTxSize);
+        ret_all.pushKV("medianfee", record.nMedianFee);
+        ret_all.pushKV("mediantime", pindex->GetMedianTimePast());
+        ret_all.pushKV("mediantxsize", record.nMedianTxSize);
+        ret_all.pushKV("minfee", record.nMinFee);
+        ret_all.pushKV("minfeerate", record.nMinFeeRate);
+        ret_all.pushKV("mintxsize", record.nMinTxSize);
+        ret_all.pushKV("outs", record.nOutputs);
+        ret_all.pushKV("subsidy", pindex->pprev ? GetBlockSubsidy(pindex->pprev->nBits, pindex->pprev->nHeight, Params().GetConsensus()) : 50 * COIN);
+        ret_all.pushKV("time", pindex->GetBlockTime());
+        ret_all.pushKV("total_out", record.nTotalOut);
+        ret_all.pushKV("total_size", record.nTotalSize);
+        ret_all.pushKV("totalfee", record.nTotalFee);
+        ret_all.pushKV("txs", record.nTxCount);
+        ret_all.pushKV("utxo_increase", record.nOutputs - record.nInputs);
+        ret_all.pushKV("utxo_size_inc", record.nUtxoSizeInc);
+
+        if (do_all) {
+            return ret_all;
+        }
+
+        UniValue ret(UniValue::VOBJ);
+        for (const std::string& stat : stats) {
+            const UniValue& value = ret_all[stat];
+            if (value.isNull()) {
+                throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Invalid selected statistic %s", stat));
+            }
+            ret.pushKV(stat, value);
+        }
+        return ret;
+    }
+
     const CBlock block = GetBlockChecked(pindex);
     const CBlockUndo blockUndo = GetUndoChecked(pindex);
 
-    const bool do_all = stats.size() == 0; // Calculate everything if nothing selected (default)
     const bool do_mediantxsize = do_all || stats.count("mediantxsize") != 0;
     const bool do_medianfee = do_all || stats.count("medianfee") != 0;
     const bool do_feerate_percentiles = do_all || stats.count("feerate_percentiles") != 0;
@@ -2682,6 +2952,13 @@ static UniValue getblockfilter(const JSONRPCRequest& request)
 /**
  * Serialize the UTXO set to a file for loading elsewhere.
  *
+ * The snapshot consists of the metadata, exactly metadata.m_coins_count
+ * serialized (COutPoint, Coin) pairs and, after those, the deterministic
+ * masternode list at the base block. The list is required to bootstrap
+ * masternode payment and quorum validation from the snapshot height, which a
+ * plain UTXO set can't provide - it's built from special transactions
+ * processed block by block.
+ *
  * @see SnapshotMetadata
  */
 UniValue dumptxoutset(const JSONRPCRequest& request)
@@ -2698,6 +2975,7 @@ UniValue dumptxoutset(const JSONRPCRequest& request)
                     {RPCResult::Type::NUM, "coins_written", "the number of coins written in the snapshot"},
                     {RPCResult::Type::STR_HEX, "base_hash", "the hash of the base of the snapshot"},
                     {RPCResult::Type::NUM, "base_height", "the height of the base of the snapshot"},
+                    {RPCResult::Type::NUM, "masternodes_written", "the number of masternode list entries written in the snapshot"},
                     {RPCResult::Type::STR, "path", "the absolute path that the snapshot was written to"},
                 }
         },
@@ -2751,6 +3029,9 @@ UniValue dumptxoutset(const JSONRPCRequest& request)
         CHECK_NONFATAL(tip);
     }
 
+    // The list for the base block is immutable, no need to hold cs_main for it
+    const CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(tip);
+
     SnapshotMetadata metadata{tip->GetBlockHash(), stats.coins_count, tip->nChainTx};
 
     afile << metadata;
@@ -2770,6 +3051,8 @@ UniValue dumptxoutset(const JSONRPCRequest& request)
         pcursor->Next();
     }
 
+    afile << mnList;
+
     afile.fclose();
     fs::rename(temppath, path);
 
@@ -2777,6 +3060,7 @@ UniValue dumptxoutset(const JSONRPCRequest& request)
     result.pushKV("coins_written", stats.coins_count);
     result.pushKV("base_hash", tip->GetBlockHash().ToString());
     result.pushKV("base_height", tip->nHeight);
+    result.pushKV("masternodes_written", (int64_t)mnList.GetAllMNsCount());
     result.pushKV("path", path.string());
     return result;
 }
@@ -2786,6 +3070,7 @@ static const CRPCCommand commands[] =
 { //  category              name                      actor (function)         argNames
   //  --------------------- ------------------------  -----------------------  ----------
     { "blockchain",         "getblockchaininfo",      &getblockchaininfo,      {} },
+    { "blockchain",         "getcachestats",          &getcachestats,          {} },
     { "blockchain",         "getchaintxstats",        &getchaintxstats,        {"nblocks", "blockhash"} },
     { "blockchain",         "getblockstats",          &getblockstats,          {"hash_or_height", "stats"} },
     { "blockchain",         "getbestblockhash",       &getbestblockhash,       {} },
@@ -2802,6 +3087,7 @@ static const CRPCCommand commands[] =
     { "blockchain",         "getmempoolancestors",    &getmempoolancestors,    {"txid","verbose"} },
     { "blockchain",         "getmempooldescendants",  &getmempooldescendants,  {"txid","verbose"} },
     { "blockchain",         "getmempoolentry",        &getmempoolentry,        {"txid"} },
+    { "blockchain",         "getmempoolfeehistogram", &getmempoolfeehistogram, {} },
     { "blockchain",         "getmempoolinfo",         &getmempoolinfo,         {} },
     { "blockchain",         "getrawmempool",          &getrawmempool,          {"verbose"} },
     { "blockchain",         "getspecialtxes",         &getspecialtxes,         {"blockhash", "type", "count", "skip", "verbosity"} },
@@ -2809,6 +3095,7 @@ static const CRPCCommand commands[] =
     { "blockchain",         "gettxoutsetinfo",        &gettxoutsetinfo,        {"hash_type"} },
     { "blockchain",         "pruneblockchain",        &pruneblockchain,        {"height"} },
     { "blockchain",         "savemempool",            &savemempool,            {} },
+    { "blockchain",         "setdbcache",             &setdbcache,             {"size"} },
     { "blockchain",         "verifychain",            &verifychain,            {"checklevel","nblocks"} },
 
     { "blockchain",         "preciousblock",          &preciousblock,          {"blockhash"} },
@@ -7,8 +7,10 @@
 
 #include <amount.h>
 #include <context.h>
+#include <primitives/transaction.h>
 #include <sync.h>
 
+#include <algorithm>
 #include <stdint.h>
 #include <vector>
 
@@ -28,6 +30,10 @@ class CInstantSendManager;
 
 static constexpr int NUM_GETBLOCKSTATS_PERCENTILES = 5;
 
+/** Size a utxo contributes to the utxo index beyond its serialized output:
+ *  outpoint (needed for the utxo index) + nHeight + fCoinBase */
+static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
+
 /**
  * Get the difficulty of the net wrt to the given block index.
  *
@@ -54,6 +60,23 @@ UniValue blockheaderToJSON(const CBlockIndex* tip, const CBlockIndex* blockindex
 /** Used by getblockstats to get feerates at different percentiles by weight  */
 void CalculatePercentilesBySize(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_size);
 
+/** Used by getblockstats and the blockstatsindex for median fee/size stats */
+template<typename T>
+T CalculateTruncatedMedian(std::vector<T>& scores)
+{
+    size_t size = scores.size();
+    if (size == 0) {
+        return 0;
+    }
+
+    std::sort(scores.begin(), scores.end());
+    if (size % 2 == 0) {
+        return (scores[size / 2 - 1] + scores[size / 2]) / 2;
+    } else {
+        return scores[size / 2];
+    }
+}
+
 NodeContext& EnsureNodeContext(const CoreContext& context);
 LLMQContext& EnsureLLMQContext(const CoreContext& context);
 CTxMemPool& EnsureMemPool(const CoreContext& context);
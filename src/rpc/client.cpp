@@ -181,6 +181,7 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "getspecialtxes", 2, "count" },
     { "getspecialtxes", 3, "skip" },
     { "getspecialtxes", 4, "verbosity" },
+    { "setdbcache", 0, "size" },
     { "disconnectnode", 1, "nodeid" },
     { "upgradewallet", 0, "version" },
     // Echo with conversion (For testing only)
@@ -13,6 +13,7 @@
 #include <evo/simplifiedmns.h>
 #include <evo/specialtx.h>
 #include <evo/specialtxman.h>
+#include <hash.h>
 #include <index/txindex.h>
 #include <llmq/blockprocessor.h>
 #include <llmq/context.h>
@@ -1285,6 +1286,15 @@ static UniValue BuildDMNListEntry(CWallet* pwallet, const CDeterministicMN& dmn,
     return o;
 }
 
+//! "protx list" rebuilds entries for the whole MN set per call and is polled
+//! frequently by monitoring with identical parameters. Results for a given
+//! block are deterministic, so they are cached keyed by (block hash, type,
+//! detailed) - but only when no wallet is attached to the request, since
+//! entries then carry wallet-specific fields.
+static constexpr size_t PROTX_LIST_CACHE_MAX{10};
+static Mutex cs_protx_list_cache;
+static std::map<uint256, UniValue> protxListCache GUARDED_BY(cs_protx_list_cache);
+
 static UniValue protx_list(const JSONRPCRequest& request)
 {
     protx_list_help(request);
@@ -1358,11 +1368,33 @@ static UniValue protx_list(const JSONRPCRequest& request)
             throw JSONRPCError(RPC_INVALID_PARAMETER, "invalid height specified");
         }
 
-        CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(::ChainActive()[height]);
+        const CBlockIndex* pindex = ::ChainActive()[height];
+        const bool use_cache = wallet == nullptr;
+        uint256 cacheKey;
+        if (use_cache) {
+            CHashWriter hw(SER_GETHASH, 0);
+            hw << pindex->GetBlockHash() << type << detailed;
+            cacheKey = hw.GetHash();
+            LOCK(cs_protx_list_cache);
+            auto it = protxListCache.find(cacheKey);
+            if (it != protxListCache.end()) {
+                return it->second;
+            }
+        }
+
+        CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(pindex);
         bool onlyValid = type == "valid";
         mnList.ForEachMN(onlyValid, [&](const auto& dmn) {
             ret.push_back(BuildDMNListEntry(wallet.get(), dmn, detailed));
         });
+
+        if (use_cache) {
+            LOCK(cs_protx_list_cache);
+            if (protxListCache.size() >= PROTX_LIST_CACHE_MAX) {
+                protxListCache.clear();
+            }
+            protxListCache.emplace(cacheKey, ret);
+        }
     } else {
         throw JSONRPCError(RPC_INVALID_PARAMETER, "invalid type specified");
     }
@@ -1442,6 +1474,12 @@ static uint256 ParseBlock(const UniValue& v, std::string strName) EXCLUSIVE_LOCK
     }
 }
 
+//! "protx diff" results are keyed by both block hashes, which pin the content
+//! entirely, so cached entries never go stale and need no invalidation.
+static constexpr size_t PROTX_DIFF_CACHE_MAX{8};
+static Mutex cs_protx_diff_cache;
+static std::map<uint256, UniValue> protxDiffCache GUARDED_BY(cs_protx_diff_cache);
+
 static UniValue protx_diff(const JSONRPCRequest& request)
 {
     protx_diff_help(request);
@@ -1454,6 +1492,17 @@ static UniValue protx_diff(const JSONRPCRequest& request)
         extended = ParseBoolV(request.params[2], "extended");
     }
 
+    CHashWriter hw(SER_GETHASH, 0);
+    hw << baseBlockHash << blockHash << extended;
+    const uint256 cacheKey = hw.GetHash();
+    {
+        LOCK(cs_protx_diff_cache);
+        auto it = protxDiffCache.find(cacheKey);
+        if (it != protxDiffCache.end()) {
+            return it->second;
+        }
+    }
+
     CSimplifiedMNListDiff mnListDiff;
     std::string strError;
     LLMQContext& llmq_ctx = EnsureLLMQContext(request.context);
@@ -1464,6 +1513,14 @@ static UniValue protx_diff(const JSONRPCRequest& request)
 
     UniValue ret;
     mnListDiff.ToJson(ret, extended);
+
+    {
+        LOCK(cs_protx_diff_cache);
+        if (protxDiffCache.size() >= PROTX_DIFF_CACHE_MAX) {
+            protxDiffCache.clear();
+        }
+        protxDiffCache.emplace(cacheKey, ret);
+    }
     return ret;
 }
 
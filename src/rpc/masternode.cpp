@@ -566,6 +566,17 @@ static UniValue masternode(const JSONRPCRequest& request)
     }
 }
 
+//! masternodelist rebuilds JSON for the whole MN set and monitoring tends to
+//! poll it every few seconds with identical parameters. The result depends on
+//! chain state only (the deterministic MN list and the UTXO set both mutate
+//! on block events alone), so results are cached per (mode, filter) and
+//! invalidated as a whole when the tip changes. The entry cap bounds memory
+//! when callers vary the filter.
+static constexpr size_t MNLIST_RESULT_CACHE_MAX{25};
+static Mutex cs_mnlist_result_cache;
+static uint256 mnlistResultCacheTip GUARDED_BY(cs_mnlist_result_cache);
+static std::map<std::pair<std::string, std::string>, UniValue> mnlistResultCache GUARDED_BY(cs_mnlist_result_cache);
+
 static UniValue masternodelist(const JSONRPCRequest& request)
 {
     std::string strMode = "json";
@@ -586,6 +597,19 @@ static UniValue masternodelist(const JSONRPCRequest& request)
         masternode_list_help(request);
     }
 
+    const uint256 tipHash = WITH_LOCK(cs_main, return ::ChainActive().Tip()->GetBlockHash());
+    {
+        LOCK(cs_mnlist_result_cache);
+        if (mnlistResultCacheTip != tipHash) {
+            mnlistResultCache.clear();
+            mnlistResultCacheTip = tipHash;
+        }
+        auto it = mnlistResultCache.find(std::make_pair(strMode, strFilter));
+        if (it != mnlistResultCache.end()) {
+            return it->second;
+        }
+    }
+
     UniValue obj(UniValue::VOBJ);
 
     auto mnList = deterministicMNManager->GetListAtChainTip();
@@ -698,7 +722,7 @@ static UniValue masternodelist(const JSONRPCRequest& request)
             objMN.pushKV("votingaddress", EncodeDestination(PKHash(dmn.pdmnState->keyIDVoting)));
             objMN.pushKV("collateraladdress", collateralAddressStr);
             objMN.pushKV("pubkeyoperator", dmn.pdmnState->pubKeyOperator.Get().ToString());
-            obj.pushKV(strOutpoint, objMN);
+            obj.pushKV(strOutpoint, std::move(objMN));
         } else if (strMode == "lastpaidblock") {
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
             obj.pushKV(strOutpoint, dmn.pdmnState->nLastPaidHeight);
@@ -726,6 +750,14 @@ static UniValue masternodelist(const JSONRPCRequest& request)
         }
     });
 
+    {
+        LOCK(cs_mnlist_result_cache);
+        // only store when the tip didn't move while we were building
+        if (mnlistResultCacheTip == tipHash && mnlistResultCache.size() < MNLIST_RESULT_CACHE_MAX) {
+            mnlistResultCache.emplace(std::make_pair(strMode, strFilter), obj);
+        }
+    }
+
     return obj;
 }
 // clang-format off
@@ -19,6 +19,7 @@
 #include <rpc/util.h>
 #include <scheduler.h>
 #include <script/descriptor.h>
+#include <support/allocators/counting.h>
 #include <txmempool.h>
 #include <util/check.h>
 #include <util/message.h> // For MessageSign(), MessageVerify()
@@ -823,9 +824,13 @@ static UniValue getaddressdeltas(const JSONRPCRequest& request)
 
     UniValue startValue = find_value(request.params[0].get_obj(), "start");
     UniValue endValue = find_value(request.params[0].get_obj(), "end");
+    UniValue startBlockindexValue = find_value(request.params[0].get_obj(), "startblockindex");
+    UniValue countValue = find_value(request.params[0].get_obj(), "count");
 
     int start = 0;
     int end = 0;
+    unsigned int startTxindex = 0;
+    size_t count = 0;
 
     if (startValue.isNum() && endValue.isNum()) {
         start = startValue.get_int();
@@ -834,6 +839,21 @@ static UniValue getaddressdeltas(const JSONRPCRequest& request)
             throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "End value is expected to be greater than start");
         }
     }
+    if (startBlockindexValue.isNum()) {
+        if (start <= 0) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "startblockindex requires start to be set");
+        }
+        if (startBlockindexValue.get_int() < 0) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Expected positive startblockindex");
+        }
+        startTxindex = startBlockindexValue.get_int();
+    }
+    if (countValue.isNum()) {
+        if (countValue.get_int() <= 0) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Expected positive count");
+        }
+        count = countValue.get_int();
+    }
 
     std::vector<std::pair<uint160, int> > addresses;
 
@@ -844,14 +864,11 @@ static UniValue getaddressdeltas(const JSONRPCRequest& request)
     std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
 
     for (std::vector<std::pair<uint160, int> >::iterator it = addresses.begin(); it != addresses.end(); it++) {
-        if (start > 0 && end > 0) {
-            if (!GetAddressIndex((*it).first, (*it).second, addressIndex, start, end)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
-        } else {
-            if (!GetAddressIndex((*it).first, (*it).second, addressIndex)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
+        if (!GetAddressIndex((*it).first, (*it).second, addressIndex, start, end, startTxindex, count)) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+        }
+        if (count > 0 && addressIndex.size() >= count) {
+            break;
         }
     }
 
@@ -973,6 +990,8 @@ static UniValue getaddresstxids(const JSONRPCRequest& request)
 
     int start = 0;
     int end = 0;
+    unsigned int startTxindex = 0;
+    size_t count = 0;
     if (request.params[0].isObject()) {
         UniValue startValue = find_value(request.params[0].get_obj(), "start");
         UniValue endValue = find_value(request.params[0].get_obj(), "end");
@@ -980,19 +999,24 @@ static UniValue getaddresstxids(const JSONRPCRequest& request)
             start = startValue.get_int();
             end = endValue.get_int();
         }
+        UniValue startBlockindexValue = find_value(request.params[0].get_obj(), "startblockindex");
+        if (startBlockindexValue.isNum() && start > 0 && startBlockindexValue.get_int() >= 0) {
+            startTxindex = startBlockindexValue.get_int();
+        }
+        UniValue countValue = find_value(request.params[0].get_obj(), "count");
+        if (countValue.isNum() && countValue.get_int() > 0) {
+            count = countValue.get_int();
+        }
     }
 
     std::vector<std::pair<CAddressIndexKey, CAmount> > addressIndex;
 
     for (std::vector<std::pair<uint160, int> >::iterator it = addresses.begin(); it != addresses.end(); it++) {
-        if (start > 0 && end > 0) {
-            if (!GetAddressIndex((*it).first, (*it).second, addressIndex, start, end)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
-        } else {
-            if (!GetAddressIndex((*it).first, (*it).second, addressIndex)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
-            }
+        if (!GetAddressIndex((*it).first, (*it).second, addressIndex, start, end, startTxindex, count)) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "No information available for address");
+        }
+        if (count > 0 && addressIndex.size() >= count) {
+            break;
         }
     }
 
@@ -1160,6 +1184,14 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
                         {RPCResult::Type::NUM, "chunks_used", "Number allocated chunks"},
                         {RPCResult::Type::NUM, "chunks_free", "Number unused chunks"},
                     }},
+                    {RPCResult::Type::OBJ_DYN, "allocations", /* optional */ true, "Per-site allocation counters (only present if compiled with --enable-perf-tracking)",
+                    {
+                        {RPCResult::Type::OBJ, "site", "Counters for the allocation site with this name",
+                        {
+                            {RPCResult::Type::NUM, "bytes", "Number of bytes currently allocated"},
+                            {RPCResult::Type::NUM, "allocations", "Number of allocations since startup"},
+                        }},
+                    }},
                 }
             },
             RPCResult{"mode \"mallocinfo\"",
@@ -1176,6 +1208,18 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
     if (mode == "stats") {
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("locked", RPCLockedMemoryInfo());
+#ifdef ENABLE_PERF_TRACKING
+        UniValue allocations(UniValue::VOBJ);
+        for (size_t i = 0; i < static_cast<size_t>(alloc_tracking::Site::NUM_SITES); ++i) {
+            const auto site = static_cast<alloc_tracking::Site>(i);
+            const auto& stats = alloc_tracking::GetStats(site);
+            UniValue siteObj(UniValue::VOBJ);
+            siteObj.pushKV("bytes", stats.nBytes.load(std::memory_order_relaxed));
+            siteObj.pushKV("allocations", stats.nAllocations.load(std::memory_order_relaxed));
+            allocations.pushKV(alloc_tracking::GetSiteName(site), siteObj);
+        }
+        obj.pushKV("allocations", allocations);
+#endif
         return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
@@ -1188,6 +1232,41 @@ static UniValue getmemoryinfo(const JSONRPCRequest& request)
     }
 }
 
+static UniValue getlockstats(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"getlockstats",
+        "Returns wait time statistics of contended lock acquisitions since startup, keyed by lock name.\n"
+        "Only acquisitions that actually had to wait are counted. Locks sharing a variable name\n"
+        "(e.g. \"cs\") are aggregated under that name.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ_DYN, "", "",
+            {
+                {RPCResult::Type::OBJ, "name", "Statistics for the lock(s) with this name",
+                {
+                    {RPCResult::Type::NUM, "contentions", "Number of acquisitions that had to wait"},
+                    {RPCResult::Type::NUM, "wait_total_usec", "Total time spent waiting, in microseconds"},
+                    {RPCResult::Type::NUM, "wait_max_usec", "Longest single wait, in microseconds"},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("getlockstats", "")
+    + HelpExampleRpc("getlockstats", "")
+        },
+    }.Check(request);
+
+    UniValue obj(UniValue::VOBJ);
+    for (const auto& [lockName, lockStats] : GetLockContentionStats()) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("contentions", lockStats.count);
+        entry.pushKV("wait_total_usec", lockStats.total_wait_usec);
+        entry.pushKV("wait_max_usec", lockStats.max_wait_usec);
+        obj.pushKV(lockName, entry);
+    }
+    return obj;
+}
+
 static void EnableOrDisableLogCategories(UniValue cats, bool enable) {
     cats = cats.get_array();
     for (unsigned int i = 0; i < cats.size(); ++i) {
@@ -1300,6 +1379,7 @@ static const CRPCCommand commands[] =
 { //  category              name                      actor (function)         argNames
   //  --------------------- ------------------------  -----------------------  ----------
     { "control",            "debug",                  &debug,                  {} },
+    { "control",            "getlockstats",           &getlockstats,           {} },
     { "control",            "getmemoryinfo",          &getmemoryinfo,          {"mode"} },
     { "control",            "logging",                &logging,                {"include", "exclude"}},
     { "util",               "validateaddress",        &validateaddress,        {"address"} },
@@ -362,6 +362,40 @@ static UniValue quorum_dkgstatus(const JSONRPCRequest& request)
     return ret;
 }
 
+static void quorum_dkgevents_help(const JSONRPCRequest& request)
+{
+    RPCHelpMan{"quorum dkgevents",
+        "Return incremental session-level DKG status events (init, phase\n"
+        "transitions, sent messages, aborts) from a bounded ring buffer.\n"
+        "Meant for monitoring: poll with the \"lastSeq\" of the previous\n"
+        "response to only receive new events, instead of rebuilding the\n"
+        "full dkgstatus on every poll.\n",
+        {
+            {"since_seq", RPCArg::Type::NUM, /* default */ "0",
+                "Only return events with a sequence number greater than this."},
+        },
+        RPCResults{},
+        RPCExamples{""},
+    }.Check(request);
+}
+
+static UniValue quorum_dkgevents(const JSONRPCRequest& request)
+{
+    quorum_dkgevents_help(request);
+
+    uint64_t nSinceSeq = 0;
+    if (!request.params[0].isNull()) {
+        int64_t nParsed = ParseInt64V(request.params[0], "since_seq");
+        if (nParsed < 0) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "invalid since_seq");
+        }
+        nSinceSeq = (uint64_t)nParsed;
+    }
+
+    LLMQContext& llmq_ctx = EnsureLLMQContext(request.context);
+    return llmq_ctx.dkg_debugman->GetDebugEventsJson(nSinceSeq);
+}
+
 static void quorum_memberof_help(const JSONRPCRequest& request)
 {
     RPCHelpMan{"quorum memberof",
@@ -805,6 +839,7 @@ static UniValue quorum_rotationinfo(const JSONRPCRequest& request)
             "  info              - Return information about a quorum\n"
             "  dkgsimerror       - Simulates DKG errors and malicious behavior\n"
             "  dkgstatus         - Return the status of the current DKG process\n"
+            "  dkgevents         - Return incremental session-level DKG status events\n"
             "  memberof          - Checks which quorums the given masternode is a member of\n"
             "  sign              - Threshold-sign a message\n"
             "  verify            - Test if a quorum signature is valid for a request id and a message hash\n"
@@ -836,6 +871,8 @@ static UniValue _quorum(const JSONRPCRequest& request)
         return quorum_info(new_request);
     } else if (command == "quorumdkgstatus") {
         return quorum_dkgstatus(new_request);
+    } else if (command == "quorumdkgevents") {
+        return quorum_dkgevents(new_request);
     } else if (command == "quorummemberof") {
         return quorum_memberof(new_request);
     } else if (command == "quorumsign" || command == "quorumverify" || command == "quorumhasrecsig" || command == "quorumgetrecsig" || command == "quorumisconflicting") {
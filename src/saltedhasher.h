@@ -9,6 +9,8 @@
 #include <uint256.h>
 #include <crypto/siphash.h>
 
+#include <utility>
+
 /** Helper classes for std::unordered_map and std::unordered_set hashing */
 
 template<typename T> struct SaltedHasherImpl;
@@ -31,6 +33,15 @@ struct SaltedHasherImpl<std::pair<N, uint256>>
     }
 };
 
+template<typename N>
+struct SaltedHasherImpl<std::pair<N, uint160>>
+{
+    static std::size_t CalcHash(const std::pair<N, uint160>& v, uint64_t k0, uint64_t k1)
+    {
+        return CSipHasher(k0, k1).Write((uint64_t)v.first).Write(v.second.begin(), v.second.size()).Finalize();
+    }
+};
+
 template<>
 struct SaltedHasherImpl<uint256>
 {
@@ -10,6 +10,7 @@
 #include <list>
 #include <map>
 #include <thread>
+#include <vector>
 
 #include <sync.h>
 
@@ -36,7 +37,14 @@ public:
     CScheduler();
     ~CScheduler();
 
-    std::thread m_service_thread;
+    /**
+     * Threads running serviceQueue(). Usually one; more may be started so that
+     * independent periodic tasks can't delay each other (a slow wallet flush
+     * holding back short-interval llmq cleanups, for example). Tasks that must
+     * never run in parallel with each other should go through a
+     * SingleThreadedSchedulerClient instead of relying on a single thread.
+     */
+    std::vector<std::thread> m_service_threads;
 
     typedef std::function<void()> Function;
 
@@ -74,14 +82,20 @@ public:
     {
         WITH_LOCK(newTaskMutex, stopRequested = true);
         newTaskScheduled.notify_all();
-        if (m_service_thread.joinable()) m_service_thread.join();
+        for (auto& thread : m_service_threads) {
+            if (thread.joinable()) thread.join();
+        }
+        m_service_threads.clear();
     }
     /** Tell any threads running serviceQueue to stop when there is no work left to be done */
     void StopWhenDrained()
     {
         WITH_LOCK(newTaskMutex, stopWhenEmpty = true);
         newTaskScheduled.notify_all();
-        if (m_service_thread.joinable()) m_service_thread.join();
+        for (auto& thread : m_service_threads) {
+            if (thread.joinable()) thread.join();
+        }
+        m_service_threads.clear();
     }
 
     /**
@@ -622,7 +622,9 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x - 0 | x x)
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch = stacktop(-1);
+                    // push_back of an element of the same vector is safe, so
+                    // no temporary copy is needed
+                    const valtype& vch = stacktop(-1);
                     if (CastToBool(vch))
                         stack.push_back(vch);
                 }
@@ -650,8 +652,9 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x -- x x)
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch = stacktop(-1);
-                    stack.push_back(vch);
+                    // push_back of an element of the same vector is safe, so
+                    // no temporary copy is needed
+                    stack.push_back(stacktop(-1));
                 }
                 break;
 
@@ -1602,6 +1605,58 @@ bool GenericTransactionSignatureChecker<T>::CheckSequence(const CScriptNum& nSeq
 template class GenericTransactionSignatureChecker<CTransaction>;
 template class GenericTransactionSignatureChecker<CMutableTransaction>;
 
+/** Try to decode scriptSig as exactly two data pushes (signature, then pubkey),
+ * i.e. the canonical spend of a P2PKH output. Any other shape — extra ops,
+ * OP_1..OP_16 pushes, oversized elements, non-minimal pushes under MINIMALDATA —
+ * returns false, so the caller falls back to the generic interpreter and all
+ * unusual spends keep their exact generic error codes. */
+bool static MatchP2PKHScriptSig(const CScript& scriptSig, unsigned int flags, valtype& vchSig, valtype& vchPubKey)
+{
+    valtype* pushes[2] = {&vchSig, &vchPubKey};
+    CScript::const_iterator pc = scriptSig.begin();
+    for (auto* push : pushes) {
+        opcodetype opcode;
+        if (!scriptSig.GetOp(pc, opcode, *push)) return false;
+        if (opcode > OP_PUSHDATA4) return false;
+        if (push->size() > MAX_SCRIPT_ELEMENT_SIZE) return false;
+        if ((flags & SCRIPT_VERIFY_MINIMALDATA) && !CheckMinimalPush(*push, opcode)) return false;
+    }
+    return pc == scriptSig.end();
+}
+
+/** Verify a standard P2PKH spend without the opcode loop and stack machinery.
+ * This must stay semantically identical to running
+ * <sig> <pubkey> | DUP HASH160 <hash> EQUALVERIFY CHECKSIG through EvalScript,
+ * including error codes, evaluation order and flag handling. */
+bool static VerifyP2PKH(const valtype& vchSig, const valtype& vchPubKey, const CScript& scriptPubKey, unsigned int flags, const BaseSignatureChecker& checker, ScriptError* serror)
+{
+    // DUP HASH160 <hash> EQUALVERIFY
+    valtype vchHash(20);
+    CHash160().Write(vchPubKey).Finalize(vchHash);
+    if (!std::equal(vchHash.begin(), vchHash.end(), scriptPubKey.begin() + 3)) {
+        return set_error(serror, SCRIPT_ERR_EQUALVERIFY);
+    }
+
+    // CHECKSIG
+    CScript scriptCode(scriptPubKey.begin(), scriptPubKey.end());
+    int found = FindAndDelete(scriptCode, CScript() << vchSig);
+    if (found > 0 && (flags & SCRIPT_VERIFY_CONST_SCRIPTCODE))
+        return set_error(serror, SCRIPT_ERR_SIG_FINDANDDELETE);
+
+    if (!CheckSignatureEncoding(vchSig, flags, serror) || !CheckPubKeyEncoding(vchPubKey, flags, SigVersion::BASE, serror)) {
+        // serror is set
+        return false;
+    }
+    bool fSuccess = checker.CheckSig(vchSig, vchPubKey, scriptCode, SigVersion::BASE);
+
+    if (!fSuccess && (flags & SCRIPT_VERIFY_NULLFAIL) && vchSig.size())
+        return set_error(serror, SCRIPT_ERR_SIG_NULLFAIL);
+    if (!fSuccess)
+        return set_error(serror, SCRIPT_ERR_EVAL_FALSE);
+
+    return set_success(serror);
+}
+
 bool VerifyScript(const CScript& scriptSig, const CScript& scriptPubKey, unsigned int flags, const BaseSignatureChecker& checker, ScriptError* serror)
 {
     set_error(serror, SCRIPT_ERR_UNKNOWN_ERROR);
@@ -1610,13 +1665,34 @@ bool VerifyScript(const CScript& scriptSig, const CScript& scriptPubKey, unsigne
         return set_error(serror, SCRIPT_ERR_SIG_PUSHONLY);
     }
 
+    // The overwhelming majority of inputs spend standard P2PKH outputs, so
+    // dispatch those to a specialized routine instead of the opcode loop.
+    // A scriptSig the matcher doesn't recognize falls through to the generic
+    // interpreter below.
+    if (scriptPubKey.IsPayToPublicKeyHash()) {
+        valtype vchSig, vchPubKey;
+        if (MatchP2PKHScriptSig(scriptSig, flags, vchSig, vchPubKey)) {
+            return VerifyP2PKH(vchSig, vchPubKey, scriptPubKey, flags, checker, serror);
+        }
+    }
+
     // scriptSig and scriptPubKey must be evaluated sequentially on the same stack
     // rather than being simply concatenated (see CVE-2010-5141)
-    std::vector<std::vector<unsigned char> > stack, stackCopy;
+    //
+    // The stack containers are pooled per thread and reused across
+    // invocations, so their buffers don't have to be reallocated for every
+    // input verified in the parallel script check phase. VerifyScript never
+    // reenters itself, so one pooled pair per thread suffices.
+    static thread_local std::vector<std::vector<unsigned char> > stack, stackCopy;
+    stack.clear();
+    stackCopy.clear();
     if (!EvalScript(stack, scriptSig, flags, checker, SigVersion::BASE, serror))
         // serror is set
         return false;
-    if (flags & SCRIPT_VERIFY_P2SH)
+    // The copy is only consumed by the P2SH branch below, so skip it for all
+    // other output types instead of deep-copying the stack per input
+    const bool is_p2sh = (flags & SCRIPT_VERIFY_P2SH) && scriptPubKey.IsPayToScriptHash();
+    if (is_p2sh)
         stackCopy = stack;
     if (!EvalScript(stack, scriptPubKey, flags, checker, SigVersion::BASE, serror))
         // serror is set
@@ -1627,7 +1703,7 @@ bool VerifyScript(const CScript& scriptSig, const CScript& scriptPubKey, unsigne
         return set_error(serror, SCRIPT_ERR_EVAL_FALSE);
 
     // Additional validation for spend-to-script-hash transactions:
-    if ((flags & SCRIPT_VERIFY_P2SH) && scriptPubKey.IsPayToScriptHash())
+    if (is_p2sh)
     {
         // scriptSig must be literals-only or validation fails
         if (!scriptSig.IsPushOnly())
@@ -106,6 +106,16 @@ enum
 
 bool CheckSignatureEncoding(const std::vector<unsigned char> &vchSig, unsigned int flags, ScriptError* serror);
 
+/** Per-transaction data shared between all signature checks of one validation.
+ *
+ * Dash only implements the legacy sighash algorithm, which reserializes the
+ * transaction for every signature check, so there are no reusable midstates
+ * here: the BIP143 hashPrevouts/hashSequence/hashOutputs fields below are
+ * never computed or read and remain only to keep the interface close to
+ * upstream. Redundant verification between mempool acceptance and block
+ * connection is instead avoided by the script execution and signature caches
+ * (see CheckInputsFromMempoolAndCache in validation.cpp).
+ */
 struct PrecomputedTransactionData
 {
     uint256 hashPrevouts, hashSequence, hashOutputs;
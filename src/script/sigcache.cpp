@@ -12,6 +12,7 @@
 
 #include <cuckoocache.h>
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <vector>
@@ -56,6 +57,14 @@ public:
         return setValid.contains(entry, erase);
     }
 
+    void Prefetch(const uint256& entry) const
+    {
+        // Only computes addresses and issues prefetch hints, so no lock is
+        // needed; this overlaps the table cache misses with acquiring
+        // cs_sigcache in Get().
+        setValid.prefetch(entry);
+    }
+
     void Set(const uint256& entry)
     {
         std::unique_lock<std::shared_mutex> lock(cs_sigcache);
@@ -74,29 +83,56 @@ public:
  * signatureCache could be made local to VerifySignature.
 */
 static CSignatureCache signatureCache;
+
+// Cumulative probe counters for the getcachestats RPC. Relaxed ordering is
+// fine; these are statistics, not synchronization.
+static std::atomic<uint64_t> g_sigcache_hits{0};
+static std::atomic<uint64_t> g_sigcache_misses{0};
 } // namespace
 
 // To be called once in AppInitMain/BasicTestingSetup to initialize the
 // signatureCache.
 void InitSignatureCache()
 {
+    // When the script execution cache is sized on its own with
+    // -maxscriptcachesize, -maxsigcachesize belongs entirely to the
+    // signature cache; otherwise the two caches keep their historical
+    // half/half split of it.
+    int64_t nRequestedSize = gArgs.GetArg("-maxsigcachesize", DEFAULT_MAX_SIG_CACHE_SIZE);
+    if (!gArgs.IsArgSet("-maxscriptcachesize")) {
+        nRequestedSize /= 2;
+    }
     // nMaxCacheSize is unsigned. If -maxsigcachesize is set to zero,
     // setup_bytes creates the minimum possible cache (2 elements).
-    size_t nMaxCacheSize = std::min(std::max((int64_t)0, gArgs.GetArg("-maxsigcachesize", DEFAULT_MAX_SIG_CACHE_SIZE) / 2), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
+    size_t nMaxCacheSize = std::min(std::max((int64_t)0, nRequestedSize), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
     size_t nElems = signatureCache.setup_bytes(nMaxCacheSize);
-    LogPrintf("Using %zu MiB out of %zu/2 requested for signature cache, able to store %zu elements\n",
-            (nElems*sizeof(uint256)) >>20, (nMaxCacheSize*2)>>20, nElems);
+    LogPrintf("Using %zu MiB out of %zu requested for signature cache, able to store %zu elements\n",
+            (nElems*sizeof(uint256)) >>20, nMaxCacheSize>>20, nElems);
 }
 
 bool CachingTransactionSignatureChecker::VerifySignature(const std::vector<unsigned char>& vchSig, const CPubKey& pubkey, const uint256& sighash) const
 {
     uint256 entry;
     signatureCache.ComputeEntry(entry, sighash, vchSig, pubkey);
-    if (signatureCache.Get(entry, !store))
+    signatureCache.Prefetch(entry);
+    if (signatureCache.Get(entry, !store)) {
+        g_sigcache_hits.fetch_add(1, std::memory_order_relaxed);
         return true;
+    }
+    g_sigcache_misses.fetch_add(1, std::memory_order_relaxed);
     if (!TransactionSignatureChecker::VerifySignature(vchSig, pubkey, sighash))
         return false;
     if (store)
         signatureCache.Set(entry);
     return true;
 }
+
+uint64_t SignatureCacheHits()
+{
+    return g_sigcache_hits.load(std::memory_order_relaxed);
+}
+
+uint64_t SignatureCacheMisses()
+{
+    return g_sigcache_misses.load(std::memory_order_relaxed);
+}
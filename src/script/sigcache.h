@@ -53,4 +53,8 @@ public:
 
 void InitSignatureCache();
 
+/** Cumulative signature cache probe counters, exposed by the getcachestats RPC */
+uint64_t SignatureCacheHits();
+uint64_t SignatureCacheMisses();
+
 #endif // BITCOIN_SCRIPT_SIGCACHE_H
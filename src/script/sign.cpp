@@ -11,6 +11,9 @@
 #include <script/signingprovider.h>
 #include <script/standard.h>
 #include <uint256.h>
+#include <util/system.h>
+
+#include <thread>
 
 typedef std::vector<unsigned char> valtype;
 
@@ -390,13 +393,16 @@ bool SignTransaction(CMutableTransaction& mtx, const SigningProvider* keystore,
     // Use CTransaction for the constant parts of the
     // transaction to avoid rehashing.
     const CTransaction txConst(mtx);
-    // Sign what we can:
-    for (unsigned int i = 0; i < mtx.vin.size(); i++) {
+
+    // Signing and verifying one input only reads the shared transaction state
+    // (a sighash never covers another input's scriptSig) and writes nothing
+    // but its own txin, so inputs can be signed on worker threads. The
+    // process-global secp256k1 signing context is safe to use concurrently.
+    auto sign_input = [&](unsigned int i) -> std::string {
         CTxIn& txin = mtx.vin[i];
         auto coin = coins.find(txin.prevout);
         if (coin == coins.end() || coin->second.IsSpent()) {
-            input_errors[i] = "Input not found or already spent";
-            continue;
+            return "Input not found or already spent";
         }
         const CScript& prevPubKey = coin->second.out.scriptPubKey;
         const CAmount& amount = coin->second.out.nValue;
@@ -413,14 +419,45 @@ bool SignTransaction(CMutableTransaction& mtx, const SigningProvider* keystore,
         if (!VerifyScript(txin.scriptSig, prevPubKey, STANDARD_SCRIPT_VERIFY_FLAGS, TransactionSignatureChecker(&txConst, i, amount), &serror)) {
             if (serror == SCRIPT_ERR_INVALID_STACK_OPERATION) {
                 // Unable to sign input and verification failed (possible attempt to partially sign).
-                input_errors[i] = "Unable to sign input, invalid stack size (possibly missing key)";
+                return "Unable to sign input, invalid stack size (possibly missing key)";
             } else if (serror == SCRIPT_ERR_SIG_NULLFAIL) {
                 // Verification failed (possibly due to insufficient signatures).
-                input_errors[i] = "CHECK(MULTI)SIG failing with non-zero signature (possibly need more signatures)";
+                return "CHECK(MULTI)SIG failing with non-zero signature (possibly need more signatures)";
             } else {
-                input_errors[i] = ScriptErrorString(serror);
+                return std::string(ScriptErrorString(serror));
             }
         }
+        return std::string();
+    };
+
+    /** Don't bother spinning up threads for everyday transaction sizes. */
+    constexpr unsigned int PARALLEL_SIGN_THRESHOLD{16};
+    constexpr unsigned int MAX_PARALLEL_SIGN_THREADS{8};
+    const unsigned int nInputs = mtx.vin.size();
+    std::vector<std::string> errors(nInputs);
+    const unsigned int nThreads = std::min<unsigned int>({nInputs / (PARALLEL_SIGN_THRESHOLD / 2), (unsigned int)std::max(1, GetNumCores()), MAX_PARALLEL_SIGN_THREADS});
+    if (nInputs >= PARALLEL_SIGN_THRESHOLD && nThreads > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads);
+        for (unsigned int t = 0; t < nThreads; t++) {
+            threads.emplace_back([&, t]() {
+                for (unsigned int i = t; i < nInputs; i += nThreads) {
+                    errors[i] = sign_input(i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    } else {
+        for (unsigned int i = 0; i < nInputs; i++) {
+            errors[i] = sign_input(i);
+        }
+    }
+    for (unsigned int i = 0; i < nInputs; i++) {
+        if (!errors[i].empty()) {
+            input_errors[i] = errors[i];
+        }
     }
     return input_errors.empty();
 }
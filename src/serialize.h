@@ -20,6 +20,7 @@
 #include <set>
 #include <string>
 #include <string.h>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -831,6 +832,22 @@ template<typename Stream, unsigned int N, typename T> void Unserialize_impl(Stre
 template<typename Stream, unsigned int N, typename T, typename V> void Unserialize_impl(Stream& is, prevector<N, T>& v, const V&);
 template<typename Stream, unsigned int N, typename T> inline void Unserialize(Stream& is, prevector<N, T>& v);
 
+/**
+ * Opt-in marker for element types whose serialized form is identical to their
+ * in-memory representation on all platforms (e.g. base_blob subclasses, which
+ * serialize as raw bytes). Vectors of such types are read and written as one
+ * blob instead of element by element, which produces byte-identical output
+ * but avoids per-element call overhead on large messages (mnlistdiff,
+ * qsigsharesinv). Do not specialize this for types with custom serialization
+ * (e.g. BLS ids) or with any platform-dependent layout.
+ */
+template<typename T> struct ser_is_byte_blob : std::false_type {};
+
+class uint160;
+class uint256;
+template<> struct ser_is_byte_blob<uint160> : std::true_type {};
+template<> struct ser_is_byte_blob<uint256> : std::true_type {};
+
 /**
  * vector
  * vectors of unsigned char are a special case and are intended to be serialized as a single opaque blob.
@@ -1075,7 +1092,14 @@ void Serialize_impl(Stream& os, const std::vector<T, A>& v, const bool&)
 template<typename Stream, typename T, typename A, typename V>
 void Serialize_impl(Stream& os, const std::vector<T, A>& v, const V&)
 {
-    Serialize(os, Using<VectorFormatter<DefaultFormatter>>(v));
+    if constexpr (ser_is_byte_blob<T>::value) {
+        static_assert(std::is_trivially_copyable_v<T>, "byte blob types must be trivially copyable");
+        WriteCompactSize(os, v.size());
+        if (!v.empty())
+            os.write((const char*)v.data(), v.size() * sizeof(T));
+    } else {
+        Serialize(os, Using<VectorFormatter<DefaultFormatter>>(v));
+    }
 }
 
 template<typename Stream, typename T, typename A>
@@ -1104,7 +1128,22 @@ void Unserialize_impl(Stream& is, std::vector<T, A>& v, const unsigned char&)
 template<typename Stream, typename T, typename A, typename V>
 void Unserialize_impl(Stream& is, std::vector<T, A>& v, const V&)
 {
-    Unserialize(is, Using<VectorFormatter<DefaultFormatter>>(v));
+    if constexpr (ser_is_byte_blob<T>::value) {
+        static_assert(std::is_trivially_copyable_v<T>, "byte blob types must be trivially copyable");
+        // Limit size per read so bogus size value won't cause out of memory
+        v.clear();
+        unsigned int nSize = ReadCompactSize(is);
+        unsigned int i = 0;
+        while (i < nSize)
+        {
+            unsigned int blk = std::min(nSize - i, (unsigned int)(1 + 4999999 / sizeof(T)));
+            v.resize(i + blk);
+            is.read((char*)&v[i], blk * sizeof(T));
+            i += blk;
+        }
+    } else {
+        Unserialize(is, Using<VectorFormatter<DefaultFormatter>>(v));
+    }
 }
 
 template<typename Stream, typename T, typename A>
@@ -1394,9 +1433,12 @@ class CSizeComputer
 protected:
     size_t nSize;
 
+    const int nType;
     const int nVersion;
 public:
-    explicit CSizeComputer(int nVersionIn) : nSize(0), nVersion(nVersionIn) {}
+    explicit CSizeComputer(int nVersionIn) : nSize(0), nType(0), nVersion(nVersionIn) {}
+    //! For objects whose serialization depends on the stream type (s.GetType())
+    CSizeComputer(int nTypeIn, int nVersionIn) : nSize(0), nType(nTypeIn), nVersion(nVersionIn) {}
 
     void write(const char *psz, size_t _nSize)
     {
@@ -1420,6 +1462,7 @@ public:
         return nSize;
     }
 
+    int GetType() const { return nType; }
     int GetVersion() const { return nVersion; }
 };
 
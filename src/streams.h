@@ -130,6 +130,56 @@ private:
     size_t nPos;
 };
 
+/** Minimal stream for overwriting an existing fixed-size byte span
+ *
+ * Unlike CVectorWriter the destination cannot grow, so the serialized size
+ * must be known up front; writing past the end of the span asserts. Useful
+ * for serializing fixed-layout objects to the stack without a heap
+ * allocation.
+ */
+class SpanWriter
+{
+public:
+    /*
+     * @param[in]  nTypeIn Serialization Type
+     * @param[in]  nVersionIn Serialization Version (including any flags)
+     * @param[in]  dataIn  Referenced byte span to overwrite
+     */
+    SpanWriter(int nTypeIn, int nVersionIn, Span<unsigned char> dataIn) : nType(nTypeIn), nVersion(nVersionIn), data(dataIn) {}
+
+    void write(const char* pch, size_t nSize)
+    {
+        assert(nPos + nSize <= data.size());
+        memcpy(data.data() + nPos, pch, nSize);
+        nPos += nSize;
+    }
+    template<typename T>
+    SpanWriter& operator<<(const T& obj)
+    {
+        // Serialize to this stream
+        ::Serialize(*this, obj);
+        return (*this);
+    }
+    int GetVersion() const
+    {
+        return nVersion;
+    }
+    int GetType() const
+    {
+        return nType;
+    }
+    size_t size() const
+    {
+        return nPos;
+    }
+
+private:
+    const int nType;
+    const int nVersion;
+    Span<unsigned char> data;
+    size_t nPos{0};
+};
+
 /** Minimal stream for reading from an existing vector by reference
  */
 class VectorReader
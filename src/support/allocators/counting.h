@@ -0,0 +1,98 @@
+// Copyright (c) 2026 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_SUPPORT_ALLOCATORS_COUNTING_H
+#define BITCOIN_SUPPORT_ALLOCATORS_COUNTING_H
+
+#if defined(HAVE_CONFIG_H)
+#include <config/bitcoin-config.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace alloc_tracking {
+
+//! Allocation sites instrumented when configured with --enable-perf-tracking.
+//! Counters exist in all builds (they are a few atomics), but only
+//! instrumented container typedefs actually feed them.
+enum class Site : std::size_t {
+    MEMPOOL_TX,  //!< CTxMemPool::mapTx multi-index nodes
+    NET_SENDMSG, //!< CNode::vSendMsg list nodes
+    NUM_SITES
+};
+
+struct SiteStats {
+    std::atomic<int64_t> nBytes{0};       //!< live allocated bytes
+    std::atomic<int64_t> nAllocations{0}; //!< cumulative allocation count
+};
+
+inline SiteStats& GetStats(Site site)
+{
+    static std::array<SiteStats, static_cast<std::size_t>(Site::NUM_SITES)> stats;
+    return stats[static_cast<std::size_t>(site)];
+}
+
+inline const char* GetSiteName(Site site)
+{
+    switch (site) {
+    case Site::MEMPOOL_TX: return "mempool_tx";
+    case Site::NET_SENDMSG: return "net_sendmsg";
+    case Site::NUM_SITES: break;
+    }
+    return "unknown";
+}
+
+} // namespace alloc_tracking
+
+/**
+ * Minimal allocator recording live bytes and cumulative allocation counts for
+ * one site, so fleet telemetry can attribute RSS growth to subsystems through
+ * getmemoryinfo without attaching a profiler. Only wired into container
+ * typedefs under ENABLE_PERF_TRACKING; release builds are unaffected.
+ */
+template <typename T, alloc_tracking::Site site>
+struct counting_allocator {
+    using value_type = T;
+
+    counting_allocator() noexcept = default;
+    template <typename U>
+    counting_allocator(const counting_allocator<U, site>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        auto& stats = alloc_tracking::GetStats(site);
+        stats.nBytes.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+        stats.nAllocations.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        alloc_tracking::GetStats(site).nBytes.fetch_sub(n * sizeof(T), std::memory_order_relaxed);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = counting_allocator<U, site>;
+    };
+};
+
+template <typename T, typename U, alloc_tracking::Site site>
+bool operator==(const counting_allocator<T, site>&, const counting_allocator<U, site>&) noexcept
+{
+    return true;
+}
+
+template <typename T, typename U, alloc_tracking::Site site>
+bool operator!=(const counting_allocator<T, site>&, const counting_allocator<U, site>&) noexcept
+{
+    return false;
+}
+
+#endif // BITCOIN_SUPPORT_ALLOCATORS_COUNTING_H
@@ -7,6 +7,7 @@
 
 #include <support/allocators/pooled_secure.h>
 
+#include <atomic>
 #include <thread>
 #include <mutex>
 
@@ -61,8 +62,14 @@ struct mt_pooled_secure_allocator : public std::allocator<T> {
 private:
     size_t get_bucket()
     {
-        size_t x = std::hash<std::thread::id>{}(std::this_thread::get_id());
-        return x % pools.size();
+        // Assign each thread a pool round-robin on first use. As long as no
+        // more threads allocate than there are pools, every thread gets a
+        // pool (and thus a mutex and free list) of its own; hashing thread
+        // ids collides much earlier and makes unrelated threads serialize
+        // on the same pool.
+        static std::atomic<size_t> counter{0};
+        thread_local const size_t id = counter.fetch_add(1, std::memory_order_relaxed);
+        return id % pools.size();
     }
 
     struct internal_pool : pooled_secure_allocator<uint8_t> {
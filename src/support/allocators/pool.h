@@ -0,0 +1,249 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_SUPPORT_ALLOCATORS_POOL_H
+#define BITCOIN_SUPPORT_ALLOCATORS_POOL_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+/**
+ * A memory resource similar to std::pmr::unsynchronized_pool_resource, but
+ * optimized for node-based containers. Allocations up to
+ * MAX_BLOCK_SIZE_BYTES are carved out of large pre-allocated chunks and
+ * recycled through per-size free lists, so node allocation/deallocation
+ * becomes a couple of pointer operations and does not touch the global heap.
+ * Larger allocations (e.g. a hash map's bucket array) fall through to
+ * operator new.
+ *
+ * Memory is only returned to the system when the resource is destroyed, so
+ * the resource should live exactly as long as the container(s) using it.
+ * Not thread safe; use one resource per container.
+ *
+ * A resource can optionally be backed by huge pages: chunks are then rounded
+ * up to and aligned on 2MB boundaries and advised as MADV_HUGEPAGE, so a
+ * multi-GB cache occupies a few thousand TLB entries instead of millions.
+ * On platforms without madvise this degrades to plain aligned allocation.
+ */
+template <std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+class PoolResource
+{
+    static_assert(ALIGN_BYTES > 0 && (ALIGN_BYTES & (ALIGN_BYTES - 1)) == 0, "ALIGN_BYTES must be a power of two");
+
+    /**
+     * In-place linked list of returned blocks of one size class
+     */
+    struct ListNode {
+        ListNode* m_next;
+
+        explicit ListNode(ListNode* next) : m_next(next) {}
+    };
+    static_assert(std::is_trivially_destructible_v<ListNode>, "ListNode must be trivially destructible");
+
+    /**
+     * Internal alignment for all pooled blocks; a block must at least be able
+     * to hold a ListNode when it is on a free list
+     */
+    static constexpr std::size_t ELEM_ALIGN_BYTES = std::max(alignof(ListNode), ALIGN_BYTES);
+    static_assert((ELEM_ALIGN_BYTES & (ELEM_ALIGN_BYTES - 1)) == 0, "ELEM_ALIGN_BYTES must be a power of two");
+    static_assert(sizeof(ListNode) <= ELEM_ALIGN_BYTES, "free list nodes must fit in the smallest block");
+    static_assert(MAX_BLOCK_SIZE_BYTES % ELEM_ALIGN_BYTES == 0, "MAX_BLOCK_SIZE_BYTES must be a multiple of the alignment");
+
+    //! Size of the chunks the pooled blocks are carved out of
+    const std::size_t m_chunk_size_bytes;
+
+    //! Whether chunks are huge page aligned and advised as MADV_HUGEPAGE
+    const bool m_huge_pages;
+
+    //! All allocated chunks, only freed on destruction
+    std::list<std::byte*> m_allocated_chunks{};
+
+    //! One free list per size class (multiples of ELEM_ALIGN_BYTES)
+    std::array<ListNode*, MAX_BLOCK_SIZE_BYTES / ELEM_ALIGN_BYTES + 1> m_free_lists{};
+
+    //! Not yet carved up part of the current chunk
+    std::byte* m_available_memory_it = nullptr;
+    std::byte* m_available_memory_end = nullptr;
+
+    //! Number of ELEM_ALIGN_BYTES units needed for an allocation of the given size
+    [[nodiscard]] static constexpr std::size_t NumElemAlignBytes(std::size_t bytes)
+    {
+        return (bytes + ELEM_ALIGN_BYTES - 1) / ELEM_ALIGN_BYTES;
+    }
+
+    [[nodiscard]] static constexpr bool IsFreeListUsable(std::size_t bytes, std::size_t alignment)
+    {
+        return alignment <= ELEM_ALIGN_BYTES && bytes <= MAX_BLOCK_SIZE_BYTES;
+    }
+
+    void PlacementAddToList(void* p, ListNode*& node)
+    {
+        node = new (p) ListNode{node};
+    }
+
+    void AllocateChunk()
+    {
+        if (m_huge_pages) {
+            m_available_memory_it = static_cast<std::byte*>(::operator new(m_chunk_size_bytes, std::align_val_t{HUGE_PAGE_SIZE_BYTES}));
+#if defined(MADV_HUGEPAGE)
+            madvise(m_available_memory_it, m_chunk_size_bytes, MADV_HUGEPAGE);
+#endif
+        } else {
+            m_available_memory_it = new std::byte[m_chunk_size_bytes];
+        }
+        m_available_memory_end = m_available_memory_it + m_chunk_size_bytes;
+        m_allocated_chunks.emplace_back(m_available_memory_it);
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+public:
+    //! Huge page size chunks are rounded up to and aligned on when huge pages are requested
+    static constexpr std::size_t HUGE_PAGE_SIZE_BYTES{std::size_t{2} << 20};
+
+    explicit PoolResource(std::size_t chunk_size_bytes, bool huge_pages = false)
+        : m_chunk_size_bytes(huge_pages ? (chunk_size_bytes + HUGE_PAGE_SIZE_BYTES - 1) & ~(HUGE_PAGE_SIZE_BYTES - 1) : chunk_size_bytes),
+          m_huge_pages(huge_pages)
+    {
+        assert(m_chunk_size_bytes >= MAX_BLOCK_SIZE_BYTES);
+        AllocateChunk();
+    }
+
+    PoolResource() : PoolResource(262144) {}
+
+    ~PoolResource()
+    {
+        for (std::byte* chunk : m_allocated_chunks) {
+            if (m_huge_pages) {
+                ::operator delete(chunk, std::align_val_t{HUGE_PAGE_SIZE_BYTES});
+            } else {
+                delete[] chunk;
+            }
+        }
+    }
+
+    void* Allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (IsFreeListUsable(bytes, alignment)) {
+            const std::size_t num_alignments = NumElemAlignBytes(bytes);
+            if (ListNode* node = m_free_lists[num_alignments]) {
+                // we've already got a block of the right size, reuse it
+                m_free_lists[num_alignments] = node->m_next;
+                return node;
+            }
+
+            if (m_available_memory_it + num_alignments * ELEM_ALIGN_BYTES > m_available_memory_end) {
+                // slice remaining memory into the largest possible free list entry, then allocate a new chunk
+                const std::size_t remaining = (m_available_memory_end - m_available_memory_it) / ELEM_ALIGN_BYTES;
+                if (remaining > 0) {
+                    PlacementAddToList(m_available_memory_it, m_free_lists[remaining]);
+                }
+                AllocateChunk();
+            }
+
+            void* ret = m_available_memory_it;
+            m_available_memory_it += num_alignments * ELEM_ALIGN_BYTES;
+            return ret;
+        }
+        return ::operator new(bytes, std::align_val_t{alignment});
+    }
+
+    void Deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if (IsFreeListUsable(bytes, alignment)) {
+            PlacementAddToList(p, m_free_lists[NumElemAlignBytes(bytes)]);
+        } else {
+            ::operator delete(p, std::align_val_t{alignment});
+        }
+    }
+
+    //! Number of chunks allocated so far, for memory usage estimation
+    [[nodiscard]] std::size_t NumAllocatedChunks() const { return m_allocated_chunks.size(); }
+
+    //! Size of a chunk, for memory usage estimation
+    [[nodiscard]] std::size_t ChunkSizeBytes() const { return m_chunk_size_bytes; }
+};
+
+/**
+ * Allocator that delegates all small allocations to a PoolResource. A default
+ * constructed PoolAllocator has no resource and falls back to the global
+ * heap, which keeps containers using it default constructible; two
+ * allocators compare equal only when they point to the same resource.
+ */
+template <class T, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES = alignof(T)>
+class PoolAllocator
+{
+    PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>* m_resource{nullptr};
+
+    template <typename U, std::size_t M, std::size_t A>
+    friend class PoolAllocator;
+
+public:
+    using value_type = T;
+    using ResourceType = PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>;
+
+    PoolAllocator() noexcept = default;
+
+    PoolAllocator(ResourceType* resource) noexcept : m_resource(resource) {}
+
+    PoolAllocator(const PoolAllocator& other) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept = default;
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& other) noexcept : m_resource(other.resource()) {}
+
+    /**
+     * The rebound allocator for type U still allocates from the same resource
+     */
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>;
+    };
+
+    T* allocate(size_t n)
+    {
+        if (m_resource != nullptr) {
+            return static_cast<T*>(m_resource->Allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if (m_resource != nullptr) {
+            m_resource->Deallocate(p, n * sizeof(T), alignof(T));
+        } else {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        }
+    }
+
+    ResourceType* resource() const noexcept { return m_resource; }
+};
+
+template <class T1, class T2, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+bool operator==(const PoolAllocator<T1, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& a,
+                const PoolAllocator<T2, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& b) noexcept
+{
+    return a.resource() == b.resource();
+}
+
+template <class T1, class T2, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+bool operator!=(const PoolAllocator<T1, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& a,
+                const PoolAllocator<T2, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& b) noexcept
+{
+    return !(a == b);
+}
+
+#endif // BITCOIN_SUPPORT_ALLOCATORS_POOL_H
@@ -32,6 +32,28 @@ void PrintLockContention(const char* pszName, const char* pszFile, int nLine)
 }
 #endif /* DEBUG_LOCKCONTENTION */
 
+// Plain std::mutex on purpose: this code runs on every contended lock
+// acquisition and must not recurse into the instrumented lock machinery.
+static std::mutex g_lock_contention_mutex;
+static std::map<std::string, LockContentionStats> g_lock_contention_stats;
+
+void RecordLockContention(const char* pszName, int64_t wait_usec)
+{
+    std::lock_guard<std::mutex> lock(g_lock_contention_mutex);
+    LockContentionStats& stats = g_lock_contention_stats[pszName];
+    stats.count++;
+    stats.total_wait_usec += wait_usec;
+    if (wait_usec > stats.max_wait_usec) {
+        stats.max_wait_usec = wait_usec;
+    }
+}
+
+std::map<std::string, LockContentionStats> GetLockContentionStats()
+{
+    std::lock_guard<std::mutex> lock(g_lock_contention_mutex);
+    return g_lock_contention_stats;
+}
+
 #ifdef DEBUG_LOCKORDER
 //
 // Early deadlock detection.
@@ -9,7 +9,9 @@
 #include <threadsafety.h>
 #include <util/macros.h>
 
+#include <chrono>
 #include <condition_variable>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -127,6 +129,17 @@ typedef AnnotatedMixin<std::mutex> Mutex;
 void PrintLockContention(const char* pszName, const char* pszFile, int nLine);
 #endif
 
+/** Aggregated wait times of contended lock acquisitions, keyed by lock name.
+ *  Only acquisitions which actually had to wait are recorded, so the fast
+ *  path stays a plain (try_)lock. */
+struct LockContentionStats {
+    int64_t count{0};           //!< number of contended acquisitions
+    int64_t total_wait_usec{0}; //!< total time spent waiting for the lock
+    int64_t max_wait_usec{0};   //!< worst single wait
+};
+void RecordLockContention(const char* pszName, int64_t wait_usec);
+std::map<std::string, LockContentionStats> GetLockContentionStats();
+
 /** Wrapper around std::unique_lock style lock for Mutex. */
 template <typename Mutex, typename Base = typename Mutex::UniqueLock>
 class SCOPED_LOCKABLE UniqueLock : public Base
@@ -135,14 +148,14 @@ private:
     void Enter(const char* pszName, const char* pszFile, int nLine)
     {
         EnterCritical(pszName, pszFile, nLine, (void*)(Base::mutex()));
-#ifdef DEBUG_LOCKCONTENTION
         if (!Base::try_lock()) {
+#ifdef DEBUG_LOCKCONTENTION
             PrintLockContention(pszName, pszFile, nLine);
 #endif
+            const auto start{std::chrono::steady_clock::now()};
             Base::lock();
-#ifdef DEBUG_LOCKCONTENTION
+            RecordLockContention(pszName, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
         }
-#endif
     }
 
     bool TryEnter(const char* pszName, const char* pszFile, int nLine)
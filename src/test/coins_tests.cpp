@@ -12,7 +12,9 @@
 #include <undo.h>
 #include <util/strencodings.h>
 
+#include <atomic>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -877,4 +879,70 @@ BOOST_AUTO_TEST_CASE(ccoins_write)
                     CheckWriteCoins(parent_value, child_value, parent_value, parent_flags, child_flags, parent_flags);
 }
 
+BOOST_AUTO_TEST_CASE(sharded_cache_basic)
+{
+    CCoinsViewTest base;
+    CCoinsViewShardedCache cache(&base);
+
+    std::vector<COutPoint> outpoints;
+    for (int i = 0; i < 500; i++) {
+        COutPoint outpoint(InsecureRand256(), InsecureRandRange(10));
+        Coin coin;
+        coin.out.nValue = i + 1;
+        coin.out.scriptPubKey.assign(InsecureRandBits(6), 0);
+        coin.nHeight = 1;
+        cache.AddCoin(outpoint, std::move(coin), false);
+        outpoints.push_back(outpoint);
+    }
+
+    for (size_t i = 0; i < outpoints.size(); i++) {
+        Coin coin;
+        BOOST_CHECK(cache.HaveCoinInCache(outpoints[i]));
+        BOOST_CHECK(cache.GetCoin(outpoints[i], coin));
+        BOOST_CHECK_EQUAL(coin.out.nValue, (CAmount)(i + 1));
+    }
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), outpoints.size());
+    BOOST_CHECK(cache.DynamicMemoryUsage() > 0);
+
+    // Spend every other coin. FRESH entries must disappear from the cache.
+    for (size_t i = 0; i < outpoints.size(); i += 2) {
+        Coin moved;
+        BOOST_CHECK(cache.SpendCoin(outpoints[i], &moved));
+        BOOST_CHECK_EQUAL(moved.out.nValue, (CAmount)(i + 1));
+        BOOST_CHECK(!cache.HaveCoin(outpoints[i]));
+    }
+
+    // Concurrent readers must all observe a consistent view.
+    {
+        std::atomic<int> failures{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&]() {
+                for (size_t i = 0; i < outpoints.size(); i++) {
+                    Coin coin;
+                    bool expected_unspent = (i % 2) == 1;
+                    if (cache.GetCoin(outpoints[i], coin) != expected_unspent) {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        BOOST_CHECK_EQUAL(failures.load(), 0);
+    }
+
+    // After a flush, a plain cache on the same base must see the same UTXOs.
+    cache.SetBestBlock(InsecureRand256());
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0U);
+    CCoinsViewCache verify(&base);
+    for (size_t i = 0; i < outpoints.size(); i++) {
+        Coin coin;
+        BOOST_CHECK_EQUAL(verify.GetCoin(outpoints[i], coin), (i % 2) == 1);
+        if ((i % 2) == 1) {
+            BOOST_CHECK_EQUAL(coin.out.nValue, (CAmount)(i + 1));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
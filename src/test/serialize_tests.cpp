@@ -264,6 +264,37 @@ BOOST_AUTO_TEST_CASE(vector_bool)
     BOOST_CHECK(SerializeHash(vec1) == SerializeHash(vec2));
 }
 
+BOOST_AUTO_TEST_CASE(vector_byte_blob)
+{
+    // The bulk path for vectors of byte-blob types (see ser_is_byte_blob)
+    // must produce the exact same bytes as element-wise serialization.
+    std::vector<uint256> vec;
+    for (int i = 0; i < 37; i++) {
+        vec.push_back(InsecureRand256());
+    }
+
+    CDataStream ssBulk(SER_DISK, 0);
+    ssBulk << vec;
+
+    CDataStream ssElems(SER_DISK, 0);
+    WriteCompactSize(ssElems, vec.size());
+    for (const auto& hash : vec) {
+        ssElems << hash;
+    }
+    BOOST_CHECK(ssBulk.str() == ssElems.str());
+
+    std::vector<uint256> vec2;
+    ssBulk >> vec2;
+    BOOST_CHECK(vec == vec2);
+
+    // An empty vector roundtrips too
+    CDataStream ssEmpty(SER_DISK, 0);
+    ssEmpty << std::vector<uint256>{};
+    std::vector<uint256> vec3{InsecureRand256()};
+    ssEmpty >> vec3;
+    BOOST_CHECK(vec3.empty());
+}
+
 BOOST_AUTO_TEST_CASE(noncanonical)
 {
     // Write some non-canonical CompactSize encodings, and
@@ -16,6 +16,10 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 static const char DB_COIN = 'C';
 static const char DB_COINS = 'c';
 static const char DB_BLOCK_FILES = 'f';
@@ -30,6 +34,7 @@ static const char DB_HEAD_BLOCKS = 'H';
 static const char DB_FLAG = 'F';
 static const char DB_REINDEX_FLAG = 'R';
 static const char DB_LAST_BLOCK = 'l';
+static const char DB_VERSIONBITS_CACHE = 'v';
 
 namespace {
 
@@ -105,18 +110,37 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
     batch.Erase(DB_BEST_BLOCK);
     batch.Write(DB_HEAD_BLOCKS, Vector(hashBlock, old_tip));
 
-    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end();) {
+    // Collect the dirty entries and sort them to match LevelDB's key order
+    // (bytewise on the serialized key, i.e. on the outpoint hash bytes with
+    // the index as a tie breaker - VARINT encodings compare bytewise in
+    // numeric order). Feeding keys to LevelDB pre-sorted lets the memtable
+    // flush into non-overlapping tables and substantially cuts compaction
+    // work after large flushes. Only iterators are collected, so the extra
+    // memory is a few bytes per dirty entry rather than a copy of the coins.
+    count = mapCoins.size();
+    std::vector<CCoinsMap::iterator> dirty_entries;
+    dirty_entries.reserve(mapCoins.size());
+    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); ++it) {
         if (it->second.flags & CCoinsCacheEntry::DIRTY) {
-            CoinEntry entry(&it->first);
-            if (it->second.coin.IsSpent())
-                batch.Erase(entry);
-            else
-                batch.Write(entry, it->second.coin);
-            changed++;
+            dirty_entries.push_back(it);
         }
-        count++;
-        CCoinsMap::iterator itOld = it++;
-        mapCoins.erase(itOld);
+    }
+    std::sort(dirty_entries.begin(), dirty_entries.end(), [](const CCoinsMap::iterator& a, const CCoinsMap::iterator& b) {
+        int cmp = memcmp(a->first.hash.begin(), b->first.hash.begin(), a->first.hash.size());
+        if (cmp != 0) return cmp < 0;
+        return a->first.n < b->first.n;
+    });
+
+    for (CCoinsMap::iterator it : dirty_entries) {
+        CoinEntry entry(&it->first);
+        if (it->second.coin.IsSpent())
+            batch.Erase(entry);
+        else
+            batch.Write(entry, it->second.coin);
+        changed++;
+        // Erase flushed entries right away so cache memory is released as
+        // sub-batches are written instead of peaking at flush time.
+        mapCoins.erase(it);
         if (batch.SizeEstimate() > batch_size) {
             LogPrint(BCLog::COINDB, "Writing partial batch of %.2f MiB\n", batch.SizeEstimate() * (1.0 / 1048576.0));
             m_db->WriteBatch(batch);
@@ -130,6 +154,7 @@ bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock) {
             }
         }
     }
+    mapCoins.clear();
 
     // In the last batch, mark the database as consistent with hashBlock again.
     batch.Erase(DB_HEAD_BLOCKS);
@@ -303,11 +328,13 @@ bool CBlockTreeDB::EraseAddressIndex(const std::vector<std::pair<CAddressIndexKe
 
 bool CBlockTreeDB::ReadAddressIndex(uint160 addressHash, int type,
                                     std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
-                                    int start, int end) {
+                                    int start, int end, unsigned int startTxindex, size_t maxCount) {
 
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
 
-    if (start > 0 && end > 0) {
+    if (start > 0 && startTxindex > 0) {
+        pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorHeightTxindexKey(type, addressHash, start, startTxindex)));
+    } else if (start > 0) {
         pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorHeightKey(type, addressHash, start)));
     } else {
         pcursor->Seek(std::make_pair(DB_ADDRESSINDEX, CAddressIndexIteratorKey(type, addressHash)));
@@ -319,6 +346,15 @@ bool CBlockTreeDB::ReadAddressIndex(uint160 addressHash, int type,
             if (end > 0 && key.second.blockHeight > end) {
                 break;
             }
+            if (maxCount > 0 && addressIndex.size() >= maxCount) {
+                // Only cut at (height, txindex) boundaries so that a cursor pointing right
+                // behind the last returned entry can neither skip nor duplicate deltas of
+                // the same transaction on the next page.
+                const CAddressIndexKey& last = addressIndex.back().first;
+                if (key.second.blockHeight != last.blockHeight || key.second.txindex != last.txindex) {
+                    break;
+                }
+            }
             CAmount nValue;
             if (pcursor->GetValue(nValue)) {
                 addressIndex.push_back(std::make_pair(key.second, nValue));
@@ -334,6 +370,37 @@ bool CBlockTreeDB::ReadAddressIndex(uint160 addressHash, int type,
     return true;
 }
 
+bool CBlockTreeDB::WriteIndexesForBlock(const std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
+                                        const std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &addressUnspentIndex,
+                                        const std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > &spentIndex,
+                                        const CTimestampIndexKey *timestampIndex) {
+    // All optional index entries for one connected block go into a single
+    // batch so the block connect pays for one LevelDB commit instead of one
+    // per index kind
+    CDBBatch batch(*this);
+    for (const auto& entry : addressIndex) {
+        batch.Write(std::make_pair(DB_ADDRESSINDEX, entry.first), entry.second);
+    }
+    for (const auto& entry : addressUnspentIndex) {
+        if (entry.second.IsNull()) {
+            batch.Erase(std::make_pair(DB_ADDRESSUNSPENTINDEX, entry.first));
+        } else {
+            batch.Write(std::make_pair(DB_ADDRESSUNSPENTINDEX, entry.first), entry.second);
+        }
+    }
+    for (const auto& entry : spentIndex) {
+        if (entry.second.IsNull()) {
+            batch.Erase(std::make_pair(DB_SPENTINDEX, entry.first));
+        } else {
+            batch.Write(std::make_pair(DB_SPENTINDEX, entry.first), entry.second);
+        }
+    }
+    if (timestampIndex != nullptr) {
+        batch.Write(std::make_pair(DB_TIMESTAMPINDEX, *timestampIndex), 0);
+    }
+    return WriteBatch(batch);
+}
+
 bool CBlockTreeDB::WriteTimestampIndex(const CTimestampIndexKey &timestampIndex) {
     CDBBatch batch(*this);
     batch.Write(std::make_pair(DB_TIMESTAMPINDEX, timestampIndex), 0);
@@ -371,6 +438,22 @@ bool CBlockTreeDB::ReadFlag(const std::string &name, bool &fValue) {
     return true;
 }
 
+bool CBlockTreeDB::WriteVersionBitsCache(const uint256& deploymentsHash, const std::vector<std::pair<uint8_t, std::pair<uint256, uint8_t>>>& entries)
+{
+    return Write(DB_VERSIONBITS_CACHE, std::make_pair(deploymentsHash, entries));
+}
+
+bool CBlockTreeDB::ReadVersionBitsCache(const uint256& deploymentsHash, std::vector<std::pair<uint8_t, std::pair<uint256, uint8_t>>>& entries)
+{
+    std::pair<uint256, std::vector<std::pair<uint8_t, std::pair<uint256, uint8_t>>>> data;
+    if (!Read(DB_VERSIONBITS_CACHE, data)) return false;
+    // The entries are keyed by deployment index; discard them if the
+    // deployment table they were flushed under no longer matches.
+    if (data.first != deploymentsHash) return false;
+    entries = std::move(data.second);
+    return true;
+}
+
 bool CBlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex)
 {
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
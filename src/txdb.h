@@ -29,6 +29,8 @@ static const int64_t nDefaultDbBatchSize = 16 << 20;
 static const int64_t nMaxDbCache = sizeof(void*) > 4 ? 16384 : 1024;
 //! min. -dbcache (MiB)
 static const int64_t nMinDbCache = 4;
+//! -dbcachehugepages default
+static const bool fDefaultDbCacheHugePages = false;
 //! Max memory allocated to block tree DB specific cache, if no -txindex (MiB)
 static const int64_t nMaxBlockDBCache = 2;
 //! Max memory allocated to block tree DB specific cache, if -txindex (MiB)
@@ -114,11 +116,17 @@ public:
     bool EraseAddressIndex(const std::vector<std::pair<CAddressIndexKey, CAmount> > &vect);
     bool ReadAddressIndex(uint160 addressHash, int type,
                           std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
-                          int start = 0, int end = 0);
+                          int start = 0, int end = 0, unsigned int startTxindex = 0, size_t maxCount = 0);
     bool WriteTimestampIndex(const CTimestampIndexKey &timestampIndex);
+    bool WriteIndexesForBlock(const std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
+                              const std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &addressUnspentIndex,
+                              const std::vector<std::pair<CSpentIndexKey, CSpentIndexValue> > &spentIndex,
+                              const CTimestampIndexKey *timestampIndex);
     bool ReadTimestampIndex(const unsigned int &high, const unsigned int &low, std::vector<uint256> &vect);
     bool WriteFlag(const std::string &name, bool fValue);
     bool ReadFlag(const std::string &name, bool &fValue);
+    bool WriteVersionBitsCache(const uint256& deploymentsHash, const std::vector<std::pair<uint8_t, std::pair<uint256, uint8_t>>>& entries);
+    bool ReadVersionBitsCache(const uint256& deploymentsHash, std::vector<std::pair<uint8_t, std::pair<uint256, uint8_t>>>& entries);
     bool LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex);
 };
 
@@ -25,6 +25,7 @@
 #include <evo/deterministicmns.h>
 #include <llmq/instantsend.h>
 
+#include <cmath>
 #include <optional>
 
 CTxMemPoolEntry::CTxMemPoolEntry(const CTransactionRef& _tx, const CAmount& _nFee,
@@ -159,18 +160,25 @@ void CTxMemPool::UpdateTransactionsFromBlock(const std::vector<uint256> &vHashes
 
 bool CTxMemPool::CalculateMemPoolAncestors(const CTxMemPoolEntry &entry, setEntries &setAncestors, uint64_t limitAncestorCount, uint64_t limitAncestorSize, uint64_t limitDescendantCount, uint64_t limitDescendantSize, std::string &errString, bool fSearchForParents /* = true */) const
 {
-    setEntries parentHashes;
     const CTransaction &tx = entry.GetTx();
 
+    // Working queue of discovered but not yet processed ancestors. Deduplication is done
+    // via the epoch machinery instead of a staging setEntries, which avoids the O(log n)
+    // lookups and per-node allocations of a set-based walk.
+    std::vector<txiter> staged;
+    bool fCacheable = false;
+
+    const auto epoch = GetFreshEpoch();
+
     if (fSearchForParents) {
         // Get parents of this transaction that are in the mempool
         // GetMemPoolParents() is only valid for entries in the mempool, so we
         // iterate mapTx to find parents.
         for (unsigned int i = 0; i < tx.vin.size(); i++) {
             std::optional<txiter> piter = GetIter(tx.vin[i].prevout.hash);
-            if (piter) {
-                parentHashes.insert(*piter);
-                if (parentHashes.size() + 1 > limitAncestorCount) {
+            if (piter && !visited(*piter)) {
+                staged.push_back(*piter);
+                if (staged.size() + 1 > limitAncestorCount) {
                     errString = strprintf("too many unconfirmed parents [limit: %u]", limitAncestorCount);
                     return false;
                 }
@@ -180,16 +188,46 @@ bool CTxMemPool::CalculateMemPoolAncestors(const CTxMemPoolEntry &entry, setEntr
         // If we're not searching for parents, we require this to be an
         // entry in the mempool already.
         txiter it = mapTx.iterator_to(entry);
-        parentHashes = GetMemPoolParents(it);
+        fCacheable = limitAncestorCount == std::numeric_limits<uint64_t>::max() &&
+                     limitAncestorSize == std::numeric_limits<uint64_t>::max() &&
+                     limitDescendantCount == std::numeric_limits<uint64_t>::max() &&
+                     limitDescendantSize == std::numeric_limits<uint64_t>::max();
+        if (fCacheable) {
+            auto cacheIt = m_ancestor_cache.find(tx.GetHash());
+            if (cacheIt != m_ancestor_cache.end()) {
+                setAncestors = cacheIt->second;
+                return true;
+            }
+        }
+        for (txiter piter : GetMemPoolParents(it)) {
+            visited(piter);
+            staged.push_back(piter);
+        }
+    }
+
+    if (staged.size() == 1) {
+        // With a single in-mempool parent, the ancestors of the new entry are exactly the
+        // parent plus the parent's ancestors, so the cached ancestor aggregates give the
+        // ancestor limits without walking the chain. This catches over-long chains (e.g.
+        // chained CoinJoin denominations) before they cost a full ancestor walk.
+        const txiter parent = staged.front();
+        if (parent->GetCountWithAncestors() + 1 > limitAncestorCount) {
+            errString = strprintf("too many unconfirmed ancestors [limit: %u]", limitAncestorCount);
+            return false;
+        }
+        if (parent->GetSizeWithAncestors() + entry.GetTxSize() > limitAncestorSize) {
+            errString = strprintf("exceeds ancestor size limit [limit: %u]", limitAncestorSize);
+            return false;
+        }
     }
 
     size_t totalSizeWithAncestors = entry.GetTxSize();
 
-    while (!parentHashes.empty()) {
-        txiter stageit = *parentHashes.begin();
+    while (!staged.empty()) {
+        txiter stageit = staged.back();
+        staged.pop_back();
 
         setAncestors.insert(stageit);
-        parentHashes.erase(stageit);
         totalSizeWithAncestors += stageit->GetTxSize();
 
         if (stageit->GetSizeWithDescendants() + entry.GetTxSize() > limitDescendantSize) {
@@ -206,16 +244,20 @@ bool CTxMemPool::CalculateMemPoolAncestors(const CTxMemPoolEntry &entry, setEntr
         const setEntries & setMemPoolParents = GetMemPoolParents(stageit);
         for (txiter phash : setMemPoolParents) {
             // If this is a new ancestor, add it.
-            if (setAncestors.count(phash) == 0) {
-                parentHashes.insert(phash);
+            if (!visited(phash)) {
+                staged.push_back(phash);
             }
-            if (parentHashes.size() + setAncestors.size() + 1 > limitAncestorCount) {
+            if (staged.size() + setAncestors.size() + 1 > limitAncestorCount) {
                 errString = strprintf("too many unconfirmed ancestors [limit: %u]", limitAncestorCount);
                 return false;
             }
         }
     }
 
+    if (fCacheable && !setAncestors.empty()) {
+        m_ancestor_cache.emplace(tx.GetHash(), setAncestors);
+    }
+
     return true;
 }
 
@@ -361,13 +403,74 @@ void CTxMemPool::AddTransactionsUpdated(unsigned int n)
     nTransactionsUpdated += n;
 }
 
+std::shared_ptr<const CTxMemPoolSnapshot> CTxMemPool::GetSnapshot() const
+{
+    LOCK(cs_snapshot);
+    if (m_cached_snapshot && m_cached_snapshot_sequence == nTransactionsUpdated) {
+        return m_cached_snapshot;
+    }
+
+    auto snapshot = std::make_shared<CTxMemPoolSnapshot>();
+    {
+        LOCK(cs);
+        auto iters = GetSortedDepthAndScore();
+        snapshot->entries.reserve(iters.size());
+        for (auto it : iters) {
+            snapshot->txidToEntry.emplace(it->GetTx().GetHash(), snapshot->entries.size());
+            snapshot->entries.push_back(*it);
+        }
+        snapshot->totalTxSize = totalTxSize;
+        snapshot->dynamicUsage = DynamicMemoryUsage();
+        snapshot->minFeeRate = GetMinFee(gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000);
+        snapshot->loaded = m_is_loaded;
+        // note the sequence while cs is still held, so that a concurrent
+        // mempool change cannot be attributed to this snapshot
+        m_cached_snapshot_sequence = nTransactionsUpdated;
+    }
+    m_cached_snapshot = snapshot;
+    return m_cached_snapshot;
+}
+
+size_t CTxMemPool::FeeHistogramBucketFor(CAmount nModFee, size_t nTxSize)
+{
+    const CAmount feePerK = CFeeRate(nModFee, nTxSize).GetFeePerK();
+    if (feePerK < FEE_HISTOGRAM_MIN_FEERATE) {
+        return 0;
+    }
+    const size_t bucket = 1 + static_cast<size_t>(std::log(double(feePerK) / FEE_HISTOGRAM_MIN_FEERATE) / std::log(FEE_HISTOGRAM_GROWTH));
+    return std::min(bucket, FEE_HISTOGRAM_BUCKETS - 1);
+}
+
+CAmount CTxMemPool::FeeHistogramBucketFloor(size_t bucket)
+{
+    if (bucket == 0) {
+        return 0;
+    }
+    return static_cast<CAmount>(FEE_HISTOGRAM_MIN_FEERATE * std::pow(FEE_HISTOGRAM_GROWTH, bucket - 1));
+}
+
+void CTxMemPool::FeeHistogramAdd(CAmount nModFee, size_t nTxSize)
+{
+    auto& bucket = m_fee_histogram[FeeHistogramBucketFor(nModFee, nTxSize)];
+    bucket.count += 1;
+    bucket.bytes += nTxSize;
+}
+
+void CTxMemPool::FeeHistogramRemove(CAmount nModFee, size_t nTxSize)
+{
+    auto& bucket = m_fee_histogram[FeeHistogramBucketFor(nModFee, nTxSize)];
+    assert(bucket.count > 0 && bucket.bytes >= nTxSize);
+    bucket.count -= 1;
+    bucket.bytes -= nTxSize;
+}
+
 void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAncestors, bool validFeeEstimate)
 {
     // Add to memory pool without checking anything.
     // Used by AcceptToMemoryPool(), which DOES do
     // all the appropriate checks.
     indexed_transaction_set::iterator newit = mapTx.insert(entry).first;
-    mapLinks.insert(make_pair(newit, TxLinks()));
+    mapLinks.insert(std::make_pair(newit, TxLinks()));
 
     // Update transaction for any feeDelta created by PrioritiseTransaction
     // TODO: refactor so that the fee delta is calculated before inserting
@@ -377,6 +480,7 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
     if (delta) {
             mapTx.modify(newit, update_fee_delta(delta));
     }
+    FeeHistogramAdd(newit->GetModifiedFee(), newit->GetTxSize());
 
     // Update cachedInnerUsage to include contained transaction's usage.
     // (When we update the entry for in-mempool parents, memory usage will be
@@ -630,6 +734,11 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     for (const CTxIn& txin : it->GetTx().vin)
         mapNextTx.erase(txin.prevout);
 
+    // Removal may shrink remaining ancestor sets and dangle cached iterators
+    m_ancestor_cache.clear();
+
+    FeeHistogramRemove(it->GetModifiedFee(), it->GetTxSize());
+
     RemoveUnbroadcastTx(hash, true /* add logging because unchecked */ );
 
     if (vTxHashes.size() > 1) {
@@ -1010,6 +1119,8 @@ void CTxMemPool::_clear()
     mapNextTx.clear();
     mapProTxAddresses.clear();
     mapProTxPubKeyIDs.clear();
+    m_ancestor_cache.clear();
+    m_fee_histogram.fill(FeeHistogramBucket{});
     totalTxSize = 0;
     cachedInnerUsage = 0;
     lastRollingFeeUpdate = GetTime();
@@ -1340,7 +1451,9 @@ void CTxMemPool::PrioritiseTransaction(const uint256& hash, const CAmount& nFeeD
         delta += nFeeDelta;
         txiter it = mapTx.find(hash);
         if (it != mapTx.end()) {
+            FeeHistogramRemove(it->GetModifiedFee(), it->GetTxSize());
             mapTx.modify(it, update_fee_delta(delta));
+            FeeHistogramAdd(it->GetModifiedFee(), it->GetTxSize());
             // Now update all ancestors' modified fees with descendants
             setEntries setAncestors;
             uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
@@ -1495,6 +1608,16 @@ void CTxMemPool::UpdateChild(txiter entry, txiter child, bool add)
 void CTxMemPool::UpdateParent(txiter entry, txiter parent, bool add)
 {
     AssertLockHeld(cs);
+    // A parent-link change alters the memoized ancestor sets of this entry
+    // and everything below it. Fresh adds have neither a cache entry nor
+    // descendants, so this only does real work for reorg relinking.
+    if (!m_ancestor_cache.empty()) {
+        setEntries descendants;
+        CalculateDescendants(entry, descendants);
+        for (txiter descendantIt : descendants) {
+            m_ancestor_cache.erase(descendantIt->GetTx().GetHash());
+        }
+    }
     setEntries s;
     if (add && mapLinks[entry].parents.insert(parent).second) {
         cachedInnerUsage += memusage::IncrementalDynamicUsage(s);
@@ -6,11 +6,14 @@
 #ifndef BITCOIN_TXMEMPOOL_H
 #define BITCOIN_TXMEMPOOL_H
 
+#include <array>
 #include <atomic>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -26,6 +29,7 @@
 #include <random.h>
 #include <netaddress.h>
 #include <pubkey.h>
+#include <support/allocators/counting.h>
 
 #include <boost/optional.hpp>
 #include <boost/multi_index_container.hpp>
@@ -375,6 +379,42 @@ public:
     }
 };
 
+/**
+ * An immutable copy of the mempool contents plus the derived statistics that
+ * the read-only RPCs report. Snapshots are created by CTxMemPool::GetSnapshot()
+ * and shared between all concurrent readers, so repeated polling (e.g. by
+ * external mining pools) does not contend with transaction acceptance on
+ * CTxMemPool::cs.
+ */
+class CTxMemPoolSnapshot
+{
+public:
+    //! entries in depth-and-score order, as queryHashes() reports them
+    std::vector<CTxMemPoolEntry> entries;
+    //! index into entries by txid
+    std::unordered_map<uint256, size_t, SaltedTxidHasher> txidToEntry;
+
+    //! sum of all mempool tx' byte sizes at snapshot time
+    uint64_t totalTxSize{0};
+    //! DynamicMemoryUsage() of the pool at snapshot time
+    size_t dynamicUsage{0};
+    //! GetMinFee() of the pool at snapshot time
+    CFeeRate minFeeRate;
+    //! IsLoaded() of the pool at snapshot time
+    bool loaded{false};
+
+    bool exists(const uint256& txid) const
+    {
+        return txidToEntry.count(txid) != 0;
+    }
+
+    const CTxMemPoolEntry* GetEntry(const uint256& txid) const
+    {
+        auto it = txidToEntry.find(txid);
+        return it != txidToEntry.end() ? &entries[it->second] : nullptr;
+    }
+};
+
 /**
  * CTxMemPool stores valid-according-to-the-current-best-chain transactions
  * that may be included in the next block.
@@ -466,6 +506,34 @@ private:
 
     bool m_is_loaded GUARDED_BY(cs){false};
 
+    //! cached result of GetSnapshot(), valid while the pool is unchanged
+    mutable Mutex cs_snapshot;
+    mutable std::shared_ptr<const CTxMemPoolSnapshot> m_cached_snapshot GUARDED_BY(cs_snapshot);
+    mutable unsigned int m_cached_snapshot_sequence GUARDED_BY(cs_snapshot){0};
+
+public:
+    //! Feerate histogram parameters: bucket 0 holds everything below the
+    //! minimum boundary, the rest grow geometrically from there. ~80 buckets
+    //! span 1000 duffs/kB to well beyond any realistic feerate.
+    static constexpr size_t FEE_HISTOGRAM_BUCKETS{80};
+    static constexpr CAmount FEE_HISTOGRAM_MIN_FEERATE{1000}; // duffs per kB
+    static constexpr double FEE_HISTOGRAM_GROWTH{1.2};
+
+    struct FeeHistogramBucket {
+        uint64_t count{0};
+        uint64_t bytes{0};
+    };
+
+private:
+    /** Histogram over modified feerates of all mempool entries, maintained on
+     *  add/remove/prioritise so feerate-at-depth style queries are O(buckets)
+     *  instead of a walk over mapTx. */
+    std::array<FeeHistogramBucket, FEE_HISTOGRAM_BUCKETS> m_fee_histogram GUARDED_BY(cs){};
+
+    static size_t FeeHistogramBucketFor(CAmount nModFee, size_t nTxSize);
+    void FeeHistogramAdd(CAmount nModFee, size_t nTxSize) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void FeeHistogramRemove(CAmount nModFee, size_t nTxSize) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
 public:
 
     static const int ROLLING_FEE_HALFLIFE = 60 * 60 * 12; // public only for testing
@@ -494,6 +562,10 @@ public:
                 CompareTxMemPoolEntryByAncestorFee
             >
         >
+#ifdef ENABLE_PERF_TRACKING
+        // count mempool node allocations per site for getmemoryinfo
+        , counting_allocator<CTxMemPoolEntry, alloc_tracking::Site::MEMPOOL_TX>
+#endif
     > indexed_transaction_set;
 
     /**
@@ -550,6 +622,18 @@ private:
     typedef std::map<txiter, TxLinks, CompareIteratorByHash> txlinksMap;
     txlinksMap mapLinks;
 
+    /**
+     * Memoized ancestor sets for the unlimited in-mempool lookup used by the
+     * miner (CalculateMemPoolAncestors with fSearchForParents=false and no
+     * limits). Adding a transaction never changes an existing entry's
+     * ancestor set, so additions keep the cache; any removal may both shrink
+     * ancestor sets and dangle cached iterators, so removals clear it
+     * wholesale. This keeps repeated block template creation from re-walking
+     * ancestor chains (e.g. chained CoinJoin denominations) the mempool
+     * already resolved moments earlier.
+     */
+    mutable std::map<uint256, setEntries> m_ancestor_cache GUARDED_BY(cs);
+
     typedef std::map<CMempoolAddressDeltaKey, CMempoolAddressDelta, CMempoolAddressDeltaKeyCompare> addressDeltaMap;
     addressDeltaMap mapAddress;
 
@@ -630,6 +714,12 @@ public:
     bool isSpent(const COutPoint& outpoint) const;
     unsigned int GetTransactionsUpdated() const;
     void AddTransactionsUpdated(unsigned int n);
+
+    /** Get an immutable snapshot of the mempool contents for read-only
+     *  consumers. The snapshot is rebuilt at most once per mempool change
+     *  (tracked via nTransactionsUpdated) and shared between callers, so
+     *  polling RPCs do not repeatedly contend with ATMP on cs. */
+    std::shared_ptr<const CTxMemPoolSnapshot> GetSnapshot() const;
     /**
      * Check that none of this transactions inputs are in the mempool, and thus
      * the tx is not dependent on other mempool transactions to be included in a block.
@@ -728,6 +818,15 @@ public:
         return totalTxSize;
     }
 
+    /** Lowest feerate (duffs per kB) a histogram bucket covers. */
+    static CAmount FeeHistogramBucketFloor(size_t bucket);
+    /** Copy out the maintained feerate histogram. */
+    std::array<FeeHistogramBucket, FEE_HISTOGRAM_BUCKETS> GetFeeHistogram() const
+    {
+        LOCK(cs);
+        return m_fee_histogram;
+    }
+
     bool exists(const uint256& hash) const
     {
         LOCK(cs);
@@ -68,4 +68,60 @@ public:
     SERIALIZE_METHODS(CBlockUndo, obj) { READWRITE(obj.vtxundo); }
 };
 
+/** Serializes a CBlockUndo in the compact undo layout (written when
+ *  -compressundo is enabled; which layout a block's undo record uses is
+ *  recorded per block via BLOCK_UNDO_COMPRESSED in the block index).
+ *
+ *  Differences from the legacy layout: coin heights are stored as varint
+ *  deltas below the spending block's height (recently created coins dominate
+ *  spends, so the delta is usually 1-2 bytes instead of 3+), and the legacy
+ *  dummy version byte per coin is dropped. */
+class CompactBlockUndo
+{
+private:
+    CBlockUndo* undo{nullptr};
+    const CBlockUndo* undo_const;
+    uint32_t nSpendHeight;
+
+public:
+    CompactBlockUndo(CBlockUndo& undoIn, uint32_t nSpendHeightIn) : undo(&undoIn), undo_const(&undoIn), nSpendHeight(nSpendHeightIn) {}
+    CompactBlockUndo(const CBlockUndo& undoIn, uint32_t nSpendHeightIn) : undo_const(&undoIn), nSpendHeight(nSpendHeightIn) {}
+
+    template<typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ::WriteCompactSize(s, undo_const->vtxundo.size());
+        for (const auto& txundo : undo_const->vtxundo) {
+            ::WriteCompactSize(s, txundo.vprevout.size());
+            for (const Coin& coin : txundo.vprevout) {
+                // coins spent in a block are created at or below its height
+                assert(coin.nHeight <= nSpendHeight);
+                ::Serialize(s, VARINT((nSpendHeight - coin.nHeight) * uint32_t{2} + coin.fCoinBase));
+                ::Serialize(s, Using<TxOutCompression>(coin.out));
+            }
+        }
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s)
+    {
+        assert(undo != nullptr);
+        undo->vtxundo.clear();
+        undo->vtxundo.resize(::ReadCompactSize(s));
+        for (auto& txundo : undo->vtxundo) {
+            txundo.vprevout.resize(::ReadCompactSize(s));
+            for (Coin& coin : txundo.vprevout) {
+                uint32_t nCode = 0;
+                ::Unserialize(s, VARINT(nCode));
+                if ((nCode >> 1) > nSpendHeight) {
+                    throw std::ios_base::failure("CompactBlockUndo: height delta out of range");
+                }
+                coin.nHeight = nSpendHeight - (nCode >> 1);
+                coin.fCoinBase = nCode & 1;
+                ::Unserialize(s, Using<TxOutCompression>(coin.out));
+            }
+        }
+    }
+};
+
 #endif // BITCOIN_UNDO_H
@@ -82,6 +82,7 @@ public:
     bool isObject() const { return (typ == VOBJ); }
 
     bool push_back(const UniValue& val);
+    bool push_back(UniValue&& val);
     bool push_back(const std::string& val_) {
         UniValue tmpVal(VSTR, val_);
         return push_back(tmpVal);
@@ -113,7 +114,9 @@ public:
     bool push_backV(const std::vector<UniValue>& vec);
 
     void __pushKV(const std::string& key, const UniValue& val);
+    void __pushKV(const std::string& key, UniValue&& val);
     bool pushKV(const std::string& key, const UniValue& val);
+    bool pushKV(const std::string& key, UniValue&& val);
     bool pushKV(const std::string& key, const std::string& val_) {
         UniValue tmpVal(VSTR, val_);
         return pushKV(key, tmpVal);
@@ -144,6 +147,13 @@ public:
     }
     bool pushKVs(const UniValue& obj);
 
+    void reserve(size_t n) {
+        if (typ == VOBJ)
+            keys.reserve(n);
+        if (typ == VOBJ || typ == VARR)
+            values.reserve(n);
+    }
+
     std::string write(unsigned int prettyIndent = 0,
                       unsigned int indentLevel = 0) const;
 
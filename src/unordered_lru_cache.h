@@ -37,18 +37,19 @@ public:
     void _emplace(const Key& key, Value2&& v)
     {
         truncate_if_needed();
-        auto it = cacheMap.find(key);
-        if (it == cacheMap.end()) {
-            cacheMap.emplace(key, std::make_pair(std::forward<Value2>(v), accessCounter++));
-        } else {
+        // try_emplace hashes and probes only once for both the insert and the
+        // update case; it leaves v untouched when the key already exists
+        auto [it, inserted] = cacheMap.try_emplace(key, std::forward<Value2>(v), accessCounter);
+        if (!inserted) {
             it->second.first = std::forward<Value2>(v);
-            it->second.second = accessCounter++;
+            it->second.second = accessCounter;
         }
+        accessCounter++;
     }
 
     void emplace(const Key& key, Value&& v)
     {
-        _emplace(key, v);
+        _emplace(key, std::move(v));
     }
 
     void insert(const Key& key, const Value& v)
@@ -92,7 +93,7 @@ private:
     {
         typedef typename MapType::iterator Iterator;
 
-        if (cacheMap.size() <= truncateThreshold) {
+        if (cacheMap.size() <= truncateThreshold || cacheMap.size() <= maxSize) {
             return;
         }
 
@@ -101,8 +102,9 @@ private:
         for (auto it = cacheMap.begin(); it != cacheMap.end(); ++it) {
             vec.emplace_back(it);
         }
-        // sort by last access time (descending order)
-        std::sort(vec.begin(), vec.end(), [](const Iterator& it1, const Iterator& it2) {
+        // partition by last access time (descending order); only the split at
+        // maxSize matters, not the order within the two halves
+        std::nth_element(vec.begin(), vec.begin() + maxSize, vec.end(), [](const Iterator& it1, const Iterator& it2) {
             return it1->second.second > it2->second.second;
         });
 
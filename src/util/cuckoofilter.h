@@ -0,0 +1,129 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_CUCKOOFILTER_H
+#define BITCOIN_UTIL_CUCKOOFILTER_H
+
+#include <random.h>
+#include <uint256.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * A cuckoo filter for approximate set membership (Fan et al., 2014).
+ *
+ * Compared to a bloom filter with the same false positive rate it needs less
+ * space at high load factors and answers lookups with at most two cache-line
+ * accesses. Elements are identified by a uint256 key which is assumed to be
+ * uniformly distributed, e.g. a hash of the actual item.
+ *
+ * This implementation is insert-only. As long as every element of the
+ * underlying set was Insert()ed and IsSaturated() is false, a negative
+ * Contains() answer is authoritative; a positive answer is only "maybe" and
+ * must be confirmed against the underlying data. Not thread safe.
+ */
+class CuckooFilter
+{
+private:
+    static constexpr size_t ENTRIES_PER_BUCKET{4};
+    static constexpr int MAX_KICKS{500};
+
+    //! bucket count, always a power of two
+    size_t nBuckets;
+    //! flat bucket-major fingerprint table, 0 marks an empty slot
+    std::vector<uint16_t> table;
+    //! set when an insertion had to be given up, which invalidates negative answers
+    bool fSaturated{false};
+    FastRandomContext rng;
+
+    static uint16_t Fingerprint(const uint256& key)
+    {
+        uint16_t fp = (uint16_t)(key.GetUint64(1) & 0xffff);
+        // 0 is reserved for empty slots
+        return fp == 0 ? (uint16_t)1 : fp;
+    }
+    size_t Bucket1(const uint256& key) const
+    {
+        return key.GetUint64(0) & (nBuckets - 1);
+    }
+    size_t OtherBucket(size_t bucket, uint16_t fp) const
+    {
+        // partial-key cuckoo hashing: the alternative bucket only depends on
+        // the fingerprint, so it can be recomputed when evicting an entry
+        return (bucket ^ (fp * 0x5bd1e995)) & (nBuckets - 1);
+    }
+    bool BucketInsert(size_t bucket, uint16_t fp)
+    {
+        for (size_t i = 0; i < ENTRIES_PER_BUCKET; i++) {
+            if (table[bucket * ENTRIES_PER_BUCKET + i] == 0) {
+                table[bucket * ENTRIES_PER_BUCKET + i] = fp;
+                return true;
+            }
+        }
+        return false;
+    }
+    bool BucketContains(size_t bucket, uint16_t fp) const
+    {
+        for (size_t i = 0; i < ENTRIES_PER_BUCKET; i++) {
+            if (table[bucket * ENTRIES_PER_BUCKET + i] == fp) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    //! Create a filter able to hold roughly nCapacity elements
+    explicit CuckooFilter(size_t nCapacity)
+    {
+        nBuckets = 1;
+        while (nBuckets * ENTRIES_PER_BUCKET < nCapacity) {
+            nBuckets <<= 1;
+        }
+        table.assign(nBuckets * ENTRIES_PER_BUCKET, 0);
+    }
+
+    void Insert(const uint256& key)
+    {
+        uint16_t fp = Fingerprint(key);
+        size_t bucket1 = Bucket1(key);
+        if (BucketInsert(bucket1, fp)) {
+            return;
+        }
+        size_t bucket2 = OtherBucket(bucket1, fp);
+        if (BucketInsert(bucket2, fp)) {
+            return;
+        }
+        // both buckets are full, evict random entries until a slot frees up
+        size_t bucket = rng.randbool() ? bucket1 : bucket2;
+        for (int i = 0; i < MAX_KICKS; i++) {
+            size_t slot = bucket * ENTRIES_PER_BUCKET + rng.randrange(ENTRIES_PER_BUCKET);
+            std::swap(fp, table[slot]);
+            bucket = OtherBucket(bucket, fp);
+            if (BucketInsert(bucket, fp)) {
+                return;
+            }
+        }
+        fSaturated = true;
+    }
+
+    bool Contains(const uint256& key) const
+    {
+        uint16_t fp = Fingerprint(key);
+        size_t bucket1 = Bucket1(key);
+        if (BucketContains(bucket1, fp)) {
+            return true;
+        }
+        return BucketContains(OtherBucket(bucket1, fp), fp);
+    }
+
+    bool IsSaturated() const
+    {
+        return fSaturated;
+    }
+};
+
+#endif // BITCOIN_UTIL_CUCKOOFILTER_H
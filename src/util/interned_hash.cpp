@@ -0,0 +1,69 @@
+// Copyright (c) 2026 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/interned_hash.h>
+
+#include <sync.h>
+
+#include <map>
+
+namespace {
+
+struct DerefCompare {
+    using is_transparent = void;
+    bool operator()(const uint256* a, const uint256* b) const { return *a < *b; }
+    bool operator()(const uint256* a, const uint256& b) const { return *a < b; }
+    bool operator()(const uint256& a, const uint256* b) const { return a < *b; }
+};
+
+Mutex g_intern_mutex;
+/** All live slots, keyed by their payload (via transparent deref compare) so
+ * lookups can dedup without storing a second copy of the value. The weak_ptr
+ * lets a hit recover shared ownership of the existing slot. */
+std::map<const uint256*, std::weak_ptr<const uint256>, DerefCompare> g_intern_table GUARDED_BY(g_intern_mutex);
+
+void DropInternSlot(const uint256* hash)
+{
+    {
+        LOCK(g_intern_mutex);
+        auto it = g_intern_table.find(*hash);
+        // Only erase our own entry. A concurrent InternSlot() for the same
+        // value may have found this slot already expired and replaced it.
+        if (it != g_intern_table.end() && it->first == hash) {
+            g_intern_table.erase(it);
+        }
+    }
+    delete hash;
+}
+
+std::shared_ptr<const uint256> InternSlot(const uint256& hash)
+{
+    LOCK(g_intern_mutex);
+    auto it = g_intern_table.find(hash);
+    if (it != g_intern_table.end()) {
+        if (auto existing = it->second.lock()) {
+            return existing;
+        }
+        // The last handle to this slot is being destroyed on another thread
+        // right now; replace the dying entry (DropInternSlot skips entries
+        // that don't point at its own slot).
+        g_intern_table.erase(it);
+    }
+    std::shared_ptr<const uint256> slot(new uint256(hash), DropInternSlot);
+    g_intern_table.emplace(slot.get(), slot);
+    return slot;
+}
+
+} // anonymous namespace
+
+InternedHash::InternedHash(const uint256& hash) :
+    m_hash(InternSlot(hash))
+{
+}
+
+const uint256& InternedHash::Get() const
+{
+    static const uint256 null_hash;
+    return m_hash ? *m_hash : null_hash;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_INTERNED_HASH_H
+#define BITCOIN_UTIL_INTERNED_HASH_H
+
+#include <saltedhasher.h>
+#include <uint256.h>
+
+#include <memory>
+#include <string>
+
+/** Handle to a uint256 interned in a process-wide table.
+ *
+ * Hot hashes tend to be stored in many places at once: a txid once per input
+ * in outpoint-keyed maps, an islock hash in several caches, etc. Interning
+ * keeps a single refcounted 32-byte slot per distinct value and hands out
+ * handles, so N copies collapse into one allocation while lookups keep
+ * touching the same cache line. A slot is dropped from the table
+ * automatically when the last handle to it goes away.
+ *
+ * A handle converts implicitly to const uint256& and supports comparison and
+ * salted hashing, so it can replace stored uint256 values (and container
+ * keys) without touching read sites.
+ */
+class InternedHash
+{
+private:
+    std::shared_ptr<const uint256> m_hash;
+
+public:
+    InternedHash() = default;
+    explicit InternedHash(const uint256& hash);
+
+    const uint256& Get() const;
+    operator const uint256&() const { return Get(); }
+
+    bool IsNull() const { return Get().IsNull(); }
+    std::string ToString() const { return Get().ToString(); }
+
+    friend bool operator==(const InternedHash& a, const InternedHash& b)
+    {
+        // equal interned values share a slot, so this is usually a pointer compare
+        return a.m_hash == b.m_hash || a.Get() == b.Get();
+    }
+    friend bool operator!=(const InternedHash& a, const InternedHash& b) { return !(a == b); }
+    friend bool operator==(const InternedHash& a, const uint256& b) { return a.Get() == b; }
+    friend bool operator==(const uint256& a, const InternedHash& b) { return a == b.Get(); }
+    friend bool operator!=(const InternedHash& a, const uint256& b) { return !(a == b); }
+    friend bool operator!=(const uint256& a, const InternedHash& b) { return !(a == b); }
+    friend bool operator<(const InternedHash& a, const InternedHash& b) { return a.Get() < b.Get(); }
+};
+
+template<>
+struct SaltedHasherImpl<InternedHash>
+{
+    static std::size_t CalcHash(const InternedHash& v, uint64_t k0, uint64_t k1)
+    {
+        return SipHashUint256(k0, k1, v.Get());
+    }
+};
+
+#endif // BITCOIN_UTIL_INTERNED_HASH_H
@@ -0,0 +1,71 @@
+// Copyright (c) 2023 The Dash Core developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_MPSCQUEUE_H
+#define BITCOIN_UTIL_MPSCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/**
+ * Unbounded lock-free multi-producer/single-consumer queue.
+ *
+ * Producers push individual items with PushBack(), which costs one CAS and
+ * never blocks other producers or the consumer. The consumer takes the whole
+ * backlog at once with TakeAll(), which detaches the internal list with a
+ * single atomic exchange and returns the items in push order. Multiple
+ * concurrent consumers are not supported (each item would still be returned
+ * exactly once, but ordering guarantees only hold for a single consumer).
+ */
+template <typename T>
+class MPSCQueue
+{
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+    std::atomic<Node*> m_head{nullptr};
+
+public:
+    MPSCQueue() = default;
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+    ~MPSCQueue() { TakeAll(); }
+
+    void PushBack(T&& value)
+    {
+        Node* node = new Node{std::move(value), m_head.load(std::memory_order_relaxed)};
+        while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+    void PushBack(const T& value)
+    {
+        PushBack(T{value});
+    }
+
+    //! Remove and return all queued items, oldest first.
+    std::vector<T> TakeAll()
+    {
+        Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+        std::vector<T> ret;
+        while (node != nullptr) {
+            ret.push_back(std::move(node->value));
+            Node* prev = node;
+            node = node->next;
+            delete prev;
+        }
+        // The internal list is LIFO, so restore push order
+        std::reverse(ret.begin(), ret.end());
+        return ret;
+    }
+
+    bool Empty() const
+    {
+        return m_head.load(std::memory_order_relaxed) == nullptr;
+    }
+};
+
+#endif // BITCOIN_UTIL_MPSCQUEUE_H
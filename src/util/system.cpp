@@ -1109,6 +1109,31 @@ bool FileCommit(FILE *file)
     return true;
 }
 
+/**
+ * this function asks the OS to drop the given file's cached pages from the
+ * page cache; it is advisory only, and the data should be committed to disk
+ * first (see FileCommit) for the eviction to have any effect
+ */
+void EvictFileFromCache(FILE *file)
+{
+#if defined(POSIX_FADV_DONTNEED)
+    posix_fadvise(fileno(file), 0, 0, POSIX_FADV_DONTNEED);
+#else
+    (void)file;
+#endif
+}
+
+void PrefetchFileRange(FILE *file, unsigned int offset, unsigned int length)
+{
+#if defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(fileno(file), offset, length, POSIX_FADV_WILLNEED);
+#else
+    (void)file;
+    (void)offset;
+    (void)length;
+#endif
+}
+
 bool TruncateFile(FILE *file, unsigned int length) {
 #if defined(WIN32)
     return _chsize(_fileno(file), length) == 0;
@@ -72,6 +72,9 @@ bool error(const char* fmt, const Args&... args)
 
 void PrintExceptionContinue(const std::exception_ptr pex, const char* pszExceptionOrigin);
 bool FileCommit(FILE *file);
+void EvictFileFromCache(FILE *file);
+/** Advise the kernel to page in the given range of the file ahead of use. No-op when unsupported. */
+void PrefetchFileRange(FILE *file, unsigned int offset, unsigned int length);
 bool TruncateFile(FILE *file, unsigned int length);
 int RaiseFileDescriptorLimit(int nMinFD);
 void AllocateFileRange(FILE *file, unsigned int offset, unsigned int length);
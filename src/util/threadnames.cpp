@@ -14,6 +14,7 @@
 #endif
 
 #include <util/threadnames.h>
+#include <util/threadpolicy.h>
 
 #ifdef HAVE_SYS_PRCTL_H
 #include <sys/prctl.h> // For prctl, PR_SET_NAME, PR_GET_NAME
@@ -57,6 +58,9 @@ static void SetInternalName(std::string name) { }
 void util::ThreadRename(std::string&& name)
 {
     SetThreadName(("d-" + name).c_str());
+    // Renaming is the one spot every worker thread and pool passes through,
+    // so -threadpolicy affinity/priority is applied here centrally.
+    ApplyThreadPolicy(name);
     SetInternalName(std::move(name));
 }
 
@@ -0,0 +1,171 @@
+// Copyright (c) 2026 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#if defined(HAVE_CONFIG_H)
+#include <config/bitcoin-config.h>
+#endif
+
+#include <util/threadpolicy.h>
+
+#include <logging.h>
+#include <tinyformat.h>
+#include <util/strencodings.h>
+#include <util/string.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+
+#ifndef WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct ThreadPolicy {
+    std::string prefix;
+    std::vector<int> cpus;              //!< empty = leave affinity alone
+    std::optional<int> nice_level;
+    std::optional<int> sched_policy;
+    int sched_priority{0};
+};
+
+//! Set once at startup before threads are spawned, read-only afterwards.
+std::vector<ThreadPolicy> g_thread_policies;
+
+bool ParseCpuList(const std::string& str, std::vector<int>& cpus, std::string& error)
+{
+    if (str.empty()) return true;
+    for (const std::string& part : SplitString(str, ',')) {
+        int lo, hi;
+        const auto dash = part.find('-');
+        if (!ParseInt32(part.substr(0, dash), &lo)) {
+            error = strprintf("Invalid cpu '%s' in -threadpolicy cpu list", part);
+            return false;
+        }
+        hi = lo;
+        if (dash != std::string::npos && !ParseInt32(part.substr(dash + 1), &hi)) {
+            error = strprintf("Invalid cpu range '%s' in -threadpolicy cpu list", part);
+            return false;
+        }
+        if (lo < 0 || hi < lo) {
+            error = strprintf("Invalid cpu range '%s' in -threadpolicy cpu list", part);
+            return false;
+        }
+        for (int cpu = lo; cpu <= hi; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return true;
+}
+
+bool ParseSched(const std::string& str, ThreadPolicy& policy, std::string& error)
+{
+#ifndef WIN32
+    if (str == "other") {
+        policy.sched_policy = SCHED_OTHER;
+        return true;
+    }
+#ifdef SCHED_BATCH
+    if (str == "batch") {
+        policy.sched_policy = SCHED_BATCH;
+        return true;
+    }
+#endif
+    for (const auto& [name, value] : {std::make_pair("fifo", SCHED_FIFO), std::make_pair("rr", SCHED_RR)}) {
+        if (str.rfind(name, 0) == 0) {
+            int prio;
+            if (!ParseInt32(str.substr(strlen(name)), &prio) ||
+                prio < sched_get_priority_min(value) || prio > sched_get_priority_max(value)) {
+                error = strprintf("Invalid priority in -threadpolicy scheduler '%s'", str);
+                return false;
+            }
+            policy.sched_policy = value;
+            policy.sched_priority = prio;
+            return true;
+        }
+    }
+#endif // !WIN32
+    error = strprintf("Unknown -threadpolicy scheduler '%s'", str);
+    return false;
+}
+
+} // anonymous namespace
+
+bool util::InitThreadPolicies(const std::vector<std::string>& specs, std::string& error)
+{
+    g_thread_policies.clear();
+    for (const std::string& spec : specs) {
+        const auto parts = SplitString(spec, ':');
+        if (parts.size() < 2 || parts.size() > 4 || parts[0].empty()) {
+            error = strprintf("Invalid -threadpolicy spec '%s', expected <name-prefix>:<cpulist>[:<nice>[:<sched>]]", spec);
+            return false;
+        }
+        ThreadPolicy policy;
+        policy.prefix = parts[0];
+        if (!ParseCpuList(parts[1], policy.cpus, error)) {
+            return false;
+        }
+        if (parts.size() > 2 && !parts[2].empty()) {
+            int nice_level;
+            if (!ParseInt32(parts[2], &nice_level) || nice_level < -20 || nice_level > 19) {
+                error = strprintf("Invalid niceness in -threadpolicy spec '%s'", spec);
+                return false;
+            }
+            policy.nice_level = nice_level;
+        }
+        if (parts.size() > 3 && !ParseSched(parts[3], policy, error)) {
+            return false;
+        }
+        g_thread_policies.push_back(std::move(policy));
+    }
+    return true;
+}
+
+void util::ApplyThreadPolicy(const std::string& name)
+{
+    if (g_thread_policies.empty()) return;
+    for (const auto& policy : g_thread_policies) {
+        if (name.compare(0, policy.prefix.size(), policy.prefix) != 0) continue;
+#ifndef WIN32
+        if (!policy.cpus.empty()) {
+#ifdef __linux__
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            for (const int cpu : policy.cpus) {
+                CPU_SET(cpu, &cpuset);
+            }
+            if (const int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset)) {
+                LogPrintf("%s: pthread_setaffinity_np failed for thread %s: %s\n", __func__, name, strerror(rc));
+            }
+#endif
+        }
+        if (policy.nice_level) {
+#ifdef __linux__
+            // On Linux setpriority() with the kernel thread id adjusts just
+            // this thread's niceness, not the whole process
+            if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), *policy.nice_level) != 0) {
+                LogPrintf("%s: setpriority failed for thread %s: %s\n", __func__, name, strerror(errno));
+            }
+#endif
+        }
+        if (policy.sched_policy) {
+            sched_param param{};
+            param.sched_priority = policy.sched_priority;
+            if (const int rc = pthread_setschedparam(pthread_self(), *policy.sched_policy, &param)) {
+                LogPrintf("%s: pthread_setschedparam failed for thread %s: %s\n", __func__, name, strerror(rc));
+            }
+        }
+#endif // !WIN32
+        // First matching policy wins
+        break;
+    }
+}
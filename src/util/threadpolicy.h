@@ -0,0 +1,38 @@
+// Copyright (c) 2026 The Dash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_THREADPOLICY_H
+#define BITCOIN_UTIL_THREADPOLICY_H
+
+#include <string>
+#include <vector>
+
+namespace util {
+
+/**
+ * Parse -threadpolicy specs into the global policy table. Must be called
+ * before worker threads are spawned. Each spec has the form
+ *
+ *   <name-prefix>:<cpulist>[:<nice>[:<sched>]]
+ *
+ * where <name-prefix> matches the internal thread name set via ThreadRename
+ * (e.g. "scriptch", "bls-work", "net"), <cpulist> is a taskset-style list
+ * ("2-5,8", empty to leave affinity alone), <nice> is a niceness value and
+ * <sched> is one of "other", "batch", "fifo<prio>" or "rr<prio>".
+ *
+ * Returns false and sets error if a spec is malformed.
+ */
+bool InitThreadPolicies(const std::vector<std::string>& specs, std::string& error);
+
+/**
+ * Apply the first configured policy whose prefix matches the given thread
+ * name to the calling thread. Called automatically from ThreadRename, so
+ * every named thread (and thread pool) picks its policy up centrally.
+ * A no-op when no policy matches or none are configured.
+ */
+void ApplyThreadPolicy(const std::string& name);
+
+} // namespace util
+
+#endif // BITCOIN_UTIL_THREADPOLICY_H
@@ -42,6 +42,7 @@
 #include <undo.h>
 #include <util/check.h> // For NDEBUG compile time check
 #include <util/strencodings.h>
+#include <util/trace.h>
 #include <util/translation.h>
 #include <util/validation.h>
 #include <util/system.h>
@@ -62,8 +63,12 @@
 
 #include <statsd_client.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <list>
 #include <optional>
 #include <string>
+#include <thread>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
@@ -117,6 +122,14 @@ CChain& ChainActive()
     return ::ChainstateActive().m_chain;
 }
 
+//! Published active tip for lock-free readers, see GetChainTipSnapshot()
+static std::atomic<const CBlockIndex*> g_chain_tip_snapshot{nullptr};
+
+const CBlockIndex* GetChainTipSnapshot()
+{
+    return g_chain_tip_snapshot.load(std::memory_order_acquire);
+}
+
 /**
  * Mutex to guard access to validation specific variables, such as reading
  * or changing the chainstate.
@@ -150,6 +163,7 @@ int64_t nMaxTipAge = DEFAULT_MAX_TIP_AGE;
 std::atomic<bool> fDIP0001ActiveAtTip{false};
 
 uint256 hashAssumeValid;
+bool fAssumeChainLocks = false;
 arith_uint256 nMinimumChainWork;
 
 CFeeRate minRelayTxFee = CFeeRate(DEFAULT_MIN_RELAY_TX_FEE);
@@ -406,6 +420,12 @@ static void LimitMempoolSize(CTxMemPool& pool, size_t limit, std::chrono::second
         ::ChainstateActive().CoinsTip().Uncache(removed);
 }
 
+void TrimMempool(CTxMemPool& pool)
+{
+    LOCK2(cs_main, pool.cs);
+    LimitMempoolSize(pool, gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000, std::chrono::hours{gArgs.GetArg("-mempoolexpiry", DEFAULT_MEMPOOL_EXPIRY)});
+}
+
 static bool IsCurrentForFeeEstimation() EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
     AssertLockHeld(cs_main);
@@ -792,9 +812,15 @@ static bool AcceptToMemoryPoolWorker(const CChainParams& chainparams, CTxMemPool
         }
 
         if (!bypass_limits) {
-            LimitMempoolSize(pool, gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000, std::chrono::hours{gArgs.GetArg("-mempoolexpiry", DEFAULT_MEMPOOL_EXPIRY)});
-            if (!pool.exists(hash))
-                return state.Invalid(ValidationInvalidReason::TX_MEMPOOL_POLICY, false, REJECT_INSUFFICIENTFEE, "mempool full");
+            // Eviction is deferred to the scheduled TrimMempool task as long as the pool
+            // stays within a small headroom above the configured limit, so that a burst
+            // of acceptances doesn't pay the full descendant-score eviction cost per tx.
+            const size_t nMempoolLimit = gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000;
+            if (pool.DynamicMemoryUsage() > nMempoolLimit + nMempoolLimit / 20) {
+                LimitMempoolSize(pool, nMempoolLimit, std::chrono::hours{gArgs.GetArg("-mempoolexpiry", DEFAULT_MEMPOOL_EXPIRY)});
+                if (!pool.exists(hash))
+                    return state.Invalid(ValidationInvalidReason::TX_MEMPOOL_POLICY, false, REJECT_INSUFFICIENTFEE, "mempool full");
+            }
         }
     }
 
@@ -866,12 +892,13 @@ bool GetSpentIndex(CTxMemPool& mempool, CSpentIndexKey &key, CSpentIndexValue &v
 }
 
 bool GetAddressIndex(uint160 addressHash, int type,
-                     std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex, int start, int end)
+                     std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex, int start, int end,
+                     unsigned int startTxindex, size_t maxCount)
 {
     if (!fAddressIndex)
         return error("address index not enabled");
 
-    if (!pblocktree->ReadAddressIndex(addressHash, type, addressIndex, start, end))
+    if (!pblocktree->ReadAddressIndex(addressHash, type, addressIndex, start, end, startTxindex, maxCount))
         return error("unable to get txids for address");
 
     return true;
@@ -982,6 +1009,175 @@ bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus
     return true;
 }
 
+//! Budget for the decoded-block LRU cache. Explorer-style RPC/REST workloads
+//! re-read the same recent blocks constantly; 32 MiB covers a good stretch of
+//! typical blocks while worst-case full blocks still leave over a dozen
+//! entries.
+static constexpr size_t MAX_DECODED_BLOCK_CACHE_BYTES{32 * 1024 * 1024};
+
+struct DecodedBlockCacheEntry {
+    std::shared_ptr<const CBlock> block;
+    size_t nSize{0};
+    std::list<uint256>::iterator lruIt;
+};
+
+static Mutex cs_decoded_block_cache;
+//! Most recently used first.
+static std::list<uint256> decodedBlockLru GUARDED_BY(cs_decoded_block_cache);
+static std::unordered_map<uint256, DecodedBlockCacheEntry, BlockHasher> decodedBlockCache GUARDED_BY(cs_decoded_block_cache);
+static size_t decodedBlockCacheUsage GUARDED_BY(cs_decoded_block_cache){0};
+
+std::shared_ptr<const CBlock> ReadCachedBlockFromDisk(const CBlockIndex* pindex, const Consensus::Params& consensusParams, size_t* block_size)
+{
+    const uint256 hash = pindex->GetBlockHash();
+    {
+        LOCK(cs_decoded_block_cache);
+        auto it = decodedBlockCache.find(hash);
+        if (it != decodedBlockCache.end()) {
+            decodedBlockLru.splice(decodedBlockLru.begin(), decodedBlockLru, it->second.lruIt);
+            if (block_size) *block_size = it->second.nSize;
+            return it->second.block;
+        }
+    }
+
+    // Read from disk without holding the lock so a miss doesn't stall
+    // concurrent readers; two readers racing on the same block at worst read
+    // it twice. Block files are immutable, so entries never need invalidation.
+    auto pblock = std::make_shared<CBlock>();
+    if (!ReadBlockFromDisk(*pblock, pindex, consensusParams)) {
+        return nullptr;
+    }
+    const size_t nSize = ::GetSerializeSize(*pblock, PROTOCOL_VERSION);
+    if (block_size) *block_size = nSize;
+
+    LOCK(cs_decoded_block_cache);
+    const auto [it, inserted] = decodedBlockCache.emplace(hash, DecodedBlockCacheEntry{pblock, nSize, decodedBlockLru.end()});
+    if (inserted) {
+        decodedBlockLru.push_front(hash);
+        it->second.lruIt = decodedBlockLru.begin();
+        decodedBlockCacheUsage += nSize;
+        while (decodedBlockCacheUsage > MAX_DECODED_BLOCK_CACHE_BYTES && !decodedBlockLru.empty()) {
+            auto evictIt = decodedBlockCache.find(decodedBlockLru.back());
+            decodedBlockCacheUsage -= evictIt->second.nSize;
+            decodedBlockCache.erase(evictIt);
+            decodedBlockLru.pop_back();
+        }
+    }
+    return pblock;
+}
+
+//! Read and sanity check the meta header preceding a block's serialized data,
+//! reporting the block size it records. filein must be positioned at the meta
+//! header, 8 bytes before the block data.
+static bool ReadRawBlockMetaFromDisk(CAutoFile& filein, uint64_t& block_size, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start)
+{
+    CMessageHeader::MessageStartChars blk_start;
+    unsigned int blk_size;
+
+    filein >> blk_start >> blk_size;
+
+    if (memcmp(blk_start, message_start, CMessageHeader::MESSAGE_START_SIZE)) {
+        return error("%s: Block magic mismatch for %s: %s versus expected %s", __func__, pos.ToString(),
+            HexStr(blk_start), HexStr(message_start));
+    }
+
+    if (blk_size > MAX_SIZE) {
+        return error("%s: Block data is larger than maximum deserialization size for %s: %s versus %s", __func__, pos.ToString(),
+            blk_size, MAX_SIZE);
+    }
+
+    block_size = blk_size;
+    return true;
+}
+
+bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start)
+{
+    FlatFilePos hpos = pos;
+    hpos.nPos -= 8; // Seek back 8 bytes for meta header
+    CAutoFile filein(OpenBlockFile(hpos, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        return error("%s: OpenBlockFile failed for %s", __func__, pos.ToString());
+    }
+
+    try {
+        uint64_t blk_size;
+        if (!ReadRawBlockMetaFromDisk(filein, blk_size, pos, message_start)) {
+            return false;
+        }
+
+        block.resize(blk_size); // Zeroing of memory is intentional here
+        filein.read((char*)block.data(), blk_size);
+    } catch (const std::exception& e) {
+        return error("%s: Read from block file failed: %s for %s", __func__, e.what(), pos.ToString());
+    }
+
+    return true;
+}
+
+bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const CBlockIndex* pindex, const CMessageHeader::MessageStartChars& message_start)
+{
+    FlatFilePos block_pos;
+    {
+        LOCK(cs_main);
+        block_pos = pindex->GetBlockPos();
+    }
+
+    return ReadRawBlockFromDisk(block, block_pos, message_start);
+}
+
+void PrefetchBlockFromDisk(const FlatFilePos& pos)
+{
+    CAutoFile filein(OpenBlockFile(pos, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        return;
+    }
+    // The serialized size is not known without reading the meta header first;
+    // advising the maximum block size instead is harmless, the kernel clamps
+    // the range to the end of the file.
+    PrefetchFileRange(filein.Get(), pos.nPos, MaxBlockSize() + 8);
+}
+
+bool ReadRawBlockSliceFromDisk(std::vector<uint8_t>& slice, uint64_t& block_size, const CBlockIndex* pindex, const CMessageHeader::MessageStartChars& message_start, uint64_t offset, uint64_t length)
+{
+    FlatFilePos pos;
+    {
+        LOCK(cs_main);
+        pos = pindex->GetBlockPos();
+    }
+
+    FlatFilePos hpos = pos;
+    hpos.nPos -= 8; // Seek back 8 bytes for meta header
+    CAutoFile filein(OpenBlockFile(hpos, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        return error("%s: OpenBlockFile failed for %s", __func__, pos.ToString());
+    }
+
+    try {
+        if (!ReadRawBlockMetaFromDisk(filein, block_size, pos, message_start)) {
+            return false;
+        }
+
+        if (offset > block_size || length > block_size - offset) {
+            return error("%s: Slice [%u, +%u) is out of bounds for %s (%u bytes)", __func__,
+                offset, length, pos.ToString(), block_size);
+        }
+        if (length == 0) {
+            slice.clear();
+            return true;
+        }
+
+        if (offset > 0 && fseek(filein.Get(), offset, SEEK_CUR) != 0) {
+            return error("%s: fseek failed for %s", __func__, pos.ToString());
+        }
+        slice.resize(length);
+        filein.read((char*)slice.data(), length);
+    } catch (const std::exception& e) {
+        return error("%s: Read from block file failed: %s for %s", __func__, e.what(), pos.ToString());
+    }
+
+    return true;
+}
+
 double ConvertBitsToDouble(unsigned int nBits)
 {
     int nShift = (nBits >> 24) & 0xff;
@@ -1128,7 +1324,8 @@ CoinsViews::CoinsViews(
 
 void CoinsViews::InitCache()
 {
-    m_cacheview = std::make_unique<CCoinsViewCache>(&m_catcherview);
+    m_cacheview = std::make_unique<CCoinsViewCache>(&m_catcherview,
+                                                    gArgs.GetBoolArg("-dbcachehugepages", fDefaultDbCacheHugePages));
 }
 
 CChainState::CChainState(BlockManager& blockman,
@@ -1334,6 +1531,29 @@ void static ConflictingChainFound(CBlockIndex* pindexNew) EXCLUSIVE_LOCKS_REQUIR
     CheckForkWarningConditions();
 }
 
+//! Bound on the recently-processed hash sets below. A block race only lasts
+//! seconds, so a small window is plenty; the sets are simply dropped once full.
+static constexpr size_t RECENT_BLOCK_HASHES_MAX{4096};
+/** Protects the recently-processed sets. Deliberately not cs_main: their whole
+ *  purpose is answering duplicate announcements without touching it. */
+static Mutex g_recent_blocks_mutex;
+//! Header hash -> index entry for headers accepted by ProcessNewBlockHeaders.
+//! The pointers stay valid as the block index is only torn down by
+//! UnloadBlockIndex, which clears this map.
+static std::map<uint256, const CBlockIndex*> g_recent_block_headers GUARDED_BY(g_recent_blocks_mutex);
+//! Blocks whose data ProcessNewBlock accepted and ran through ActivateBestChain.
+static std::set<uint256> g_recent_full_blocks GUARDED_BY(g_recent_blocks_mutex);
+
+//! Drop the duplicate-announcement filters. Called whenever a block is marked
+//! invalid or conflicting so that a cached "all done" answer can never mask a
+//! validity change, and on UnloadBlockIndex as the index entries go away.
+static void EraseRecentlyProcessedBlocks()
+{
+    LOCK(g_recent_blocks_mutex);
+    g_recent_block_headers.clear();
+    g_recent_full_blocks.clear();
+}
+
 // Same as InvalidChainFound, above, except not called directly from InvalidateBlock,
 // which does its own setBlockIndexCandidates manageent.
 void CChainState::InvalidBlockFound(CBlockIndex *pindex, const CValidationState &state) {
@@ -1344,6 +1564,7 @@ void CChainState::InvalidBlockFound(CBlockIndex *pindex, const CValidationState
         setDirtyBlockIndex.insert(pindex);
         setBlockIndexCandidates.erase(pindex);
         InvalidChainFound(pindex);
+        EraseRecentlyProcessedBlocks();
     }
 }
 
@@ -1358,8 +1579,8 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, CTxUndo &txund
             assert(is_spent);
         }
     }
-    // add outputs
-    AddCoins(inputs, tx, nHeight);
+    // add outputs, accounting cache usage once for the whole transaction
+    inputs.AddCoins(tx, nHeight);
 }
 
 void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, int nHeight)
@@ -1385,6 +1606,21 @@ int GetSpendHeight(const CCoinsViewCache& inputs)
 static CuckooCache::cache<uint256, SignatureCacheHasher> g_scriptExecutionCache;
 static CSHA256 g_scriptExecutionCacheHasher;
 
+// Cumulative probe counters for the getcachestats RPC; relaxed ordering is
+// fine, these are statistics only.
+static std::atomic<uint64_t> g_script_execution_cache_hits{0};
+static std::atomic<uint64_t> g_script_execution_cache_misses{0};
+
+uint64_t ScriptExecutionCacheHits()
+{
+    return g_script_execution_cache_hits.load(std::memory_order_relaxed);
+}
+
+uint64_t ScriptExecutionCacheMisses()
+{
+    return g_script_execution_cache_misses.load(std::memory_order_relaxed);
+}
+
 void InitScriptExecutionCache() {
     // Setup the salted hasher
     uint256 nonce = GetRandHash();
@@ -1393,12 +1629,17 @@ void InitScriptExecutionCache() {
     // just write our 32-byte entropy twice to fill the 64 bytes.
     g_scriptExecutionCacheHasher.Write(nonce.begin(), 32);
     g_scriptExecutionCacheHasher.Write(nonce.begin(), 32);
-    // nMaxCacheSize is unsigned. If -maxsigcachesize is set to zero,
+    // With -maxscriptcachesize this cache is sized independently; without
+    // it, it keeps its historical half share of -maxsigcachesize.
+    int64_t nRequestedSize = gArgs.IsArgSet("-maxscriptcachesize") ?
+        gArgs.GetArg("-maxscriptcachesize", DEFAULT_MAX_SCRIPT_CACHE_SIZE) :
+        gArgs.GetArg("-maxsigcachesize", DEFAULT_MAX_SIG_CACHE_SIZE) / 2;
+    // nMaxCacheSize is unsigned. If the requested size is zero,
     // setup_bytes creates the minimum possible cache (2 elements).
-    size_t nMaxCacheSize = std::min(std::max((int64_t)0, gArgs.GetArg("-maxsigcachesize", DEFAULT_MAX_SIG_CACHE_SIZE) / 2), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
+    size_t nMaxCacheSize = std::min(std::max((int64_t)0, nRequestedSize), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
     size_t nElems = g_scriptExecutionCache.setup_bytes(nMaxCacheSize);
-    LogPrintf("Using %zu MiB out of %zu/2 requested for script execution cache, able to store %zu elements\n",
-            (nElems*sizeof(uint256)) >>20, (nMaxCacheSize*2)>>20, nElems);
+    LogPrintf("Using %zu MiB out of %zu requested for script execution cache, able to store %zu elements\n",
+            (nElems*sizeof(uint256)) >>20, nMaxCacheSize>>20, nElems);
 }
 
 /**
@@ -1446,8 +1687,10 @@ bool CheckInputs(const CTransaction& tx, CValidationState &state, const CCoinsVi
             hasher.Write(tx.GetHash().begin(), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
             AssertLockHeld(cs_main); //TODO: Remove this requirement by making CuckooCache not require external locks
             if (g_scriptExecutionCache.contains(hashCacheEntry, !cacheFullScriptStore)) {
+                g_script_execution_cache_hits.fetch_add(1, std::memory_order_relaxed);
                 return true;
             }
+            g_script_execution_cache_misses.fetch_add(1, std::memory_order_relaxed);
 
             if (!txdata.m_ready) {
                 txdata.Init(tx, {});
@@ -1515,15 +1758,18 @@ bool CheckInputs(const CTransaction& tx, CValidationState &state, const CCoinsVi
     return true;
 }
 
-static bool UndoWriteToDisk(const CBlockUndo& blockundo, FlatFilePos& pos, const uint256& hashBlock, const CMessageHeader::MessageStartChars& messageStart)
+static bool UndoWriteToDisk(const CBlockUndo& blockundo, FlatFilePos& pos, const uint256& hashBlock, uint32_t nSpendHeight, bool fCompact, const CMessageHeader::MessageStartChars& messageStart)
 {
     // Open history file to append
     CAutoFile fileout(OpenUndoFile(pos), SER_DISK, CLIENT_VERSION);
     if (fileout.IsNull())
         return error("%s: OpenUndoFile failed", __func__);
 
+    const CompactBlockUndo compactUndo(blockundo, nSpendHeight);
+
     // Write index header
-    unsigned int nSize = GetSerializeSize(blockundo, fileout.GetVersion());
+    unsigned int nSize = fCompact ? GetSerializeSize(compactUndo, fileout.GetVersion())
+                                  : GetSerializeSize(blockundo, fileout.GetVersion());
     fileout << messageStart << nSize;
 
     // Write undo data
@@ -1531,12 +1777,17 @@ static bool UndoWriteToDisk(const CBlockUndo& blockundo, FlatFilePos& pos, const
     if (fileOutPos < 0)
         return error("%s: ftell failed", __func__);
     pos.nPos = (unsigned int)fileOutPos;
-    fileout << blockundo;
 
     // calculate & write checksum
     CHashWriter hasher(SER_GETHASH, PROTOCOL_VERSION);
     hasher << hashBlock;
-    hasher << blockundo;
+    if (fCompact) {
+        fileout << compactUndo;
+        hasher << compactUndo;
+    } else {
+        fileout << blockundo;
+        hasher << blockundo;
+    }
     fileout << hasher.GetHash();
 
     return true;
@@ -1559,7 +1810,12 @@ bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex)
     CHashVerifier<CAutoFile> verifier(&filein); // We need a CHashVerifier as reserializing may lose data
     try {
         verifier << pindex->pprev->GetBlockHash();
-        verifier >> blockundo;
+        if (pindex->nStatus & BLOCK_UNDO_COMPRESSED) {
+            CompactBlockUndo compactUndo(blockundo, pindex->nHeight);
+            verifier >> compactUndo;
+        } else {
+            verifier >> blockundo;
+        }
         filein >> hashChecksum;
     }
     catch (const std::exception& e) {
@@ -1629,7 +1885,7 @@ int ApplyTxInUndo(Coin&& undo, CCoinsViewCache& view, const COutPoint& out)
 
 /** Undo the effects of this block (with given index) on the UTXO set represented by coins.
  *  When FAILED is returned, view is left in an indeterminate state. */
-DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view)
+DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CBlockUndo* pblockUndo)
 {
     AssertLockHeld(cs_main);
     assert(m_quorum_block_processor);
@@ -1645,11 +1901,15 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
 
     bool fClean = true;
 
-    CBlockUndo blockUndo;
-    if (!UndoReadFromDisk(blockUndo, pindex)) {
-        error("DisconnectBlock(): failure reading undo data");
-        return DISCONNECT_FAILED;
+    CBlockUndo blockUndoStorage;
+    if (pblockUndo == nullptr) {
+        if (!UndoReadFromDisk(blockUndoStorage, pindex)) {
+            error("DisconnectBlock(): failure reading undo data");
+            return DISCONNECT_FAILED;
+        }
+        pblockUndo = &blockUndoStorage;
     }
+    CBlockUndo& blockUndo = *pblockUndo;
 
     if (blockUndo.vtxundo.size() + 1 != block.vtx.size()) {
         error("DisconnectBlock(): block and undo data inconsistent");
@@ -1664,6 +1924,14 @@ DisconnectResult CChainState::DisconnectBlock(const CBlock& block, const CBlockI
         return DISCONNECT_FAILED;
     }
 
+    // Restoring the spent coins inserts up to one cache entry per input; size
+    // the map for the whole block up front instead of growing it piecemeal.
+    size_t nCoinsToRestore{0};
+    for (const auto& txu : blockUndo.vtxundo) {
+        nCoinsToRestore += txu.vprevout.size();
+    }
+    view.Reserve(nCoinsToRestore);
+
     // undo transactions in reverse order
     for (int i = block.vtx.size() - 1; i >= 0; i--) {
         const CTransaction &tx = *(block.vtx[i]);
@@ -1811,6 +2079,15 @@ static void FlushUndoFile(int block_file, bool finalize = false)
     if (!UndoFileSeq().Flush(undo_pos_old, finalize)) {
         AbortNode("Flushing undo file to disk failed. This is likely the result of an I/O error.");
     }
+    if (finalize) {
+        // Undo data is only read again on a reorg. Once the file is complete
+        // and synced, drop its pages so they don't compete with the coins
+        // cache flushes for page cache while blocks keep streaming in.
+        if (FILE* file = UndoFileSeq().Open(FlatFilePos(block_file, 0), true)) {
+            EvictFileFromCache(file);
+            fclose(file);
+        }
+    }
 }
 
 static void FlushBlockFile(bool fFinalize = false, bool finalize_undo = false)
@@ -1831,11 +2108,17 @@ static bool WriteUndoDataForBlock(const CBlockUndo& blockundo, CValidationState&
 {
     // Write undo information to disk
     if (pindex->GetUndoPos().IsNull()) {
+        const bool fCompact = gArgs.GetBoolArg("-compressundo", DEFAULT_COMPRESS_UNDO);
+        const size_t nUndoSize = fCompact ? ::GetSerializeSize(CompactBlockUndo(blockundo, pindex->nHeight), CLIENT_VERSION)
+                                          : ::GetSerializeSize(blockundo, CLIENT_VERSION);
         FlatFilePos _pos;
-        if (!FindUndoPos(state, pindex->nFile, _pos, ::GetSerializeSize(blockundo, CLIENT_VERSION) + 40))
+        if (!FindUndoPos(state, pindex->nFile, _pos, nUndoSize + 40))
             return error("ConnectBlock(): FindUndoPos failed");
-        if (!UndoWriteToDisk(blockundo, _pos, pindex->pprev->GetBlockHash(), chainparams.MessageStart()))
+        if (!UndoWriteToDisk(blockundo, _pos, pindex->pprev->GetBlockHash(), pindex->nHeight, fCompact, chainparams.MessageStart()))
             return AbortNode(state, "Failed to write undo data");
+        if (fCompact) {
+            pindex->nStatus |= BLOCK_UNDO_COMPRESSED;
+        }
         // rev files are written in block height order, whereas blk files are written as blocks come in (often out of order)
         // we want to flush the rev (undo) file once we've written the last block, which is indicated by the last height
         // in the block file info as below; note that this does not catch the case where the undo writes are keeping up
@@ -1868,6 +2151,62 @@ void StopScriptCheckWorkerThreads()
 
 VersionBitsCache versionbitscache GUARDED_BY(cs_main);
 
+/**
+ * Digest of the deployment table the cached states were computed under. The
+ * on-disk entries are keyed by raw deployment index, which shifts when a
+ * deployment is buried, and a state is only valid for the exact parameters it
+ * was evaluated with - so a cache flushed by a different deployment table must
+ * be thrown away rather than restored.
+ */
+static uint256 VersionBitsDeploymentsHash(const Consensus::Params& params)
+{
+    CHashWriter ss(SER_GETHASH, 0);
+    for (int b = 0; b < Consensus::MAX_VERSION_BITS_DEPLOYMENTS; b++) {
+        const Consensus::BIP9Deployment& dep = params.vDeployments[b];
+        ss << uint8_t(b) << dep.bit << dep.nStartTime << dep.nTimeout
+           << dep.nWindowSize << dep.nThresholdStart << dep.nThresholdMin << dep.nFalloffCoeff;
+    }
+    return ss.GetHash();
+}
+
+/**
+ * Persist the versionbits threshold states to the block tree DB so a restart
+ * does not redo the full header-chain walk to rebuild them. Entries are keyed
+ * by block hash on disk; states are deterministic per block, so restoring
+ * entries for blocks still present in the index is always safe - as long as
+ * the deployment table is unchanged, which the stored digest guards.
+ */
+static void FlushVersionBitsCache(CBlockTreeDB& blocktree) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+{
+    std::vector<std::pair<uint8_t, std::pair<uint256, uint8_t>>> entries;
+    for (int b = 0; b < Consensus::MAX_VERSION_BITS_DEPLOYMENTS; b++) {
+        for (const auto& [pindex, state] : versionbitscache.caches[b]) {
+            if (pindex == nullptr) continue;
+            entries.emplace_back(uint8_t(b), std::make_pair(pindex->GetBlockHash(), uint8_t(state)));
+        }
+    }
+    blocktree.WriteVersionBitsCache(VersionBitsDeploymentsHash(Params().GetConsensus()), entries);
+}
+
+static void LoadVersionBitsCache(CBlockTreeDB& blocktree) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+{
+    std::vector<std::pair<uint8_t, std::pair<uint256, uint8_t>>> entries;
+    if (!blocktree.ReadVersionBitsCache(VersionBitsDeploymentsHash(Params().GetConsensus()), entries)) {
+        LogPrintf("%s: no versionbits cache restored (missing or stale deployment table)\n", __func__);
+        return;
+    }
+    size_t restored = 0;
+    for (const auto& [bit, entry] : entries) {
+        if (bit >= Consensus::MAX_VERSION_BITS_DEPLOYMENTS) continue;
+        if (entry.second > uint8_t(ThresholdState::FAILED)) continue;
+        const CBlockIndex* pindex = LookupBlockIndex(entry.first);
+        if (pindex == nullptr) continue;
+        versionbitscache.caches[bit].emplace(pindex, ThresholdState(entry.second));
+        restored++;
+    }
+    LogPrintf("%s: restored %u versionbits cache entries\n", __func__, restored);
+}
+
 int32_t ComputeBlockVersion(const CBlockIndex* pindexPrev, const Consensus::Params& params, bool fCheckMasternodesUpgraded)
 {
     LOCK(cs_main);
@@ -2071,6 +2410,16 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
         }
     }
 
+    if (fScriptChecks && fAssumeChainLocks && m_clhandler->HasChainLock(pindex->nHeight, block_hash)) {
+        // This block is covered by a chainlock whose quorum signature we verified,
+        // i.e. the network has already reached finality on it. With -assumechainlocks
+        // the chainlock is treated like assumevalid and script verification is
+        // skipped; all other consensus checks still run. This mainly helps
+        // -reindex-chainstate replays, which become IO-bound once the current
+        // chainlock is received.
+        fScriptChecks = false;
+    }
+
     int64_t nTime1 = GetTimeMicros(); nTimeCheck += nTime1 - nTimeStart;
     LogPrint(BCLog::BENCHMARK, "    - Sanity checks: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime1 - nTimeStart), nTimeCheck * MICRO, nTimeCheck * MILLI / nBlocksTotal);
 
@@ -2165,7 +2514,6 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     for (unsigned int i = 0; i < block.vtx.size(); i++)
     {
         const CTransaction &tx = *(block.vtx[i]);
-        const uint256 txhash = tx.GetHash();
 
         nInputs += tx.vin.size();
 
@@ -2200,12 +2548,74 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
                 return state.Invalid(ValidationInvalidReason::CONSENSUS, error("%s: contains a non-BIP68-final transaction", __func__), REJECT_INVALID, "bad-txns-nonfinal");
             }
 
-            if (fAddressIndex || fSpentIndex)
-            {
+        }
+
+        // GetTransactionSigOpCount counts 2 types of sigops:
+        // * legacy (always)
+        // * p2sh (when P2SH enabled in flags and excludes coinbase)
+        nSigOps += GetTransactionSigOpCount(tx, view, flags);
+        if (nSigOps > MaxBlockSigOps(fDIP0001Active_context)) {
+            return state.Invalid(ValidationInvalidReason::CONSENSUS, error("ConnectBlock(): too many sigops"), REJECT_INVALID, "bad-blk-sigops");
+        }
+
+        if (!tx.IsCoinBase())
+        {
+
+            std::vector<CScriptCheck> vChecks;
+            bool fCacheResults = fJustCheck; /* Don't cache results if we're actually connecting blocks (still consult the cache, though) */
+            if (fScriptChecks && !CheckInputs(tx, state, view, fScriptChecks, flags, fCacheResults, fCacheResults, txsdata[i], g_parallel_script_checks ? &vChecks : nullptr)) {
+                if (state.GetReason() == ValidationInvalidReason::TX_NOT_STANDARD) {
+                    // CheckInputs may return NOT_STANDARD for extra flags we passed,
+                    // but we can't return that, as it's not defined for a block, so
+                    // we reset the reason flag to CONSENSUS here.
+                    // In the event of a future soft-fork, we may need to
+                    // consider whether rewriting to CONSENSUS or
+                    // RECENT_CONSENSUS_CHANGE would be more appropriate.
+                    state.Invalid(ValidationInvalidReason::CONSENSUS, false,
+                              state.GetRejectCode(), state.GetRejectReason(), state.GetDebugMessage());
+                }
+                return error("ConnectBlock(): CheckInputs on %s failed with %s",
+                    tx.GetHash().ToString(), FormatStateMessage(state));
+            }
+            control.Add(vChecks);
+        }
+
+        CTxUndo undoDummy;
+        if (i > 0) {
+            blockundo.vtxundo.push_back(CTxUndo());
+        }
+        UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), pindex->nHeight);
+    }
+    int64_t nTime3 = GetTimeMicros(); nTimeConnect += nTime3 - nTime2;
+    LogPrint(BCLog::BENCHMARK, "      - Connect %u transactions: %.2fms (%.3fms/tx, %.3fms/txin) [%.2fs (%.2fms/blk)]\n", (unsigned)block.vtx.size(), MILLI * (nTime3 - nTime2), MILLI * (nTime3 - nTime2) / block.vtx.size(), nInputs <= 1 ? 0 : MILLI * (nTime3 - nTime2) / (nInputs-1), nTimeConnect * MICRO, nTimeConnect * MILLI / nBlocksTotal);
+
+    // All script checks for the block have been dispatched to the checkqueue at
+    // this point. Build the optional address/spent index entries now so that
+    // this (potentially large) chunk of serial bookkeeping overlaps with the
+    // script verification threads instead of delaying their dispatch. Spent
+    // prevouts are no longer available in the view here (UpdateCoins erased
+    // them), so they are read back from the undo data collected above.
+    if (fAddressIndex || fSpentIndex) {
+        size_t nTotalOut = 0;
+        for (const auto& tx : block.vtx) {
+            nTotalOut += tx->vout.size();
+        }
+        if (fAddressIndex) {
+            addressIndex.reserve(nInputs + nTotalOut);
+            addressUnspentIndex.reserve(nInputs + nTotalOut);
+        }
+        if (fSpentIndex) {
+            spentIndex.reserve(nInputs);
+        }
+        for (unsigned int i = 0; i < block.vtx.size(); i++) {
+            const CTransaction& tx = *(block.vtx[i]);
+            const uint256 txhash = tx.GetHash();
+
+            if (!tx.IsCoinBase()) {
+                const CTxUndo& txundo = blockundo.vtxundo[i - 1];
                 for (size_t j = 0; j < tx.vin.size(); j++) {
-                    const CTxIn input = tx.vin[j];
-                    const Coin& coin = view.AccessCoin(tx.vin[j].prevout);
-                    const CTxOut &prevout = coin.out;
+                    const CTxIn& input = tx.vin[j];
+                    const CTxOut& prevout = txundo.vprevout[j].out;
                     uint160 hashBytes;
                     int addressType;
 
@@ -2237,82 +2647,42 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
                         spentIndex.push_back(std::make_pair(CSpentIndexKey(input.prevout.hash, input.prevout.n), CSpentIndexValue(txhash, j, pindex->nHeight, prevout.nValue, addressType, hashBytes)));
                     }
                 }
-
             }
 
-        }
+            if (fAddressIndex) {
+                for (unsigned int k = 0; k < tx.vout.size(); k++) {
+                    const CTxOut &out = tx.vout[k];
 
-        // GetTransactionSigOpCount counts 2 types of sigops:
-        // * legacy (always)
-        // * p2sh (when P2SH enabled in flags and excludes coinbase)
-        nSigOps += GetTransactionSigOpCount(tx, view, flags);
-        if (nSigOps > MaxBlockSigOps(fDIP0001Active_context)) {
-            return state.Invalid(ValidationInvalidReason::CONSENSUS, error("ConnectBlock(): too many sigops"), REJECT_INVALID, "bad-blk-sigops");
-        }
-
-        if (!tx.IsCoinBase())
-        {
-
-            std::vector<CScriptCheck> vChecks;
-            bool fCacheResults = fJustCheck; /* Don't cache results if we're actually connecting blocks (still consult the cache, though) */
-            if (fScriptChecks && !CheckInputs(tx, state, view, fScriptChecks, flags, fCacheResults, fCacheResults, txsdata[i], g_parallel_script_checks ? &vChecks : nullptr)) {
-                if (state.GetReason() == ValidationInvalidReason::TX_NOT_STANDARD) {
-                    // CheckInputs may return NOT_STANDARD for extra flags we passed,
-                    // but we can't return that, as it's not defined for a block, so
-                    // we reset the reason flag to CONSENSUS here.
-                    // In the event of a future soft-fork, we may need to
-                    // consider whether rewriting to CONSENSUS or
-                    // RECENT_CONSENSUS_CHANGE would be more appropriate.
-                    state.Invalid(ValidationInvalidReason::CONSENSUS, false,
-                              state.GetRejectCode(), state.GetRejectReason(), state.GetDebugMessage());
-                }
-                return error("ConnectBlock(): CheckInputs on %s failed with %s",
-                    tx.GetHash().ToString(), FormatStateMessage(state));
-            }
-            control.Add(vChecks);
-        }
-
-        if (fAddressIndex) {
-            for (unsigned int k = 0; k < tx.vout.size(); k++) {
-                const CTxOut &out = tx.vout[k];
+                    if (out.scriptPubKey.IsPayToScriptHash()) {
+                        std::vector<unsigned char> hashBytes(out.scriptPubKey.begin()+2, out.scriptPubKey.begin()+22);
 
-                if (out.scriptPubKey.IsPayToScriptHash()) {
-                    std::vector<unsigned char> hashBytes(out.scriptPubKey.begin()+2, out.scriptPubKey.begin()+22);
+                        // record receiving activity
+                        addressIndex.push_back(std::make_pair(CAddressIndexKey(2, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
 
-                    // record receiving activity
-                    addressIndex.push_back(std::make_pair(CAddressIndexKey(2, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
+                        // record unspent output
+                        addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(2, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
 
-                    // record unspent output
-                    addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(2, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
+                    } else if (out.scriptPubKey.IsPayToPublicKeyHash()) {
+                        std::vector<unsigned char> hashBytes(out.scriptPubKey.begin()+3, out.scriptPubKey.begin()+23);
 
-                } else if (out.scriptPubKey.IsPayToPublicKeyHash()) {
-                    std::vector<unsigned char> hashBytes(out.scriptPubKey.begin()+3, out.scriptPubKey.begin()+23);
+                        // record receiving activity
+                        addressIndex.push_back(std::make_pair(CAddressIndexKey(1, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
 
-                    // record receiving activity
-                    addressIndex.push_back(std::make_pair(CAddressIndexKey(1, uint160(hashBytes), pindex->nHeight, i, txhash, k, false), out.nValue));
+                        // record unspent output
+                        addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(1, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
 
-                    // record unspent output
-                    addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(1, uint160(hashBytes), txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
+                    } else if (out.scriptPubKey.IsPayToPublicKey()) {
+                        uint160 hashBytes(Hash160(out.scriptPubKey.begin()+1, out.scriptPubKey.end()-1));
+                        addressIndex.push_back(std::make_pair(CAddressIndexKey(1, hashBytes, pindex->nHeight, i, txhash, k, false), out.nValue));
+                        addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(1, hashBytes, txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
+                    } else {
+                        continue;
+                    }
 
-                } else if (out.scriptPubKey.IsPayToPublicKey()) {
-                    uint160 hashBytes(Hash160(out.scriptPubKey.begin()+1, out.scriptPubKey.end()-1));
-                    addressIndex.push_back(std::make_pair(CAddressIndexKey(1, hashBytes, pindex->nHeight, i, txhash, k, false), out.nValue));
-                    addressUnspentIndex.push_back(std::make_pair(CAddressUnspentKey(1, hashBytes, txhash, k), CAddressUnspentValue(out.nValue, out.scriptPubKey, pindex->nHeight)));
-                } else {
-                    continue;
                 }
-
             }
         }
-
-        CTxUndo undoDummy;
-        if (i > 0) {
-            blockundo.vtxundo.push_back(CTxUndo());
-        }
-        UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), pindex->nHeight);
     }
-    int64_t nTime3 = GetTimeMicros(); nTimeConnect += nTime3 - nTime2;
-    LogPrint(BCLog::BENCHMARK, "      - Connect %u transactions: %.2fms (%.3fms/tx, %.3fms/txin) [%.2fs (%.2fms/blk)]\n", (unsigned)block.vtx.size(), MILLI * (nTime3 - nTime2), MILLI * (nTime3 - nTime2) / block.vtx.size(), nInputs <= 1 ? 0 : MILLI * (nTime3 - nTime2) / (nInputs-1), nTimeConnect * MICRO, nTimeConnect * MILLI / nBlocksTotal);
 
     if (!control.Wait())
         return state.Invalid(ValidationInvalidReason::CONSENSUS, error("%s: CheckQueue failed", __func__), REJECT_INVALID, "block-validation-failed");
@@ -2393,24 +2763,14 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
         setDirtyBlockIndex.insert(pindex);
     }
 
-    if (fAddressIndex) {
-        if (!pblocktree->WriteAddressIndex(addressIndex)) {
-            return AbortNode(state, "Failed to write address index");
-        }
-
-        if (!pblocktree->UpdateAddressUnspentIndex(addressUnspentIndex)) {
-            return AbortNode(state, "Failed to write address unspent index");
+    if (fAddressIndex || fSpentIndex || fTimestampIndex) {
+        const CTimestampIndexKey timestampIndex(pindex->nTime, pindex->GetBlockHash());
+        if (!pblocktree->WriteIndexesForBlock(addressIndex, addressUnspentIndex, spentIndex,
+                                              fTimestampIndex ? &timestampIndex : nullptr)) {
+            return AbortNode(state, "Failed to write address/spent index");
         }
     }
 
-    if (fSpentIndex)
-        if (!pblocktree->UpdateSpentIndex(spentIndex))
-            return AbortNode(state, "Failed to write transaction index");
-
-    if (fTimestampIndex)
-        if (!pblocktree->WriteTimestampIndex(CTimestampIndexKey(pindex->nTime, pindex->GetBlockHash())))
-            return AbortNode(state, "Failed to write timestamp index");
-
     assert(pindex->phashBlock);
     // add this block to the view's block chain
     view.SetBestBlock(pindex->GetBlockHash());
@@ -2432,6 +2792,15 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     statsClient.gauge("blocks.tip.NumTransactions", block.vtx.size(), 1.0f);
     statsClient.gauge("blocks.tip.SigOps", nSigOps, 1.0f);
 
+    TRACE6(validation, block_connected,
+        pindex->GetBlockHash().data(),
+        pindex->nHeight,
+        block.vtx.size(),
+        nInputs,
+        nSigOps,
+        GetTimeMicros() - nTimeStart // in microseconds (µs)
+    );
+
     return true;
 }
 
@@ -2517,15 +2886,15 @@ bool CChainState::FlushStateToDisk(
             nLastFlush = nNow;
         }
         // The cache is large and we're within 10% and 10 MiB of the limit, but we have time now (not in the middle of a block processing).
-        bool fCacheLarge = mode == FlushStateMode::PERIODIC && cache_state >= CoinsCacheSizeState::LARGE;
+        bool fCacheLarge = (mode == FlushStateMode::PERIODIC || mode == FlushStateMode::BACKGROUND) && cache_state >= CoinsCacheSizeState::LARGE;
         // The cache is over the limit, we have to write now.
         bool fCacheCritical = mode == FlushStateMode::IF_NEEDED && cache_state >= CoinsCacheSizeState::CRITICAL;
         // The evodb cache is too large
         bool fEvoDbCacheCritical = mode == FlushStateMode::IF_NEEDED && m_evoDb != nullptr && m_evoDb->GetMemoryUsage() >= (64 << 20);
         // It's been a while since we wrote the block index to disk. Do this frequently, so we don't need to redownload after a crash.
-        bool fPeriodicWrite = mode == FlushStateMode::PERIODIC && nNow > nLastWrite + DATABASE_WRITE_INTERVAL;
+        bool fPeriodicWrite = (mode == FlushStateMode::PERIODIC || mode == FlushStateMode::BACKGROUND) && nNow > nLastWrite + DATABASE_WRITE_INTERVAL;
         // It's been very long since we flushed the cache. Do this infrequently, to optimize cache usage.
-        bool fPeriodicFlush = mode == FlushStateMode::PERIODIC && nNow > nLastFlush + DATABASE_FLUSH_INTERVAL;
+        bool fPeriodicFlush = (mode == FlushStateMode::PERIODIC || mode == FlushStateMode::BACKGROUND) && nNow > nLastFlush + DATABASE_FLUSH_INTERVAL;
         // Combine all conditions that result in a full cache flush.
         fDoFullFlush = (mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical || fEvoDbCacheCritical || fPeriodicFlush || fFlushForPrune;
         // Write blocks and block index to disk.
@@ -2561,6 +2930,7 @@ bool CChainState::FlushStateToDisk(
                 if (!pblocktree->WriteBatchSync(vFiles, nLastBlockFile, vBlocks)) {
                     return AbortNode(state, "Failed to write to block index database");
                 }
+                FlushVersionBitsCache(*pblocktree);
             }
             // Finally remove any pruned files
             if (fFlushForPrune) {
@@ -2645,6 +3015,13 @@ void static UpdateTip(CTxMemPool& mempool, const CBlockIndex *pindexNew, const C
     // New best block
     mempool.AddTransactionsUpdated(1);
 
+    // Republish the lock-free tip snapshot. SetTip already ran, so comparing
+    // against the active chain's tip keeps background chainstates from
+    // clobbering the published view.
+    if (::ChainActive().Tip() == pindexNew) {
+        g_chain_tip_snapshot.store(pindexNew, std::memory_order_release);
+    }
+
     {
         LOCK(g_best_block_mutex);
         g_best_block = pindexNew->GetBlockHash();
@@ -2688,6 +3065,44 @@ void static UpdateTip(CTxMemPool& mempool, const CBlockIndex *pindexNew, const C
       !warningMessages.empty() ? strprintf(" warning='%s'", warningMessages) : "");
 }
 
+/** Reads the block and undo data of a known disconnect path ahead of the
+  * serial DisconnectTip loop, so that the loop finds it in the OS page cache
+  * instead of waiting on disk for every block. Reads are purely advisory:
+  * failures are ignored here and surface in DisconnectTip when the data is
+  * actually needed. Only immutable block index fields are touched, so the
+  * reader needs no locks. */
+class CBlockDisconnectPrefetcher
+{
+private:
+    std::vector<const CBlockIndex*> m_indexes; //!< in disconnect (tip first) order
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+
+public:
+    CBlockDisconnectPrefetcher(std::vector<const CBlockIndex*> indexes, const Consensus::Params& consensus_params) :
+        m_indexes(std::move(indexes))
+    {
+        m_thread = std::thread([this, params = &consensus_params]() {
+            for (const CBlockIndex* pindex : m_indexes) {
+                if (m_stop) return;
+                CBlock block;
+                ReadBlockFromDisk(block, pindex, *params);
+                if (m_stop) return;
+                if (!pindex->GetUndoPos().IsNull()) {
+                    CBlockUndo undo;
+                    UndoReadFromDisk(undo, pindex);
+                }
+            }
+        });
+    }
+
+    ~CBlockDisconnectPrefetcher()
+    {
+        m_stop = true;
+        m_thread.join();
+    }
+};
+
 /** Disconnect m_chain's tip.
   * After calling, the mempool will be in an inconsistent state, with
   * transactions from disconnected blocks being added to disconnectpool.  You
@@ -2958,6 +3373,20 @@ bool CChainState::ActivateBestChainStep(CValidationState& state, const CChainPar
     const CBlockIndex *pindexOldTip = m_chain.Tip();
     const CBlockIndex *pindexFork = m_chain.FindFork(pindexMostWork);
 
+    // Once the fork point is known the whole disconnect path is known too;
+    // read its block and undo data ahead of the serial disconnect loop. The
+    // tip itself is skipped since DisconnectTip reads it right away.
+    std::optional<CBlockDisconnectPrefetcher> prefetcher;
+    if (m_chain.Tip() && m_chain.Tip() != pindexFork) {
+        std::vector<const CBlockIndex*> vpindexDisconnect;
+        for (const CBlockIndex* pindex = m_chain.Tip()->pprev; pindex && pindex != pindexFork; pindex = pindex->pprev) {
+            vpindexDisconnect.push_back(pindex);
+        }
+        if (!vpindexDisconnect.empty()) {
+            prefetcher.emplace(std::move(vpindexDisconnect), chainparams.GetConsensus());
+        }
+    }
+
     // Disconnect active blocks which are no longer in the best chain.
     bool fBlocksDisconnected = false;
     DisconnectedBlockTransactions disconnectpool;
@@ -3217,6 +3646,8 @@ bool CChainState::InvalidateBlock(CValidationState& state, const CChainParams& c
     assert(pindex);
     if (pindex->nHeight == 0) return false;
 
+    EraseRecentlyProcessedBlocks();
+
     CBlockIndex* to_mark_failed = pindex;
     bool pindex_was_in_chain = false;
     int disconnected = 0;
@@ -3253,6 +3684,25 @@ bool CChainState::InvalidateBlock(CValidationState& state, const CChainParams& c
         }
     }
 
+    // The disconnect path is known up front here as well: everything from the
+    // current tip down to and including pindex. Warm the page cache for it
+    // before the disconnect loop starts. ActivateBestChain can't run while
+    // m_cs_chainstate is held, so the path only shrinks from the front as we
+    // disconnect and a stale prefetch is harmless.
+    std::optional<CBlockDisconnectPrefetcher> prefetcher;
+    {
+        LOCK(cs_main);
+        if (m_chain.Contains(pindex)) {
+            std::vector<const CBlockIndex*> vpindexDisconnect;
+            for (const CBlockIndex* walk = m_chain.Tip(); walk && walk->nHeight >= pindex->nHeight; walk = walk->pprev) {
+                vpindexDisconnect.push_back(walk);
+            }
+            if (!vpindexDisconnect.empty()) {
+                prefetcher.emplace(std::move(vpindexDisconnect), chainparams.GetConsensus());
+            }
+        }
+    }
+
     // Disconnect (descendants of) pindex, and mark them invalid.
     while (true) {
         if (ShutdownRequested()) break;
@@ -3407,6 +3857,8 @@ bool CChainState::MarkConflictingBlock(CValidationState& state, const CChainPara
 {
     AssertLockHeld(cs_main);
 
+    EraseRecentlyProcessedBlocks();
+
     // We first disconnect backwards and then mark the blocks as conflicting.
 
     bool pindex_was_in_chain = false;
@@ -3538,19 +3990,18 @@ void ResetBlockFailureFlags(CBlockIndex *pindex) {
     return ::ChainstateActive().ResetBlockFailureFlags(pindex);
 }
 
-CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, enum BlockStatus nStatus)
+CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, const uint256& hash, enum BlockStatus nStatus)
 {
     assert(!(nStatus & BLOCK_FAILED_MASK)); // no failed blocks allowed
     AssertLockHeld(cs_main);
 
     // Check for duplicate
-    uint256 hash = block.GetHash();
     BlockMap::iterator it = m_block_index.find(hash);
     if (it != m_block_index.end())
         return it->second;
 
     // Construct new block index object
-    CBlockIndex* pindexNew = new CBlockIndex(block);
+    CBlockIndex* pindexNew = &m_block_index_storage.emplace_back(block);
     // We assign the sequence id to blocks only when the full data is available,
     // to avoid miners withholding blocks but broadcasting headers, to get a
     // competitive advantage.
@@ -3707,16 +4158,18 @@ static bool FindUndoPos(CValidationState &state, int nFile, FlatFilePos &pos, un
     return true;
 }
 
-static bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true)
+// block_hash must be the (expensive to compute) X11 hash of block, so that callers
+// which already know it don't force a recomputation here
+static bool CheckBlockHeader(const CBlockHeader& block, CValidationState& state, const Consensus::Params& consensusParams, const uint256& block_hash, bool fCheckPOW = true)
 {
     // Check proof of work matches claimed amount
-    if (fCheckPOW && !CheckProofOfWork(block.GetHash(), block.nBits, consensusParams))
+    if (fCheckPOW && !CheckProofOfWork(block_hash, block.nBits, consensusParams))
         return state.Invalid(ValidationInvalidReason::BLOCK_INVALID_HEADER, false, REJECT_INVALID, "high-hash", "proof of work failed");
 
     // Check DevNet
     if (!consensusParams.hashDevnetGenesisBlock.IsNull() &&
             block.hashPrevBlock == consensusParams.hashGenesisBlock &&
-            block.GetHash() != consensusParams.hashDevnetGenesisBlock) {
+            block_hash != consensusParams.hashDevnetGenesisBlock) {
         return state.Invalid(ValidationInvalidReason::CONSENSUS, error("CheckBlockHeader(): wrong devnet genesis"), REJECT_INVALID, "devnet-genesis");
     }
 
@@ -3734,7 +4187,7 @@ bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::P
 
     // Check that the header is valid (particularly PoW).  This is mostly
     // redundant with the call in AcceptBlockHeader.
-    if (!CheckBlockHeader(block, state, consensusParams, fCheckPOW))
+    if (!CheckBlockHeader(block, state, consensusParams, block.GetHash(), fCheckPOW))
         return false;
 
     // Check the merkle root.
@@ -3954,7 +4407,7 @@ bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState
             return true;
         }
 
-        if (!CheckBlockHeader(block, state, chainparams.GetConsensus()))
+        if (!CheckBlockHeader(block, state, chainparams.GetConsensus(), hash))
             return error("%s: Consensus::CheckBlockHeader: %s, %s", __func__, hash.ToString(), FormatStateMessage(state));
 
         // Get prev block index
@@ -4015,13 +4468,13 @@ bool BlockManager::AcceptBlockHeader(const CBlockHeader& block, CValidationState
 
         if (llmq::chainLocksHandler->HasConflictingChainLock(pindexPrev->nHeight + 1, hash)) {
             if (pindex == nullptr) {
-                AddToBlockIndex(block, BLOCK_CONFLICT_CHAINLOCK);
+                AddToBlockIndex(block, hash, BLOCK_CONFLICT_CHAINLOCK);
             }
             return state.Invalid(ValidationInvalidReason::BLOCK_CHAINLOCK, error("%s: header %s conflicts with chainlock", __func__, hash.ToString()), REJECT_INVALID, "bad-chainlock");
         }
     }
     if (pindex == nullptr)
-        pindex = AddToBlockIndex(block);
+        pindex = AddToBlockIndex(block, hash);
 
     if (ppindex)
         *ppindex = pindex;
@@ -4037,6 +4490,31 @@ bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>&
 {
     AssertLockNotHeld(cs_main);
     if (first_invalid != nullptr) first_invalid->SetNull();
+
+    // During a block race every peer announces the same header(s). If the
+    // whole batch was accepted recently, answer from the side map without
+    // queueing on cs_main at the worst possible moment.
+    {
+        LOCK(g_recent_blocks_mutex);
+        const CBlockIndex* pindexLast = nullptr;
+        for (const CBlockHeader& header : headers) {
+            auto it = g_recent_block_headers.find(header.GetHash());
+            if (it == g_recent_block_headers.end()) {
+                pindexLast = nullptr;
+                break;
+            }
+            pindexLast = it->second;
+        }
+        if (pindexLast != nullptr) {
+            if (ppindex) {
+                *ppindex = pindexLast;
+            }
+            return true;
+        }
+    }
+
+    std::vector<const CBlockIndex*> vAccepted;
+    vAccepted.reserve(headers.size());
     {
         LOCK(cs_main);
         for (const CBlockHeader& header : headers) {
@@ -4049,11 +4527,21 @@ bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>&
                 if (first_invalid) *first_invalid = header;
                 return false;
             }
+            vAccepted.push_back(pindex);
             if (ppindex) {
                 *ppindex = pindex;
             }
         }
     }
+    {
+        LOCK(g_recent_blocks_mutex);
+        if (g_recent_block_headers.size() + vAccepted.size() > RECENT_BLOCK_HASHES_MAX) {
+            g_recent_block_headers.clear();
+        }
+        for (const CBlockIndex* pindex : vAccepted) {
+            g_recent_block_headers.emplace(pindex->GetBlockHash(), pindex);
+        }
+    }
     if (NotifyHeaderTip()) {
         if (::ChainstateActive().IsInitialBlockDownload() && ppindex && *ppindex) {
             LogPrintf("Synchronizing blockheaders, height: %d (~%.2f%%)\n", (*ppindex)->nHeight, 100.0/((*ppindex)->nHeight+(GetAdjustedTime() - (*ppindex)->GetBlockTime()) / Params().GetConsensus().nPowTargetSpacing) * (*ppindex)->nHeight);
@@ -4177,6 +4665,32 @@ bool ChainstateManager::ProcessNewBlock(const CChainParams& chainparams, const s
 {
     AssertLockNotHeld(cs_main);
 
+    const uint256 hash = pblock->GetHash();
+    {
+        // A block we just fully processed gets announced by every peer at
+        // once; answer those duplicates here, before the payload prechecks
+        // and before queueing on cs_main.
+        LOCK(g_recent_blocks_mutex);
+        if (g_recent_full_blocks.count(hash) != 0) {
+            if (fNewBlock) *fNewBlock = false;
+            return true;
+        }
+    }
+
+    {
+        // Pre-verify the special transaction payloads before cs_main is taken.
+        // These checks are a chain-state-free subset of CheckSpecialTx, so a
+        // block carrying malformed payloads is rejected without entering the
+        // critical section at all. The expensive signature checks can't move
+        // here as the keys to verify against come from chain state.
+        const CBlockIndex* pindexPrev = WITH_LOCK(cs_main, return LookupBlockIndex(pblock->hashPrevBlock));
+        CValidationState state;
+        if (pindexPrev != nullptr && !PreCheckSpecialTxsInBlock(*pblock, pindexPrev, state)) {
+            GetMainSignals().BlockChecked(*pblock, state);
+            return error("%s: PreCheckSpecialTxsInBlock FAILED: %s", __func__, FormatStateMessage(state));
+        }
+    }
+
     {
         CBlockIndex *pindex = nullptr;
         if (fNewBlock) *fNewBlock = false;
@@ -4205,6 +4719,14 @@ bool ChainstateManager::ProcessNewBlock(const CChainParams& chainparams, const s
     if (!::ChainstateActive().ActivateBestChain(state, chainparams, pblock))
         return error("%s: ActivateBestChain failed: %s", __func__, FormatStateMessage(state));
 
+    {
+        LOCK(g_recent_blocks_mutex);
+        if (g_recent_full_blocks.size() >= RECENT_BLOCK_HASHES_MAX) {
+            g_recent_full_blocks.clear();
+        }
+        g_recent_full_blocks.insert(hash);
+    }
+
     LogPrintf("%s : ACCEPTED\n", __func__);
     return true;
 }
@@ -4220,11 +4742,10 @@ bool TestBlockValidity(CValidationState& state, llmq::CChainLocksHandler& clhand
     }
 
     CCoinsViewCache viewNew(&::ChainstateActive().CoinsTip());
-    uint256 block_hash(block.GetHash());
     CBlockIndex indexDummy(block);
     indexDummy.pprev = pindexPrev;
     indexDummy.nHeight = pindexPrev->nHeight + 1;
-    indexDummy.phashBlock = &block_hash;
+    indexDummy.phashBlock = &hash;
 
     // begin tx and let it rollback
     auto dbTx = evoDb.BeginTransaction();
@@ -4445,7 +4966,7 @@ CBlockIndex * BlockManager::InsertBlockIndex(const uint256& hash)
         return (*mi).second;
 
     // Create new
-    CBlockIndex* pindexNew = new CBlockIndex();
+    CBlockIndex* pindexNew = &m_block_index_storage.emplace_back();
     mi = m_block_index.insert(std::make_pair(hash, pindexNew)).first;
     pindexNew->phashBlock = &((*mi).first);
 
@@ -4516,12 +5037,9 @@ void BlockManager::Unload() {
     m_failed_blocks.clear();
     m_blocks_unlinked.clear();
 
-    for (const BlockMap::value_type& entry : m_block_index) {
-        delete entry.second;
-    }
-
     m_block_index.clear();
     m_prev_block_index.clear();
+    m_block_index_storage.clear();
 }
 
 bool static LoadBlockIndexDB(ChainstateManager& chainman, const CChainParams& chainparams) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
@@ -4588,6 +5106,9 @@ bool static LoadBlockIndexDB(ChainstateManager& chainman, const CChainParams& ch
     pblocktree->ReadFlag("spentindex", fSpentIndex);
     LogPrintf("%s: spent index %s\n", __func__, fSpentIndex ? "enabled" : "disabled");
 
+    // Restore versionbits threshold states cached by a previous run
+    LoadVersionBitsCache(*pblocktree);
+
     return true;
 }
 
@@ -4619,6 +5140,9 @@ bool CChainState::LoadChainTip(const CChainParams& chainparams)
     PruneBlockIndexCandidates();
 
     tip = m_chain.Tip();
+    if (this == &::ChainstateActive()) {
+        g_chain_tip_snapshot.store(tip, std::memory_order_release);
+    }
     LogPrintf("Loaded best chain: hashBestChain=%s height=%d date=%s progress=%f\n",
         tip->GetBlockHash().ToString(),
         m_chain.Height(),
@@ -4653,19 +5177,17 @@ bool CVerifyDB::VerifyDB(const CChainParams& chainparams, CCoinsView *coinsview,
     LogPrintf("Verifying last %i blocks at level %i\n", nCheckDepth, nCheckLevel);
     CCoinsViewCache coins(coinsview);
     CBlockIndex* pindex;
-    CBlockIndex* pindexFailure = nullptr;
+    const CBlockIndex* pindexFailure = nullptr;
     int nGoodTransactions = 0;
-    CValidationState state;
     int reportDone = 0;
     LogPrintf("[0%%]..."); /* Continued */
+
+    // Collect the range of blocks to verify up front, so that the context-free
+    // work per block (disk read, deserialization and check levels 1/2) can be
+    // farmed out to worker threads while the coins disconnect walk below stays
+    // strictly ordered.
+    std::vector<const CBlockIndex*> vpindexRange;
     for (pindex = ::ChainActive().Tip(); pindex && pindex->pprev; pindex = pindex->pprev) {
-        const int percentageDone = std::max(1, std::min(99, (int)(((double)(::ChainActive().Height() - pindex->nHeight)) / (double)nCheckDepth * (nCheckLevel >= 4 ? 50 : 100))));
-        if (reportDone < percentageDone/10) {
-            // report every 10% step
-            LogPrintf("[%d%%]...", percentageDone); /* Continued */
-            reportDone = percentageDone/10;
-        }
-        uiInterface.ShowProgress(_("Verifying blocks...").translated, percentageDone, false);
         if (pindex->nHeight <= ::ChainActive().Height()-nCheckDepth)
             break;
         if (fPruneMode && !(pindex->nStatus & BLOCK_HAVE_DATA)) {
@@ -4673,39 +5195,146 @@ bool CVerifyDB::VerifyDB(const CChainParams& chainparams, CCoinsView *coinsview,
             LogPrintf("VerifyDB(): block verification stopping at height %d (pruning, no data)\n", pindex->nHeight);
             break;
         }
+        vpindexRange.push_back(pindex);
+    }
+
+    struct BlockVerifySlot {
         CBlock block;
-        // check level 0: read from disk
-        if (!ReadBlockFromDisk(block, pindex, chainparams.GetConsensus()))
-            return error("VerifyDB(): *** ReadBlockFromDisk failed at %d, hash=%s", pindex->nHeight, pindex->GetBlockHash().ToString());
-        // check level 1: verify block validity
-        if (nCheckLevel >= 1 && !CheckBlock(block, state, chainparams.GetConsensus()))
-            return error("%s: *** found bad block at %d, hash=%s (%s)\n", __func__,
-                         pindex->nHeight, pindex->GetBlockHash().ToString(), FormatStateMessage(state));
-        // check level 2: verify undo validity
-        if (nCheckLevel >= 2 && pindex) {
-            CBlockUndo undo;
-            if (!pindex->GetUndoPos().IsNull()) {
-                if (!UndoReadFromDisk(undo, pindex)) {
-                    return error("VerifyDB(): *** found bad undo data at %d, hash=%s\n", pindex->nHeight, pindex->GetBlockHash().ToString());
-                }
+        CBlockUndo undo;
+        CValidationState state;
+        bool fReadFailed{false};
+        bool fCheckFailed{false};
+        bool fUndoFailed{false};
+        bool fHasUndo{false};
+        bool fReady{false};
+    };
+
+    // Workers stay at most a window's worth of blocks ahead of the consumer,
+    // which bounds the amount of decoded block data held in memory at once
+    constexpr size_t VERIFY_LOOKAHEAD{32};
+    std::vector<BlockVerifySlot> ring(std::max<size_t>(std::min(VERIFY_LOOKAHEAD, vpindexRange.size()), 1));
+
+    Mutex mutexVerify;
+    std::condition_variable condProduced;
+    std::condition_variable condConsumed;
+    std::atomic<size_t> nNextIdx{0};
+    size_t nConsumed GUARDED_BY(mutexVerify){0};
+    bool fStopWorkers GUARDED_BY(mutexVerify){false};
+
+    auto verifyWorker = [&]() {
+        size_t i;
+        while ((i = nNextIdx.fetch_add(1)) < vpindexRange.size()) {
+            {
+                WAIT_LOCK(mutexVerify, lock);
+                condConsumed.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(mutexVerify) { return fStopWorkers || i < nConsumed + ring.size(); });
+                if (fStopWorkers) return;
+            }
+            // The window protocol above guarantees exclusive access to the slot.
+            // The block index fields read here are immutable while cs_main is
+            // held by the main thread.
+            const CBlockIndex* pi = vpindexRange[i];
+            auto& slot = ring[i % ring.size()];
+            slot.state = CValidationState();
+            slot.fCheckFailed = false;
+            slot.fUndoFailed = false;
+            // check level 0: read from disk
+            slot.fReadFailed = !ReadBlockFromDisk(slot.block, pi, chainparams.GetConsensus());
+            // check level 1: verify block validity
+            if (!slot.fReadFailed && nCheckLevel >= 1) {
+                slot.fCheckFailed = !CheckBlock(slot.block, slot.state, chainparams.GetConsensus());
             }
+            // check level 2: verify undo validity. The undo data stays in the
+            // slot so the level 3 disconnect below doesn't re-read it from disk.
+            slot.fHasUndo = false;
+            if (!slot.fReadFailed && nCheckLevel >= 2 && !pi->GetUndoPos().IsNull()) {
+                slot.fUndoFailed = !UndoReadFromDisk(slot.undo, pi);
+                slot.fHasUndo = !slot.fUndoFailed;
+            }
+            {
+                LOCK(mutexVerify);
+                slot.fReady = true;
+            }
+            condProduced.notify_one();
+        }
+    };
+
+    // -verifydbthreads=0 (the default) sizes the pool from the machine, leaving
+    // one core to the consumer thread driving the coins disconnect walk.
+    int nConfiguredThreads = gArgs.GetArg("-verifydbthreads", DEFAULT_VERIFYDB_THREADS);
+    if (nConfiguredThreads <= 0) nConfiguredThreads = std::max(1, GetNumCores() - 1);
+    const size_t nThreads = std::min(vpindexRange.size(), (size_t)nConfiguredThreads);
+    std::vector<std::thread> verifyThreads;
+    verifyThreads.reserve(nThreads);
+    for (size_t n = 0; n < nThreads; n++) {
+        verifyThreads.emplace_back(verifyWorker);
+    }
+    auto stopWorkers = [&]() {
+        WITH_LOCK(mutexVerify, fStopWorkers = true);
+        condConsumed.notify_all();
+        for (auto& t : verifyThreads) {
+            t.join();
+        }
+    };
+
+    std::string strFailure;
+    bool fShutdown{false};
+    for (size_t i = 0; i < vpindexRange.size(); i++) {
+        const CBlockIndex* pi = vpindexRange[i];
+        const int percentageDone = std::max(1, std::min(99, (int)(((double)(::ChainActive().Height() - pi->nHeight)) / (double)nCheckDepth * (nCheckLevel >= 4 ? 50 : 100))));
+        if (reportDone < percentageDone/10) {
+            // report every 10% step
+            LogPrintf("[%d%%]...", percentageDone); /* Continued */
+            reportDone = percentageDone/10;
+        }
+        uiInterface.ShowProgress(_("Verifying blocks...").translated, percentageDone, false);
+        auto& slot = ring[i % ring.size()];
+        {
+            WAIT_LOCK(mutexVerify, lock);
+            condProduced.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(mutexVerify) { return slot.fReady; });
+        }
+        if (slot.fReadFailed) {
+            strFailure = strprintf("VerifyDB(): *** ReadBlockFromDisk failed at %d, hash=%s", pi->nHeight, pi->GetBlockHash().ToString());
+            break;
+        }
+        if (slot.fCheckFailed) {
+            strFailure = strprintf("%s: *** found bad block at %d, hash=%s (%s)\n", __func__,
+                                   pi->nHeight, pi->GetBlockHash().ToString(), FormatStateMessage(slot.state));
+            break;
+        }
+        if (slot.fUndoFailed) {
+            strFailure = strprintf("VerifyDB(): *** found bad undo data at %d, hash=%s\n", pi->nHeight, pi->GetBlockHash().ToString());
+            break;
         }
         // check level 3: check for inconsistencies during memory-only disconnect of tip blocks
         if (nCheckLevel >= 3 && (coins.DynamicMemoryUsage() + ::ChainstateActive().CoinsTip().DynamicMemoryUsage()) <= ::ChainstateActive().m_coinstip_cache_size_bytes) {
-            assert(coins.GetBestBlock() == pindex->GetBlockHash());
-            DisconnectResult res = ::ChainstateActive().DisconnectBlock(block, pindex, coins);
+            assert(coins.GetBestBlock() == pi->GetBlockHash());
+            DisconnectResult res = ::ChainstateActive().DisconnectBlock(slot.block, pi, coins, slot.fHasUndo ? &slot.undo : nullptr);
             if (res == DISCONNECT_FAILED) {
-                return error("VerifyDB(): *** irrecoverable inconsistency in block data at %d, hash=%s", pindex->nHeight, pindex->GetBlockHash().ToString());
+                strFailure = strprintf("VerifyDB(): *** irrecoverable inconsistency in block data at %d, hash=%s", pi->nHeight, pi->GetBlockHash().ToString());
+                break;
             }
             if (res == DISCONNECT_UNCLEAN) {
                 nGoodTransactions = 0;
-                pindexFailure = pindex;
+                pindexFailure = pi;
             } else {
-                nGoodTransactions += block.vtx.size();
+                nGoodTransactions += slot.block.vtx.size();
             }
         }
-        if (ShutdownRequested()) return true;
+        {
+            LOCK(mutexVerify);
+            slot.fReady = false;
+            nConsumed = i + 1;
+        }
+        condConsumed.notify_all();
+        if (ShutdownRequested()) {
+            fShutdown = true;
+            break;
+        }
     }
+    stopWorkers();
+    if (fShutdown) return true;
+    if (!strFailure.empty()) return error("%s", strFailure);
+
     if (pindexFailure)
         return error("VerifyDB(): *** coin database inconsistencies found (last %i blocks, %i good transactions before that)\n", ::ChainActive().Height() - pindexFailure->nHeight + 1, nGoodTransactions);
 
@@ -4714,6 +5343,7 @@ bool CVerifyDB::VerifyDB(const CChainParams& chainparams, CCoinsView *coinsview,
 
     // check level 4: try reconnecting blocks
     if (nCheckLevel >= 4) {
+        CValidationState state;
         while (pindex != ::ChainActive().Tip()) {
             const int percentageDone = std::max(1, std::min(99, 100 - (int)(((double)(::ChainActive().Height() - pindex->nHeight)) / (double)nCheckDepth * 50)));
             if (reportDone < percentageDone/10) {
@@ -4867,6 +5497,7 @@ void UnloadBlockIndex(CTxMemPool* mempool)
     for (int b = 0; b < VERSIONBITS_NUM_BITS; b++) {
         warningcache[b].clear();
     }
+    EraseRecentlyProcessedBlocks();
     fHavePruned = false;
 }
 
@@ -4910,7 +5541,7 @@ bool CChainState::AddGenesisBlock(const CChainParams& chainparams, const CBlock&
     FlatFilePos blockPos = SaveBlockToDisk(block, 0, chainparams, nullptr);
     if (blockPos.IsNull())
         return error("%s: writing genesis block to disk failed (%s)", __func__, FormatStateMessage(state));
-    CBlockIndex* pindex = m_blockman.AddToBlockIndex(block);
+    CBlockIndex* pindex = m_blockman.AddToBlockIndex(block, block.GetHash());
     ReceivedBlockTransactions(block, pindex, blockPos);
     return true;
 }
@@ -5360,18 +5991,69 @@ bool LoadMempool(CTxMemPool& pool)
         if (version != MEMPOOL_DUMP_VERSION) {
             return false;
         }
+
+        // Read the whole dump up front so the expensive signature checks can
+        // be parallelized below before transactions get re-accepted one by one.
+        struct DumpedTx {
+            CTransactionRef tx;
+            int64_t nTime;
+            int64_t nFeeDelta;
+        };
+        std::vector<DumpedTx> dumped_txs;
         uint64_t num;
         file >> num;
+        dumped_txs.reserve(std::min<uint64_t>(num, 10000));
         while (num) {
             --num;
-            CTransactionRef tx;
-            int64_t nTime;
-            int64_t nFeeDelta;
-            file >> tx;
-            file >> nTime;
-            file >> nFeeDelta;
+            DumpedTx dumped;
+            file >> dumped.tx;
+            file >> dumped.nTime;
+            file >> dumped.nFeeDelta;
+            dumped_txs.push_back(std::move(dumped));
+            if (ShutdownRequested())
+                return false;
+        }
 
-            CAmount amountdelta = nFeeDelta;
+        // Prewarm the signature cache with all checks the dump will need.
+        // AcceptToMemoryPool verifies input scripts serially under cs_main, so
+        // for a large mempool.dat the load is dominated by single-threaded
+        // signature verification; running the checks through the script check
+        // worker threads first makes the serial pass below hit the cache.
+        // This is best-effort: failures and transactions spending unconfirmed
+        // outputs are simply left for AcceptToMemoryPool to deal with.
+        if (g_parallel_script_checks) {
+            LOCK(cs_main);
+            CCoinsViewCache& coins_cache = ::ChainstateActive().CoinsTip();
+            CCheckQueueControl<CScriptCheck> control(&scriptcheckqueue);
+            std::list<PrecomputedTransactionData> txsdata;
+            for (const auto& dumped : dumped_txs) {
+                if (dumped.nTime + nExpiryTimeout <= nNow) continue;
+                if (ShutdownRequested()) break;
+                const CTransaction& tx = *dumped.tx;
+                const auto have_all_coins = [&coins_cache, &tx]() {
+                    for (const auto& txin : tx.vin) {
+                        if (!coins_cache.HaveCoin(txin.prevout)) return false;
+                    }
+                    return true;
+                };
+                if (tx.vin.empty() || !have_all_coins()) continue;
+                txsdata.emplace_back(tx);
+                std::vector<CScriptCheck> vChecks;
+                vChecks.reserve(tx.vin.size());
+                for (unsigned int i = 0; i < tx.vin.size(); i++) {
+                    const Coin& coin = coins_cache.AccessCoin(tx.vin[i].prevout);
+                    vChecks.emplace_back(coin.out, tx, i, STANDARD_SCRIPT_VERIFY_FLAGS, /* cacheIn */ true, &txsdata.back());
+                }
+                control.Add(vChecks);
+            }
+            control.Wait();
+        }
+
+        for (const auto& dumped : dumped_txs) {
+            const CTransactionRef& tx = dumped.tx;
+            const int64_t nTime = dumped.nTime;
+
+            CAmount amountdelta = dumped.nFeeDelta;
             if (amountdelta) {
                 pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
             }
@@ -5508,10 +6190,7 @@ class CMainCleanup
 public:
     CMainCleanup() {}
     ~CMainCleanup() {
-        // block headers
-        BlockMap::iterator it1 = g_chainman.BlockIndex().begin();
-        for (; it1 != g_chainman.BlockIndex().end(); it1++)
-            delete (*it1).second;
+        // block headers (storage is owned by BlockManager)
         g_chainman.BlockIndex().clear();
     }
 };
@@ -5595,6 +6274,8 @@ bool ChainstateManager::IsBackgroundIBD(CChainState* chainstate) const
 
 void ChainstateManager::Unload()
 {
+    g_chain_tip_snapshot.store(nullptr, std::memory_order_release);
+
     for (CChainState* chainstate : this->GetAll()) {
         chainstate->m_chain.SetTip(nullptr);
         chainstate->UnloadBlockIndex();
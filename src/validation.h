@@ -26,6 +26,7 @@
 #include <spentindex.h>
 
 #include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <optional>
@@ -91,6 +92,8 @@ static const unsigned int MAX_HEADERS_RESULTS = 2000;
 static const int64_t DEFAULT_MAX_TIP_AGE = 6 * 60 * 60; // ~144 blocks behind -> 2 x fork detection time, was 24 * 60 * 60 in bitcoin
 
 static const bool DEFAULT_CHECKPOINTS_ENABLED = true;
+/** Default for -compressundo */
+static const bool DEFAULT_COMPRESS_UNDO = false;
 static const bool DEFAULT_TXINDEX = true;
 static const bool DEFAULT_ADDRESSINDEX = false;
 static const bool DEFAULT_TIMESTAMPINDEX = false;
@@ -108,6 +111,8 @@ static const int DEFAULT_STOPATHEIGHT = 0;
 static const unsigned int MIN_BLOCKS_TO_KEEP = 288;
 static const signed int DEFAULT_CHECKBLOCKS = 6;
 static const unsigned int DEFAULT_CHECKLEVEL = 3;
+/** Default for -verifydbthreads (0 = determine from the number of cores) */
+static const int DEFAULT_VERIFYDB_THREADS = 0;
 
 // Require that user allocate at least 945 MiB for block & undo files (blk???.dat and rev???.dat)
 // At 2B MiB per block, 288 blocks = 576 MiB.
@@ -159,6 +164,12 @@ extern std::atomic<bool> fDIP0001ActiveAtTip;
 /** Block hash whose ancestors we will assume to have valid scripts without checking them. */
 extern uint256 hashAssumeValid;
 
+/** Whether blocks covered by a verified chainlock are assumed to have valid scripts.
+ *  Speeds up -reindex-chainstate to a mostly IO-bound pass once the current
+ *  chainlock is known; quorum signature verification of the chainlock itself
+ *  still happens as usual. */
+extern bool fAssumeChainLocks;
+
 /** Minimum work we will assume exists on some valid chain. */
 extern arith_uint256 nMinimumChainWork;
 
@@ -231,6 +242,11 @@ bool AcceptToMemoryPool(CTxMemPool& pool, CValidationState &state, const CTransa
                         bool* pfMissingInputs, bool bypass_limits,
                         const CAmount nAbsurdFee, bool test_accept=false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+/** Expire old mempool entries and evict down to the configured -maxmempool limit. Run
+ * periodically from the scheduler; AcceptToMemoryPool only trims inline when the pool
+ * exceeds the limit by more than a small headroom. */
+void TrimMempool(CTxMemPool& pool);
+
 bool GetUTXOCoin(const COutPoint& outpoint, Coin& coin);
 int GetUTXOHeight(const COutPoint& outpoint);
 int GetUTXOConfirmations(const COutPoint& outpoint);
@@ -315,16 +331,39 @@ bool GetTimestampIndex(const unsigned int &high, const unsigned int &low, std::v
 bool GetSpentIndex(CTxMemPool& mempool, CSpentIndexKey &key, CSpentIndexValue &value);
 bool GetAddressIndex(uint160 addressHash, int type,
                      std::vector<std::pair<CAddressIndexKey, CAmount> > &addressIndex,
-                     int start = 0, int end = 0);
+                     int start = 0, int end = 0, unsigned int startTxindex = 0, size_t maxCount = 0);
 bool GetAddressUnspent(uint160 addressHash, int type,
                        std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > &unspentOutputs);
+/** Default -maxscriptcachesize (MiB); matches the half share of the default
+ *  -maxsigcachesize the script execution cache historically received */
+static const int64_t DEFAULT_MAX_SCRIPT_CACHE_SIZE = 16;
 /** Initializes the script-execution cache */
 void InitScriptExecutionCache();
 
+/** Cumulative script-execution cache probe counters, exposed by the getcachestats RPC */
+uint64_t ScriptExecutionCacheHits();
+uint64_t ScriptExecutionCacheMisses();
+
 
 /** Functions for disk access for blocks */
 bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, const Consensus::Params& consensusParams);
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams);
+/** Read a block through the global bounded decoded-block cache, shared by RPC,
+ *  REST, block serving and index sync. Returns nullptr if the block could not
+ *  be read from disk; if block_size is given it receives the block's
+ *  serialized size. */
+std::shared_ptr<const CBlock> ReadCachedBlockFromDisk(const CBlockIndex* pindex, const Consensus::Params& consensusParams, size_t* block_size = nullptr);
+/** Read the raw serialized bytes of a block from disk without deserializing it.
+ *  Useful for callers which just forward the bytes (e.g. getblock verbosity=0 and
+ *  binary/hex REST responses) as it avoids the CBlock round trip. */
+bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos, const CMessageHeader::MessageStartChars& message_start);
+bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const CBlockIndex* pindex, const CMessageHeader::MessageStartChars& message_start);
+/** Read a slice [offset, offset + length) of a block's raw serialized bytes
+ *  from disk. Reports the full serialized block size in block_size; the slice
+ *  must lie within it. Calling with length 0 only probes the size. */
+bool ReadRawBlockSliceFromDisk(std::vector<uint8_t>& slice, uint64_t& block_size, const CBlockIndex* pindex, const CMessageHeader::MessageStartChars& message_start, uint64_t offset, uint64_t length);
+/** Ask the kernel to page in a block's serialized bytes ahead of a future ReadBlockFromDisk */
+void PrefetchBlockFromDisk(const FlatFilePos& pos);
 
 bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex);
 
@@ -362,6 +401,11 @@ enum class FlushStateMode {
     NONE,
     IF_NEEDED,
     PERIODIC,
+    //! Like PERIODIC, but additionally does a full flush as soon as the coins
+    //! cache is LARGE (instead of waiting until it turns CRITICAL). Used by the
+    //! scheduler-driven background flusher so that the expensive flush happens
+    //! off the block connection path.
+    BACKGROUND,
     ALWAYS
 };
 
@@ -379,6 +423,14 @@ struct CBlockIndexWorkComparator
  */
 class BlockManager {
 public:
+    /**
+     * Slab storage owning all CBlockIndex entries. A deque keeps addresses
+     * stable (CBlockIndex pointers are held all over the codebase) while
+     * laying entries out contiguously in insertion order, which is height
+     * order for the common startup load, so ancestor walks stay mostly
+     * cache-linear instead of chasing individually heap-allocated nodes.
+     */
+    std::deque<CBlockIndex> m_block_index_storage GUARDED_BY(cs_main);
     BlockMap m_block_index GUARDED_BY(cs_main);
     PrevBlockMap m_prev_block_index GUARDED_BY(cs_main);
 
@@ -424,7 +476,8 @@ public:
     /** Clear all data members. */
     void Unload() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
-    CBlockIndex* AddToBlockIndex(const CBlockHeader& block, enum BlockStatus nStatus = BLOCK_VALID_TREE) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    //! hash must be the precomputed block hash, so callers which already hashed the header don't force another X11 run
+    CBlockIndex* AddToBlockIndex(const CBlockHeader& block, const uint256& hash, enum BlockStatus nStatus = BLOCK_VALID_TREE) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     /** Create a new block index entry for a given block hash */
     CBlockIndex* InsertBlockIndex(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
@@ -673,7 +726,10 @@ public:
     bool AcceptBlock(const std::shared_ptr<const CBlock>& pblock, CValidationState& state, const CChainParams& chainparams, CBlockIndex** ppindex, bool fRequested, const FlatFilePos* dbp, bool* fNewBlock) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Block (dis)connection on a given view:
-    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    //! If the caller already has the block's undo data deserialized (e.g. from a
+    //! verification pipeline), it can be passed via pblockUndo to skip re-reading
+    //! it from disk. The restored coins are moved out of it, leaving it spent.
+    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, CBlockUndo* pblockUndo = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& view, const CChainParams& chainparams, bool fJustCheck = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Apply the effects of a block disconnection on the UTXO set.
@@ -976,6 +1032,18 @@ CChainState& ChainstateActive();
 /** Please prefer the identical ChainstateManager::ActiveChain */
 CChain& ChainActive();
 
+/**
+ * Lock-free snapshot of the active chain tip, republished on every tip change.
+ *
+ * CBlockIndex entries are never freed while the node runs and the fields
+ * reachable from the tip (nHeight, the block hash, header fields, pprev/pskip
+ * and thus GetAncestor()) are immutable once the entry is linked, so read-only
+ * code like RPC handlers can inspect the returned chain without taking
+ * cs_main. Returns nullptr until a tip has been loaded. Callers that need the
+ * block index map (e.g. lookups by hash) still require cs_main.
+ */
+const CBlockIndex* GetChainTipSnapshot();
+
 /** Global variable that points to the active block tree (protected by cs_main) */
 extern std::unique_ptr<CBlockTreeDB> pblocktree;
 
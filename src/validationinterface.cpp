@@ -7,61 +7,141 @@
 
 #include <primitives/block.h>
 #include <scheduler.h>
+#include <sync.h>
 
 #include <future>
+#include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <boost/signals2/signal.hpp>
 
 struct ValidationInterfaceConnections {
-    boost::signals2::scoped_connection UpdatedBlockTip;
+    // Only the synchronous notifications go through boost signals; the queued
+    // ones are dispatched through the per-listener queues below.
     boost::signals2::scoped_connection SynchronousUpdatedBlockTip;
-    boost::signals2::scoped_connection TransactionAddedToMempool;
-    boost::signals2::scoped_connection BlockConnected;
-    boost::signals2::scoped_connection BlockDisconnected;
-    boost::signals2::scoped_connection TransactionRemovedFromMempool;
-    boost::signals2::scoped_connection ChainStateFlushed;
     boost::signals2::scoped_connection BlockChecked;
     boost::signals2::scoped_connection NewPoWValidBlock;
     boost::signals2::scoped_connection AcceptedBlockHeader;
     boost::signals2::scoped_connection NotifyHeaderTip;
-    boost::signals2::scoped_connection NotifyTransactionLock;
-    boost::signals2::scoped_connection NotifyChainLock;
-    boost::signals2::scoped_connection NotifyGovernanceVote;
-    boost::signals2::scoped_connection NotifyGovernanceObject;
-    boost::signals2::scoped_connection NotifyInstantSendDoubleSpendAttempt;
     boost::signals2::scoped_connection NotifyMasternodeListChanged;
-    boost::signals2::scoped_connection NotifyRecoveredSig;
+};
+
+/**
+ * A registered listener together with its own serial notification queue.
+ *
+ * Queued notifications capture a shared_ptr to their entry, so the queue and
+ * the listener reference outlive unregistration until every notification
+ * queued before it has been drained. Delivery runs under m_cs and
+ * Deactivate() blocks on it, so no notification is delivered after
+ * unregistration returns - the same guarantee the blocking disconnect of
+ * boost signals used to provide.
+ */
+class ListenerEntry
+{
+private:
+    Mutex m_cs;
+    std::shared_ptr<CValidationInterface> m_callbacks GUARDED_BY(m_cs);
+
+public:
+    CValidationInterface* const m_id;
+    SingleThreadedSchedulerClient m_queue;
+
+    ListenerEntry(std::shared_ptr<CValidationInterface> callbacks, CScheduler* scheduler) :
+        m_callbacks(std::move(callbacks)), m_id(m_callbacks.get()), m_queue(scheduler) {}
+
+    template <typename F>
+    void Invoke(const F& f)
+    {
+        LOCK(m_cs);
+        if (m_callbacks) f(*m_callbacks);
+    }
 
+    //! Stop delivering queued notifications, blocking on one in flight.
+    void Deactivate()
+    {
+        LOCK(m_cs);
+        m_callbacks.reset();
+    }
 };
 
 struct MainSignalsInstance {
-    boost::signals2::signal<void (const CBlockIndex *, const CBlockIndex *, bool fInitialDownload)> UpdatedBlockTip;
     boost::signals2::signal<void (const CBlockIndex *, const CBlockIndex *, bool fInitialDownload)> SynchronousUpdatedBlockTip;
-    boost::signals2::signal<void (const CTransactionRef &, int64_t)> TransactionAddedToMempool;
-    boost::signals2::signal<void (const std::shared_ptr<const CBlock> &, const CBlockIndex *pindex)> BlockConnected;
-    boost::signals2::signal<void (const std::shared_ptr<const CBlock>&, const CBlockIndex* pindex)> BlockDisconnected;
-    boost::signals2::signal<void (const CTransactionRef &, MemPoolRemovalReason)> TransactionRemovedFromMempool;
-    boost::signals2::signal<void (const CBlockLocator &)> ChainStateFlushed;
     boost::signals2::signal<void (const CBlock&, const CValidationState&)> BlockChecked;
     boost::signals2::signal<void (const CBlockIndex *, const std::shared_ptr<const CBlock>&)> NewPoWValidBlock;
     boost::signals2::signal<void (const CBlockIndex *)>AcceptedBlockHeader;
     boost::signals2::signal<void (const CBlockIndex *, bool)>NotifyHeaderTip;
-    boost::signals2::signal<void (const CTransactionRef& tx, const std::shared_ptr<const llmq::CInstantSendLock>& islock)>NotifyTransactionLock;
-    boost::signals2::signal<void (const CBlockIndex* pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)>NotifyChainLock;
-    boost::signals2::signal<void (const std::shared_ptr<const CGovernanceVote>& vote)>NotifyGovernanceVote;
-    boost::signals2::signal<void (const std::shared_ptr<const CGovernanceObject>& object)>NotifyGovernanceObject;
-    boost::signals2::signal<void (const CTransactionRef& currentTx, const CTransactionRef& previousTx)>NotifyInstantSendDoubleSpendAttempt;
     boost::signals2::signal<void (bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff, CConnman& connman)>NotifyMasternodeListChanged;
-    boost::signals2::signal<void (const std::shared_ptr<const llmq::CRecoveredSig>& sig)>NotifyRecoveredSig;
     // We are not allowed to assume the scheduler only runs in one thread,
     // but must ensure all callbacks happen in-order, so we end up creating
     // our own queue here :(
     SingleThreadedSchedulerClient m_schedulerClient;
     std::unordered_map<CValidationInterface*, ValidationInterfaceConnections> m_connMainSignals;
 
-    explicit MainSignalsInstance(CScheduler *pscheduler) : m_schedulerClient(pscheduler) {}
+    CScheduler* const m_scheduler;
+    Mutex m_listeners_mutex;
+    //! Listeners receiving the queued notifications, each through its own
+    //! serial queue. A slow listener then only lags its own queue, and with
+    //! more than one scheduler service thread (-schedulerthreads) the
+    //! listeners are notified in parallel while per-listener ordering is
+    //! still preserved.
+    std::vector<std::shared_ptr<ListenerEntry>> m_asyncListeners GUARDED_BY(m_listeners_mutex);
+
+    explicit MainSignalsInstance(CScheduler *pscheduler) : m_schedulerClient(pscheduler), m_scheduler(pscheduler) {}
+
+    std::vector<std::shared_ptr<ListenerEntry>> GetListeners()
+    {
+        LOCK(m_listeners_mutex);
+        return m_asyncListeners;
+    }
+
+    //! Queue a notification into every listener's queue, preserving the
+    //! emission order per listener.
+    template <typename F>
+    void QueueForEachListener(const F& f)
+    {
+        for (auto& entry : GetListeners()) {
+            entry->m_queue.AddToProcessQueue([entry, f] { entry->Invoke(f); });
+        }
+    }
+
+    void AddListener(std::shared_ptr<CValidationInterface> callbacks)
+    {
+        RemoveListener(callbacks.get()); // re-registration replaces the old entry
+        LOCK(m_listeners_mutex);
+        m_asyncListeners.push_back(std::make_shared<ListenerEntry>(std::move(callbacks), m_scheduler));
+    }
+
+    void RemoveListener(CValidationInterface* callbacks)
+    {
+        std::shared_ptr<ListenerEntry> entry;
+        {
+            LOCK(m_listeners_mutex);
+            for (auto it = m_asyncListeners.begin(); it != m_asyncListeners.end(); ++it) {
+                if ((*it)->m_id == callbacks) {
+                    entry = *it;
+                    m_asyncListeners.erase(it);
+                    break;
+                }
+            }
+        }
+        // Deactivate outside m_listeners_mutex, so blocking on an in-flight
+        // notification does not stall dispatch to the other listeners.
+        if (entry) entry->Deactivate();
+    }
+
+    void RemoveAllListeners()
+    {
+        std::vector<std::shared_ptr<ListenerEntry>> entries;
+        {
+            LOCK(m_listeners_mutex);
+            entries.swap(m_asyncListeners);
+        }
+        for (auto& entry : entries) {
+            entry->Deactivate();
+        }
+    }
 };
 
 static CMainSignals g_signals;
@@ -77,13 +157,23 @@ void CMainSignals::UnregisterBackgroundSignalScheduler() {
 
 void CMainSignals::FlushBackgroundCallbacks() {
     if (m_internals) {
+        // Listener queues first: a drain marker queued by
+        // CallFunctionInValidationInterfaceQueue adds to the shared queue as
+        // it is processed, so the shared queue has to be emptied last.
+        for (auto& entry : m_internals->GetListeners()) {
+            entry->m_queue.EmptyQueue();
+        }
         m_internals->m_schedulerClient.EmptyQueue();
     }
 }
 
 size_t CMainSignals::CallbacksPending() {
     if (!m_internals) return 0;
-    return m_internals->m_schedulerClient.CallbacksPending();
+    size_t pending = m_internals->m_schedulerClient.CallbacksPending();
+    for (auto& entry : m_internals->GetListeners()) {
+        pending += entry->m_queue.CallbacksPending();
+    }
+    return pending;
 }
 
 CMainSignals& GetMainSignals()
@@ -97,22 +187,13 @@ void RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface> pwa
     ValidationInterfaceConnections& conns = g_signals.m_internals->m_connMainSignals[pwalletIn.get()];
     conns.AcceptedBlockHeader = g_signals.m_internals->AcceptedBlockHeader.connect(std::bind(&CValidationInterface::AcceptedBlockHeader, pwalletIn, std::placeholders::_1));
     conns.NotifyHeaderTip = g_signals.m_internals->NotifyHeaderTip.connect(std::bind(&CValidationInterface::NotifyHeaderTip, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.UpdatedBlockTip = g_signals.m_internals->UpdatedBlockTip.connect(std::bind(&CValidationInterface::UpdatedBlockTip, pwalletIn, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
     conns.SynchronousUpdatedBlockTip = g_signals.m_internals->SynchronousUpdatedBlockTip.connect(std::bind(&CValidationInterface::SynchronousUpdatedBlockTip, pwalletIn, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-    conns.TransactionAddedToMempool = g_signals.m_internals->TransactionAddedToMempool.connect(std::bind(&CValidationInterface::TransactionAddedToMempool, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.BlockConnected = g_signals.m_internals->BlockConnected.connect(std::bind(&CValidationInterface::BlockConnected, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.BlockDisconnected = g_signals.m_internals->BlockDisconnected.connect(std::bind(&CValidationInterface::BlockDisconnected, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.NotifyTransactionLock = g_signals.m_internals->NotifyTransactionLock.connect(std::bind(&CValidationInterface::NotifyTransactionLock, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.NotifyChainLock = g_signals.m_internals->NotifyChainLock.connect(std::bind(&CValidationInterface::NotifyChainLock, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.TransactionRemovedFromMempool = g_signals.m_internals->TransactionRemovedFromMempool.connect(std::bind(&CValidationInterface::TransactionRemovedFromMempool, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.ChainStateFlushed = g_signals.m_internals->ChainStateFlushed.connect(std::bind(&CValidationInterface::ChainStateFlushed, pwalletIn, std::placeholders::_1));
     conns.BlockChecked = g_signals.m_internals->BlockChecked.connect(std::bind(&CValidationInterface::BlockChecked, pwalletIn, std::placeholders::_1, std::placeholders::_2));
     conns.NewPoWValidBlock = g_signals.m_internals->NewPoWValidBlock.connect(std::bind(&CValidationInterface::NewPoWValidBlock, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.NotifyGovernanceObject = g_signals.m_internals->NotifyGovernanceObject.connect(std::bind(&CValidationInterface::NotifyGovernanceObject, pwalletIn, std::placeholders::_1));
-    conns.NotifyGovernanceVote = g_signals.m_internals->NotifyGovernanceVote.connect(std::bind(&CValidationInterface::NotifyGovernanceVote, pwalletIn, std::placeholders::_1));
-    conns.NotifyInstantSendDoubleSpendAttempt = g_signals.m_internals->NotifyInstantSendDoubleSpendAttempt.connect(std::bind(&CValidationInterface::NotifyInstantSendDoubleSpendAttempt, pwalletIn, std::placeholders::_1, std::placeholders::_2));
-    conns.NotifyRecoveredSig = g_signals.m_internals->NotifyRecoveredSig.connect(std::bind(&CValidationInterface::NotifyRecoveredSig, pwalletIn, std::placeholders::_1));
     conns.NotifyMasternodeListChanged = g_signals.m_internals->NotifyMasternodeListChanged.connect(std::bind(&CValidationInterface::NotifyMasternodeListChanged, pwalletIn, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+    // The queued notifications are delivered through a per-listener queue
+    // instead of a shared signal, holding a reference of their own.
+    g_signals.m_internals->AddListener(std::move(pwalletIn));
 }
 
 void RegisterValidationInterface(CValidationInterface* callbacks)
@@ -130,6 +211,7 @@ void UnregisterSharedValidationInterface(std::shared_ptr<CValidationInterface> c
 void UnregisterValidationInterface(CValidationInterface* pwalletIn) {
     if (g_signals.m_internals) {
         g_signals.m_internals->m_connMainSignals.erase(pwalletIn);
+        g_signals.m_internals->RemoveListener(pwalletIn);
     }
 }
 
@@ -138,10 +220,25 @@ void UnregisterAllValidationInterfaces() {
         return;
     }
     g_signals.m_internals->m_connMainSignals.clear();
+    g_signals.m_internals->RemoveAllListeners();
 }
 
 void CallFunctionInValidationInterfaceQueue(std::function<void ()> func) {
-    g_signals.m_internals->m_schedulerClient.AddToProcessQueue(std::move(func));
+    // The notifications generated so far are spread over the per-listener
+    // queues, so a drain marker is dropped into each of them (and into the
+    // shared queue, behind any function queued here earlier). The last marker
+    // to be processed - via the shared_ptr deleter - queues func on the shared
+    // queue, so func never runs before a callback generated prior to now.
+    auto barrier = std::shared_ptr<std::function<void()>>(
+        new std::function<void()>(std::move(func)),
+        [](std::function<void()>* f) {
+            g_signals.m_internals->m_schedulerClient.AddToProcessQueue(std::move(*f));
+            delete f;
+        });
+    for (auto& entry : g_signals.m_internals->GetListeners()) {
+        entry->m_queue.AddToProcessQueue([barrier] {});
+    }
+    g_signals.m_internals->m_schedulerClient.AddToProcessQueue([barrier] {});
 }
 
 void SyncWithValidationInterfaceQueue() {
@@ -159,8 +256,8 @@ void CMainSignals::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockInd
     // the chain actually updates. One way to ensure this is for the caller to invoke this signal
     // in the same critical section where the chain is updated
 
-    m_internals->m_schedulerClient.AddToProcessQueue([pindexNew, pindexFork, fInitialDownload, this] {
-        m_internals->UpdatedBlockTip(pindexNew, pindexFork, fInitialDownload);
+    m_internals->QueueForEachListener([pindexNew, pindexFork, fInitialDownload](CValidationInterface& callbacks) {
+        callbacks.UpdatedBlockTip(pindexNew, pindexFork, fInitialDownload);
     });
 }
 
@@ -169,32 +266,32 @@ void CMainSignals::SynchronousUpdatedBlockTip(const CBlockIndex *pindexNew, cons
 }
 
 void CMainSignals::TransactionAddedToMempool(const CTransactionRef &ptx, int64_t nAcceptTime) {
-    m_internals->m_schedulerClient.AddToProcessQueue([ptx, nAcceptTime, this] {
-        m_internals->TransactionAddedToMempool(ptx, nAcceptTime);
+    m_internals->QueueForEachListener([ptx, nAcceptTime](CValidationInterface& callbacks) {
+        callbacks.TransactionAddedToMempool(ptx, nAcceptTime);
     });
 }
 
 void CMainSignals::TransactionRemovedFromMempool(const CTransactionRef &ptx, MemPoolRemovalReason reason) {
-    m_internals->m_schedulerClient.AddToProcessQueue([ptx, reason, this] {
-        m_internals->TransactionRemovedFromMempool(ptx, reason);
+    m_internals->QueueForEachListener([ptx, reason](CValidationInterface& callbacks) {
+        callbacks.TransactionRemovedFromMempool(ptx, reason);
     });
 }
 
 void CMainSignals::BlockConnected(const std::shared_ptr<const CBlock> &pblock, const CBlockIndex *pindex) {
-    m_internals->m_schedulerClient.AddToProcessQueue([pblock, pindex, this] {
-        m_internals->BlockConnected(pblock, pindex);
+    m_internals->QueueForEachListener([pblock, pindex](CValidationInterface& callbacks) {
+        callbacks.BlockConnected(pblock, pindex);
     });
 }
 
 void CMainSignals::BlockDisconnected(const std::shared_ptr<const CBlock> &pblock, const CBlockIndex* pindex) {
-    m_internals->m_schedulerClient.AddToProcessQueue([pblock, pindex, this] {
-        m_internals->BlockDisconnected(pblock, pindex);
+    m_internals->QueueForEachListener([pblock, pindex](CValidationInterface& callbacks) {
+        callbacks.BlockDisconnected(pblock, pindex);
     });
 }
 
 void CMainSignals::ChainStateFlushed(const CBlockLocator &locator) {
-    m_internals->m_schedulerClient.AddToProcessQueue([locator, this] {
-        m_internals->ChainStateFlushed(locator);
+    m_internals->QueueForEachListener([locator](CValidationInterface& callbacks) {
+        callbacks.ChainStateFlushed(locator);
     });
 }
 
@@ -215,38 +312,38 @@ void CMainSignals::NotifyHeaderTip(const CBlockIndex *pindexNew, bool fInitialDo
 }
 
 void CMainSignals::NotifyTransactionLock(const CTransactionRef &tx, const std::shared_ptr<const llmq::CInstantSendLock>& islock) {
-    m_internals->m_schedulerClient.AddToProcessQueue([tx, islock, this] {
-        m_internals->NotifyTransactionLock(tx, islock);
+    m_internals->QueueForEachListener([tx, islock](CValidationInterface& callbacks) {
+        callbacks.NotifyTransactionLock(tx, islock);
     });
 }
 
 void CMainSignals::NotifyChainLock(const CBlockIndex* pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig) {
-    m_internals->m_schedulerClient.AddToProcessQueue([pindex, clsig, this] {
-        m_internals->NotifyChainLock(pindex, clsig);
+    m_internals->QueueForEachListener([pindex, clsig](CValidationInterface& callbacks) {
+        callbacks.NotifyChainLock(pindex, clsig);
     });
 }
 
 void CMainSignals::NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote) {
-    m_internals->m_schedulerClient.AddToProcessQueue([vote, this] {
-        m_internals->NotifyGovernanceVote(vote);
+    m_internals->QueueForEachListener([vote](CValidationInterface& callbacks) {
+        callbacks.NotifyGovernanceVote(vote);
     });
 }
 
 void CMainSignals::NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object) {
-    m_internals->m_schedulerClient.AddToProcessQueue([object, this] {
-        m_internals->NotifyGovernanceObject(object);
+    m_internals->QueueForEachListener([object](CValidationInterface& callbacks) {
+        callbacks.NotifyGovernanceObject(object);
     });
 }
 
 void CMainSignals::NotifyInstantSendDoubleSpendAttempt(const CTransactionRef& currentTx, const CTransactionRef& previousTx) {
-    m_internals->m_schedulerClient.AddToProcessQueue([currentTx, previousTx, this] {
-        m_internals->NotifyInstantSendDoubleSpendAttempt(currentTx, previousTx);
+    m_internals->QueueForEachListener([currentTx, previousTx](CValidationInterface& callbacks) {
+        callbacks.NotifyInstantSendDoubleSpendAttempt(currentTx, previousTx);
     });
 }
 
 void CMainSignals::NotifyRecoveredSig(const std::shared_ptr<const llmq::CRecoveredSig>& sig) {
-    m_internals->m_schedulerClient.AddToProcessQueue([sig, this] {
-        m_internals->NotifyRecoveredSig(sig);
+    m_internals->QueueForEachListener([sig](CValidationInterface& callbacks) {
+        callbacks.NotifyRecoveredSig(sig);
     });
 }
 
@@ -52,6 +52,8 @@ void UnregisterSharedValidationInterface(std::shared_ptr<CValidationInterface> c
 /**
  * Pushes a function to callback onto the notification queue, guaranteeing any
  * callbacks generated prior to now are finished when the function is called.
+ * With per-listener notification queues this acts as a barrier: the function
+ * runs only once every listener's queue has drained past this point.
  *
  * Be very careful blocking on func to be called if any locks are held -
  * validation interface clients may not be able to make progress as they often
@@ -197,6 +199,7 @@ protected:
     friend void ::RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface>);
     friend void ::UnregisterValidationInterface(CValidationInterface*);
     friend void ::UnregisterAllValidationInterfaces();
+    friend class CMainSignals;
 };
 
 struct MainSignalsInstance;
@@ -208,6 +211,7 @@ private:
     friend void ::UnregisterValidationInterface(CValidationInterface*);
     friend void ::UnregisterAllValidationInterfaces();
     friend void ::CallFunctionInValidationInterfaceQueue(std::function<void ()> func);
+    friend void ::SyncWithValidationInterfaceQueue();
 
 public:
     /** Register a CScheduler to give callbacks which should run in the background (may only be called once) */
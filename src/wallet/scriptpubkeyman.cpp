@@ -1379,6 +1379,12 @@ bool LegacyScriptPubKeyMan::TopUp(unsigned int kpSize)
         }
         bool fInternal = false;
         WalletBatch batch(m_storage.GetDatabase());
+        // Commit the whole top-up as one db transaction: restoring a wallet
+        // adds thousands of keys and committing every key, metadata and
+        // chain-counter write individually is what makes it take minutes.
+        if (!batch.TxnBegin()) {
+            throw std::runtime_error(std::string(__func__) + ": cannot start db transaction");
+        }
         for (int64_t i = missingInternal + missingExternal; i--;)
         {
             if (i < missingInternal) {
@@ -1389,16 +1395,18 @@ bool LegacyScriptPubKeyMan::TopUp(unsigned int kpSize)
             CPubKey pubkey(GenerateNewKey(batch, 0, fInternal));
             AddKeypoolPubkeyWithDB(pubkey, fInternal, batch);
 
-            if (missingInternal + missingExternal > 0) {
-                WalletLogPrintf("keypool added %d keys (%d internal), size=%u (%u internal)\n",
-                          missingInternal + missingExternal, missingInternal,
-                          setInternalKeyPool.size() + setExternalKeyPool.size(), setInternalKeyPool.size());
-            }
-
             double dProgress = 100.f * m_max_keypool_index / (nTargetSize + 1);
             std::string strMsg = strprintf(_("Loading wallet... (%3.2f %%)").translated, dProgress);
             uiInterface.InitMessage(strMsg);
         }
+        if (!batch.TxnCommit()) {
+            throw std::runtime_error(std::string(__func__) + ": writing keypool failed");
+        }
+        if (missingInternal + missingExternal > 0) {
+            WalletLogPrintf("keypool added %d keys (%d internal), size=%u (%u internal)\n",
+                      missingInternal + missingExternal, missingInternal,
+                      setInternalKeyPool.size() + setExternalKeyPool.size(), setInternalKeyPool.size());
+        }
     }
     NotifyCanGetAddressesChanged();
     return true;
@@ -57,6 +57,10 @@
 #include <llmq/chainlocks.h>
 #include <assert.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 const std::map<uint64_t,std::string> WALLET_FLAG_CAVEATS{
     {WALLET_FLAG_AVOID_REUSE,
         "You need to rescan the blockchain in order to correctly mark used "
@@ -780,6 +784,7 @@ void CWallet::MarkDirty()
 
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 }
 
 void CWallet::SetSpentKeyState(WalletBatch& batch, const uint256& hash, unsigned int n, bool used, std::set<CTxDestination>& tx_destinations)
@@ -821,11 +826,20 @@ bool CWallet::IsSpentKey(const uint256& hash, unsigned int n) const
     return false;
 }
 
-bool CWallet::AddToWallet(const CWalletTx& wtxIn, bool fFlushOnClose)
+bool CWallet::AddToWallet(const CWalletTx& wtxIn, bool fFlushOnClose, WalletBatch* pbatch)
 {
     LOCK(cs_wallet);
 
-    WalletBatch batch(*database, fFlushOnClose);
+    WalletBatch fallbackBatch(*database, fFlushOnClose);
+    // Write into the caller's batch when one is given (e.g. BlockConnected
+    // grouping a whole block into a single db transaction) and leave the
+    // transaction management to the caller. Otherwise group the
+    // used-destination, order-counter and tx record writes below into one db
+    // transaction so the backend syncs them to disk in a single commit
+    // instead of one per write. If the transaction cannot be started just
+    // fall back to individually committed writes.
+    WalletBatch& batch = pbatch != nullptr ? *pbatch : fallbackBatch;
+    const bool fBatchTxn = pbatch == nullptr && batch.TxnBegin();
 
     uint256 hash = wtxIn.GetHash();
 
@@ -900,9 +914,14 @@ bool CWallet::AddToWallet(const CWalletTx& wtxIn, bool fFlushOnClose)
     WalletLogPrintf("AddToWallet %s  %s%s\n", wtxIn.GetHash().ToString(), (fInsertedNew ? "new" : ""), (fUpdated ? "update" : ""));
 
     // Write to disk
-    if (fInsertedNew || fUpdated)
-        if (!batch.WriteTx(wtx))
+    if (fInsertedNew || fUpdated) {
+        if (!batch.WriteTx(wtx)) {
+            if (fBatchTxn) batch.TxnAbort();
             return false;
+        }
+    }
+    if (fBatchTxn && !batch.TxnCommit())
+        return false;
 
     // Break debit/credit balance caches:
     wtx.MarkDirty();
@@ -932,6 +951,7 @@ bool CWallet::AddToWallet(const CWalletTx& wtxIn, bool fFlushOnClose)
 
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 
     return true;
 }
@@ -977,7 +997,7 @@ void CWallet::LoadToWallet(CWalletTx& wtxIn)
     }
 }
 
-bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, CWalletTx::Confirmation confirm, bool fUpdate)
+bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, CWalletTx::Confirmation confirm, bool fUpdate, WalletBatch* pbatch)
 {
     const CTransaction& tx = *ptx;
     {
@@ -1006,7 +1026,8 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, CWalletTx::Co
              * the mostly recently created transactions from newer versions of the wallet.
              */
 
-            WalletBatch batch(*database);
+            WalletBatch fallbackBatch(*database);
+            WalletBatch& batch = pbatch != nullptr ? *pbatch : fallbackBatch;
             // loop though all outputs
             for (const CTxOut& txout: tx.vout) {
                 if (auto spk_man = m_spk_man.get()) {
@@ -1020,7 +1041,7 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, CWalletTx::Co
             // which means user may have to call abandontransaction again
             wtx.m_confirm = confirm;
 
-            return AddToWallet(wtx, false);
+            return AddToWallet(wtx, false, pbatch);
         }
     }
     return false;
@@ -1046,6 +1067,13 @@ void CWallet::MarkInputsDirty(const CTransactionRef& tx)
         auto it = mapWallet.find(txin.prevout.hash);
         if (it != mapWallet.end()) {
             it->second.MarkDirty();
+            // Keep the UTXO index in sync: when the spender is abandoned or
+            // conflicted the spent output becomes available again. The spend
+            // case is a no-op here, AddToSpends already erased the outpoint.
+            if (txin.prevout.n < it->second.tx->vout.size() &&
+                    IsMine(it->second.tx->vout[txin.prevout.n]) && !IsSpent(txin.prevout.hash, txin.prevout.n)) {
+                setWalletUTXO.insert(txin.prevout);
+            }
         }
     }
 }
@@ -1103,6 +1131,7 @@ bool CWallet::AbandonTransaction(const uint256& hashTx)
 
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 
     return true;
 }
@@ -1172,11 +1201,12 @@ void CWallet::MarkConflicted(const uint256& hashBlock, int conflicting_height, c
 
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 }
 
-void CWallet::SyncTransaction(const CTransactionRef& ptx, CWalletTx::Confirmation confirm, bool update_tx)
+void CWallet::SyncTransaction(const CTransactionRef& ptx, CWalletTx::Confirmation confirm, bool update_tx, WalletBatch* pbatch)
 {
-    if (!AddToWalletIfInvolvingMe(ptx, confirm, update_tx))
+    if (!AddToWalletIfInvolvingMe(ptx, confirm, update_tx, pbatch))
         return; // Not one of ours
 
     // If a transaction changes 'conflicted' state, that changes the balance
@@ -1186,6 +1216,7 @@ void CWallet::SyncTransaction(const CTransactionRef& ptx, CWalletTx::Confirmatio
 
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 }
 
 void CWallet::TransactionAddedToMempool(const CTransactionRef& ptx, int64_t nAcceptTime) {
@@ -1216,15 +1247,22 @@ void CWallet::BlockConnected(const CBlock& block, int height)
 
     m_last_block_processed_height = height;
     m_last_block_processed = block_hash;
+
+    // Group the tx record writes of the whole block into one db transaction;
+    // high-volume wallets would otherwise pay one db commit per affected tx.
+    WalletBatch batch(*database);
+    const bool fBatchTxn = batch.TxnBegin();
     for (size_t index = 0; index < block.vtx.size(); index++) {
         CWalletTx::Confirmation confirm(CWalletTx::Status::CONFIRMED, height, block_hash, index);
-        SyncTransaction(block.vtx[index], confirm);
+        SyncTransaction(block.vtx[index], confirm, /* update_tx */ true, fBatchTxn ? &batch : nullptr);
         TransactionRemovedFromMempool(block.vtx[index], MemPoolRemovalReason::MANUAL);
     }
+    if (fBatchTxn) batch.TxnCommit();
 
     // reset cache to make sure no longer immature coins are included
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 }
 
 void CWallet::BlockDisconnected(const CBlock& block, int height)
@@ -1237,14 +1275,20 @@ void CWallet::BlockDisconnected(const CBlock& block, int height)
     // future with a stickier abandoned state or even removing abandontransaction call.
     m_last_block_processed_height = height - 1;
     m_last_block_processed = block.hashPrevBlock;
+
+    // As in BlockConnected, group the whole block's writes into one db transaction.
+    WalletBatch batch(*database);
+    const bool fBatchTxn = batch.TxnBegin();
     for (const CTransactionRef& ptx : block.vtx) {
         CWalletTx::Confirmation confirm(CWalletTx::Status::UNCONFIRMED, /* block_height */ 0, {}, /* nIndex */ 0);
-        SyncTransaction(ptx, confirm);
+        SyncTransaction(ptx, confirm, /* update_tx */ true, fBatchTxn ? &batch : nullptr);
     }
+    if (fBatchTxn) batch.TxnCommit();
 
     // reset cache to make sure no longer mature coins are excluded
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 }
 
 void CWallet::UpdatedBlockTip()
@@ -1399,7 +1443,7 @@ bool CWallet::IsDenominated(const COutPoint& outpoint) const
         return false;
     }
 
-    return CCoinJoin::IsDenominatedAmount(it->second.tx->vout[outpoint.n].nValue);
+    return it->second.IsDenominatedOutput(outpoint.n);
 }
 
 bool CWallet::IsFullyMixed(const COutPoint& outpoint) const
@@ -1894,6 +1938,63 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
         progress_end = chain().guessVerificationProgress(stop_block.IsNull() ? tip_hash : stop_block);
     }
     double progress_current = progress_begin;
+
+    // A single reader thread fetches and deserializes the next block from
+    // disk while the current one is scanned, so block reads and wallet
+    // matching overlap instead of taking turns on one thread.
+    std::mutex prefetch_mutex;
+    std::condition_variable prefetch_cv;
+    uint256 prefetch_requested;
+    uint256 prefetch_done_hash;
+    CBlock prefetch_block;
+    bool prefetch_success{false};
+    bool prefetch_stop{false};
+    std::thread prefetch_thread([&] {
+        std::unique_lock<std::mutex> lock(prefetch_mutex);
+        while (true) {
+            prefetch_cv.wait(lock, [&] { return !prefetch_requested.IsNull() || prefetch_stop; });
+            if (prefetch_stop) return;
+            const uint256 hash_to_read = prefetch_requested;
+            lock.unlock();
+            CBlock block_read;
+            const bool found = chain().findBlock(hash_to_read, &block_read) && !block_read.IsNull();
+            lock.lock();
+            prefetch_block = std::move(block_read);
+            prefetch_success = found;
+            prefetch_done_hash = hash_to_read;
+            prefetch_requested.SetNull();
+            prefetch_cv.notify_one();
+        }
+    });
+
+    // Speculatively kick off the read of a block on the reader thread
+    auto request_prefetch = [&](const uint256& hash) {
+        std::lock_guard<std::mutex> lock(prefetch_mutex);
+        if (!prefetch_requested.IsNull() || prefetch_done_hash == hash) {
+            // reader still busy, or the block is already there
+            return;
+        }
+        prefetch_done_hash.SetNull();
+        prefetch_requested = hash;
+        prefetch_cv.notify_one();
+    };
+
+    // Return the block for the given hash, either from the prefetched slot or
+    // by reading it synchronously if the speculation missed
+    auto read_block = [&](const uint256& hash, CBlock& block) {
+        {
+            std::unique_lock<std::mutex> lock(prefetch_mutex);
+            // if this exact block is being read right now, wait for it
+            prefetch_cv.wait(lock, [&] { return prefetch_requested != hash; });
+            if (prefetch_done_hash == hash) {
+                block = std::move(prefetch_block);
+                prefetch_done_hash.SetNull();
+                return prefetch_success;
+            }
+        }
+        return chain().findBlock(hash, &block) && !block.IsNull();
+    };
+
     while (block_height && !fAbortRescan && !chain().shutdownRequested()) {
         m_scanning_progress = (progress_current - progress_begin) / (progress_end - progress_begin);
         if (*block_height % 100 == 0 && progress_end - progress_begin > 0.0) {
@@ -1905,7 +2006,15 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
         }
 
         CBlock block;
-        if (chain().findBlock(block_hash, &block) && !block.IsNull()) {
+        const bool block_found = read_block(block_hash, block);
+        {
+            // let the reader fetch the likely next block while this one is scanned
+            std::optional<int> tip_height = chain().getHeight();
+            if (tip_height && *tip_height > *block_height && block_hash != stop_block) {
+                request_prefetch(chain().getBlockHash(*block_height + 1));
+            }
+        }
+        if (block_found) {
             LOCK(cs_wallet);
             if (!chain().getBlockHeight(block_hash)) {
                 // Abort scan if current block is no longer active, to prevent
@@ -1952,6 +2061,12 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
             }
         }
     }
+    {
+        std::lock_guard<std::mutex> lock(prefetch_mutex);
+        prefetch_stop = true;
+    }
+    prefetch_cv.notify_one();
+    prefetch_thread.join();
     ShowProgress(strprintf("%s " + _("Rescanning...").translated, GetDisplayName()), 100); // hide progress dialog in GUI
     if (block_height && fAbortRescan) {
         WalletLogPrintf("Rescan aborted at block %d. Progress=%f\n", *block_height, progress_current);
@@ -2042,6 +2157,21 @@ std::set<uint256> CWalletTx::GetConflicts() const
     return result;
 }
 
+int CWalletTx::GetOutputDenomination(unsigned int n) const
+{
+    if (m_denom_cache.size() != tx->vout.size()) {
+        m_denom_cache.clear();
+        m_denom_cache.reserve(tx->vout.size());
+        for (const auto& txout : tx->vout) {
+            m_denom_cache.push_back(static_cast<uint8_t>(CCoinJoin::AmountToDenomination(txout.nValue)));
+        }
+    }
+    if (n >= m_denom_cache.size()) {
+        return 0;
+    }
+    return m_denom_cache[n];
+}
+
 CAmount CWalletTx::GetCachableAmount(AmountType type, const isminefilter& filter, bool recalculate) const
 {
     auto& amount = m_amounts[type];
@@ -2165,7 +2295,7 @@ CAmount CWalletTx::GetAnonymizedCredit(const CCoinControl* coinControl) const
             continue;
         }
 
-        if (pwallet->IsSpent(hashTx, i) || !CCoinJoin::IsDenominatedAmount(txout.nValue)) continue;
+        if (pwallet->IsSpent(hashTx, i) || !IsDenominatedOutput(i)) continue;
 
         if (pwallet->IsFullyMixed(outpoint)) {
             nCredit += pwallet->GetCredit(txout, ISMINE_SPENDABLE);
@@ -2212,7 +2342,7 @@ CAmount CWalletTx::GetDenominatedCredit(bool unconfirmed, bool fUseCache) const
     {
         const CTxOut &txout = tx->vout[i];
 
-        if (pwallet->IsSpent(hashTx, i) || !CCoinJoin::IsDenominatedAmount(txout.nValue)) continue;
+        if (pwallet->IsSpent(hashTx, i) || !IsDenominatedOutput(i)) continue;
 
         nCredit += pwallet->GetCredit(txout, ISMINE_SPENDABLE);
         if (!MoneyRange(nCredit))
@@ -2243,14 +2373,17 @@ bool CWalletTx::InMempool() const
 
 bool CWalletTx::IsTrusted() const
 {
-    // Quick answer in most cases
-    if (!pwallet->chain().checkFinalTx(*tx))
-        return false;
+    // Quick answer in most cases. A transaction in the chain passed the
+    // finality checks when its block connected and stays final afterwards,
+    // so only the unconfirmed cases below need the checkFinalTx round trip
+    // through cs_main.
     int nDepth = GetDepthInMainChain();
     if (nDepth >= 1)
         return true;
     if (nDepth < 0)
         return false;
+    if (!pwallet->chain().checkFinalTx(*tx))
+        return false;
     if (IsLockedByInstantSend())
         return true;
     if (!pwallet->m_spend_zero_conf_change || !IsFromMe(ISMINE_ALL)) // using wtx's cached debit
@@ -2373,8 +2506,14 @@ CWallet::Balance CWallet::GetBalance(const int min_depth, const bool avoid_reuse
 {
     Balance ret;
     isminefilter reuse_filter = avoid_reuse ? 0 : ISMINE_USED;
+    // Only the default-argument query is cached; parameterized queries would
+    // each need their own entry and are rare.
+    const bool fCacheable = min_depth == 0 && avoid_reuse && !fAddLocked && coinControl == nullptr;
     {
         LOCK(cs_wallet);
+        if (fCacheable && fBalanceCached) {
+            return m_balance_cached;
+        }
         for (auto pcoin : GetSpendableTXs()) {
             const bool is_trusted{pcoin->IsTrusted()};
             const int tx_depth{pcoin->GetDepthInMainChain()};
@@ -2396,6 +2535,10 @@ CWallet::Balance CWallet::GetBalance(const int min_depth, const bool avoid_reuse
                 ret.m_denominated_untrusted_pending += pcoin->GetDenominatedCredit(true);
             }
         }
+        if (fCacheable) {
+            m_balance_cached = ret;
+            fBalanceCached = true;
+        }
     }
     return ret;
 }
@@ -2495,42 +2638,71 @@ void CWallet::AvailableCoins(std::vector<COutput> &vCoins, bool fOnlySafe, const
     // a coin control object is provided, and has the avoid address reuse flag set to false, do we allow already used addresses
     bool allow_used_addresses = !IsWalletFlagSet(WALLET_FLAG_AVOID_REUSE) || (coinControl && !coinControl->m_avoid_address_reuse);
 
-    for (auto pcoin : GetSpendableTXs()) {
-        const uint256& wtxid = pcoin->GetHash();
-
-        if (!chain().checkFinalTx(*pcoin->tx))
+    // Walk the UTXO index directly instead of re-scanning every output of
+    // every spendable tx: old denominate transactions keep hundreds of
+    // mostly-spent outputs that would otherwise be filtered one by one.
+    for (auto it = setWalletUTXO.begin(); it != setWalletUTXO.end(); ) {
+        const uint256 wtxid = it->hash;
+        // setWalletUTXO is sorted by COutPoint, so all outpoints of the same
+        // tx are neighbors; skip them all at once when a per-tx check fails
+        const auto skip_tx = [&]() {
+            while (it != setWalletUTXO.end() && it->hash == wtxid) ++it;
+        };
+
+        const auto mi = mapWallet.find(wtxid);
+        if (mi == mapWallet.end()) {
+            skip_tx();
             continue;
+        }
+        const CWalletTx* pcoin = &mi->second;
 
-        if (pcoin->IsImmatureCoinBase())
+        if (pcoin->IsImmatureCoinBase()) {
+            skip_tx();
             continue;
+        }
 
         int nDepth = pcoin->GetDepthInMainChain();
 
         // We should not consider coins which aren't at least in our mempool
         // It's possible for these to be conflicted via ancestors which we may never be able to detect
-        if (nDepth == 0 && !pcoin->InMempool())
+        if (nDepth == 0 && !pcoin->InMempool()) {
+            skip_tx();
             continue;
+        }
+
+        // Like IsTrusted(): transactions in the chain passed the finality
+        // checks at connect time and stay final, so only unconfirmed ones
+        // need the checkFinalTx round trip through cs_main.
+        if (nDepth <= 0 && !chain().checkFinalTx(*pcoin->tx)) {
+            skip_tx();
+            continue;
+        }
 
         bool safeTx = pcoin->IsTrusted();
 
         if (fOnlySafe && !safeTx) {
+            skip_tx();
             continue;
         }
 
-        if (nDepth < nMinDepth || nDepth > nMaxDepth)
+        if (nDepth < nMinDepth || nDepth > nMaxDepth) {
+            skip_tx();
             continue;
+        }
 
-        for (unsigned int i = 0; i < pcoin->tx->vout.size(); i++) {
+        for (; it != setWalletUTXO.end() && it->hash == wtxid; ++it) {
+            const unsigned int i = it->n;
+            if (i >= pcoin->tx->vout.size()) continue;
             bool found = false;
             if (nCoinType == CoinType::ONLY_FULLY_MIXED) {
-                if (!CCoinJoin::IsDenominatedAmount(pcoin->tx->vout[i].nValue)) continue;
+                if (!pcoin->IsDenominatedOutput(i)) continue;
                 found = IsFullyMixed(COutPoint(wtxid, i));
             } else if(nCoinType == CoinType::ONLY_READY_TO_MIX) {
-                if (!CCoinJoin::IsDenominatedAmount(pcoin->tx->vout[i].nValue)) continue;
+                if (!pcoin->IsDenominatedOutput(i)) continue;
                 found = !IsFullyMixed(COutPoint(wtxid, i));
             } else if(nCoinType == CoinType::ONLY_NONDENOMINATED) {
                 if (CCoinJoin::IsCollateralAmount(pcoin->tx->vout[i].nValue)) continue; // do not use collateral amounts
-                found = !CCoinJoin::IsDenominatedAmount(pcoin->tx->vout[i].nValue);
+                found = !pcoin->IsDenominatedOutput(i);
             } else if(nCoinType == CoinType::ONLY_MASTERNODE_COLLATERAL) {
                 found = dmn_types::IsCollateralAmount(pcoin->tx->vout[i].nValue);
             } else if(nCoinType == CoinType::ONLY_COINJOIN_COLLATERAL) {
@@ -3038,7 +3210,7 @@ std::vector<CompactTallyItem> CWallet::SelectCoinsGroupedByAddresses(bool fSkipD
 
             if(IsSpent(outpoint.hash, i) || IsLockedCoin(outpoint.hash, i)) continue;
 
-            if(fSkipDenominated && CCoinJoin::IsDenominatedAmount(wtx.tx->vout[i].nValue)) continue;
+            if(fSkipDenominated && wtx.IsDenominatedOutput(i)) continue;
 
             if(fAnonymizable) {
                 // ignore collaterals
@@ -4015,6 +4187,7 @@ void CWallet::LockCoin(const COutPoint& output)
 
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 }
 
 void CWallet::UnlockCoin(const COutPoint& output)
@@ -4026,6 +4199,7 @@ void CWallet::UnlockCoin(const COutPoint& output)
 
     fAnonymizableTallyCached = false;
     fAnonymizableTallyCachedNonDenom = false;
+    fBalanceCached = false;
 }
 
 void CWallet::UnlockAllCoins()
@@ -4781,8 +4955,14 @@ void CWallet::NotifyTransactionLock(const CTransactionRef &tx, const std::shared
     LOCK(cs_wallet);
     // Only notify UI if this transaction is in this wallet
     uint256 txHash = tx->GetHash();
-    std::map<uint256, CWalletTx>::const_iterator mi = mapWallet.find(txHash);
+    std::map<uint256, CWalletTx>::iterator mi = mapWallet.find(txHash);
     if (mi != mapWallet.end()){
+        // Remember the lock on the wtx itself: balance computation calls
+        // IsLockedByInstantSend() for every wtx and can now be answered from
+        // this flag instead of querying the InstantSend manager each time.
+        mi->second.MarkLockedByInstantSend();
+        // The lock may move this tx from pending to trusted in GetBalance()
+        fBalanceCached = false;
         NotifyTransactionChanged(this, txHash, CT_UPDATED);
         NotifyISLockReceived();
 #if HAVE_SYSTEM
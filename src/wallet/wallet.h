@@ -333,6 +333,17 @@ public:
     mutable bool fChangeCached;
     mutable bool fInMempool;
     mutable CAmount nChangeCached;
+    /**
+     * Per-output denomination bits (CCoinJoin::AmountToDenomination), computed
+     * lazily on first use. Output values are immutable, so unlike the amount
+     * caches above this never needs invalidation. Avoids re-running the denom
+     * comparisons for every output on every mixing tick under cs_wallet.
+     */
+    mutable std::vector<uint8_t> m_denom_cache;
+
+    /** Cached CCoinJoin::AmountToDenomination of output n, 0 if not a standard denomination */
+    int GetOutputDenomination(unsigned int n) const;
+    bool IsDenominatedOutput(unsigned int n) const { return GetOutputDenomination(n) > 0; }
 
     CWalletTx(const CWallet* pwalletIn, CTransactionRef arg)
         : tx(std::move(arg))
@@ -538,6 +549,9 @@ public:
     int GetDepthInMainChain() const NO_THREAD_SAFETY_ANALYSIS;
     bool IsInMainChain() const { return GetDepthInMainChain() > 0; }
     bool IsLockedByInstantSend() const;
+    //! Cache a received InstantSend lock so IsLockedByInstantSend() is answered
+    //! from this flag instead of querying the InstantSend manager every call.
+    void MarkLockedByInstantSend() { fIsInstantSendLocked = true; }
     bool IsChainLocked() const;
 
     /**
@@ -703,7 +717,7 @@ private:
      * Abandoned state should probably be more carefully tracked via different
      * posInBlock signals or by checking mempool presence when necessary.
      */
-    bool AddToWalletIfInvolvingMe(const CTransactionRef& tx, CWalletTx::Confirmation confirm, bool fUpdate) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    bool AddToWalletIfInvolvingMe(const CTransactionRef& tx, CWalletTx::Confirmation confirm, bool fUpdate, WalletBatch* pbatch = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     /* Mark a transaction (and its in-wallet descendants) as conflicting with a particular block. */
     void MarkConflicted(const uint256& hashBlock, int conflicting_height, const uint256& hashTx);
@@ -714,8 +728,10 @@ private:
     void SyncMetaData(std::pair<TxSpends::iterator, TxSpends::iterator>) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     /* Used by TransactionAddedToMemorypool/BlockConnected/Disconnected/ScanForWalletTransactions.
-     * Should be called with non-zero block_hash and posInBlock if this is for a transaction that is included in a block. */
-    void SyncTransaction(const CTransactionRef& tx, CWalletTx::Confirmation confirm, bool update_tx = true) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+     * Should be called with non-zero block_hash and posInBlock if this is for a transaction that is included in a block.
+     * When pbatch is given all db writes go into it, so a caller processing a whole block
+     * can group them into a single db transaction. */
+    void SyncTransaction(const CTransactionRef& tx, CWalletTx::Confirmation confirm, bool update_tx = true, WalletBatch* pbatch = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     std::atomic<uint64_t> m_wallet_flags{0};
 
@@ -945,7 +961,9 @@ public:
     DBErrors ReorderTransactions();
 
     void MarkDirty();
-    bool AddToWallet(const CWalletTx& wtxIn, bool fFlushOnClose=true);
+    //! If pbatch is given, all writes go into it and transaction management is
+    //! left to the caller (who typically groups a whole block into one commit).
+    bool AddToWallet(const CWalletTx& wtxIn, bool fFlushOnClose=true, WalletBatch* pbatch = nullptr);
     void LoadToWallet(CWalletTx& wtxIn) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
     void TransactionAddedToMempool(const CTransactionRef& tx, int64_t nAcceptTime) override;
     void BlockConnected(const CBlock& block, int height) override;
@@ -985,6 +1003,14 @@ public:
     };
     Balance GetBalance(const int min_depth = 0, const bool avoid_reuse = true, const bool fAddLocked = false, const CCoinControl* coinControl = nullptr) const;
 
+private:
+    //! Cache of the default-argument GetBalance() result, maintained like the
+    //! anonymizable tally cache: invalidated wherever wallet tx state changes.
+    mutable bool fBalanceCached = false;
+    mutable Balance m_balance_cached;
+
+public:
+
     CAmount GetAnonymizableBalance(bool fSkipDenominated = false, bool fSkipUnconfirmed = true) const;
     float GetAverageAnonymizedRounds() const;
     CAmount GetNormalizedAnonymizedBalance() const;
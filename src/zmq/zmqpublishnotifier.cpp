@@ -22,6 +22,7 @@
 #include <cstdarg>
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -194,6 +195,84 @@ bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, const void
     return true;
 }
 
+/* zmq_msg_init_data free function: the message owns the serialized payload
+   and releases it once the frame has left the socket */
+static void FreeSerializedPayload(void* /*data*/, void* hint)
+{
+    delete static_cast<CDataStream*>(hint);
+}
+
+bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, CDataStream&& data)
+{
+    assert(psocket);
+
+    /* command part is small and copied as usual */
+    zmq_msg_t msgCommand;
+    int rc = zmq_msg_init_size(&msgCommand, strlen(command));
+    if (rc != 0)
+    {
+        zmqError("Unable to initialize ZMQ msg");
+        return false;
+    }
+    memcpy(zmq_msg_data(&msgCommand), command, strlen(command));
+
+    rc = zmq_msg_send(&msgCommand, psocket, ZMQ_SNDMORE);
+    if (rc == -1)
+    {
+        zmqError("Unable to send ZMQ msg");
+        zmq_msg_close(&msgCommand);
+        return false;
+    }
+    zmq_msg_close(&msgCommand);
+
+    /* data part takes ownership of the serialized payload instead of
+       copying it into the frame */
+    auto payload = std::make_unique<CDataStream>(std::move(data));
+    zmq_msg_t msgData;
+    rc = zmq_msg_init_data(&msgData, payload->data(), payload->size(), FreeSerializedPayload, payload.get());
+    if (rc != 0)
+    {
+        zmqError("Unable to initialize ZMQ msg");
+        return false;
+    }
+    payload.release(); // now owned by msgData
+
+    rc = zmq_msg_send(&msgData, psocket, ZMQ_SNDMORE);
+    if (rc == -1)
+    {
+        zmqError("Unable to send ZMQ msg");
+        zmq_msg_close(&msgData);
+        return false;
+    }
+    zmq_msg_close(&msgData);
+
+    /* LE 4byte sequence number part */
+    unsigned char msgseq[sizeof(uint32_t)];
+    WriteLE32(&msgseq[0], nSequence);
+    zmq_msg_t msgSeq;
+    rc = zmq_msg_init_size(&msgSeq, sizeof(uint32_t));
+    if (rc != 0)
+    {
+        zmqError("Unable to initialize ZMQ msg");
+        return false;
+    }
+    memcpy(zmq_msg_data(&msgSeq), msgseq, sizeof(uint32_t));
+
+    rc = zmq_msg_send(&msgSeq, psocket, 0);
+    if (rc == -1)
+    {
+        zmqError("Unable to send ZMQ msg");
+        zmq_msg_close(&msgSeq);
+        return false;
+    }
+    zmq_msg_close(&msgSeq);
+
+    /* increment memory only sequence number after sending */
+    nSequence++;
+
+    return true;
+}
+
 bool CZMQPublishHashBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
 {
     uint256 hash = pindex->GetBlockHash();
@@ -294,7 +373,7 @@ bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
         ss << block;
     }
 
-    return SendZmqMessage(MSG_RAWBLOCK, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWBLOCK, std::move(ss));
 }
 
 bool CZMQPublishRawChainLockNotifier::NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
@@ -315,7 +394,7 @@ bool CZMQPublishRawChainLockNotifier::NotifyChainLock(const CBlockIndex *pindex,
         ss << block;
     }
 
-    return SendZmqMessage(MSG_RAWCHAINLOCK, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWCHAINLOCK, std::move(ss));
 }
 
 bool CZMQPublishRawChainLockSigNotifier::NotifyChainLock(const CBlockIndex *pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
@@ -337,7 +416,7 @@ bool CZMQPublishRawChainLockSigNotifier::NotifyChainLock(const CBlockIndex *pind
         ss << *clsig;
     }
 
-    return SendZmqMessage(MSG_RAWCLSIG, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWCLSIG, std::move(ss));
 }
 
 bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &transaction)
@@ -346,7 +425,7 @@ bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &tr
     LogPrint(BCLog::ZMQ, "zmq: Publish rawtx %s\n", hash.GetHex());
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
     ss << transaction;
-    return SendZmqMessage(MSG_RAWTX, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWTX, std::move(ss));
 }
 
 bool CZMQPublishRawTransactionLockNotifier::NotifyTransactionLock(const CTransactionRef& transaction, const std::shared_ptr<const llmq::CInstantSendLock>& islock)
@@ -355,7 +434,7 @@ bool CZMQPublishRawTransactionLockNotifier::NotifyTransactionLock(const CTransac
     LogPrint(BCLog::ZMQ, "zmq: Publish rawtxlock %s\n", hash.GetHex());
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
     ss << *transaction;
-    return SendZmqMessage(MSG_RAWTXLOCK, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWTXLOCK, std::move(ss));
 }
 
 bool CZMQPublishRawTransactionLockSigNotifier::NotifyTransactionLock(const CTransactionRef& transaction, const std::shared_ptr<const llmq::CInstantSendLock>& islock)
@@ -365,7 +444,7 @@ bool CZMQPublishRawTransactionLockSigNotifier::NotifyTransactionLock(const CTran
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
     ss << *transaction;
     ss << *islock;
-    return SendZmqMessage(MSG_RAWTXLOCKSIG, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWTXLOCKSIG, std::move(ss));
 }
 
 bool CZMQPublishRawGovernanceVoteNotifier::NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote)
@@ -374,7 +453,7 @@ bool CZMQPublishRawGovernanceVoteNotifier::NotifyGovernanceVote(const std::share
     LogPrint(BCLog::ZMQ, "zmq: Publish rawgovernanceobject: hash = %s, vote = %d\n", nHash.ToString(), vote->ToString());
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
     ss << *vote;
-    return SendZmqMessage(MSG_RAWGVOTE, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWGVOTE, std::move(ss));
 }
 
 bool CZMQPublishRawGovernanceObjectNotifier::NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& govobj)
@@ -383,7 +462,7 @@ bool CZMQPublishRawGovernanceObjectNotifier::NotifyGovernanceObject(const std::s
     LogPrint(BCLog::ZMQ, "zmq: Publish rawgovernanceobject: hash = %s, type = %d\n", nHash.ToString(), govobj->GetObjectType());
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
     ss << *govobj;
-    return SendZmqMessage(MSG_RAWGOBJ, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWGOBJ, std::move(ss));
 }
 
 bool CZMQPublishRawInstantSendDoubleSpendNotifier::NotifyInstantSendDoubleSpendAttempt(const CTransactionRef& currentTx, const CTransactionRef& previousTx)
@@ -392,8 +471,8 @@ bool CZMQPublishRawInstantSendDoubleSpendNotifier::NotifyInstantSendDoubleSpendA
     CDataStream ssCurrent(SER_NETWORK, PROTOCOL_VERSION), ssPrevious(SER_NETWORK, PROTOCOL_VERSION);
     ssCurrent << *currentTx;
     ssPrevious << *previousTx;
-    return SendZmqMessage(MSG_RAWISCON, &(*ssCurrent.begin()), ssCurrent.size())
-        && SendZmqMessage(MSG_RAWISCON, &(*ssPrevious.begin()), ssPrevious.size());
+    return SendZmqMessage(MSG_RAWISCON, std::move(ssCurrent))
+        && SendZmqMessage(MSG_RAWISCON, std::move(ssPrevious));
 }
 
 bool CZMQPublishRawRecoveredSigNotifier::NotifyRecoveredSig(const std::shared_ptr<const llmq::CRecoveredSig>& sig)
@@ -403,6 +482,6 @@ bool CZMQPublishRawRecoveredSigNotifier::NotifyRecoveredSig(const std::shared_pt
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
     ss << *sig;
 
-    return SendZmqMessage(MSG_RAWRECSIG, &(*ss.begin()), ss.size());
+    return SendZmqMessage(MSG_RAWRECSIG, std::move(ss));
 }
 
@@ -8,6 +8,7 @@
 #include <zmq/zmqabstractnotifier.h>
 
 class CBlockIndex;
+class CDataStream;
 class CGovernanceVote;
 class CGovernanceObject;
 
@@ -25,6 +26,9 @@ public:
           * message sequence number
     */
     bool SendZmqMessage(const char *command, const void* data, size_t size);
+    /* as above, but hands the (potentially large) serialized payload to zmq
+       by ownership transfer instead of copying it into the message frame */
+    bool SendZmqMessage(const char *command, CDataStream&& data);
 
     bool Initialize(void *pcontext) override;
     void Shutdown() override;